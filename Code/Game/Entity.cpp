@@ -4,6 +4,7 @@
 
 //----------------------------------------------------------------------------------------------------
 #include "Game/Entity.hpp"
+#include "Game/TransformKernels.hpp"
 
 //----------------------------------------------------------------------------------------------------
 Entity::Entity(Game* owner)
@@ -19,10 +20,5 @@ Entity::~Entity()
 //----------------------------------------------------------------------------------------------------
 Mat44 Entity::GetModelToWorldTransform() const
 {
-    Mat44 m2w;
-
-    m2w.SetTranslation3D(m_position);
-    m2w.Append(m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
-
-    return m2w;
+    return TransformKernels::BuildModelToWorldTransform(m_position, m_orientation);
 }
@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------------------------------------
+// EntityCommandBuffer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/EntityCommandBuffer.hpp"
+
+#include <climits>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Out-of-range or NaN record values become INVALID_PROP_HANDLE and are rejected when applied.
+    PropHandle ToPropHandle(double const number)
+    {
+        return number >= 0.0 && number <= static_cast<double>(INT_MAX) ? static_cast<PropHandle>(number) : INVALID_PROP_HANDLE;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityCommandBuffer::PushCreateCube(Vec3 const& position)
+{
+    m_commands.push_back({eEntityCommandType::CREATE_CUBE, INVALID_PROP_HANDLE, position});
+    ++m_createCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityCommandBuffer::PushDestroyProp(PropHandle const propHandle)
+{
+    m_commands.push_back({eEntityCommandType::DESTROY_PROP, propHandle, Vec3::ZERO});
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityCommandBuffer::PushMoveProp(PropHandle const propHandle,
+                                       Vec3 const&      position)
+{
+    m_commands.push_back({eEntityCommandType::MOVE_PROP, propHandle, position});
+}
+
+//----------------------------------------------------------------------------------------------------
+// Decodes script records. The whole chunk is rejected if it is partial or holds an unknown type.
+//
+bool EntityCommandBuffer::AppendRecords(double const* records,
+                                        int const     numberCount)
+{
+    if (records == nullptr || numberCount <= 0 || numberCount % NUMBERS_PER_COMMAND != 0) return false;
+
+    for (int offset = 0; offset < numberCount; offset += NUMBERS_PER_COMMAND)
+    {
+        int const type = static_cast<int>(records[offset]);
+        if (type < 0 || type >= static_cast<int>(eEntityCommandType::COUNT)) return false;
+    }
+
+    m_commands.reserve(m_commands.size() + numberCount / NUMBERS_PER_COMMAND);
+
+    for (int offset = 0; offset < numberCount; offset += NUMBERS_PER_COMMAND)
+    {
+        double const* record = records + offset;
+        Vec3 const    position(static_cast<float>(record[2]), static_cast<float>(record[3]), static_cast<float>(record[4]));
+
+        switch (static_cast<eEntityCommandType>(static_cast<int>(record[0])))
+        {
+        case eEntityCommandType::CREATE_CUBE: PushCreateCube(position); break;
+        case eEntityCommandType::DESTROY_PROP: PushDestroyProp(ToPropHandle(record[1])); break;
+        case eEntityCommandType::MOVE_PROP: PushMoveProp(ToPropHandle(record[1]), position); break;
+        case eEntityCommandType::COUNT: break;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityCommandBuffer::Clear()
+{
+    m_commands.clear();
+    m_createCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool EntityCommandBuffer::IsEmpty() const
+{
+    return m_commands.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+int EntityCommandBuffer::GetCommandCount() const
+{
+    return static_cast<int>(m_commands.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int EntityCommandBuffer::GetCreateCount() const
+{
+    return m_createCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sEntityCommand> const& EntityCommandBuffer::GetCommands() const
+{
+    return m_commands;
+}
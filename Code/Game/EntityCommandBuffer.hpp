@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------------------------------
+// EntityCommandBuffer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropHandle.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+enum class eEntityCommandType : uint8_t
+{
+    CREATE_CUBE,
+    DESTROY_PROP,
+    MOVE_PROP,
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sEntityCommand
+{
+    eEntityCommandType m_type       = eEntityCommandType::CREATE_CUBE;
+    PropHandle         m_propHandle = INVALID_PROP_HANDLE;
+    Vec3               m_position;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sEntityCommandStats
+{
+    int m_created   = 0;
+    int m_destroyed = 0;
+    int m_moved     = 0;
+    int m_rejected  = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Structural changes (create/destroy/move) recorded by scripts and applied by Game in one pass.
+//
+// Script records are flat numbers, NUMBERS_PER_COMMAND per command: [type, propHandle, x, y, z]. They
+// are doubles, since handles need more bits than a float mantissa holds. Destroy and move address
+// props by PropHandle, so commands apply in record order; a command on a destroyed handle is rejected.
+// Handles of the cubes a batch created are collected in record order (Game::GetCreatedPropHandles).
+//
+class EntityCommandBuffer
+{
+public:
+    static int constexpr NUMBERS_PER_COMMAND = 5;
+
+    void PushCreateCube(Vec3 const& position);
+    void PushDestroyProp(PropHandle propHandle);
+    void PushMoveProp(PropHandle propHandle, Vec3 const& position);
+    bool AppendRecords(double const* records, int numberCount);
+    void Clear();
+
+    bool                               IsEmpty() const;
+    int                                GetCommandCount() const;
+    int                                GetCreateCount() const;
+    std::vector<sEntityCommand> const& GetCommands() const;
+
+private:
+    std::vector<sEntityCommand> m_commands;
+    int                         m_createCount = 0;
+};
@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------------------------------
+// EntityPool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sEntityPoolStats
+{
+    int    m_liveCount     = 0;
+    int    m_capacity      = 0;     // Slots in all blocks allocated so far
+    int    m_highWaterMark = 0;     // Most objects alive at once
+    int    m_blockCount    = 0;
+    int    m_recycledCount = 0;     // Allocations served from the free list
+    size_t m_reservedBytes = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Fixed-block pool for entity objects with O(1) Allocate/Free.
+//
+// Storage grows in blocks of BLOCK_SIZE slots and is never returned to the heap until the pool is
+// destroyed, so steady spawn/destroy churn reuses freed slots through an intrusive free list and the
+// footprint stays at the high-water mark. Objects still alive when the pool is destroyed are not
+// destructed; the owner frees them first.
+//
+template <typename T, int BLOCK_SIZE = 1024>
+class EntityPool
+{
+public:
+    EntityPool() = default;
+
+    EntityPool(EntityPool const&)            = delete;
+    EntityPool& operator=(EntityPool const&) = delete;
+
+    template <typename... TArgs>
+    T* Allocate(TArgs&&... args)
+    {
+        sSlot* slot = nullptr;
+
+        if (m_freeList != nullptr)
+        {
+            slot       = m_freeList;
+            m_freeList = slot->m_nextFree;
+            ++m_stats.m_recycledCount;
+        }
+        else
+        {
+            if (m_blocks.empty() || m_nextUnusedSlot == BLOCK_SIZE) AddBlock();
+
+            slot = &m_blocks.back()[m_nextUnusedSlot++];
+        }
+
+        T* object = ::new (static_cast<void*>(slot->m_storage)) T(std::forward<TArgs>(args)...);
+
+        ++m_stats.m_liveCount;
+        if (m_stats.m_liveCount > m_stats.m_highWaterMark) m_stats.m_highWaterMark = m_stats.m_liveCount;
+
+        return object;
+    }
+
+    void Free(T* object)
+    {
+        if (object == nullptr) return;
+
+        object->~T();
+
+        sSlot* slot      = reinterpret_cast<sSlot*>(object);
+        slot->m_nextFree = m_freeList;
+        m_freeList       = slot;
+
+        --m_stats.m_liveCount;
+    }
+
+    sEntityPoolStats const& GetStats() const { return m_stats; }
+    float                   GetOccupancy() const { return m_stats.m_capacity > 0 ? static_cast<float>(m_stats.m_liveCount) / static_cast<float>(m_stats.m_capacity) : 0.f; }
+
+private:
+    union sSlot
+    {
+        sSlot*                   m_nextFree;
+        alignas(T) unsigned char m_storage[sizeof(T)];
+    };
+
+    // Fresh slots are handed out front to back from the newest block; only freed slots enter the free list.
+    void AddBlock()
+    {
+        m_blocks.push_back(std::make_unique<sSlot[]>(BLOCK_SIZE));
+        m_nextUnusedSlot = 0;
+
+        m_stats.m_blockCount    = static_cast<int>(m_blocks.size());
+        m_stats.m_capacity      = m_stats.m_blockCount * BLOCK_SIZE;
+        m_stats.m_reservedBytes = static_cast<size_t>(m_stats.m_capacity) * sizeof(sSlot);
+    }
+
+    std::vector<std::unique_ptr<sSlot[]>> m_blocks;
+    sSlot*                                m_freeList       = nullptr;
+    int                                   m_nextUnusedSlot = 0;     // In the newest block
+    sEntityPoolStats                      m_stats;
+};
@@ -23,19 +23,26 @@
 #include "Engine/Resource/ResourceSubsystem.hpp"
 #include "Engine/Scripting/ScriptSubsystem.hpp"
 #include "Game/Game.hpp"
+#include "Game/ParallelFor.hpp"
+#include "Game/PropStore.hpp"
+#include "Game/Framework/GameBenchmark.hpp"
+#include "Game/Framework/ScriptHotReloader.hpp"
+#include "Game/Framework/ScriptIdleCollector.hpp"
+#include "Game/Framework/ScriptSystemProfiler.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "ThirdParty/json/json.hpp"
 
 //----------------------------------------------------------------------------------------------------
-App*                   g_app               = nullptr;       // Created and owned by Main_Windows.cpp
-AudioSystem*           g_audio             = nullptr;       // Created and owned by the App
-BitmapFont*            g_bitmapFont        = nullptr;       // Created and owned by the App
-Game*                  g_game              = nullptr;       // Created and owned by the App
-Renderer*              g_renderer          = nullptr;       // Created and owned by the App
-RandomNumberGenerator* g_rng               = nullptr;       // Created and owned by the App
-Window*                g_window            = nullptr;       // Created and owned by the App
-ResourceSubsystem*     g_resourceSubsystem = nullptr;       // Created and owned by the App
-ScriptSubsystem*       g_scriptSubsystem   = nullptr;       // Created and owned by the App
+App*                   g_app                = nullptr;       // Created and owned by Main_Windows.cpp
+AudioSystem*           g_audio              = nullptr;       // Created and owned by the App
+BitmapFont*            g_bitmapFont         = nullptr;       // Created and owned by the App
+Game*                  g_game               = nullptr;       // Created and owned by the App
+ParallelForWorkers*    g_parallelForWorkers = nullptr;       // Created and owned by the App
+Renderer*              g_renderer           = nullptr;       // Created and owned by the App
+RandomNumberGenerator* g_rng                = nullptr;       // Created and owned by the App
+Window*                g_window             = nullptr;       // Created and owned by the App
+ResourceSubsystem*     g_resourceSubsystem  = nullptr;       // Created and owned by the App
+ScriptSubsystem*       g_scriptSubsystem    = nullptr;       // Created and owned by the App
 
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::m_isQuitting = false;
@@ -49,6 +56,11 @@ void App::Startup()
     g_eventSystem = new EventSystem(sEventSystemConfig);
     g_eventSystem->SubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
     g_eventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
+    GameBenchmark::SubscribeEventCallbacks();
+    ScriptSystemProfiler::SubscribeEventCallbacks();
+    ScriptIdleCollector::SubscribeEventCallbacks();
+    ScriptHotReloader::SubscribeEventCallbacks();
+    PropStore::SubscribeEventCallbacks();
 
     //-End-of-EventSystem-----------------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------
@@ -56,12 +68,15 @@ void App::Startup()
 
     // Initialize JobSystem with 3 generic worker threads and 1 I/O thread
     JobSystem* jobSystem = new JobSystem();
-    jobSystem->StartUp(3, 1);
+    jobSystem->StartUp(JOB_WORKER_THREAD_COUNT, 1);
     g_jobSystem = jobSystem;  // Set global pointer for backward compatibility
 
     // Initialize GEngine singleton with JobSystem
     GEngine::Get().Initialize(jobSystem);
 
+    // Persistent helpers for ParallelFor loops (prop update, transform hierarchy, command lists)
+    g_parallelForWorkers = new ParallelForWorkers(PARALLEL_FOR_WORKER_COUNT);
+
     //-End-of-JobSystem-------------------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------
     //-Start-of-InputSystem---------------------------------------------------------------------------
@@ -225,7 +240,7 @@ void App::Startup()
     scriptConfig.enableDebugging     = true;
     scriptConfig.heapSizeLimit       = 256;
     scriptConfig.enableConsoleOutput = true;
-    scriptConfig.enableHotReload     = true;
+    scriptConfig.enableHotReload     = false;   // Game's ScriptHotReloader reloads per module instead
     // Chrome DevTools Inspector Configuration
     scriptConfig.enableInspector = true;  // Enable Chrome DevTools integration
     scriptConfig.inspectorPort   = 9229;  // Chrome DevTools connection port
@@ -248,6 +263,7 @@ void App::Startup()
     g_audio->Startup();
     g_resourceSubsystem->Startup();  // Keep the old instance for backward compatibility
     g_scriptSubsystem->Startup();
+    m_scriptIdleCollector.Attach(g_scriptSubsystem->GetIsolate());
 
     g_logSubsystem->RegisterCategory("LogApp", eLogVerbosity::Log, eLogVerbosity::All);
     g_logSubsystem->RegisterCategory("LogGame", eLogVerbosity::Log, eLogVerbosity::All);
@@ -268,6 +284,9 @@ void App::Shutdown()
     // Shutdown hot-reload system first
     if (g_scriptSubsystem)
     {
+        if (g_game != nullptr) g_game->ShutdownJavaScriptFramework();
+
+        m_scriptIdleCollector.Detach();
         g_scriptSubsystem->Shutdown();
         delete g_scriptSubsystem;
         g_scriptSubsystem = nullptr;
@@ -322,6 +341,7 @@ void App::Shutdown()
 
     // Shutdown GEngine singleton and JobSystem
     GEngine::Get().Shutdown();
+    GAME_SAFE_RELEASE(g_parallelForWorkers);
 
     if (g_jobSystem)
     {
@@ -378,8 +398,16 @@ STATIC void App::RequestQuit()
 }
 
 //----------------------------------------------------------------------------------------------------
-void App::BeginFrame() const
+ScriptIdleCollector& App::GetScriptIdleCollector()
+{
+    return m_scriptIdleCollector;
+}
+
+//----------------------------------------------------------------------------------------------------
+void App::BeginFrame()
 {
+    m_scriptIdleCollector.BeginFrame();
+
     g_eventSystem->BeginFrame();
     g_window->BeginFrame();
     g_renderer->BeginFrame();
@@ -401,6 +429,7 @@ void App::Update()
         g_scriptSubsystem->Update();
     }
 
+    m_scriptIdleCollector.BeginPhase(eScriptGcPhase::UPDATE);
     g_game->UpdateJS();
 }
 
@@ -411,10 +440,12 @@ void App::Update()
 // Ultimately this function (App::Render) will only call methods on Renderer (like Renderer::DrawVertexArray)
 //	to draw things, never calling OpenGL (nor DirectX) functions directly.
 //
-void App::Render() const
+void App::Render()
 {
     Rgba8 const clearColor = Rgba8::GREY;
 
+    m_scriptIdleCollector.BeginPhase(eScriptGcPhase::RENDER);
+
     g_renderer->ClearScreen(clearColor, Rgba8::BLACK);
     g_game->RenderJS();
 
@@ -424,10 +455,11 @@ void App::Render() const
 }
 
 //----------------------------------------------------------------------------------------------------
-void App::EndFrame() const
+void App::EndFrame()
 {
     g_eventSystem->EndFrame();
     g_window->EndFrame();
+    m_scriptIdleCollector.EndFrame();   // Idle-time GC, before present so it only spends leftover budget
     g_renderer->EndFrame();
     DebugRenderEndFrame();
     g_devConsole->EndFrame();
@@ -480,8 +512,9 @@ std::any App::OnGarbageCollection(std::vector<std::any> const& args)
     UNUSED(args)
     if (g_scriptSubsystem)
     {
-        g_scriptSubsystem->ForceGarbageCollection();
-        DebuggerPrintf("JS: 垃圾回收已執行\n");
+        // Timed and attributed to the current frame phase (see "ScriptGcStats")
+        float const pauseMs = g_app->GetScriptIdleCollector().CollectNow();
+        DebuggerPrintf("JS: 垃圾回收已執行 (%.3f ms)\n", pauseMs);
     }
     return std::any{};
 }
@@ -510,16 +543,8 @@ void App::SetupScriptingBindings()
 
     DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(App::SetupScriptingBindings)(start)"));
 
-    // Initialize hot-reload system (now integrated into ScriptSubsystem)
-    std::string projectRoot = "C:/p4/Personal/SD/ProtogameJS3D/";
-    if (g_scriptSubsystem->InitializeHotReload(projectRoot))
-    {
-        DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(App::SetupScriptingBindings) Hot-reload system initialized successfully"));
-    }
-    else
-    {
-        DAEMON_LOG(LogScript, eLogVerbosity::Warning, StringFormat("(App::SetupScriptingBindings) Hot-reload system initialization failed"));
-    }
+    // Hot reload is driven by Game's ScriptHotReloader (module-graph based, per-module re-evaluation);
+    // ScriptSubsystem's whole-project file watcher (InitializeHotReload) is intentionally not started.
 
     m_gameScriptInterface = std::make_shared<GameScriptInterface>(g_game);
     g_scriptSubsystem->RegisterScriptableObject("game", m_gameScriptInterface);
@@ -530,6 +555,18 @@ void App::SetupScriptingBindings()
     m_audioScriptInterface = std::make_shared<AudioScriptInterface>(g_audio);
     g_scriptSubsystem->RegisterScriptableObject("audio", m_audioScriptInterface);
 
+    // Generated V8 callbacks replace ScriptSubsystem's CallMethod dispatch for the bound methods;
+    // audio calls are one-off and keep the engine's callbacks
+    if (!m_gameScriptInterface->InstallScriptFunctions(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "game"))
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, StringFormat("(App::SetupScriptingBindings)(game methods keep the generic callbacks)"));
+    }
+
+    if (!m_inputScriptBindings.InstallScriptFunctions(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "input"))
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, StringFormat("(App::SetupScriptingBindings)(input methods keep the generic callbacks)"));
+    }
+
     g_scriptSubsystem->RegisterGlobalFunction("print", OnPrint);
     g_scriptSubsystem->RegisterGlobalFunction("debug", OnDebug);
     g_scriptSubsystem->RegisterGlobalFunction("gc", OnGarbageCollection);
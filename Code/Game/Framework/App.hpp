@@ -7,6 +7,8 @@
 #include <memory>
 
 #include "Game/Framework/GameScriptInterface.hpp"
+#include "Game/Framework/InputScriptBindings.hpp"
+#include "Game/Framework/ScriptIdleCollector.hpp"
 
 #include "Engine/Audio/AudioScriptInterface.hpp"
 #include "Engine/Core/EventSystem.hpp"
@@ -32,11 +34,13 @@ public:
     static void RequestQuit();
     static bool m_isQuitting;
 
+    ScriptIdleCollector& GetScriptIdleCollector();
+
 private:
-    void BeginFrame() const;
+    void BeginFrame();
     void Update();
-    void Render() const;
-    void EndFrame() const;
+    void Render();
+    void EndFrame();
 
     static std::any OnPrint(std::vector<std::any> const& args);
     static std::any OnDebug(std::vector<std::any> const& args);
@@ -49,4 +53,6 @@ private:
     std::shared_ptr<GameScriptInterface>   m_gameScriptInterface;
     std::shared_ptr<InputScriptInterface>  m_inputScriptInterface;
     std::shared_ptr<AudioScriptInterface>  m_audioScriptInterface;
+    InputScriptBindings                    m_inputScriptBindings;
+    ScriptIdleCollector                    m_scriptIdleCollector;
 };
@@ -0,0 +1,1807 @@
+﻿//----------------------------------------------------------------------------------------------------
+// GameBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/GameBenchmark.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Entity.hpp"
+#include "Game/Frustum.hpp"
+#include "Game/Game.hpp"
+#include "Game/IndexedMesh.hpp"
+#include "Game/ParallelFor.hpp"
+#include "Game/Player.hpp"
+#include "Game/PropCommandList.hpp"
+#include "Game/PropDrawQueue.hpp"
+#include "Game/PropRenderBackend.hpp"
+#include "Game/PropSpatialQueryBatch.hpp"
+#include "Game/PropStore.hpp"
+#include "Game/ResourceHandleTable.hpp"
+#include "Game/TransformHierarchy.hpp"
+#include "Game/TransformKernels.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/GameScriptInterface.hpp"
+#include "Game/Framework/ScriptCodeCache.hpp"
+#include "Game/Framework/ScriptFunctionHandle.hpp"
+#include "Game/Framework/ScriptModuleCompiler.hpp"
+#include "Game/Framework/ScriptModuleGraph.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Resource/ResourceSubsystem.hpp"
+#include "Engine/Scripting/ScriptSubsystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    using BenchmarkClock = std::chrono::high_resolution_clock;
+
+    double GetElapsedMicroseconds(BenchmarkClock::time_point const& start)
+    {
+        return std::chrono::duration<double, std::micro>(BenchmarkClock::now() - start).count();
+    }
+
+    // Restores the prop list to its size before a benchmark pass. Swap-remove only moves tail props among
+    // themselves, so the props below firstPropIndex keep their indices.
+    void DestroyPropsFrom(Game& game, int const firstPropIndex)
+    {
+        EntityCommandBuffer commandBuffer;
+
+        for (int propIndex = firstPropIndex; propIndex < game.GetPropCount(); ++propIndex)
+        {
+            commandBuffer.PushDestroyProp(game.GetPropHandle(propIndex));
+        }
+
+        game.ApplyEntityCommands(commandBuffer);
+    }
+
+    // The demo scene's meshes plus cubeCount cubes; meshes are uploaded to the store's render backend, if set.
+    void FillUploadBenchmarkScene(PropStore& propStore, int const cubeCount)
+    {
+        propStore.Reserve(cubeCount + 3);
+        propStore.AddProp(Vec3::ZERO, Rgba8::WHITE, propStore.AllocateRenderProp(sPropMeshDesc::Grid()));
+        propStore.AddProp(Vec3::ZERO, Rgba8::WHITE, propStore.AllocateRenderProp(sPropMeshDesc::Sphere()));
+
+        for (int cubeIndex = 0; cubeIndex < cubeCount; ++cubeIndex)
+        {
+            propStore.AddProp(Vec3(static_cast<float>(cubeIndex % 100), static_cast<float>(cubeIndex / 100), 0.f), Rgba8::WHITE, propStore.AllocateRenderProp(sPropMeshDesc::Cube()));
+        }
+    }
+
+    // propCount props with mixed shaders, blend modes, textures and meshes. The stand-in textures are only
+    // compared by pointer, never dereferenced, so they work with a headless backend only.
+    void FillMixedStateBenchmarkScene(PropStore& propStore, ResourceHandleTable& resourceHandles, int const propCount)
+    {
+        static int const s_textureCount = 8;
+        static char      s_textureStorage[s_textureCount];
+
+        TextureHandle textures[s_textureCount];
+
+        for (int textureIndex = 0; textureIndex < s_textureCount; ++textureIndex)
+        {
+            textures[textureIndex] = resourceHandles.RegisterTexture(StringFormat("PropDrawSort/{}", textureIndex), reinterpret_cast<Texture const*>(&s_textureStorage[textureIndex]));
+        }
+
+        propStore.Reserve(propCount);
+
+        for (int propIndex = 0; propIndex < propCount; ++propIndex)
+        {
+            sPropRenderState renderState;
+            renderState.m_shader    = propIndex % 3 == 0 ? ePropShader::DEFAULT : ePropShader::BLOOM;
+            renderState.m_blendMode = propIndex % 7 == 0 ? eBlendMode::ALPHA : eBlendMode::OPAQUE;
+
+            sPropMeshDesc const meshDesc = propIndex % 2 == 0 ? sPropMeshDesc::Cube() : sPropMeshDesc::Sphere();
+            Vec3 const          position = Vec3(static_cast<float>(propIndex % 100), static_cast<float>(propIndex / 100), 0.f);
+
+            propStore.AddProp(position, Rgba8::WHITE, propStore.AllocateRenderProp(meshDesc, textures[propIndex % s_textureCount], renderState));
+        }
+    }
+
+    // Recording backend that also folds every call and its arguments into one FNV-1a hash, so two frames
+    // can be checked for the same calls in the same order.
+    class HashingPropRenderBackend : public RecordingPropRenderBackend
+    {
+    public:
+        void DrawStaticMesh(PropGpuMeshHandle const mesh) override
+        {
+            Hash(&mesh, sizeof(mesh));
+            RecordingPropRenderBackend::DrawStaticMesh(mesh);
+        }
+
+        void DrawDynamicMesh(VertexList_PCU const& triangleList) override
+        {
+            size_t const vertexCount = triangleList.size();
+            Hash(&vertexCount, sizeof(vertexCount));
+            RecordingPropRenderBackend::DrawDynamicMesh(triangleList);
+        }
+
+        void SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color) override
+        {
+            Hash(modelToWorldTransform.m_values, sizeof(modelToWorldTransform.m_values));
+            Hash(&color, sizeof(color));
+            RecordingPropRenderBackend::SetModelConstants(modelToWorldTransform, color);
+        }
+
+        using RecordingPropRenderBackend::DrawDynamicMesh;
+
+        void     ResetHash() { m_hash = 14695981039346656037ull; }
+        uint64_t GetHash() const { return m_hash; }
+
+    protected:
+        void BindRenderState(sPropRenderState const& state, uint8_t const changedFields) override
+        {
+            Hash(&state, sizeof(state));
+            Hash(&changedFields, sizeof(changedFields));
+            RecordingPropRenderBackend::BindRenderState(state, changedFields);
+        }
+
+        void BindTexture(Texture const* texture) override
+        {
+            Hash(&texture, sizeof(texture));
+            RecordingPropRenderBackend::BindTexture(texture);
+        }
+
+    private:
+        void Hash(void const* data, size_t const byteCount)
+        {
+            for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex)
+            {
+                m_hash = (m_hash ^ static_cast<unsigned char const*>(data)[byteIndex]) * 1099511628211ull;
+            }
+        }
+
+        uint64_t m_hash = 14695981039346656037ull;
+    };
+
+    // One frame of prop draws the way Game::RenderEntities issues them.
+    void DrawBenchmarkFrame(PropStore& propStore, PropDrawQueue& drawQueue, PropRenderBackend& renderBackend, bool const sortItems = true)
+    {
+        static ResourceHandleTable const s_noResources;
+
+        drawQueue.Clear();
+        propStore.SubmitDraws(drawQueue, Vec3::ZERO, s_noResources);
+        drawQueue.Flush(renderBackend, sortItems);
+    }
+
+    // Replica of the prop layout before PropStore: one heap object per prop (transform, motion, color and
+    // its own vertex list), updated through a virtual call. Kept only as the benchmark baseline.
+    class PropBeforeStore : public Entity
+    {
+    public:
+        PropBeforeStore()
+            : Entity(nullptr)
+        {
+        }
+
+        void Update(float const deltaSeconds) override
+        {
+            m_position += m_velocity * deltaSeconds;
+            m_orientation.m_yawDegrees += m_angularVelocity.m_yawDegrees * deltaSeconds;
+            m_orientation.m_pitchDegrees += m_angularVelocity.m_pitchDegrees * deltaSeconds;
+            m_orientation.m_rollDegrees += m_angularVelocity.m_rollDegrees * deltaSeconds;
+        }
+
+        void Render() const override
+        {
+        }
+
+        std::vector<Vertex_PCU> m_vertexes;
+    };
+
+    // Replica of the dispatch GameScriptInterface used before ScriptMethodTable: an if/else chain over
+    // the method names in registration order, then a wrapper with ValidateArgCount, Extract* and a
+    // formatted result string. Kept only as the benchmark baseline.
+    ScriptMethodResult CallMethodBeforeBindingTable(Game& game, String const& methodName, ScriptArgs const& args)
+    {
+        static char const* const s_precedingMethodNames[] = {"appRequestQuit", "createCube", "moveProp", "getPlayerPosition"};
+
+        for (char const* precedingMethodName : s_precedingMethodNames)
+        {
+            if (methodName == precedingMethodName) return ScriptMethodResult::Error("not part of the benchmark");
+        }
+
+        if (methodName == "movePlayerCamera")
+        {
+            auto result = ScriptTypeExtractor::ValidateArgCount(args, 3, "movePlayerCamera");
+            if (!result.success) return result;
+
+            Vec3 offset = ScriptTypeExtractor::ExtractVec3(args, 0);
+            game.MovePlayerCamera(offset);
+            return ScriptMethodResult::Success(String("相機位置已移動: (" +
+                std::to_string(offset.x) + ", " +
+                std::to_string(offset.y) + ", " +
+                std::to_string(offset.z) + ")"));
+        }
+
+        static char const* const s_followingMethodNames[] = {"update", "render", "executeCommand", "executeFile"};
+
+        for (char const* followingMethodName : s_followingMethodNames)
+        {
+            if (methodName == followingMethodName) return ScriptMethodResult::Error("not part of the benchmark");
+        }
+
+        if (methodName == "isAttractMode")
+        {
+            auto result = ScriptTypeExtractor::ValidateArgCount(args, 0, "isAttractMode");
+            if (!result.success) return result;
+
+            return ScriptMethodResult::Success(game.IsAttractMode());
+        }
+
+        return ScriptMethodResult::Error("未知的方法: " + methodName);
+    }
+
+    // The game bindings registered a second time, through ScriptSubsystem only: "__benchmarkGenericGame"
+    // keeps its generic callbacks (CallMethod per call). Registered once and kept, since the script
+    // object outlives the benchmark.
+    GameScriptInterface& GetGenericBenchmarkScriptInterface()
+    {
+        static std::shared_ptr<GameScriptInterface> s_scriptInterface;
+
+        if (s_scriptInterface == nullptr)
+        {
+            s_scriptInterface = std::make_shared<GameScriptInterface>(g_game);
+            g_scriptSubsystem->RegisterScriptableObject("__benchmarkGenericGame", s_scriptInterface);
+        }
+
+        return *s_scriptInterface;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void GameBenchmark::SubscribeEventCallbacks()
+{
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkScriptBridge", OnBenchmarkScriptBridge);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkModuleGraph", OnBenchmarkModuleGraph);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkEntityCommands", OnBenchmarkEntityCommands);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkScriptBinding", OnBenchmarkScriptBinding);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkNumericCalls", OnBenchmarkNumericCalls);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropUpdate", OnBenchmarkPropUpdate);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropChurn", OnBenchmarkPropChurn);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropMeshMemory", OnBenchmarkPropMeshMemory);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropUpload", OnBenchmarkPropUpload);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropMeshIndexing", OnBenchmarkPropMeshIndexing);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropDrawSort", OnBenchmarkPropDrawSort);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkResourceLookup", OnBenchmarkResourceLookup);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropCulling", OnBenchmarkPropCulling);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropSpatialQuery", OnBenchmarkPropSpatialQuery);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropUpdateScaling", OnBenchmarkPropUpdateScaling);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkTransformKernels", OnBenchmarkTransformKernels);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkTransformHierarchy", OnBenchmarkTransformHierarchy);
+    g_eventSystem->SubscribeEventCallbackFunction("BenchmarkPropCommandLists", OnBenchmarkPropCommandLists);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Compares the per-frame bridges: a formatted source string with result fetch, a constant source that
+// reads the deltas back from game.*DeltaSeconds, and the persistent function handle Game::UpdateJS and
+// RenderJS now use. All three call the same no-op so only bridge cost is timed.
+//
+STATIC bool GameBenchmark::OnBenchmarkScriptBridge(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_scriptSubsystem == nullptr || !g_scriptSubsystem->IsInitialized()) return false;
+
+    int constexpr iterationCount = 1000;
+
+    g_scriptSubsystem->ExecuteScript("globalThis.__benchmarkBridgeNoop = function(gameDelta, systemDelta) {};");
+
+    BenchmarkClock::time_point const formattedStart = BenchmarkClock::now();
+
+    for (int i = 0; i < iterationCount; ++i)
+    {
+        float const gameDeltaSeconds   = 0.016f + static_cast<float>(i) * 0.000001f;
+        float const systemDeltaSeconds = 0.017f + static_cast<float>(i) * 0.000001f;
+        g_scriptSubsystem->ExecuteScript(StringFormat("globalThis.__benchmarkBridgeNoop({}, {});", std::to_string(gameDeltaSeconds), std::to_string(systemDeltaSeconds)));
+        String const result = g_scriptSubsystem->GetLastResult();
+        UNUSED(result)
+    }
+
+    double const formattedMicroseconds = GetElapsedMicroseconds(formattedStart);
+
+    String const constantSource = "globalThis.__benchmarkBridgeNoop(game.gameDeltaSeconds, game.systemDeltaSeconds);";
+
+    BenchmarkClock::time_point const constantStart = BenchmarkClock::now();
+
+    for (int i = 0; i < iterationCount; ++i)
+    {
+        g_scriptSubsystem->ExecuteScript(constantSource);
+    }
+
+    double const constantMicroseconds = GetElapsedMicroseconds(constantStart);
+
+    ScriptFunctionHandle noopFunction(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "globalThis", "__benchmarkBridgeNoop");
+
+    BenchmarkClock::time_point const handleStart = BenchmarkClock::now();
+
+    for (int i = 0; i < iterationCount; ++i)
+    {
+        double const frameDeltaSeconds[] = {0.016 + static_cast<double>(i) * 0.000001, 0.017 + static_cast<double>(i) * 0.000001};
+        noopFunction.Call(frameDeltaSeconds, 2);
+    }
+
+    double const handleMicroseconds = GetElapsedMicroseconds(handleStart);
+
+    ReportResult(StringFormat("(ScriptBridge)(formatted source)({:.2f} us/call)", formattedMicroseconds / iterationCount));
+    ReportResult(StringFormat("(ScriptBridge)(constant source)({:.2f} us/call)", constantMicroseconds / iterationCount));
+    ReportResult(StringFormat("(ScriptBridge)(function handle)({:.2f} us/call)", handleMicroseconds / iterationCount));
+    ReportResult(StringFormat("(ScriptBridge)(per frame, update + render)({:.2f} us -> {:.2f} us -> {:.2f} us)",
+                              2.0 * formattedMicroseconds / iterationCount, 2.0 * constantMicroseconds / iterationCount, 2.0 * handleMicroseconds / iterationCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Writes a synthetic binary-tree module graph (module_0 imports module_1 and module_2, ...) into a
+// temporary directory and loads it twice with its own code cache and manifest: cold into an empty
+// cache, which produces an entry per module, then warm from those entries into a fresh module
+// registry. The directory is removed afterwards, so neither the real cache nor Data/ is touched.
+//
+STATIC bool GameBenchmark::OnBenchmarkModuleGraph(EventArgs& args)
+{
+    if (g_scriptSubsystem == nullptr || !g_scriptSubsystem->IsInitialized()) return false;
+
+    int const moduleCount = args.GetValue("count", 300);
+
+    std::error_code       errorCode;
+    std::filesystem::path rootDirectory = std::filesystem::temp_directory_path(errorCode);
+
+    if (errorCode) return false;
+
+    rootDirectory /= StringFormat("ProtogameJS3D-ModuleGraph-{}", BenchmarkClock::now().time_since_epoch().count());
+
+    String const graphDirectory = (rootDirectory / "modules").generic_string();
+    String const cacheDirectory = (rootDirectory / "cache").generic_string();
+    std::filesystem::create_directories(graphDirectory, errorCode);
+
+    for (int moduleIndex = 0; moduleIndex < moduleCount; ++moduleIndex)
+    {
+        std::ofstream module(StringFormat("{}/module_{}.mjs", graphDirectory, moduleIndex), std::ios::trunc);
+
+        for (int childIndex = 2 * moduleIndex + 1; childIndex <= 2 * moduleIndex + 2 && childIndex < moduleCount; ++childIndex)
+        {
+            module << StringFormat("import {{ Module{} }} from './module_{}.mjs';\n", childIndex, childIndex);
+        }
+
+        module << StringFormat("export class Module{} {{\n", moduleIndex);
+        module << "    constructor() { this.values = []; for (let i = 0; i < 16; ++i) { this.values.push(i * 0.5); } }\n";
+        module << "    sum() { return this.values.reduce((total, value) => total + value, 0); }\n";
+        module << "    scale(factor) { return this.values.map((value) => value * factor); }\n";
+        module << "}\n";
+    }
+
+    String const entryPath = graphDirectory + "/module_0.mjs";
+
+    ScriptModuleGraph moduleGraph;
+    moduleGraph.Build(entryPath);
+
+    sScriptModuleLoadStats coldStats;
+    sScriptModuleLoadStats warmStats;
+    bool                   isSuccess = false;
+
+    {
+        ScriptCodeCache      codeCache(cacheDirectory);
+        ScriptModuleCompiler compiler(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), &codeCache);
+
+        isSuccess = compiler.ExecuteModule(entryPath, &coldStats);
+
+        codeCache.UpdateManifest(moduleGraph);
+        codeCache.SaveManifest();
+    }
+
+    if (isSuccess)
+    {
+        ScriptCodeCache codeCache(cacheDirectory);
+        codeCache.LoadManifest();
+
+        ScriptModuleCompiler compiler(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), &codeCache);
+
+        isSuccess = compiler.ExecuteModule(entryPath, &warmStats);
+    }
+
+    std::filesystem::remove_all(rootDirectory, errorCode);
+
+    ReportResult(StringFormat("(ModuleGraph)({} modules)(cold)({} caches produced)(compile {:.2f} ms, total {:.2f} ms)",
+                              moduleGraph.GetModules().size(), coldStats.m_producedCacheCount, coldStats.m_compileMs, coldStats.m_totalMs));
+    ReportResult(StringFormat("(ModuleGraph)({} modules)(warm)({} consumed, {} rejected)(compile {:.2f} ms, total {:.2f} ms)",
+                              moduleGraph.GetModules().size(), warmStats.m_consumedCacheCount, warmStats.m_rejectedCacheCount, warmStats.m_compileMs, warmStats.m_totalMs));
+
+    return isSuccess;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Spawns "count" cubes (default 100000) one call at a time and as one command batch, first directly
+// from C++ and then from script, removing them again after each pass.
+//
+STATIC bool GameBenchmark::OnBenchmarkEntityCommands(EventArgs& args)
+{
+    if (g_game == nullptr) return false;
+
+    int const cubeCount       = args.GetValue("count", 100000);
+    int const baselineCount   = g_game->GetPropCount();
+    auto      GetCubePosition = [](int const cubeIndex)
+    {
+        return Vec3(static_cast<float>(cubeIndex % 100) - 50.f, static_cast<float>(cubeIndex / 100 % 100) - 50.f, static_cast<float>(cubeIndex / 10000));
+    };
+
+    // C++: CreateCube per cube
+    BenchmarkClock::time_point const perCallStart = BenchmarkClock::now();
+
+    for (int cubeIndex = 0; cubeIndex < cubeCount; ++cubeIndex)
+    {
+        g_game->CreateCube(GetCubePosition(cubeIndex));
+    }
+
+    double const perCallMicroseconds = GetElapsedMicroseconds(perCallStart);
+    DestroyPropsFrom(*g_game, baselineCount);
+
+    // C++: one command batch
+    EntityCommandBuffer commandBuffer;
+
+    BenchmarkClock::time_point const batchStart = BenchmarkClock::now();
+
+    for (int cubeIndex = 0; cubeIndex < cubeCount; ++cubeIndex)
+    {
+        commandBuffer.PushCreateCube(GetCubePosition(cubeIndex));
+    }
+
+    g_game->ApplyEntityCommands(commandBuffer);
+
+    double const batchMicroseconds = GetElapsedMicroseconds(batchStart);
+    DestroyPropsFrom(*g_game, baselineCount);
+
+    ReportResult(StringFormat("(EntityCommands)(C++)({} cubes)(CreateCube per call)({:.2f} ms)", cubeCount, perCallMicroseconds / 1000.0));
+    ReportResult(StringFormat("(EntityCommands)(C++)({} cubes)(command batch)({:.2f} ms)", cubeCount, batchMicroseconds / 1000.0));
+
+    if (g_scriptSubsystem == nullptr || !g_scriptSubsystem->IsInitialized()) return true;
+
+    // Script: game.createCube per cube vs. JSEngine.entityCommands submitted once
+    String const perCallSource = StringFormat("for (let i = 0; i < {}; ++i) {{ game.createCube(i % 100 - 50, Math.floor(i / 100) % 100 - 50, Math.floor(i / 10000)); }}", cubeCount);
+    String const batchSource   = StringFormat("{{ const commands = globalThis.JSEngine.entityCommands; for (let i = 0; i < {}; ++i) {{ commands.pushCreateCube(i % 100 - 50, Math.floor(i / 100) % 100 - 50, Math.floor(i / 10000)); }} commands.flush(); }}", cubeCount);
+
+    BenchmarkClock::time_point const scriptPerCallStart = BenchmarkClock::now();
+    g_scriptSubsystem->ExecuteScript(perCallSource);
+    double const scriptPerCallMicroseconds = GetElapsedMicroseconds(scriptPerCallStart);
+    DestroyPropsFrom(*g_game, baselineCount);
+
+    BenchmarkClock::time_point const scriptBatchStart = BenchmarkClock::now();
+    g_scriptSubsystem->ExecuteScript(batchSource);
+    double const scriptBatchMicroseconds = GetElapsedMicroseconds(scriptBatchStart);
+    DestroyPropsFrom(*g_game, baselineCount);
+
+    ReportResult(StringFormat("(EntityCommands)(script)({} cubes)(game.createCube per call)({:.2f} ms)", cubeCount, scriptPerCallMicroseconds / 1000.0));
+    ReportResult(StringFormat("(EntityCommands)(script)({} cubes)(entityCommands batch)({:.2f} ms)", cubeCount, scriptBatchMicroseconds / 1000.0));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Per-call C++ overhead of CallMethod: the old if/else chain + Execute* wrapper against the generated
+// ScriptMethodTable bindings. Then the same calls from a script loop, through ScriptSubsystem's generic
+// callback (CallMethod per call) and through the generated V8 callbacks on "game".
+// movePlayerCamera uses a zero offset so the camera does not move.
+//
+STATIC bool GameBenchmark::OnBenchmarkScriptBinding(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_game == nullptr) return false;
+
+    int constexpr       iterationCount = 100000;
+    GameScriptInterface scriptInterface(g_game);
+    ScriptArgs const    cameraArgs     = {0.f, 0.f, 0.f};
+    ScriptArgs const    noArgs;
+
+    struct sBindingCase
+    {
+        char const*       m_methodName;
+        ScriptArgs const* m_args;
+        char const*       m_scriptArgs;
+    };
+
+    sBindingCase const bindingCases[] = {{"movePlayerCamera", &cameraArgs, "0, 0, 0"}, {"isAttractMode", &noArgs, ""}};
+
+    for (sBindingCase const& bindingCase : bindingCases)
+    {
+        String const methodName = bindingCase.m_methodName;
+
+        BenchmarkClock::time_point const chainStart = BenchmarkClock::now();
+
+        for (int i = 0; i < iterationCount; ++i)
+        {
+            ScriptMethodResult const result = CallMethodBeforeBindingTable(*g_game, methodName, *bindingCase.m_args);
+            UNUSED(result)
+        }
+
+        double const chainMicroseconds = GetElapsedMicroseconds(chainStart);
+
+        BenchmarkClock::time_point const tableStart = BenchmarkClock::now();
+
+        for (int i = 0; i < iterationCount; ++i)
+        {
+            ScriptMethodResult const result = scriptInterface.CallMethod(methodName, *bindingCase.m_args);
+            UNUSED(result)
+        }
+
+        double const tableMicroseconds = GetElapsedMicroseconds(tableStart);
+
+        ReportResult(StringFormat("(ScriptBinding)({})(if/else + wrapper)({:.1f} ns/call)", methodName, chainMicroseconds * 1000.0 / iterationCount));
+        ReportResult(StringFormat("(ScriptBinding)({})(generated binding)({:.1f} ns/call)", methodName, tableMicroseconds * 1000.0 / iterationCount));
+    }
+
+    if (g_scriptSubsystem == nullptr || !g_scriptSubsystem->IsInitialized()) return true;
+
+    GetGenericBenchmarkScriptInterface();
+
+    for (sBindingCase const& bindingCase : bindingCases)
+    {
+        for (bool const isGenerated : {false, true})
+        {
+            String const loopSource = StringFormat("for (let i = 0; i < {}; ++i) {{ {}.{}({}); }}", iterationCount, isGenerated ? "game" : "__benchmarkGenericGame", bindingCase.m_methodName, bindingCase.m_scriptArgs);
+
+            BenchmarkClock::time_point const loopStart = BenchmarkClock::now();
+            g_scriptSubsystem->ExecuteScript(loopSource);
+            double const loopMicroseconds = GetElapsedMicroseconds(loopStart);
+
+            ReportResult(StringFormat("(ScriptBinding)({})(script, {})({:.1f} ns/call)", bindingCase.m_methodName, isGenerated ? "generated callback" : "generic callback", loopMicroseconds * 1000.0 / iterationCount));
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// movePlayerCamera(0, 0, 0) through the typed slow path, the numeric fast path behind CallMethod and the
+// pre-resolved CallNumericMethod entry point; then calls per second from a tight script loop through
+// ScriptSubsystem's generic callback, the generated callback alone and the V8 fast API call on "game".
+//
+STATIC bool GameBenchmark::OnBenchmarkNumericCalls(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_game == nullptr) return false;
+
+    int constexpr       iterationCount   = 100000;
+    bool const          wasFastPathOn    = GameScriptInterface::IsNumericFastPathEnabled();
+    GameScriptInterface scriptInterface(g_game);
+    ScriptArgs const    cameraArgs       = {0.0, 0.0, 0.0};
+    double const        cameraNumbers[3] = {0.0, 0.0, 0.0};
+    int const           methodIndex      = scriptInterface.FindNumericMethod("movePlayerCamera");
+
+    auto const TimeCallMethod = [&]()
+    {
+        BenchmarkClock::time_point const start = BenchmarkClock::now();
+
+        for (int i = 0; i < iterationCount; ++i)
+        {
+            ScriptMethodResult const result = scriptInterface.CallMethod("movePlayerCamera", cameraArgs);
+            UNUSED(result)
+        }
+
+        return GetElapsedMicroseconds(start) * 1000.0 / iterationCount;
+    };
+
+    GameScriptInterface::SetNumericFastPathEnabled(false);
+    double const slowNanoseconds = TimeCallMethod();
+
+    GameScriptInterface::SetNumericFastPathEnabled(true);
+    double const fastNanoseconds = TimeCallMethod();
+
+    BenchmarkClock::time_point const numericStart = BenchmarkClock::now();
+
+    for (int i = 0; i < iterationCount; ++i)
+    {
+        double result = 0.0;
+        scriptInterface.CallNumericMethod(methodIndex, cameraNumbers, 3, result);
+    }
+
+    double const numericNanoseconds = GetElapsedMicroseconds(numericStart) * 1000.0 / iterationCount;
+
+    ReportResult(StringFormat("(NumericCalls)(C++)(CallMethod, typed path)({:.1f} ns/call)", slowNanoseconds));
+    ReportResult(StringFormat("(NumericCalls)(C++)(CallMethod, numeric path)({:.1f} ns/call)", fastNanoseconds));
+    ReportResult(StringFormat("(NumericCalls)(C++)(CallNumericMethod, pre-resolved)({:.1f} ns/call)", numericNanoseconds));
+
+    GameScriptInterface::SetNumericFastPathEnabled(wasFastPathOn);
+
+    if (g_scriptSubsystem != nullptr && g_scriptSubsystem->IsInitialized())
+    {
+        // Enough iterations for the loop to be optimized: only optimized call sites take fast API calls
+        int constexpr scriptIterationCount = 1000000;
+
+        GameScriptInterface& genericInterface = GetGenericBenchmarkScriptInterface();
+        g_scriptSubsystem->ExecuteScript("globalThis.__benchmarkCallbackGame = {};");
+        genericInterface.InstallScriptFunctions(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "__benchmarkCallbackGame", false);
+
+        struct sLoopCase
+        {
+            char const* m_objectName;
+            char const* m_label;
+        };
+
+        sLoopCase const loopCases[] = {{"__benchmarkGenericGame", "generic callback"}, {"__benchmarkCallbackGame", "generated callback"}, {"game", "fast API call"}};
+
+        for (sLoopCase const& loopCase : loopCases)
+        {
+            String const loopSource = StringFormat("(function (target) {{ for (let i = 0; i < {}; ++i) {{ target.movePlayerCamera(0, 0, 0); }} }})(globalThis.{});", scriptIterationCount, loopCase.m_objectName);
+
+            BenchmarkClock::time_point const loopStart = BenchmarkClock::now();
+            g_scriptSubsystem->ExecuteScript(loopSource);
+            double const loopMicroseconds = GetElapsedMicroseconds(loopStart);
+
+            ReportResult(StringFormat("(NumericCalls)(script loop)({})({:.0f} calls/s)", loopCase.m_label, scriptIterationCount / (loopMicroseconds / 1000000.0)));
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Prop update cost at 1k, 100k and 1M props: heap-allocated props behind a pointer array with a
+// virtual Update against the PropStore array pass. Both integrate the same velocities over "frames"
+// updates (default 10); the game's own props are not touched.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropUpdate(EventArgs& args)
+{
+    int const       frameCount   = std::max(args.GetValue("frames", 10), 1);
+    float constexpr deltaSeconds = 1.f / 60.f;
+    int constexpr   propCounts[] = {1000, 100000, 1000000};
+
+    for (int const propCount : propCounts)
+    {
+        Vec3 const        velocity        = Vec3(0.1f, 0.2f, 0.3f);
+        EulerAngles const angularVelocity = EulerAngles(10.f, 20.f, 30.f);
+
+        std::vector<Entity*> pointerProps;
+        pointerProps.reserve(propCount);
+
+        for (int propIndex = 0; propIndex < propCount; ++propIndex)
+        {
+            Entity* prop            = new PropBeforeStore();
+            prop->m_position        = Vec3(static_cast<float>(propIndex), 0.f, 0.f);
+            prop->m_velocity        = velocity;
+            prop->m_angularVelocity = angularVelocity;
+            pointerProps.push_back(prop);
+        }
+
+        BenchmarkClock::time_point const pointerStart = BenchmarkClock::now();
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            for (Entity* prop : pointerProps)
+            {
+                prop->Update(deltaSeconds);
+            }
+        }
+
+        double const pointerMicroseconds = GetElapsedMicroseconds(pointerStart) / frameCount;
+
+        for (Entity*& prop : pointerProps)
+        {
+            GAME_SAFE_RELEASE(prop);
+        }
+
+        PropStore propStore;
+        propStore.Reserve(propCount);
+
+        for (int propIndex = 0; propIndex < propCount; ++propIndex)
+        {
+            propStore.AddProp(Vec3(static_cast<float>(propIndex), 0.f, 0.f), Rgba8::WHITE, nullptr);
+
+            propStore.SetVelocity(propIndex, velocity);
+            propStore.SetAngularVelocity(propIndex, angularVelocity);
+        }
+
+        BenchmarkClock::time_point const storeStart = BenchmarkClock::now();
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            propStore.Update(deltaSeconds);
+        }
+
+        double const storeMicroseconds = GetElapsedMicroseconds(storeStart) / frameCount;
+
+        ReportResult(StringFormat("(PropUpdate)({} props)(pointer + virtual)({:.3f} ms/frame, {:.2f} ns/prop)", propCount, pointerMicroseconds / 1000.0, pointerMicroseconds * 1000.0 / propCount));
+        ReportResult(StringFormat("(PropUpdate)({} props)(PropStore arrays)({:.3f} ms/frame, {:.2f} ns/prop)", propCount, storeMicroseconds / 1000.0, storeMicroseconds * 1000.0 / propCount));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Continuous spawning: "cycles" rounds (default 200) of creating "count" cubes (default 1000) in one
+// batch and destroying them again. The render prop pool should stop growing after the first round.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropChurn(EventArgs& args)
+{
+    if (g_game == nullptr) return false;
+
+    int const cubeCount     = std::max(args.GetValue("count", 1000), 1);
+    int const cycleCount    = std::max(args.GetValue("cycles", 200), 1);
+    int const baselineCount = g_game->GetPropCount();
+
+    sEntityPoolStats firstCycleStats;
+
+    BenchmarkClock::time_point const start = BenchmarkClock::now();
+
+    for (int cycle = 0; cycle < cycleCount; ++cycle)
+    {
+        EntityCommandBuffer commandBuffer;
+
+        for (int cubeIndex = 0; cubeIndex < cubeCount; ++cubeIndex)
+        {
+            commandBuffer.PushCreateCube(Vec3(static_cast<float>(cubeIndex % 100) - 50.f, static_cast<float>(cubeIndex / 100) - 50.f, 0.f));
+        }
+
+        g_game->ApplyEntityCommands(commandBuffer);
+        DestroyPropsFrom(*g_game, baselineCount);
+
+        if (cycle == 0) firstCycleStats = g_game->GetPropStore().GetRenderPropPoolStats();
+    }
+
+    double const            cycleMicroseconds = GetElapsedMicroseconds(start) / cycleCount;
+    sEntityPoolStats const& lastCycleStats    = g_game->GetPropStore().GetRenderPropPoolStats();
+
+    ReportResult(StringFormat("(PropChurn)({} cycles x {} cubes)({:.2f} ms/cycle)", cycleCount, cubeCount, cycleMicroseconds / 1000.0));
+    ReportResult(StringFormat("(PropChurn)(pool after first cycle)({} slots, {} blocks, {} KB)", firstCycleStats.m_capacity, firstCycleStats.m_blockCount, firstCycleStats.m_reservedBytes / 1024));
+    ReportResult(StringFormat("(PropChurn)(pool after last cycle)({} slots, {} blocks, {} KB)(high-water mark {})(recycled {})", lastCycleStats.m_capacity, lastCycleStats.m_blockCount, lastCycleStats.m_reservedBytes / 1024, lastCycleStats.m_highWaterMark, lastCycleStats.m_recycledCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Vertex memory for "count" cubes (default 50000): one 36-vertex copy per prop, as Prop::m_vertexes
+// held before the mesh cache, against the shared cached mesh plus one handle per prop.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropMeshMemory(EventArgs& args)
+{
+    if (g_game == nullptr) return false;
+
+    int const cubeCount     = std::max(args.GetValue("count", 50000), 1);
+    int const baselineCount = g_game->GetPropCount();
+
+    EntityCommandBuffer commandBuffer;
+
+    for (int cubeIndex = 0; cubeIndex < cubeCount; ++cubeIndex)
+    {
+        commandBuffer.PushCreateCube(Vec3(static_cast<float>(cubeIndex % 100) - 50.f, static_cast<float>(cubeIndex / 100 % 100) - 50.f, static_cast<float>(cubeIndex / 10000)));
+    }
+
+    g_game->ApplyEntityCommands(commandBuffer);
+
+    PropStore const&          propStore   = g_game->GetPropStore();
+    sPropMeshCacheStats const meshStats   = propStore.GetMeshCacheStats();
+    sIndexedMesh const&       cubeMesh    = propStore.GetMesh(*propStore.GetRenderProps().back());
+    int const                 vertexCount = cubeMesh.GetVertexCount();
+    size_t const              sharedBytes = sizeof(sIndexedMesh) + cubeMesh.GetVertexBytes() + cubeMesh.GetIndexBytes() + static_cast<size_t>(cubeCount) * sizeof(PropMeshHandle);
+
+    VertexList_PCU cubeTriangleList;
+    PropMeshCache::BuildTriangleList(sPropMeshDesc::Cube(), cubeTriangleList);
+
+    // Real copies, made the way the old SetLocalVerts copied the non-indexed cube into every prop.
+    std::vector<VertexList_PCU> perPropVertexes(static_cast<size_t>(cubeCount), cubeTriangleList);
+    size_t                      perPropBytes = 0;
+
+    for (VertexList_PCU const& vertexes : perPropVertexes)
+    {
+        perPropBytes += sizeof(VertexList_PCU) + vertexes.capacity() * sizeof(Vertex_PCU);
+    }
+
+    perPropVertexes.clear();
+    perPropVertexes.shrink_to_fit();
+
+    DestroyPropsFrom(*g_game, baselineCount);
+
+    ReportResult(StringFormat("(PropMeshMemory)({} cubes)(per-prop vertex copies)({:.2f} MB, {} vertexes each)", cubeCount, static_cast<double>(perPropBytes) / (1024.0 * 1024.0), cubeTriangleList.size()));
+    ReportResult(StringFormat("(PropMeshMemory)({} cubes)(shared mesh cache)({:.2f} KB: one {}-vertex indexed mesh + {} B handle per prop)({} cached meshes, {} references)", cubeCount, static_cast<double>(sharedBytes) / 1024.0, vertexCount, sizeof(PropMeshHandle), meshStats.m_meshCount, meshStats.m_referenceCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Bytes uploaded per frame for the grid, a sphere and "count" cubes (default 1000) over "frames" frames
+// (default 60), drawn through a headless recording backend. Immediate: a store without a render backend,
+// so every draw re-uploads its vertexes as props did before persistent buffers. Persistent: each mesh is
+// uploaded once.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropUpload(EventArgs& args)
+{
+    int const cubeCount  = std::max(args.GetValue("count", 1000), 0);
+    int const frameCount = std::max(args.GetValue("frames", 60), 1);
+
+    RecordingPropRenderBackend immediateBackend;
+    RecordingPropRenderBackend persistentBackend;
+    PropDrawQueue              drawQueue;
+    size_t                     immediateBytes  = 0;
+    size_t                     persistentBytes = 0;
+    sPropRenderStats           persistentFrame;
+
+    {
+        PropStore immediateStore;
+        FillUploadBenchmarkScene(immediateStore, cubeCount);
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            immediateBackend.BeginFrame();
+            DrawBenchmarkFrame(immediateStore, drawQueue, immediateBackend);
+            immediateBytes += immediateBackend.GetCurrentFrameStats().m_uploadedBytes;
+        }
+    }
+
+    {
+        PropStore persistentStore;
+        persistentBackend.BeginFrame();
+        persistentStore.SetRenderBackend(&persistentBackend);
+        FillUploadBenchmarkScene(persistentStore, cubeCount);
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            if (frame > 0) persistentBackend.BeginFrame();
+            DrawBenchmarkFrame(persistentStore, drawQueue, persistentBackend);
+            persistentBytes += persistentBackend.GetCurrentFrameStats().m_uploadedBytes;
+        }
+
+        persistentFrame = persistentBackend.GetCurrentFrameStats();
+
+        persistentStore.Clear();
+        persistentStore.SetRenderBackend(nullptr);
+    }
+
+    sPropRenderStats const& immediateFrame = immediateBackend.GetCurrentFrameStats();
+
+    ReportResult(StringFormat("(PropUpload)({} props, {} frames)(immediate)({:.1f} KB/frame)({} dynamic draws/frame)", cubeCount + 2, frameCount, static_cast<double>(immediateBytes) / frameCount / 1024.0, immediateFrame.m_dynamicDraws));
+    ReportResult(StringFormat("(PropUpload)({} props, {} frames)(persistent)({:.1f} KB total, {:.1f} KB in the last frame)({} static buffers, {} static draws/frame)", cubeCount + 2, frameCount, static_cast<double>(persistentBytes) / 1024.0, static_cast<double>(persistentFrame.m_uploadedBytes) / 1024.0, persistentFrame.m_staticMeshes, persistentFrame.m_staticDraws));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Vertex counts and ACMR (FIFO cache of "cache" entries, default 16) for the cube, sphere and grid prop
+// meshes: as the non-indexed AddVertsFor* triangle list, deduplicated in emit order, and after the
+// Forsyth reorder the mesh cache applies. Also reports build time and the index format chosen.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropMeshIndexing(EventArgs& args)
+{
+    int const cacheSize = std::max(args.GetValue("cache", 16), 3);
+
+    struct sMeshCase
+    {
+        char const*   m_name;
+        sPropMeshDesc m_desc;
+    };
+
+    sMeshCase const meshCases[] = {
+        {"cube", sPropMeshDesc::Cube()},
+        {"sphere", sPropMeshDesc::Sphere()},
+        {"grid", sPropMeshDesc::Grid()},
+    };
+
+    for (sMeshCase const& meshCase : meshCases)
+    {
+        VertexList_PCU triangleList;
+        PropMeshCache::BuildTriangleList(meshCase.m_desc, triangleList);
+
+        int const             listVertexCount = static_cast<int>(triangleList.size());
+        std::vector<uint32_t> listIndexes(triangleList.size());
+
+        for (int index = 0; index < listVertexCount; ++index)
+        {
+            listIndexes[index] = static_cast<uint32_t>(index);
+        }
+
+        sIndexedMesh dedupedMesh;
+        BuildIndexedMesh(triangleList, dedupedMesh, false);
+
+        sIndexedMesh                     optimizedMesh;
+        BenchmarkClock::time_point const buildStart = BenchmarkClock::now();
+        BuildIndexedMesh(triangleList, optimizedMesh);
+        double const buildMicroseconds = GetElapsedMicroseconds(buildStart);
+
+        size_t const listBytes    = triangleList.size() * sizeof(Vertex_PCU);
+        size_t const indexedBytes = optimizedMesh.GetVertexBytes() + optimizedMesh.GetIndexBytes();
+
+        ReportResult(StringFormat("(PropMeshIndexing)({})(triangle list)({} vertexes, {:.1f} KB)(ACMR {:.3f})", meshCase.m_name, listVertexCount, static_cast<double>(listBytes) / 1024.0, ComputeACMR(listIndexes, listVertexCount, cacheSize)));
+        ReportResult(StringFormat("(PropMeshIndexing)({})(deduplicated)({} vertexes)(ACMR {:.3f})", meshCase.m_name, dedupedMesh.GetVertexCount(), ComputeACMR(dedupedMesh, cacheSize)));
+        ReportResult(StringFormat("(PropMeshIndexing)({})(cache optimized)({} vertexes + {} {}-bit indexes, {:.1f} KB)(ACMR {:.3f})({:.2f} ms to build)", meshCase.m_name, optimizedMesh.GetVertexCount(), optimizedMesh.GetIndexCount(), optimizedMesh.GetIndexStride() * 8, static_cast<double>(indexedBytes) / 1024.0, ComputeACMR(optimizedMesh, cacheSize), buildMicroseconds / 1000.0));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// State changes per frame for "count" props (default 10000) with mixed shaders, blend modes, textures
+// and meshes over "frames" frames (default 10), counted by a headless recording backend. Per-prop binds:
+// submission order with every state rebound on each draw, as Prop::Render did. Elided: submission order,
+// unchanged state skipped. Sorted: radix-sorted keys, unchanged state skipped.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropDrawSort(EventArgs& args)
+{
+    int const propCount  = std::max(args.GetValue("count", 10000), 1);
+    int const frameCount = std::max(args.GetValue("frames", 10), 1);
+
+    RecordingPropRenderBackend renderBackend;
+    PropDrawQueue              drawQueue;
+    PropStore                  propStore;
+    ResourceHandleTable        resourceHandles;
+
+    renderBackend.BeginFrame();
+    propStore.SetRenderBackend(&renderBackend);
+    drawQueue.Reserve(propCount);
+    FillMixedStateBenchmarkScene(propStore, resourceHandles, propCount);
+
+    struct sDrawCase
+    {
+        char const* m_name;
+        bool        m_isElisionEnabled;
+        bool        m_isSorted;
+    };
+
+    sDrawCase const drawCases[] = {
+        {"per-prop binds", false, false},
+        {"elided", true, false},
+        {"sorted", true, true},
+    };
+
+    for (sDrawCase const& drawCase : drawCases)
+    {
+        renderBackend.SetStateElision(drawCase.m_isElisionEnabled);
+
+        int    stateChanges     = 0;
+        double sortMicroseconds = 0.0;
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            renderBackend.BeginFrame();
+            drawQueue.Clear();
+            propStore.SubmitDraws(drawQueue, Vec3::ZERO, resourceHandles);
+
+            if (drawCase.m_isSorted)
+            {
+                BenchmarkClock::time_point const sortStart = BenchmarkClock::now();
+                drawQueue.Sort();
+                sortMicroseconds += GetElapsedMicroseconds(sortStart);
+            }
+
+            drawQueue.Flush(renderBackend, false);
+            stateChanges += renderBackend.GetCurrentFrameStats().m_stateChanges;
+        }
+
+        ReportResult(StringFormat("(PropDrawSort)({} props, {} frames)({})({} state changes/frame, {:.2f} per draw)({:.3f} ms sort/frame)", propCount, frameCount, drawCase.m_name, stateChanges / frameCount, static_cast<double>(stateChanges) / frameCount / propCount, sortMicroseconds / frameCount / 1000.0));
+    }
+
+    propStore.Clear();
+    propStore.SetRenderBackend(nullptr);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Per-frame cost of finding a texture and a shader for "draws" draws (default 5000) over "frames" frames
+// (default 60): by path through the engine's CreateOrGet* each draw, by path through the handle table's
+// interned map, and by cached handle. Needs the renderer and resource subsystem, so run it in-game.
+//
+STATIC bool GameBenchmark::OnBenchmarkResourceLookup(EventArgs& args)
+{
+    int const drawCount  = std::max(args.GetValue("draws", 5000), 1);
+    int const frameCount = std::max(args.GetValue("frames", 60), 1);
+
+    if (g_renderer == nullptr || g_resourceSubsystem == nullptr)
+    {
+        ReportResult("(ResourceLookup)(needs the renderer and resource subsystem)");
+        return false;
+    }
+
+    String const texturePath = "Data/Images/TestUV.png";
+    String const shaderPath  = "Data/Shaders/Default";
+
+    ResourceHandleTable resourceHandles;
+    TextureHandle const textureHandle = resourceHandles.ResolveTexture(texturePath);
+    ShaderHandle const  shaderHandle  = resourceHandles.ResolveShader(shaderPath);
+
+    // Keeps the lookups from being optimized away.
+    size_t resolvedCount = 0;
+
+    BenchmarkClock::time_point const engineStart = BenchmarkClock::now();
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        for (int draw = 0; draw < drawCount; ++draw)
+        {
+            resolvedCount += ResourceSubsystem::CreateOrGetTextureFromFile(texturePath.c_str()) != nullptr;
+            resolvedCount += g_renderer->CreateOrGetShaderFromFile(shaderPath.c_str(), eVertexType::VERTEX_PCU) != nullptr;
+        }
+    }
+
+    double const engineMicroseconds = GetElapsedMicroseconds(engineStart);
+
+    BenchmarkClock::time_point const internedStart = BenchmarkClock::now();
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        for (int draw = 0; draw < drawCount; ++draw)
+        {
+            resolvedCount += resourceHandles.GetTexture(resourceHandles.ResolveTexture(texturePath)) != nullptr;
+            resolvedCount += resourceHandles.GetShader(resourceHandles.ResolveShader(shaderPath)) != nullptr;
+        }
+    }
+
+    double const internedMicroseconds = GetElapsedMicroseconds(internedStart);
+
+    BenchmarkClock::time_point const handleStart = BenchmarkClock::now();
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        for (int draw = 0; draw < drawCount; ++draw)
+        {
+            resolvedCount += resourceHandles.GetTexture(textureHandle) != nullptr;
+            resolvedCount += resourceHandles.GetShader(shaderHandle) != nullptr;
+        }
+    }
+
+    double const handleMicroseconds = GetElapsedMicroseconds(handleStart);
+
+    sResourceHandleStats const stats = resourceHandles.GetStats();
+
+    ReportResult(StringFormat("(ResourceLookup)({} draws, {} frames)(engine CreateOrGet* by path)({:.3f} ms/frame)", drawCount, frameCount, engineMicroseconds / frameCount / 1000.0));
+    ReportResult(StringFormat("(ResourceLookup)({} draws, {} frames)(interned path -> handle)({:.3f} ms/frame)", drawCount, frameCount, internedMicroseconds / frameCount / 1000.0));
+    ReportResult(StringFormat("(ResourceLookup)({} draws, {} frames)(cached handle)({:.3f} ms/frame)({} engine path lookups in total, {} resolved)", drawCount, frameCount, handleMicroseconds / frameCount / 1000.0, stats.m_pathLookups, resolvedCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Frustum culling of "count" cubes (default 100000) scattered in a 300 x 300 x 40 box around a camera
+// with the player's perspective, turning a full circle over "frames" frames (default 36) while "moving"
+// percent of the props (default 10) move and "churn" props (default 100) are destroyed and re-created
+// elsewhere each frame. CPU only: BVH build, incremental insert/remove + refit + cull per frame, and a
+// brute-force test of every prop's bounds, whose visible count must match.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropCulling(EventArgs& args)
+{
+    int const propCount     = std::max(args.GetValue("count", 100000), 1);
+    int const frameCount    = std::max(args.GetValue("frames", 36), 1);
+    int const movingPercent = std::clamp(args.GetValue("moving", 10), 0, 100);
+    int const churnCount    = std::clamp(args.GetValue("churn", 100), 0, propCount);
+
+    std::mt19937                          random(1234);
+    std::uniform_real_distribution<float> horizontal(-150.f, 150.f);
+    std::uniform_real_distribution<float> vertical(-20.f, 20.f);
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+
+    PropStore propStore;
+    propStore.Reserve(propCount);
+
+    for (int propIndex = 0; propIndex < propCount; ++propIndex)
+    {
+        Vec3 const position(horizontal(random), horizontal(random), vertical(random));
+        propStore.AddProp(position, Rgba8::WHITE, propStore.AllocateRenderProp(sPropMeshDesc::Cube()));
+    }
+
+    std::vector<int> visiblePropIndices;
+
+    BenchmarkClock::time_point const buildStart = BenchmarkClock::now();
+    propStore.UpdateBounds();
+    double const buildMicroseconds = GetElapsedMicroseconds(buildStart);
+
+    int const movingCount = propCount * movingPercent / 100;
+
+    double cullMicroseconds  = 0.0;
+    double bruteMicroseconds = 0.0;
+    long   visibleTotal      = 0;
+    long   culledTotal       = 0;
+    long   nodesTotal        = 0;
+    long   refitTotal        = 0;
+    int    rebuildCount      = 0;
+    int    mismatchCount     = 0;
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        for (int churnIndex = 0; churnIndex < churnCount; ++churnIndex)
+        {
+            int const propIndex = static_cast<int>(random() % static_cast<unsigned int>(propStore.GetCount()));
+
+            propStore.DestroyProp(propStore.GetHandle(propIndex));
+            propStore.AddProp(Vec3(horizontal(random), horizontal(random), vertical(random)), Rgba8::WHITE, propStore.AllocateRenderProp(sPropMeshDesc::Cube()));
+        }
+
+        for (int moveIndex = 0; moveIndex < movingCount; ++moveIndex)
+        {
+            int const propIndex = (frame * movingCount + moveIndex) % propCount;
+            propStore.SetPosition(propIndex, propStore.GetPositions()[propIndex] + Vec3(step(random), step(random), step(random)));
+        }
+
+        EulerAngles const orientation(360.f * static_cast<float>(frame) / static_cast<float>(frameCount), 0.f, 0.f);
+        sFrustum const    frustum = sFrustum::CreatePerspective(Vec3::ZERO, orientation, Player::CAMERA_ASPECT, Player::CAMERA_FOV_DEGREES, Player::CAMERA_NEAR, Player::CAMERA_FAR);
+
+        BenchmarkClock::time_point const cullStart = BenchmarkClock::now();
+        sPropCullStats const             stats     = propStore.CullFrustum(frustum, visiblePropIndices);
+        cullMicroseconds += GetElapsedMicroseconds(cullStart);
+
+        BenchmarkClock::time_point const bruteStart   = BenchmarkClock::now();
+        int                              bruteVisible = 0;
+
+        for (int propIndex = 0; propIndex < propCount; ++propIndex)
+        {
+            bruteVisible += frustum.IsOverlappingAABB(propStore.GetBounds(propIndex)) ? 1 : 0;
+        }
+
+        bruteMicroseconds += GetElapsedMicroseconds(bruteStart);
+
+        visibleTotal += stats.m_visibleCount;
+        culledTotal += stats.m_culledCount;
+        nodesTotal += stats.m_nodesVisited;
+        refitTotal += stats.m_refitNodes;
+        rebuildCount += stats.m_wasRebuilt ? 1 : 0;
+        mismatchCount += bruteVisible != stats.m_visibleCount ? 1 : 0;
+    }
+
+    ReportResult(StringFormat("(PropCulling)({} props)(BVH build)({:.2f} ms)", propCount, buildMicroseconds / 1000.0));
+    ReportResult(StringFormat("(PropCulling)({} props, {} frames, {}% moving, {} churned)(BVH update + cull)({:.3f} ms/frame)({} visible, {} culled, {} nodes visited, {} nodes refit per frame)({} rebuilds)", propCount, frameCount, movingPercent, churnCount, cullMicroseconds / frameCount / 1000.0, visibleTotal / frameCount, culledTotal / frameCount, nodesTotal / frameCount, refitTotal / frameCount, rebuildCount));
+    ReportResult(StringFormat("(PropCulling)({} props, {} frames)(brute force)({:.3f} ms/frame)({} frames where the visible counts differ)", propCount, frameCount, bruteMicroseconds / frameCount / 1000.0, mismatchCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Spatial query throughput over "count" data-only props (default: 10k, 100k and 1M in turn) at a
+// constant density of one prop per 8 cubic units: hash insert (AddProp) and re-bucketing 10% of the
+// props (SetPosition), then "queries" (default 10000) radius (r 4), nearest (k 8) and ray (50 units,
+// hit radius 0.5) queries each, and the same mix through PropSpatialQueryBatch as scripts send it.
+// The first 100 queries of each kind are checked against a brute-force scan of every prop.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropSpatialQuery(EventArgs& args)
+{
+    int const       requestedCount = args.GetValue("count", 0);
+    int const       queryCount     = std::max(args.GetValue("queries", 10000), 1);
+    int constexpr   checkCount     = 100;
+    int constexpr   nearestCount   = 8;
+    float constexpr queryRadius    = 4.f;
+    float constexpr rayDistance    = 50.f;
+    float constexpr rayHitRadius   = 0.5f;
+
+    std::vector<int> propCounts = {10000, 100000, 1000000};
+    if (requestedCount > 0) propCounts = {requestedCount};
+
+    for (int const propCount : propCounts)
+    {
+        float const halfExtent = std::cbrt(static_cast<float>(propCount));
+
+        std::mt19937                          random(4321);
+        std::uniform_real_distribution<float> coordinate(-halfExtent, halfExtent);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+        PropStore propStore;
+        propStore.Reserve(propCount);
+
+        BenchmarkClock::time_point const insertStart = BenchmarkClock::now();
+
+        for (int propIndex = 0; propIndex < propCount; ++propIndex)
+        {
+            propStore.AddProp(Vec3(coordinate(random), coordinate(random), coordinate(random)), Rgba8::WHITE, nullptr);
+        }
+
+        double const insertMicroseconds = GetElapsedMicroseconds(insertStart);
+        int const    moveCount          = propCount / 10;
+
+        BenchmarkClock::time_point const moveStart = BenchmarkClock::now();
+
+        for (int moveIndex = 0; moveIndex < moveCount; ++moveIndex)
+        {
+            int const propIndex = moveIndex * 10;
+            propStore.SetPosition(propIndex, propStore.GetPositions()[propIndex] + Vec3(unit(random), unit(random), unit(random)) * 2.f);
+        }
+
+        double const moveMicroseconds = GetElapsedMicroseconds(moveStart);
+
+        std::vector<Vec3> centers(static_cast<size_t>(queryCount));
+        std::vector<Vec3> directions(static_cast<size_t>(queryCount));
+
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+        {
+            centers[queryIndex]    = Vec3(coordinate(random), coordinate(random), coordinate(random));
+            directions[queryIndex] = Vec3(unit(random), unit(random), unit(random) + 0.01f).GetNormalized();
+        }
+
+        std::vector<sPropQueryHit> hits;
+        std::vector<float>         bruteDistances;
+        int                        mismatchCount = 0;
+
+        auto const BruteForceRaycast = [&propStore](Vec3 const& start, Vec3 const& direction, float& out_distance)
+        {
+            bool isHit = false;
+
+            for (Vec3 const& position : propStore.GetPositions())
+            {
+                Vec3 const  toProp        = position - start;
+                float const alongRay      = DotProduct3D(toProp, direction);
+                float const offRaySquared = toProp.GetLengthSquared() - alongRay * alongRay;
+
+                if (offRaySquared > rayHitRadius * rayHitRadius || alongRay + rayHitRadius < 0.f) continue;
+
+                float const distance = std::max(alongRay - std::sqrt(rayHitRadius * rayHitRadius - offRaySquared), 0.f);
+
+                if (distance <= rayDistance && (!isHit || distance < out_distance))
+                {
+                    out_distance = distance;
+                    isHit        = true;
+                }
+            }
+
+            return isHit;
+        };
+
+        long                             radiusHitTotal = 0;
+        BenchmarkClock::time_point const radiusStart    = BenchmarkClock::now();
+
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+        {
+            radiusHitTotal += propStore.QueryRadius(centers[queryIndex], queryRadius, 0, hits);
+        }
+
+        double const radiusMicroseconds = GetElapsedMicroseconds(radiusStart);
+
+        BenchmarkClock::time_point const nearestStart = BenchmarkClock::now();
+
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+        {
+            propStore.QueryNearest(centers[queryIndex], nearestCount, 0.f, hits);
+        }
+
+        double const nearestMicroseconds = GetElapsedMicroseconds(nearestStart);
+
+        int                              rayHitCount = 0;
+        BenchmarkClock::time_point const rayStart    = BenchmarkClock::now();
+
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+        {
+            sPropQueryHit hit;
+            rayHitCount += propStore.Raycast(centers[queryIndex], directions[queryIndex], rayDistance, rayHitRadius, hit) ? 1 : 0;
+        }
+
+        double const rayMicroseconds = GetElapsedMicroseconds(rayStart);
+
+        for (int queryIndex = 0; queryIndex < std::min(checkCount, queryCount); ++queryIndex)
+        {
+            Vec3 const& center = centers[queryIndex];
+
+            bruteDistances.clear();
+
+            for (Vec3 const& position : propStore.GetPositions())
+            {
+                bruteDistances.push_back((position - center).GetLength());
+            }
+
+            std::sort(bruteDistances.begin(), bruteDistances.end());
+
+            int const bruteRadiusCount = static_cast<int>(std::upper_bound(bruteDistances.begin(), bruteDistances.end(), queryRadius) - bruteDistances.begin());
+            mismatchCount += propStore.QueryRadius(center, queryRadius, 0, hits) != bruteRadiusCount ? 1 : 0;
+
+            int const nearestHitCount = propStore.QueryNearest(center, nearestCount, 0.f, hits);
+            int const bruteNearest    = std::min(nearestCount, propCount);
+            mismatchCount += nearestHitCount != bruteNearest || std::fabs(hits[bruteNearest - 1].m_distance - bruteDistances[bruteNearest - 1]) > 1e-3f ? 1 : 0;
+
+            sPropQueryHit hit;
+            float         bruteRayDistance = 0.f;
+            bool const    isHit            = propStore.Raycast(center, directions[queryIndex], rayDistance, rayHitRadius, hit);
+            bool const    isBruteHit       = BruteForceRaycast(center, directions[queryIndex], bruteRayDistance);
+            mismatchCount += isHit != isBruteHit || (isHit && std::fabs(hit.m_distance - bruteRayDistance) > 1e-3f) ? 1 : 0;
+        }
+
+        PropSpatialQueryBatch queryBatch;
+
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+        {
+            queryBatch.PushRadius(centers[queryIndex], queryRadius, 0);
+            queryBatch.PushNearest(centers[queryIndex], nearestCount, 0.f);
+            queryBatch.PushRay(centers[queryIndex], directions[queryIndex], rayDistance, rayHitRadius);
+        }
+
+        BenchmarkClock::time_point const batchStart        = BenchmarkClock::now();
+        int const                        batchHitCount     = queryBatch.Execute(propStore);
+        double const                     batchMicroseconds = GetElapsedMicroseconds(batchStart);
+
+        auto const QueriesPerSecond = [queryCount](double const microseconds)
+        {
+            return microseconds > 0.0 ? static_cast<double>(queryCount) * 1000000.0 / microseconds : 0.0;
+        };
+
+        ReportResult(StringFormat("(PropSpatialQuery)({} props)(hash insert via AddProp)({:.2f} ms)(re-bucket {} moved props)({:.2f} ms)", propCount, insertMicroseconds / 1000.0, moveCount, moveMicroseconds / 1000.0));
+        ReportResult(StringFormat("(PropSpatialQuery)({} props, {} queries)(radius {:.0f})({:.3f} us/query, {:.0f} queries/s)({:.1f} hits/query)", propCount, queryCount, queryRadius, radiusMicroseconds / queryCount, QueriesPerSecond(radiusMicroseconds), static_cast<double>(radiusHitTotal) / queryCount));
+        ReportResult(StringFormat("(PropSpatialQuery)({} props, {} queries)(nearest {})({:.3f} us/query, {:.0f} queries/s)", propCount, queryCount, nearestCount, nearestMicroseconds / queryCount, QueriesPerSecond(nearestMicroseconds)));
+        ReportResult(StringFormat("(PropSpatialQuery)({} props, {} queries)(ray {:.0f})({:.3f} us/query, {:.0f} queries/s)({} hits)", propCount, queryCount, rayDistance, rayMicroseconds / queryCount, QueriesPerSecond(rayMicroseconds), rayHitCount));
+        ReportResult(StringFormat("(PropSpatialQuery)({} props, {} queries)(script batch, all three kinds)({:.3f} ms, {} hits)({} of {} brute-force checks differ)", propCount, queryCount * 3, batchMicroseconds / 1000.0, batchHitCount, mismatchCount, std::min(checkCount, queryCount) * 3));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// PropStore::Update scaling over 1, 2, 4, 8 and 16 threads for "count" moving props (default: 100k
+// and 1M in turn), "frames" updates each (default 20). Every thread count gets its own ParallelForWorkers
+// with threads - 1 workers (1 thread is the serial path); the game's workers are measured last. Speedups
+// are relative to 1 thread and cannot exceed the hardware thread count reported with them.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropUpdateScaling(EventArgs& args)
+{
+    int const       requestedCount = args.GetValue("count", 0);
+    int const       frameCount     = std::max(args.GetValue("frames", 20), 1);
+    float constexpr deltaSeconds   = 1.f / 60.f;
+    int constexpr   threadCounts[] = {1, 2, 4, 8, 16};
+
+    std::vector<int> propCounts = {100000, 1000000};
+    if (requestedCount > 0) propCounts = {requestedCount};
+
+    auto const TimeUpdates = [frameCount](PropStore& propStore)
+    {
+        BenchmarkClock::time_point const start = BenchmarkClock::now();
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            propStore.Update(deltaSeconds);
+        }
+
+        return GetElapsedMicroseconds(start) / frameCount;
+    };
+
+    for (int const propCount : propCounts)
+    {
+        PropStore propStore;
+        propStore.Reserve(propCount);
+
+        for (int propIndex = 0; propIndex < propCount; ++propIndex)
+        {
+            propStore.AddProp(Vec3(static_cast<float>(propIndex), 0.f, 0.f), Rgba8::WHITE, nullptr);
+
+            propStore.SetVelocity(propIndex, Vec3(0.1f, 0.2f, 0.3f));
+            propStore.SetAngularVelocity(propIndex, EulerAngles(10.f, 20.f, 30.f));
+        }
+
+        double serialMicroseconds = 0.0;
+
+        for (int const threadCount : threadCounts)
+        {
+            ParallelForWorkers* workers = threadCount > 1 ? new ParallelForWorkers(threadCount - 1) : nullptr;
+
+            propStore.SetParallelForWorkers(workers, threadCount);
+
+            double const             microseconds = TimeUpdates(propStore);
+            sParallelForStats const& stats        = propStore.GetLastUpdateStats();
+
+            if (threadCount == 1) serialMicroseconds = microseconds;
+
+            ReportResult(StringFormat("(PropUpdateScaling)({} props)({} threads)({:.3f} ms/frame)({:.2f}x)({} chunks of {} props, {} helper jobs)({} hardware threads)",
+                                      propCount, threadCount, microseconds / 1000.0, microseconds > 0.0 ? serialMicroseconds / microseconds : 0.0,
+                                      stats.m_chunkCount, stats.m_chunkItems, stats.m_helperCount, std::thread::hardware_concurrency()));
+
+            propStore.SetParallelForWorkers(nullptr, 1);
+            GAME_SAFE_RELEASE(workers);
+        }
+
+        if (g_parallelForWorkers != nullptr)
+        {
+            propStore.SetParallelForWorkers(g_parallelForWorkers, PARALLEL_FOR_WORKER_COUNT + 1);
+
+            double const microseconds = TimeUpdates(propStore);
+
+            ReportResult(StringFormat("(PropUpdateScaling)({} props)(game workers, {} threads)({:.3f} ms/frame)({:.2f}x)",
+                                      propCount, PARALLEL_FOR_WORKER_COUNT + 1, microseconds / 1000.0, microseconds > 0.0 ? serialMicroseconds / microseconds : 0.0));
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// TransformKernels throughput per supported SIMD level for "count" transforms (default 100k), best of
+// "iterations" passes (default 50): model matrices from position + Euler angles, matrix pair Append and
+// TransformPositions, each against the per-element Mat44/EulerAngles code. Every level is compared
+// bit for bit with the scalar reference (mismatches must be 0); the scalar kernel's max difference from
+// EulerAngles::GetAsMatrix_IFwd_JLeft_KUp shows the cost of its own sin/cos.
+//
+STATIC bool GameBenchmark::OnBenchmarkTransformKernels(EventArgs& args)
+{
+    int const count          = std::max(args.GetValue("count", 100000), 1);
+    int const iterationCount = std::max(args.GetValue("iterations", 50), 1);
+
+    std::mt19937                          random(22);
+    std::uniform_real_distribution<float> positionDistribution(-500.f, 500.f);
+    std::uniform_real_distribution<float> angleDistribution(-720.f, 720.f);
+
+    std::vector<Vec3>        positions(count);
+    std::vector<EulerAngles> orientations(count);
+
+    for (int index = 0; index < count; ++index)
+    {
+        positions[index]    = Vec3(positionDistribution(random), positionDistribution(random), positionDistribution(random));
+        orientations[index] = EulerAngles(angleDistribution(random), angleDistribution(random), angleDistribution(random));
+    }
+
+    auto const TimeBest = [iterationCount](auto const& function)
+    {
+        double bestMicroseconds = 0.0;
+
+        for (int iteration = 0; iteration < iterationCount; ++iteration)
+        {
+            BenchmarkClock::time_point const start        = BenchmarkClock::now();
+            function();
+            double const                     microseconds = GetElapsedMicroseconds(start);
+
+            if (iteration == 0 || microseconds < bestMicroseconds) bestMicroseconds = microseconds;
+        }
+
+        return bestMicroseconds;
+    };
+
+    auto const CountMismatches = [count](void const* results, void const* references, size_t const elementBytes)
+    {
+        int mismatchCount = 0;
+
+        for (int index = 0; index < count; ++index)
+        {
+            if (std::memcmp(static_cast<char const*>(results) + index * elementBytes, static_cast<char const*>(references) + index * elementBytes, elementBytes) != 0) ++mismatchCount;
+        }
+
+        return mismatchCount;
+    };
+
+    // Per-element engine code, the way Entity and PropStore built matrices before the kernels.
+    std::vector<Mat44> engineTransforms(count);
+
+    double const engineBuildMicroseconds = TimeBest([&]()
+    {
+        for (int index = 0; index < count; ++index)
+        {
+            Mat44 m2w;
+            m2w.SetTranslation3D(positions[index]);
+            m2w.Append(orientations[index].GetAsMatrix_IFwd_JLeft_KUp());
+            engineTransforms[index] = m2w;
+        }
+    });
+
+    std::vector<Mat44> referenceTransforms(count);
+    TransformKernels::BuildModelToWorldTransforms(positions.data(), orientations.data(), count, referenceTransforms.data(), eSimdLevel::SCALAR);
+
+    float maxEngineError = 0.f;
+
+    for (int index = 0; index < count; ++index)
+    {
+        for (int element = 0; element < 16; ++element)
+        {
+            maxEngineError = std::max(maxEngineError, std::fabs(referenceTransforms[index].m_values[element] - engineTransforms[index].m_values[element]));
+        }
+    }
+
+    std::vector<Mat44> engineAppended(count);
+    std::vector<Vec3>  enginePositions(count);
+    Mat44 const        viewTransform = referenceTransforms[0];
+
+    double const engineAppendMicroseconds = TimeBest([&]()
+    {
+        for (int index = 0; index < count; ++index)
+        {
+            engineAppended[index] = referenceTransforms[index];
+            engineAppended[index].Append(engineTransforms[index]);
+        }
+    });
+
+    double const engineTransformMicroseconds = TimeBest([&]()
+    {
+        for (int index = 0; index < count; ++index)
+        {
+            enginePositions[index] = viewTransform.TransformPosition3D(positions[index]);
+        }
+    });
+
+    std::vector<Mat44> referenceAppended(count);
+    std::vector<Vec3>  referencePositions(count);
+
+    TransformKernels::AppendTransforms(referenceTransforms.data(), engineTransforms.data(), count, referenceAppended.data(), eSimdLevel::SCALAR);
+    TransformKernels::TransformPositions(viewTransform, positions.data(), count, referencePositions.data(), eSimdLevel::SCALAR);
+
+    ReportResult(StringFormat("(TransformKernels)({} transforms)(engine)(build {:.1f} us, append {:.1f} us, transform {:.1f} us)(scalar kernel max error vs EulerAngles {:.2e})(best level {})",
+                              count, engineBuildMicroseconds, engineAppendMicroseconds, engineTransformMicroseconds, maxEngineError,
+                              TransformKernels::GetSimdLevelName(TransformKernels::GetBestSimdLevel())));
+
+    std::vector<Mat44> transforms(count);
+    std::vector<Mat44> appended(count);
+    std::vector<Vec3>  transformedPositions(count);
+    double             scalarBuildMicroseconds = 0.0;
+
+    for (int level = 0; level < static_cast<int>(eSimdLevel::COUNT); ++level)
+    {
+        eSimdLevel const simdLevel = static_cast<eSimdLevel>(level);
+        if (!TransformKernels::IsSimdLevelSupported(simdLevel)) continue;
+
+        double const buildMicroseconds     = TimeBest([&]() { TransformKernels::BuildModelToWorldTransforms(positions.data(), orientations.data(), count, transforms.data(), simdLevel); });
+        double const appendMicroseconds    = TimeBest([&]() { TransformKernels::AppendTransforms(referenceTransforms.data(), engineTransforms.data(), count, appended.data(), simdLevel); });
+        double const transformMicroseconds = TimeBest([&]() { TransformKernels::TransformPositions(viewTransform, positions.data(), count, transformedPositions.data(), simdLevel); });
+
+        if (simdLevel == eSimdLevel::SCALAR) scalarBuildMicroseconds = buildMicroseconds;
+
+        int const mismatchCount = CountMismatches(transforms.data(), referenceTransforms.data(), sizeof(Mat44)) +
+                                  CountMismatches(appended.data(), referenceAppended.data(), sizeof(Mat44)) +
+                                  CountMismatches(transformedPositions.data(), referencePositions.data(), sizeof(Vec3));
+
+        ReportResult(StringFormat("(TransformKernels)({} transforms)({}, {} lanes)(build {:.1f} us, {:.1f} M/s, {:.2f}x scalar, {:.2f}x engine)(append {:.1f} us)(transform {:.1f} us)({} mismatches)",
+                                  count, TransformKernels::GetSimdLevelName(simdLevel), TransformKernels::GetSimdLevelWidth(simdLevel),
+                                  buildMicroseconds, buildMicroseconds > 0.0 ? count / buildMicroseconds : 0.0,
+                                  buildMicroseconds > 0.0 ? scalarBuildMicroseconds / buildMicroseconds : 0.0,
+                                  buildMicroseconds > 0.0 ? engineBuildMicroseconds / buildMicroseconds : 0.0,
+                                  appendMicroseconds, transformMicroseconds, mismatchCount));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// TransformHierarchy updates over "nodes" nodes (default 100k) in three shapes: deep (10 chains),
+// wide (one root with every other node as its child) and balanced (8 children per node). Per shape:
+// the first Update (layout sort included), UpdateAll, Update with "dirty" random nodes changed per
+// frame (default 100), with one root changed, and with nothing changed, averaged over "frames" frames
+// (default 20), serial and on the game's ParallelFor workers. After the incremental frames every world matrix is
+// compared bit for bit with an UpdateAll of the same locals (mismatches must be 0).
+//
+STATIC bool GameBenchmark::OnBenchmarkTransformHierarchy(EventArgs& args)
+{
+    int const nodeCount  = std::max(args.GetValue("nodes", 100000), 10);
+    int const frameCount = std::max(args.GetValue("frames", 20), 1);
+    int const dirtyCount = std::max(args.GetValue("dirty", 100), 1);
+
+    char const* const shapeNames[] = {"deep", "wide", "balanced"};
+
+    for (int shape = 0; shape < 3; ++shape)
+    {
+        std::mt19937                          random(24);
+        std::uniform_real_distribution<float> offsetDistribution(-1.f, 1.f);
+        std::uniform_real_distribution<float> angleDistribution(-30.f, 30.f);
+        std::uniform_int_distribution<int>    nodeDistribution(0, nodeCount - 1);
+
+        auto const RandomOrientation = [&]() { return EulerAngles(angleDistribution(random), angleDistribution(random), angleDistribution(random)); };
+        auto const RandomPosition    = [&]() { return Vec3(offsetDistribution(random), offsetDistribution(random), offsetDistribution(random)); };
+
+        // Deep chains are created one after another, so the first Update re-sorts them into level order.
+        TransformHierarchy               hierarchy;
+        std::vector<TransformNodeHandle> nodes(nodeCount);
+
+        hierarchy.Reserve(nodeCount);
+
+        for (int index = 0; index < nodeCount; ++index)
+        {
+            TransformNodeHandle parent = INVALID_TRANSFORM_NODE;
+
+            if (shape == 0 && index % (nodeCount / 10) != 0) parent = nodes[index - 1];
+            if (shape == 1 && index > 0) parent = nodes[0];
+            if (shape == 2 && index > 0) parent = nodes[(index - 1) / 8];
+
+            nodes[index] = hierarchy.CreateNode(parent, RandomPosition(), RandomOrientation());
+        }
+
+        auto const TimeFrames = [&](auto const& ChangeNodes, bool const isFullUpdate, int& out_recomputedCount)
+        {
+            double microseconds = 0.0;
+            out_recomputedCount = 0;
+
+            for (int frame = 0; frame < frameCount; ++frame)
+            {
+                ChangeNodes();
+
+                BenchmarkClock::time_point const start = BenchmarkClock::now();
+                sTransformHierarchyStats const&  stats = isFullUpdate ? hierarchy.UpdateAll() : hierarchy.Update();
+                microseconds += GetElapsedMicroseconds(start);
+
+                out_recomputedCount += stats.m_recomputedCount;
+            }
+
+            out_recomputedCount /= frameCount;
+
+            return microseconds / frameCount / 1000.0;
+        };
+
+        auto const ChangeNothing   = []() {};
+        auto const ChangeRandom    = [&]() { for (int change = 0; change < dirtyCount; ++change) hierarchy.SetLocalTransform(nodes[nodeDistribution(random)], RandomPosition(), RandomOrientation()); };
+        auto const ChangeFirstRoot = [&]() { hierarchy.SetLocalTransform(nodes[0], RandomPosition(), RandomOrientation()); };
+
+        BenchmarkClock::time_point const firstStart        = BenchmarkClock::now();
+        sTransformHierarchyStats const   firstStats        = hierarchy.Update();
+        double const                     firstMilliseconds = GetElapsedMicroseconds(firstStart) / 1000.0;
+
+        ReportResult(StringFormat("(TransformHierarchy)({} nodes, {})({} levels)(first update with layout sort {:.3f} ms)",
+                                  nodeCount, shapeNames[shape], firstStats.m_levelCount, firstMilliseconds));
+
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            bool const isParallel = pass == 1;
+
+            if (isParallel && g_parallelForWorkers == nullptr) continue;
+
+            hierarchy.SetParallelForWorkers(isParallel ? g_parallelForWorkers : nullptr, isParallel ? PARALLEL_FOR_WORKER_COUNT + 1 : 1);
+
+            int          fullCount          = 0;
+            int          randomCount        = 0;
+            int          rootCount          = 0;
+            int          cleanCount         = 0;
+            double const fullMilliseconds   = TimeFrames(ChangeNothing, true, fullCount);
+            double const randomMilliseconds = TimeFrames(ChangeRandom, false, randomCount);
+
+            // The incremental result must match a full rebuild of the same locals bit for bit.
+            std::vector<Mat44> incrementalWorlds(nodeCount);
+
+            for (int index = 0; index < nodeCount; ++index)
+            {
+                incrementalWorlds[index] = hierarchy.GetWorldTransform(nodes[index]);
+            }
+
+            hierarchy.UpdateAll();
+
+            int mismatchCount = 0;
+
+            for (int index = 0; index < nodeCount; ++index)
+            {
+                if (std::memcmp(&incrementalWorlds[index], &hierarchy.GetWorldTransform(nodes[index]), sizeof(Mat44)) != 0) ++mismatchCount;
+            }
+
+            double const rootMilliseconds  = TimeFrames(ChangeFirstRoot, false, rootCount);
+            double const cleanMilliseconds = TimeFrames(ChangeNothing, false, cleanCount);
+
+            ReportResult(StringFormat("(TransformHierarchy)({} nodes, {})({} threads)(full {:.3f} ms)({} dirty: {:.3f} ms, {} rebuilt, {:.1f}x)(root dirty: {:.3f} ms, {} rebuilt)(clean: {:.3f} ms)({} mismatches)",
+                                      nodeCount, shapeNames[shape], isParallel ? PARALLEL_FOR_WORKER_COUNT + 1 : 1,
+                                      fullMilliseconds, dirtyCount, randomMilliseconds, randomCount, randomMilliseconds > 0.0 ? fullMilliseconds / randomMilliseconds : 0.0,
+                                      rootMilliseconds, rootCount, cleanMilliseconds, mismatchCount));
+        }
+
+        hierarchy.SetParallelForWorkers(nullptr, 1);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Per-thread prop command lists for "count" props (default 100k) of the PropDrawSort scene, averaged
+// over "frames" frames (default 20), against a headless backend. Flush is the single-threaded baseline;
+// each thread count then records the sorted draws into per-chunk command lists (RecordCommandLists) and
+// replays them on the calling thread. A hash of every backend call must match Flush's frame, and no
+// ParallelFor helper may still be outstanding once a frame's recording returned.
+//
+STATIC bool GameBenchmark::OnBenchmarkPropCommandLists(EventArgs& args)
+{
+    int const     propCount      = std::max(args.GetValue("count", 100000), 1);
+    int const     frameCount     = std::max(args.GetValue("frames", 20), 1);
+    int constexpr threadCounts[] = {1, 2, 4, 8, 16};
+
+    HashingPropRenderBackend     renderBackend;
+    PropDrawQueue                drawQueue;
+    PropStore                    propStore;
+    ResourceHandleTable          resourceHandles;
+    std::vector<PropCommandList> commandLists;
+
+    propStore.SetRenderBackend(&renderBackend);
+    drawQueue.Reserve(propCount);
+    FillMixedStateBenchmarkScene(propStore, resourceHandles, propCount);
+
+    // Sorted once up front, so every case records and issues the same order and only that is timed.
+    drawQueue.Clear();
+    propStore.SubmitDraws(drawQueue, Vec3::ZERO, resourceHandles);
+    drawQueue.Sort();
+
+    double flushMicroseconds = 0.0;
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        renderBackend.BeginFrame();
+        renderBackend.ResetHash();
+
+        BenchmarkClock::time_point const start = BenchmarkClock::now();
+        drawQueue.Flush(renderBackend, false);
+        flushMicroseconds += GetElapsedMicroseconds(start);
+    }
+
+    uint64_t const         flushHash  = renderBackend.GetHash();
+    sPropRenderStats const flushStats = renderBackend.GetCurrentFrameStats();
+    flushMicroseconds /= frameCount;
+
+    ReportResult(StringFormat("(PropCommandLists)({} props)(Flush {:.3f} ms/frame)({} draws, {} state changes)",
+                              propCount, flushMicroseconds / 1000.0, flushStats.m_staticDraws + flushStats.m_dynamicDraws, flushStats.m_stateChanges));
+
+    auto const RunCase = [&](ParallelForWorkers* workers, int const threadCount, double& out_recordMicroseconds, double& out_replayMicroseconds)
+    {
+        out_recordMicroseconds = 0.0;
+        out_replayMicroseconds = 0.0;
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            renderBackend.BeginFrame();
+            renderBackend.ResetHash();
+
+            BenchmarkClock::time_point const recordStart = BenchmarkClock::now();
+            drawQueue.RecordCommandLists(commandLists, workers, threadCount, false);
+            out_recordMicroseconds += GetElapsedMicroseconds(recordStart);
+
+            // Every helper has left by the time the frame's Run returns; none is left behind to clean up
+            if (workers != nullptr && workers->GetOutstandingHelperCount() != 0) ERROR_AND_DIE(StringFormat("(GameBenchmark::OnBenchmarkPropCommandLists)({} helpers still outstanding after frame {})", workers->GetOutstandingHelperCount(), frame))
+
+            BenchmarkClock::time_point const replayStart = BenchmarkClock::now();
+            PropDrawQueue::ReplayCommandLists(commandLists, renderBackend);
+            out_replayMicroseconds += GetElapsedMicroseconds(replayStart);
+        }
+
+        out_recordMicroseconds /= frameCount;
+        out_replayMicroseconds /= frameCount;
+    };
+
+    auto const ReportCase = [&](char const* workersName, int const threadCount, double const recordMicroseconds, double const replayMicroseconds, double const serialRecordMicroseconds)
+    {
+        int    commandCount  = 0;
+        size_t recordedBytes = 0;
+
+        for (PropCommandList const& commandList : commandLists)
+        {
+            commandCount += commandList.GetCommandCount();
+            recordedBytes += commandList.GetRecordedBytes();
+        }
+
+        sPropRenderStats const& stats     = renderBackend.GetCurrentFrameStats();
+        bool const              isMatched = renderBackend.GetHash() == flushHash && stats.m_stateChanges == flushStats.m_stateChanges;
+
+        ReportResult(StringFormat("(PropCommandLists)({} props)({}{} threads)(record {:.3f} ms, {:.1f} M draws/s, {:.2f}x)(replay {:.3f} ms)(total {:.2f}x Flush)({} lists, {} commands, {:.1f} KB)(matches Flush: {})",
+                                  propCount, workersName, threadCount, recordMicroseconds / 1000.0, recordMicroseconds > 0.0 ? propCount / recordMicroseconds : 0.0,
+                                  recordMicroseconds > 0.0 ? serialRecordMicroseconds / recordMicroseconds : 0.0, replayMicroseconds / 1000.0,
+                                  recordMicroseconds + replayMicroseconds > 0.0 ? flushMicroseconds / (recordMicroseconds + replayMicroseconds) : 0.0,
+                                  commandLists.size(), commandCount, static_cast<double>(recordedBytes) / 1024.0, isMatched ? "yes" : "NO"));
+    };
+
+    double serialRecordMicroseconds = 0.0;
+
+    for (int const threadCount : threadCounts)
+    {
+        ParallelForWorkers* workers = threadCount > 1 ? new ParallelForWorkers(threadCount - 1) : nullptr;
+
+        double recordMicroseconds = 0.0;
+        double replayMicroseconds = 0.0;
+
+        RunCase(workers, threadCount, recordMicroseconds, replayMicroseconds);
+
+        if (threadCount == 1) serialRecordMicroseconds = recordMicroseconds;
+
+        ReportCase("", threadCount, recordMicroseconds, replayMicroseconds, serialRecordMicroseconds);
+
+        GAME_SAFE_RELEASE(workers);
+    }
+
+    if (g_parallelForWorkers != nullptr)
+    {
+        double recordMicroseconds = 0.0;
+        double replayMicroseconds = 0.0;
+
+        RunCase(g_parallelForWorkers, PARALLEL_FOR_WORKER_COUNT + 1, recordMicroseconds, replayMicroseconds);
+        ReportCase("game workers, ", PARALLEL_FOR_WORKER_COUNT + 1, recordMicroseconds, replayMicroseconds, serialRecordMicroseconds);
+    }
+
+    propStore.Clear();
+    propStore.SetRenderBackend(nullptr);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void GameBenchmark::ReportResult(String const& line)
+{
+    DAEMON_LOG(LogGame, eLogVerbosity::Display, StringFormat("(GameBenchmark){}", line));
+
+    if (g_devConsole)
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, line);
+    }
+}
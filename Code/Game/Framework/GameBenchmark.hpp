@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------
+// GameBenchmark.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// In-game microbenchmarks, triggered from the DevConsole by event name (e.g. "BenchmarkScriptBridge").
+// Results are written to the log and the DevConsole.
+//
+class GameBenchmark
+{
+public:
+    static void SubscribeEventCallbacks();
+
+    static bool OnBenchmarkScriptBridge(EventArgs& args);
+    static bool OnBenchmarkModuleGraph(EventArgs& args);
+    static bool OnBenchmarkEntityCommands(EventArgs& args);
+    static bool OnBenchmarkScriptBinding(EventArgs& args);
+    static bool OnBenchmarkNumericCalls(EventArgs& args);
+    static bool OnBenchmarkPropUpdate(EventArgs& args);
+    static bool OnBenchmarkPropChurn(EventArgs& args);
+    static bool OnBenchmarkPropMeshMemory(EventArgs& args);
+    static bool OnBenchmarkPropUpload(EventArgs& args);
+    static bool OnBenchmarkPropMeshIndexing(EventArgs& args);
+    static bool OnBenchmarkPropDrawSort(EventArgs& args);
+    static bool OnBenchmarkResourceLookup(EventArgs& args);
+    static bool OnBenchmarkPropCulling(EventArgs& args);
+    static bool OnBenchmarkPropSpatialQuery(EventArgs& args);
+    static bool OnBenchmarkPropUpdateScaling(EventArgs& args);
+    static bool OnBenchmarkTransformKernels(EventArgs& args);
+    static bool OnBenchmarkTransformHierarchy(EventArgs& args);
+    static bool OnBenchmarkPropCommandLists(EventArgs& args);
+
+private:
+    static void ReportResult(String const& line);
+};
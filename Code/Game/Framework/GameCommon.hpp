@@ -12,6 +12,7 @@ class App;
 class AudioSystem;
 class BitmapFont;
 class Game;
+class ParallelForWorkers;
 class RandomNumberGenerator;
 class Renderer;
 class ResourceSubsystem;
@@ -22,11 +23,18 @@ extern App*                   g_app;
 extern AudioSystem*           g_audio;
 extern BitmapFont*            g_bitmapFont;
 extern Game*                  g_game;
+extern ParallelForWorkers*    g_parallelForWorkers;
 extern RandomNumberGenerator* g_rng;
 extern Renderer*              g_renderer;
 extern ResourceSubsystem*     g_resourceSubsystem;
 extern ScriptSubsystem*       g_scriptSubsystem;
 
+// JobSystem generic workers started by App for engine jobs
+int constexpr JOB_WORKER_THREAD_COUNT = 3;
+
+// ParallelForWorkers threads started by App; parallel loops run on them plus the calling thread
+int constexpr PARALLEL_FOR_WORKER_COUNT = 3;
+
 //-----------------------------------------------------------------------------------------------
 // DebugRender-related
 //
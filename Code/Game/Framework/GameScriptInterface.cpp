@@ -1,4 +1,4 @@
-//----------------------------------------------------------------------------------------------------
+﻿//----------------------------------------------------------------------------------------------------
 // GameScriptInterface.cpp
 //----------------------------------------------------------------------------------------------------
 
@@ -9,9 +9,13 @@
 #include "Game/Player.hpp"
 #include "Game/Framework/App.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/ScriptSystemProfiler.hpp"
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
+#include <chrono>
+#include <filesystem>
+
 //----------------------------------------------------------------------------------------------------
 GameScriptInterface::GameScriptInterface(Game* game)
     : m_game(game)
@@ -25,62 +29,7 @@ GameScriptInterface::GameScriptInterface(Game* game)
 //----------------------------------------------------------------------------------------------------
 std::vector<ScriptMethodInfo> GameScriptInterface::GetAvailableMethods() const
 {
-    return {
-        ScriptMethodInfo("appRequestQuit",
-                         "Request quit to app",
-                         {},
-                         "void"),
-
-        ScriptMethodInfo("createCube",
-                         "在指定位置創建一個立方體",
-                         {"float", "float", "float"},
-                         "string"),
-
-        ScriptMethodInfo("moveProp",
-                         "移動指定索引的道具到新位置",
-                         {"int", "float", "float", "float"},
-                         "string"),
-
-        ScriptMethodInfo("getPlayerPosition",
-                         "取得玩家目前位置",
-                         {},
-                         "object"),
-
-        ScriptMethodInfo("movePlayerCamera",
-                         "移動玩家相機（用於晃動效果）",
-                         {"float", "float", "float"},
-                         "string"),
-
-        ScriptMethodInfo("update",
-                         "JavaScript GameLoop Update",
-                         {"float", "float"},
-                         "void"),
-
-        ScriptMethodInfo("render",
-                         "JavaScript GameLoop Render",
-                         {},
-                         "void"),
-
-        ScriptMethodInfo("executeCommand",
-                         "執行 JavaScript 指令",
-                         {"string"},
-                         "string"),
-
-        ScriptMethodInfo("executeFile",
-                         "執行 JavaScript 檔案",
-                         {"string"},
-                         "string"),
-
-        ScriptMethodInfo("isAttractMode",
-                         "檢查遊戲是否處於吸引模式",
-                         {},
-                         "bool"),
-
-        ScriptMethodInfo("getFileTimestamp",
-                         "取得檔案的最後修改時間戳記",
-                         {"string"},
-                         "number")
-    };
+    return GetMethodTable().GetMethodInfos();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -88,7 +37,9 @@ std::vector<String> GameScriptInterface::GetAvailableProperties() const
 {
     return {
         "attractMode",
-        "gameState"
+        "gameState",
+        "gameDeltaSeconds",
+        "systemDeltaSeconds"
     };
 }
 
@@ -98,48 +49,7 @@ ScriptMethodResult GameScriptInterface::CallMethod(String const&     methodName,
 {
     try
     {
-        if (methodName == "appRequestQuit")
-        {
-            return ExecuteAppRequestQuit(args);
-        }
-        else if (methodName == "createCube")
-        {
-            return ExecuteCreateCube(args);
-        }
-        else if (methodName == "moveProp")
-        {
-            return ExecuteMoveProp(args);
-        }
-        else if (methodName == "getPlayerPosition")
-        {
-            return ExecuteGetPlayerPosition(args);
-        }
-        else if (methodName == "movePlayerCamera")
-        {
-            return ExecuteMovePlayerCamera(args);
-        }
-        else if (methodName == "update")
-        {
-            return ExecuteUpdate(args);
-        }
-        else if (methodName == "render")
-        {
-            return ExecuteRender(args);
-        }
-        else if (methodName == "executeCommand")
-        {
-            return ExecuteJavaScriptCommand(args);
-        }
-        else if (methodName == "executeFile")
-        {
-            return ExecuteJavaScriptFile(args);
-        }
-        else if (methodName == "isAttractMode")
-        {
-            return ExecuteIsAttractMode(args);
-        }
-
-        return ScriptMethodResult::Error("未知的方法: " + methodName);
+        return GetMethodTable().Call(*this, methodName, args);
     }
     catch (std::exception const& e)
     {
@@ -147,6 +57,93 @@ ScriptMethodResult GameScriptInterface::CallMethod(String const&     methodName,
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+Game* GameScriptInterface::GetScriptTarget() const
+{
+    return m_game;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool GameScriptInterface::InstallScriptFunctions(v8::Isolate*                 isolate,
+                                                 v8::Local<v8::Context> const context,
+                                                 String const&                objectName,
+                                                 bool const                   areFastCallsEnabled)
+{
+    return GetMethodTable().InstallFunctions(isolate, context, objectName, *this, areFastCallsEnabled);
+}
+
+//----------------------------------------------------------------------------------------------------
+int GameScriptInterface::FindNumericMethod(String const& methodName) const
+{
+    return GetMethodTable().FindNumericMethod(methodName);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool GameScriptInterface::CallNumericMethod(int const     methodIndex,
+                                            double const* numbers,
+                                            int const     numberCount,
+                                            double&       outResult)
+{
+    return GetMethodTable().CallNumeric(*this, methodIndex, numbers, numberCount, outResult);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void GameScriptInterface::SetNumericFastPathEnabled(bool const isEnabled)
+{
+    GetMethodTable().SetNumericFastPathEnabled(isEnabled);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool GameScriptInterface::IsNumericFastPathEnabled()
+{
+    return GetMethodTable().IsNumericFastPathEnabled();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Plain numeric/string methods are bound straight to Game; the typed call wrappers and method infos
+// are generated from the member function signatures. Structured or variadic methods keep hand-written
+// Execute* wrappers. BindFastCall marks the numeric methods that stay inside C++ (no script heap
+// allocation, no ArrayBuffer publish): createCube, update/render and the command/query batches do not.
+//
+STATIC ScriptMethodTable<GameScriptInterface>& GameScriptInterface::GetMethodTable()
+{
+    static ScriptMethodTable<GameScriptInterface> s_methodTable = []
+    {
+        ScriptMethodTable<GameScriptInterface> table;
+
+        table.Bind<&App::RequestQuit>("appRequestQuit", "Request quit to app");
+        table.Bind<&Game::CreateCube>("createCube", "在指定位置創建一個立方體，回傳其 prop handle");
+        table.BindFastCall<&Game::MoveProp>("moveProp", "移動指定 prop handle 的道具到新位置");
+        table.Bind<&Game::DestroyProp>("destroyProp", "銷毀指定 prop handle 的道具（失效的 handle 會被忽略）");
+        table.BindWrapper<&GameScriptInterface::ExecuteGetPlayerPosition>("getPlayerPosition", "取得玩家目前位置", {}, "object");
+        table.BindFastCall<&Game::MovePlayerCamera>("movePlayerCamera", "移動玩家相機（用於晃動效果）");
+        table.Bind<&Game::Update>("update", "JavaScript GameLoop Update");
+        table.Bind<&Game::Render>("render", "JavaScript GameLoop Render");
+        table.Bind<&Game::ExecuteJavaScriptCommand>("executeCommand", "執行 JavaScript 指令");
+        table.Bind<&Game::ExecuteJavaScriptFile>("executeFile", "執行 JavaScript 檔案");
+        table.BindFastCall<&Game::IsAttractMode>("isAttractMode", "檢查遊戲是否處於吸引模式");
+        table.BindWrapper<&GameScriptInterface::ExecuteGetFileTimestamp>("getFileTimestamp", "取得檔案的最後修改時間戳記", {"string"}, "number");
+        table.BindFastCall<&Game::GetPropCount>("getPropCount", "取得共享變換緩衝區中的道具數量");
+        table.BindFastCall<&Game::GetPropIndex>("getPropIndex", "取得 prop handle 目前在變換緩衝區中的索引，handle 失效時回傳 -1");
+        table.BindFastCall<&Game::GetPropHandle>("getPropHandle", "取得變換緩衝區索引上道具的 prop handle，索引超出範圍時回傳 -1");
+        table.Bind<&Game::ResolveTexture>("resolveTexture", "登記材質路徑並回傳材質 handle（只載入一次，請快取 handle），載入失敗時回傳 -1");
+        table.BindFastCall<&Game::SetPropTexture>("setPropTexture", "以材質 handle 設定道具的材質（-1 表示不使用材質）");
+        table.BindFastCall<&Game::AttachProp>("attachProp", "將子道具以區域偏移 (x, y, z, yaw, pitch, roll) 附加到父道具上，之後子道具會跟隨父道具");
+        table.BindFastCall<&Game::AttachPropToPlayer>("attachPropToPlayer", "將道具以區域偏移 (x, y, z, yaw, pitch, roll) 附加到玩家身上");
+        table.BindFastCall<&Game::DetachProp>("detachProp", "將道具從父物件分離，道具保持在目前位置");
+        table.BindFastCall<&ScriptSystemProfiler::GetTimeMilliseconds>("getHighResolutionMs", "取得單調遞增的高解析度時間（毫秒，用於效能分析）");
+        table.Bind<&Game::PublishScriptSystemTimings>("publishSystemTimings", "以 CSV 行 (phase,systemId,avgMs,maxMs,p99Ms,samples) 發佈 JSEngine 各系統的執行時間");
+        table.Bind<&Game::ReserveEntityCommands>("reserveEntityCommands", "確保實體指令紀錄區 (globalThis.entityCommandRecordMemory) 至少容納指定筆數的指令，回傳容量（筆數）");
+        table.Bind<&Game::SubmitEntityCommands>("submitEntityCommands", "套用紀錄區前 N 筆 [type, propHandle, x, y, z] 實體指令，新建 prop handle 依序寫入 globalThis.entityCommandCreatedMemory，回傳套用筆數（紀錄無效時回傳 -1）");
+        table.Bind<&Game::ReserveSpatialQueries>("reserveSpatialQueries", "確保空間查詢紀錄區 (globalThis.spatialQueryRecordMemory) 至少容納指定筆數的查詢，回傳容量（筆數）");
+        table.Bind<&Game::RunSpatialQueries>("submitSpatialQueries", "執行紀錄區前 N 筆 [type, x, y, z, dx, dy, dz, range, limit] 半徑/最近/射線查詢，結果寫入 globalThis.spatialQueryResultMemory，回傳總命中數（紀錄無效時回傳 -1）");
+
+        return table;
+    }();
+
+    return s_methodTable;
+}
+
 //----------------------------------------------------------------------------------------------------
 std::any GameScriptInterface::GetProperty(const String& propertyName) const
 {
@@ -170,6 +167,14 @@ std::any GameScriptInterface::GetProperty(const String& propertyName) const
             return String("UNKNOWN");
         }
     }
+    else if (propertyName == "gameDeltaSeconds")
+    {
+        return m_game->GetFrameGameDeltaSeconds();
+    }
+    else if (propertyName == "systemDeltaSeconds")
+    {
+        return m_game->GetFrameSystemDeltaSeconds();
+    }
 
     return std::any{};
 }
@@ -212,66 +217,6 @@ bool GameScriptInterface::SetProperty(const String& propertyName, const std::any
     return false;
 }
 
-ScriptMethodResult GameScriptInterface::ExecuteAppRequestQuit(ScriptArgs const& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 0, "appRequestQuit");
-    if (!result.success) return result;
-
-    try
-    {
-        App::RequestQuit();
-        return ScriptMethodResult::Success();
-    }
-    catch (const std::exception& e)
-    {
-        return ScriptMethodResult::Error("創建立方體失敗: " + String(e.what()));
-    }
-}
-
-//----------------------------------------------------------------------------------------------------
-ScriptMethodResult GameScriptInterface::ExecuteCreateCube(const ScriptArgs& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 3, "createCube");
-    if (!result.success) return result;
-
-    try
-    {
-        Vec3 position = ScriptTypeExtractor::ExtractVec3(args, 0);
-        m_game->CreateCube(position);
-        return ScriptMethodResult::Success(String("立方體創建成功，位置: (" +
-            std::to_string(position.x) + ", " +
-            std::to_string(position.y) + ", " +
-            std::to_string(position.z) + ")"));
-    }
-    catch (const std::exception& e)
-    {
-        return ScriptMethodResult::Error("創建立方體失敗: " + String(e.what()));
-    }
-}
-
-//----------------------------------------------------------------------------------------------------
-ScriptMethodResult GameScriptInterface::ExecuteMoveProp(const ScriptArgs& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 4, "moveProp");
-    if (!result.success) return result;
-
-    try
-    {
-        int  propIndex   = ScriptTypeExtractor::ExtractInt(args[0]);
-        Vec3 newPosition = ScriptTypeExtractor::ExtractVec3(args, 1);
-        m_game->MoveProp(propIndex, newPosition);
-        return ScriptMethodResult::Success(String("道具 " + std::to_string(propIndex) +
-            " 移動成功，新位置: (" +
-            std::to_string(newPosition.x) + ", " +
-            std::to_string(newPosition.y) + ", " +
-            std::to_string(newPosition.z) + ")"));
-    }
-    catch (const std::exception& e)
-    {
-        return ScriptMethodResult::Error("移動道具失敗: " + String(e.what()));
-    }
-}
-
 //----------------------------------------------------------------------------------------------------
 ScriptMethodResult GameScriptInterface::ExecuteGetPlayerPosition(const ScriptArgs& args)
 {
@@ -303,110 +248,26 @@ ScriptMethodResult GameScriptInterface::ExecuteGetPlayerPosition(const ScriptArg
 }
 
 //----------------------------------------------------------------------------------------------------
-ScriptMethodResult GameScriptInterface::ExecuteMovePlayerCamera(const ScriptArgs& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 3, "movePlayerCamera");
-    if (!result.success) return result;
-
-    try
-    {
-        Vec3 offset = ScriptTypeExtractor::ExtractVec3(args, 0);
-        m_game->MovePlayerCamera(offset);
-        return ScriptMethodResult::Success(String("相機位置已移動: (" +
-            std::to_string(offset.x) + ", " +
-            std::to_string(offset.y) + ", " +
-            std::to_string(offset.z) + ")"));
-    }
-    catch (const std::exception& e)
-    {
-        return ScriptMethodResult::Error("移動玩家相機失敗: " + String(e.what()));
-    }
-}
-
-ScriptMethodResult GameScriptInterface::ExecuteRender(const ScriptArgs& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 0, "Render");
-    if (!result.success) return result;
-
-    try
-    {
-        m_game->Render();
-        return ScriptMethodResult::Success(Stringf("Render Success"));
-    }
-    catch (const std::exception& e)
-    {
-        return ScriptMethodResult::Error("Render failed: " + String(e.what()));
-    }
-}
-
-ScriptMethodResult GameScriptInterface::ExecuteUpdate(const ScriptArgs& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 2, "Update");
-    if (!result.success) return result;
-
-    try
-    {
-        float gameDeltaSeconds   = ScriptTypeExtractor::ExtractFloat(args[0]);
-        float systemDeltaSeconds = ScriptTypeExtractor::ExtractFloat(args[1]);
-
-        m_game->Update(gameDeltaSeconds, systemDeltaSeconds);
-        return ScriptMethodResult::Success(Stringf("Update Success"));
-    }
-    catch (std::exception const& e)
-    {
-        return ScriptMethodResult::Error("Update failed: " + String(e.what()));
-    }
-}
-
-//----------------------------------------------------------------------------------------------------
-ScriptMethodResult GameScriptInterface::ExecuteJavaScriptCommand(const ScriptArgs& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 1, "executeCommand");
-    if (!result.success) return result;
-
-    try
-    {
-        String command = ScriptTypeExtractor::ExtractString(args[0]);
-        m_game->ExecuteJavaScriptCommand(command);
-        return ScriptMethodResult::Success(String("指令執行: " + command));
-    }
-    catch (std::exception const& e)
-    {
-        return ScriptMethodResult::Error("執行 JavaScript 指令失敗: " + String(e.what()));
-    }
-}
-
-//----------------------------------------------------------------------------------------------------
-ScriptMethodResult GameScriptInterface::ExecuteJavaScriptFile(const ScriptArgs& args)
+ScriptMethodResult GameScriptInterface::ExecuteGetFileTimestamp(ScriptArgs const& args)
 {
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 1, "executeFile");
+    auto result = ScriptTypeExtractor::ValidateArgCount(args, 1, "getFileTimestamp");
     if (!result.success) return result;
 
     try
     {
-        String filename = ScriptTypeExtractor::ExtractString(args[0]);
-        m_game->ExecuteJavaScriptFile(filename);
-        return ScriptMethodResult::Success(String("檔案執行: " + filename));
-    }
-    catch (std::exception const& e)
-    {
-        return ScriptMethodResult::Error("執行 JavaScript 檔案失敗: " + String(e.what()));
-    }
-}
+        String const    filePath = ScriptTypeExtractor::ExtractString(args[0]);
+        std::error_code errorCode;
+        auto const      writeTime = std::filesystem::last_write_time(filePath, errorCode);
 
-//----------------------------------------------------------------------------------------------------
-ScriptMethodResult GameScriptInterface::ExecuteIsAttractMode(const ScriptArgs& args)
-{
-    auto result = ScriptTypeExtractor::ValidateArgCount(args, 0, "isAttractMode");
-    if (!result.success) return result;
+        if (errorCode)
+        {
+            return ScriptMethodResult::Error("取得檔案時間戳記失敗: " + filePath);
+        }
 
-    try
-    {
-        bool isAttract = m_game->IsAttractMode();
-        return ScriptMethodResult::Success(isAttract);
+        return ScriptMethodResult::Success(static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(writeTime.time_since_epoch()).count()));
     }
     catch (std::exception const& e)
     {
-        return ScriptMethodResult::Error("檢查吸引模式失敗: " + String(e.what()));
+        return ScriptMethodResult::Error("取得檔案時間戳記失敗: " + String(e.what()));
     }
 }
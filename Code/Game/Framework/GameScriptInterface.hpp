@@ -1,10 +1,12 @@
-//----------------------------------------------------------------------------------------------------
+﻿//----------------------------------------------------------------------------------------------------
 // GameScriptInterface.hpp
 //----------------------------------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
 //----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptMethodTable.hpp"
+//----------------------------------------------------------------------------------------------------
 #include "Engine/Scripting/IScriptableObject.hpp"
 #include "Engine/Scripting/ScriptTypeExtractor.hpp"
 
@@ -24,17 +26,24 @@ public:
     std::any           GetProperty(String const& propertyName) const override;
     bool               SetProperty(String const& propertyName, std::any const& value) override;
 
+    // Target of methods bound from Game (see ScriptMethodTable)
+    Game* GetScriptTarget() const;
+
+    // Replaces the generic callbacks on globalThis[objectName] with the generated ones (see ScriptMethodTable)
+    bool InstallScriptFunctions(v8::Isolate* isolate, v8::Local<v8::Context> context, String const& objectName, bool areFastCallsEnabled = true);
+
+    // Numeric fast path for all-number methods (moveProp, movePlayerCamera, isAttractMode, ...), shaped
+    // for a V8 fast API CFunction: resolve the index once, then call with plain doubles.
+    int         FindNumericMethod(String const& methodName) const;
+    bool        CallNumericMethod(int methodIndex, double const* numbers, int numberCount, double& outResult);
+    static void SetNumericFastPathEnabled(bool isEnabled);
+    static bool IsNumericFastPathEnabled();
+
 private:
+    static ScriptMethodTable<GameScriptInterface>& GetMethodTable();
+
     Game* m_game;
 
-    ScriptMethodResult ExecuteAppRequestQuit(ScriptArgs const& args);
-    ScriptMethodResult ExecuteCreateCube(ScriptArgs const& args);
-    ScriptMethodResult ExecuteMoveProp(ScriptArgs const& args);
     ScriptMethodResult ExecuteGetPlayerPosition(ScriptArgs const& args);
-    ScriptMethodResult ExecuteMovePlayerCamera(ScriptArgs const& args);
-    ScriptMethodResult ExecuteRender(ScriptArgs const& args);
-    ScriptMethodResult ExecuteUpdate(ScriptArgs const& args);
-    ScriptMethodResult ExecuteJavaScriptCommand(ScriptArgs const& args);
-    ScriptMethodResult ExecuteJavaScriptFile(ScriptArgs const& args);
-    ScriptMethodResult ExecuteIsAttractMode(ScriptArgs const& args);
+    ScriptMethodResult ExecuteGetFileTimestamp(ScriptArgs const& args);
 };
@@ -0,0 +1,61 @@
+﻿//----------------------------------------------------------------------------------------------------
+// InputScriptBindings.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/InputScriptBindings.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Input/InputSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    bool IsKeyCodeValid(int const keyCode)
+    {
+        return keyCode >= 0 && keyCode <= 255;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool InputScriptBindings::InstallScriptFunctions(v8::Isolate*                 isolate,
+                                                 v8::Local<v8::Context> const context,
+                                                 String const&                objectName)
+{
+    return GetMethodTable().InstallFunctions(isolate, context, objectName, *this);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool InputScriptBindings::WasKeyJustPressed(int const keyCode) const
+{
+    return IsKeyCodeValid(keyCode) && g_input->WasKeyJustPressed(static_cast<unsigned char>(keyCode));
+}
+
+//----------------------------------------------------------------------------------------------------
+bool InputScriptBindings::WasKeyJustReleased(int const keyCode) const
+{
+    return IsKeyCodeValid(keyCode) && g_input->WasKeyJustReleased(static_cast<unsigned char>(keyCode));
+}
+
+//----------------------------------------------------------------------------------------------------
+bool InputScriptBindings::IsKeyDown(int const keyCode) const
+{
+    return IsKeyCodeValid(keyCode) && g_input->IsKeyDown(static_cast<unsigned char>(keyCode));
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC ScriptMethodTable<InputScriptBindings>& InputScriptBindings::GetMethodTable()
+{
+    static ScriptMethodTable<InputScriptBindings> s_methodTable = []
+    {
+        ScriptMethodTable<InputScriptBindings> table;
+
+        table.BindFastCall<&InputScriptBindings::WasKeyJustPressed>("wasKeyJustPressed", "檢查按鍵是否在這一幀剛被按下");
+        table.BindFastCall<&InputScriptBindings::WasKeyJustReleased>("wasKeyJustReleased", "檢查按鍵是否在這一幀剛被放開");
+        table.BindFastCall<&InputScriptBindings::IsKeyDown>("isKeyDown", "檢查按鍵目前是否被按住");
+
+        return table;
+    }();
+
+    return s_methodTable;
+}
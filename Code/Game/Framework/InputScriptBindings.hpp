@@ -0,0 +1,27 @@
+﻿//----------------------------------------------------------------------------------------------------
+// InputScriptBindings.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptMethodTable.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Generated callbacks and V8 fast API calls for the per-frame keyboard queries on the "input" object.
+// The engine's InputScriptInterface stays registered as "input" for everything else;
+// InstallScriptFunctions only replaces these methods, so scripts polling keys every frame skip its
+// CallMethod dispatch.
+//
+class InputScriptBindings
+{
+public:
+    bool InstallScriptFunctions(v8::Isolate* isolate, v8::Local<v8::Context> context, String const& objectName);
+
+    bool WasKeyJustPressed(int keyCode) const;
+    bool WasKeyJustReleased(int keyCode) const;
+    bool IsKeyDown(int keyCode) const;
+
+private:
+    static ScriptMethodTable<InputScriptBindings>& GetMethodTable();
+};
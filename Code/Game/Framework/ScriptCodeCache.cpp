@@ -0,0 +1,175 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptCodeCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptCodeCache.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptModuleGraph.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+//----------------------------------------------------------------------------------------------------
+// Bump when the entry layout changes; V8 additionally rejects caches produced by another V8 build.
+uint32_t constexpr CODE_CACHE_MAGIC          = 0x43534A50; // "PJSC"
+uint32_t constexpr CODE_CACHE_FORMAT_VERSION = 1;
+
+//----------------------------------------------------------------------------------------------------
+struct sCodeCacheEntryHeader
+{
+    uint32_t m_magic         = CODE_CACHE_MAGIC;
+    uint32_t m_formatVersion = CODE_CACHE_FORMAT_VERSION;
+    uint64_t m_sourceHash    = 0;
+    uint64_t m_dataSize      = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+ScriptCodeCache::ScriptCodeCache(String const& cacheDirectory)
+    : m_cacheDirectory(cacheDirectory)
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(m_cacheDirectory, errorCode);
+
+    if (errorCode)
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, StringFormat("(ScriptCodeCache::ScriptCodeCache)(cannot create cache directory)({})", m_cacheDirectory));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Manifest format: one "<16 hex digit source hash> <module path>" pair per line.
+//
+void ScriptCodeCache::LoadManifest()
+{
+    m_sourceHashByModule.clear();
+
+    std::ifstream manifest(GetManifestPath());
+    String        line;
+
+    while (std::getline(manifest, line))
+    {
+        size_t const separator = line.find(' ');
+
+        if (separator == String::npos) continue;
+
+        m_sourceHashByModule[line.substr(separator + 1)] = std::stoull(line.substr(0, separator), nullptr, 16);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptCodeCache::SaveManifest() const
+{
+    std::ofstream manifest(GetManifestPath(), std::ios::trunc);
+
+    for (auto const& [modulePath, sourceHash] : m_sourceHashByModule)
+    {
+        manifest << StringFormat("{:016x} {}\n", sourceHash, modulePath);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptCodeCache::UpdateManifest(ScriptModuleGraph const& moduleGraph)
+{
+    for (sScriptModuleNode const& module : moduleGraph.GetModules())
+    {
+        m_sourceHashByModule[module.m_path] = module.m_sourceHash;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptCodeCache::LoadCodeCache(uint64_t const sourceHash, std::vector<uint8_t>& out_data) const
+{
+    std::ifstream entry(GetEntryPath(sourceHash), std::ios::binary);
+
+    if (!entry.is_open()) return false;
+
+    sCodeCacheEntryHeader header;
+    entry.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!entry ||
+        header.m_magic != CODE_CACHE_MAGIC ||
+        header.m_formatVersion != CODE_CACHE_FORMAT_VERSION ||
+        header.m_sourceHash != sourceHash)
+    {
+        return false;
+    }
+
+    out_data.resize(header.m_dataSize);
+    entry.read(reinterpret_cast<char*>(out_data.data()), static_cast<std::streamsize>(header.m_dataSize));
+
+    return static_cast<bool>(entry);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Writes to a temporary file first so a crash mid-write never leaves a truncated entry behind.
+//
+bool ScriptCodeCache::StoreCodeCache(uint64_t const sourceHash, std::vector<uint8_t> const& data) const
+{
+    String const entryPath     = GetEntryPath(sourceHash);
+    String const temporaryPath = entryPath + ".tmp";
+
+    {
+        std::ofstream entry(temporaryPath, std::ios::binary | std::ios::trunc);
+
+        if (!entry.is_open()) return false;
+
+        sCodeCacheEntryHeader header;
+        header.m_sourceHash = sourceHash;
+        header.m_dataSize   = data.size();
+
+        entry.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        entry.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        if (!entry) return false;
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPath, entryPath, errorCode);
+
+    return !errorCode;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Removes entries whose source hash is no longer referenced by the manifest.
+//
+void ScriptCodeCache::PruneStaleEntries() const
+{
+    std::unordered_set<String> liveEntries;
+
+    for (auto const& [modulePath, sourceHash] : m_sourceHashByModule)
+    {
+        liveEntries.insert(std::filesystem::path(GetEntryPath(sourceHash)).filename().string());
+    }
+
+    std::error_code errorCode;
+
+    for (std::filesystem::directory_entry const& file : std::filesystem::directory_iterator(m_cacheDirectory, errorCode))
+    {
+        if (file.path().extension() != ".bin") continue;
+        if (liveEntries.contains(file.path().filename().string())) continue;
+
+        std::filesystem::remove(file.path(), errorCode);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& ScriptCodeCache::GetCacheDirectory() const
+{
+    return m_cacheDirectory;
+}
+
+//----------------------------------------------------------------------------------------------------
+String ScriptCodeCache::GetEntryPath(uint64_t const sourceHash) const
+{
+    return StringFormat("{}/{:016x}.bin", m_cacheDirectory, sourceHash);
+}
+
+//----------------------------------------------------------------------------------------------------
+String ScriptCodeCache::GetManifestPath() const
+{
+    return m_cacheDirectory + "/manifest.txt";
+}
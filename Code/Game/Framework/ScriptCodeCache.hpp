@@ -0,0 +1,46 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptCodeCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ScriptModuleGraph;
+
+//----------------------------------------------------------------------------------------------------
+// Persistent, content-addressed store for compiled module code caches.
+//
+// Entries are keyed by the 64-bit hash of the module source (ScriptModuleGraph::HashSource), so an
+// edited module simply misses and is rebuilt, and identical sources share one entry. Entries are
+// consumed and produced by ScriptModuleCompiler. A manifest of module path -> source hash records
+// what the last launch loaded; entries it no longer references are pruned.
+//
+class ScriptCodeCache
+{
+public:
+    explicit ScriptCodeCache(String const& cacheDirectory);
+
+    void LoadManifest();
+    void SaveManifest() const;
+    void UpdateManifest(ScriptModuleGraph const& moduleGraph);
+
+    bool LoadCodeCache(uint64_t sourceHash, std::vector<uint8_t>& out_data) const;
+    bool StoreCodeCache(uint64_t sourceHash, std::vector<uint8_t> const& data) const;
+    void PruneStaleEntries() const;
+
+    String const& GetCacheDirectory() const;
+
+private:
+    String GetEntryPath(uint64_t sourceHash) const;
+    String GetManifestPath() const;
+
+    String                               m_cacheDirectory;
+    std::unordered_map<String, uint64_t> m_sourceHashByModule;
+};
@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptFunctionHandle.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptFunctionHandle.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+ScriptFunctionHandle::ScriptFunctionHandle(v8::Isolate*                 isolate,
+                                           v8::Local<v8::Context> const context,
+                                           String const&                objectName,
+                                           String const&                methodName)
+    : m_isolate(isolate),
+      m_context(isolate, context),
+      m_objectName(objectName),
+      m_methodName(methodName),
+      m_name(objectName + "." + methodName)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptFunctionHandle::~ScriptFunctionHandle()
+{
+    Reset();
+    m_context.Reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Calls the function with numberCount (at most MAX_ARG_COUNT) numbers. Returns false, with the reason
+// in GetLastError, if the method cannot be resolved or the call threw.
+//
+bool ScriptFunctionHandle::Call(double const* numbers, int const numberCount)
+{
+    v8::Isolate::Scope           isolateScope(m_isolate);
+    v8::HandleScope              handleScope(m_isolate);
+    v8::Local<v8::Context> const context = m_context.Get(m_isolate);
+    v8::Context::Scope           contextScope(context);
+
+    if (m_function.IsEmpty() && !Resolve(context)) return false;
+
+    v8::Local<v8::Value> args[MAX_ARG_COUNT];
+    int const            argCount = std::min(numberCount, MAX_ARG_COUNT);
+
+    for (int i = 0; i < argCount; ++i)
+    {
+        args[i] = v8::Number::New(m_isolate, numbers[i]);
+    }
+
+    v8::TryCatch tryCatch(m_isolate);
+
+    if (m_function.Get(m_isolate)->Call(context, m_receiver.Get(m_isolate), argCount, args).IsEmpty())
+    {
+        v8::String::Utf8Value const message(m_isolate, tryCatch.Exception());
+        m_lastError = *message != nullptr ? String(*message) : String("unknown exception");
+        return false;
+    }
+
+    // ExecuteScript drained the microtask queue after every frame call; promise jobs queued by the frame still run now
+    m_isolate->PerformMicrotaskCheckpoint();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptFunctionHandle::Reset()
+{
+    m_function.Reset();
+    m_receiver.Reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& ScriptFunctionHandle::GetName() const
+{
+    return m_name;
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& ScriptFunctionHandle::GetLastError() const
+{
+    return m_lastError;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptFunctionHandle::Resolve(v8::Local<v8::Context> const context)
+{
+    v8::Local<v8::Value> object;
+    v8::Local<v8::Value> function;
+
+    if (!context->Global()->Get(context, v8::String::NewFromUtf8(m_isolate, m_objectName.c_str()).ToLocalChecked()).ToLocal(&object) || !object->IsObject())
+    {
+        m_lastError = StringFormat("globalThis.{} is not an object", m_objectName);
+        return false;
+    }
+
+    if (!object.As<v8::Object>()->Get(context, v8::String::NewFromUtf8(m_isolate, m_methodName.c_str()).ToLocalChecked()).ToLocal(&function) || !function->IsFunction())
+    {
+        m_lastError = StringFormat("{} is not a function", m_name);
+        return false;
+    }
+
+    m_receiver.Reset(m_isolate, object.As<v8::Object>());
+    m_function.Reset(m_isolate, function.As<v8::Function>());
+
+    return true;
+}
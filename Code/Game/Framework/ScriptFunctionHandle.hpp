@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptFunctionHandle.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <v8.h>
+
+//----------------------------------------------------------------------------------------------------
+// A script method, globalThis[<object>][<method>], resolved once into persistent handles to the function
+// and its receiver. Calls from C++ pass numbers straight in as v8::Number arguments: no source string is
+// compiled or looked up, and the result is dropped without being converted to a string.
+//
+// Resolve runs lazily on the first call after construction or Reset; Reset whenever the object may have
+// been replaced (a root hot reload re-creates JSEngine).
+//
+// Owns V8 handles: must be destroyed while the isolate is still alive.
+//
+class ScriptFunctionHandle
+{
+public:
+    static int constexpr MAX_ARG_COUNT = 4;
+
+    ScriptFunctionHandle(v8::Isolate* isolate, v8::Local<v8::Context> context, String const& objectName, String const& methodName);
+    ~ScriptFunctionHandle();
+
+    bool Call(double const* numbers, int numberCount);
+    void Reset();
+
+    String const& GetName() const;
+    String const& GetLastError() const;
+
+private:
+    bool Resolve(v8::Local<v8::Context> context);
+
+    v8::Isolate*             m_isolate = nullptr;
+    v8::Global<v8::Context>  m_context;
+    v8::Global<v8::Object>   m_receiver;
+    v8::Global<v8::Function> m_function;
+    String                   m_objectName;
+    String                   m_methodName;
+    String                   m_name;            // "<object>.<method>", for logs
+    String                   m_lastError;
+};
@@ -0,0 +1,427 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptHotReloader.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptHotReloader.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Game.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/ScriptModuleCompiler.hpp"
+#include "Game/Framework/ScriptSystemProfiler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Scripting/ScriptSubsystem.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    bool Contains(std::vector<String> const& paths, String const& path)
+    {
+        return std::find(paths.begin(), paths.end(), path) != paths.end();
+    }
+
+    String GetFileName(String const& path)
+    {
+        size_t const lastSlash = path.find_last_of("/\\");
+
+        return lastSlash == String::npos ? path : path.substr(lastSlash + 1);
+    }
+
+    void ReplaceQuoted(String& source, String const& from, String const& to)
+    {
+        for (char const quote : {'\'', '"'})
+        {
+            String const quotedFrom = quote + from + quote;
+            String const quotedTo   = quote + to + quote;
+
+            for (size_t position = source.find(quotedFrom); position != String::npos; position = source.find(quotedFrom, position + quotedTo.size()))
+            {
+                source.replace(position, quotedFrom.size(), quotedTo);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptHotReloader::ScriptHotReloader(ScriptModuleGraph const& moduleGraph,
+                                     ScriptModuleCompiler&    moduleCompiler,
+                                     String const&            hotSwapDirectory)
+    : m_moduleGraph(moduleGraph),
+      m_moduleCompiler(moduleCompiler),
+      m_hotSwapDirectory(hotSwapDirectory)
+{
+    RecordTimestamps();
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptHotReloader::~ScriptHotReloader()
+{
+    RemoveVersionedModules();
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void ScriptHotReloader::SubscribeEventCallbacks()
+{
+    g_eventSystem->SubscribeEventCallbackFunction("ScriptHotReload", OnReloadCommand);
+    g_eventSystem->SubscribeEventCallbackFunction("ScriptHotReloadStats", OnPrintStats);
+}
+
+//----------------------------------------------------------------------------------------------------
+// ScriptHotReload file=Data/Scripts/components/CubeSpawner.mjs [force=1]
+// force=1 reloads even when the bytes are unchanged (latency measurement without editing files).
+//
+STATIC bool ScriptHotReloader::OnReloadCommand(EventArgs& args)
+{
+    if (g_game == nullptr || g_game->GetScriptHotReloader() == nullptr) return false;
+
+    String const modulePath = ScriptModuleGraph::ResolveImportPath("", args.GetValue("file", String("Data/Scripts/main.mjs")));
+    bool const   isForced   = args.GetValue("force", 0) != 0;
+
+    return g_game->GetScriptHotReloader()->ReloadModule(modulePath, isForced);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool ScriptHotReloader::OnPrintStats(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_game == nullptr || g_game->GetScriptHotReloader() == nullptr) return false;
+
+    int   leafCount    = 0;
+    int   rootCount    = 0;
+    int   skippedCount = 0;
+    float leafTotalMs  = 0.f;
+    float rootTotalMs  = 0.f;
+
+    for (sScriptReloadReport const& report : g_game->GetScriptHotReloader()->GetReports())
+    {
+        if (report.m_isSkipped)
+        {
+            ++skippedCount;
+        }
+        else if (report.m_isRootReload)
+        {
+            ++rootCount;
+            rootTotalMs += report.m_latencyMs;
+        }
+        else
+        {
+            ++leafCount;
+            leafTotalMs += report.m_latencyMs;
+        }
+    }
+
+    String const line = StringFormat("(ScriptHotReloadStats)(leaf: {} reloads, avg {:.2f} ms)(root: {} reloads, avg {:.2f} ms)({} unchanged edits skipped)",
+                                     leafCount, leafCount > 0 ? leafTotalMs / static_cast<float>(leafCount) : 0.f,
+                                     rootCount, rootCount > 0 ? rootTotalMs / static_cast<float>(rootCount) : 0.f,
+                                     skippedCount);
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Display, line);
+    if (g_devConsole) g_devConsole->AddLine(DevConsole::INFO_MINOR, line);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Polls module timestamps every POLL_INTERVAL_FRAMES frames and reloads the ones that changed.
+//
+void ScriptHotReloader::Update()
+{
+    if (++m_framesSincePoll < POLL_INTERVAL_FRAMES) return;
+
+    m_framesSincePoll = 0;
+
+    std::vector<String> changedModules;
+
+    for (auto& [modulePath, timestamp] : m_timestampByModule)
+    {
+        std::error_code                       errorCode;
+        std::filesystem::file_time_type const writeTime = std::filesystem::last_write_time(modulePath, errorCode);
+
+        if (!errorCode && writeTime != timestamp)
+        {
+            timestamp = writeTime;
+            changedModules.push_back(modulePath);
+        }
+    }
+
+    for (String const& modulePath : changedModules)
+    {
+        ReloadModule(modulePath);
+    }
+
+    if (!changedModules.empty()) RecordTimestamps();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptHotReloader::ReloadModule(String const& modulePath, bool const isForced)
+{
+    if (g_scriptSubsystem == nullptr || !g_scriptSubsystem->IsInitialized()) return false;
+
+    if (m_moduleGraph.FindModule(modulePath) == nullptr)
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, StringFormat("(ScriptHotReloader::ReloadModule)(not in module graph)({})", modulePath));
+        return false;
+    }
+
+    double const        startMs = ScriptSystemProfiler::GetTimeMilliseconds();
+    sScriptReloadReport report;
+    report.m_modulePath = modulePath;
+
+    String     source;
+    bool const isChanged = m_moduleGraph.RefreshModule(modulePath, source);
+
+    if (!isChanged && !(isForced && ScriptModuleGraph::ReadSourceFile(modulePath, source)))
+    {
+        report.m_isSkipped = true;
+        report.m_latencyMs = static_cast<float>(ScriptSystemProfiler::GetTimeMilliseconds() - startMs);
+        AddReport(report);
+
+        DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(ScriptHotReloader::ReloadModule)({})(content unchanged, skipped)", modulePath));
+        return false;
+    }
+
+    std::vector<String> const dirtyModules = CollectDirtyModules(modulePath);
+
+    ++m_generation;
+
+    for (String const& dirtyModule : dirtyModules)
+    {
+        String dirtySource;
+
+        if (dirtyModule == modulePath)
+        {
+            dirtySource = source;
+        }
+        else if (!ScriptModuleGraph::ReadSourceFile(dirtyModule, dirtySource))
+        {
+            DAEMON_LOG(LogScript, eLogVerbosity::Error, StringFormat("(ScriptHotReloader::ReloadModule)(failed to read dependent)({})", dirtyModule));
+            return false;
+        }
+
+        if (!WriteVersionedModule(dirtyModule, dirtySource, dirtyModules, IsHotSwappable(dirtyModule)))
+        {
+            return false;
+        }
+    }
+
+    // Older copies are superseded once the new generation is on disk
+    for (String const& dirtyModule : dirtyModules)
+    {
+        String& versionedPath = m_versionedPathByModule[dirtyModule];
+
+        if (!versionedPath.empty())
+        {
+            std::error_code errorCode;
+            std::filesystem::remove(versionedPath, errorCode);
+        }
+
+        versionedPath = GetVersionedPath(dirtyModule);
+    }
+
+    // Evaluate only the tops of the dirty set; everything below is reached through their imports.
+    // Non-swappable tops (the entry module) go first so component swaps land in the new world.
+    std::vector<String> topModules;
+
+    for (String const& dirtyModule : dirtyModules)
+    {
+        bool isTop = true;
+
+        for (String const& importer : m_moduleGraph.GetImporters(dirtyModule))
+        {
+            if (Contains(dirtyModules, importer)) isTop = false;
+        }
+
+        if (isTop) topModules.push_back(dirtyModule);
+    }
+
+    std::stable_partition(topModules.begin(), topModules.end(), [this](String const& path) { return !IsHotSwappable(path); });
+
+    report.m_isRootReload = Contains(dirtyModules, m_moduleGraph.GetModules().front().m_path);
+
+    // The new world starts with no prop handles, so the old world's props would be orphaned
+    if (report.m_isRootReload && g_game != nullptr) g_game->DestroyScriptProps();
+
+    bool isSuccess = true;
+
+    for (String const& topModule : topModules)
+    {
+        if (!m_moduleCompiler.ExecuteModule(GetVersionedPath(topModule)))
+        {
+            isSuccess = false;
+            DAEMON_LOG(LogScript, eLogVerbosity::Error, StringFormat("(ScriptHotReloader::ReloadModule)(evaluation failed)({})({})", topModule, m_moduleCompiler.GetLastError()));
+        }
+    }
+
+    // The re-evaluated root assigned a new globalThis.JSEngine; drop the handles to the old one
+    if (report.m_isRootReload && g_game != nullptr) g_game->ResetJavaScriptFrameFunctions();
+
+    report.m_reloadedModuleCount = static_cast<int>(dirtyModules.size());
+    report.m_latencyMs           = static_cast<float>(ScriptSystemProfiler::GetTimeMilliseconds() - startMs);
+    AddReport(report);
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Display, StringFormat("(ScriptHotReloader::ReloadModule)({})({})({} modules re-evaluated)({:.2f} ms)",
+                                                               modulePath, report.m_isRootReload ? "root" : "leaf", report.m_reloadedModuleCount, report.m_latencyMs));
+
+    return isSuccess;
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptModuleGraph const& ScriptHotReloader::GetModuleGraph() const
+{
+    return m_moduleGraph;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sScriptReloadReport> const& ScriptHotReloader::GetReports() const
+{
+    return m_reports;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptHotReloader::IsHotSwappable(String const& modulePath) const
+{
+    return modulePath.rfind(m_hotSwapDirectory, 0) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The edited module plus its transitive importers; propagation stops at hot-swappable modules.
+//
+std::vector<String> ScriptHotReloader::CollectDirtyModules(String const& modulePath) const
+{
+    std::vector<String> dirtyModules = {modulePath};
+
+    for (size_t i = 0; i < dirtyModules.size(); ++i)
+    {
+        if (IsHotSwappable(dirtyModules[i])) continue;
+
+        for (String const& importer : m_moduleGraph.GetImporters(dirtyModules[i]))
+        {
+            if (!Contains(dirtyModules, importer)) dirtyModules.push_back(importer);
+        }
+    }
+
+    return dirtyModules;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Writes this generation's copy of a dirty module next to the original (so its own relative imports
+// still resolve). Hot-swappable modules get a footer handing their namespace to JSEngine.
+//
+bool ScriptHotReloader::WriteVersionedModule(String const& modulePath, String const& source, std::vector<String> const& dirtyModules, bool const isHotSwappable) const
+{
+    sScriptModuleNode const* node = m_moduleGraph.FindModule(modulePath);
+
+    if (node == nullptr) return false;
+
+    String versionedSource = source;
+
+    for (size_t i = 0; i < node->m_imports.size(); ++i)
+    {
+        String const currentSpecifier = GetCurrentSpecifier(node->m_importSpecifiers[i], node->m_imports[i], dirtyModules);
+
+        if (currentSpecifier != node->m_importSpecifiers[i])
+        {
+            ReplaceQuoted(versionedSource, node->m_importSpecifiers[i], currentSpecifier);
+        }
+    }
+
+    String const versionedPath = GetVersionedPath(modulePath);
+
+    if (isHotSwappable)
+    {
+        versionedSource += StringFormat("\nimport * as __hotModule from './{}';\nglobalThis.JSEngine?.acceptHotModule?.('{}', __hotModule);\n", GetFileName(versionedPath), modulePath);
+    }
+
+    std::ofstream file(versionedPath, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Error, StringFormat("(ScriptHotReloader::WriteVersionedModule)(cannot write)({})", versionedPath));
+        return false;
+    }
+
+    file.write(versionedSource.data(), static_cast<std::streamsize>(versionedSource.size()));
+
+    return file.good();
+}
+
+//----------------------------------------------------------------------------------------------------
+// "Data/Scripts/components/CubeSpawner.mjs" -> "Data/Scripts/components/CubeSpawner.hot-<generation>.mjs"
+//
+String ScriptHotReloader::GetVersionedPath(String const& path) const
+{
+    size_t const extension = path.rfind(".mjs");
+    String const stem      = extension == String::npos ? path : path.substr(0, extension);
+
+    return StringFormat("{}.hot-{}.mjs", stem, m_generation);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Dirty imports point at this generation's copy, previously reloaded ones at their latest copy.
+//
+String ScriptHotReloader::GetCurrentSpecifier(String const& specifier, String const& resolvedPath, std::vector<String> const& dirtyModules) const
+{
+    String targetPath;
+
+    if (Contains(dirtyModules, resolvedPath))
+    {
+        targetPath = GetVersionedPath(resolvedPath);
+    }
+    else if (auto const found = m_versionedPathByModule.find(resolvedPath); found != m_versionedPathByModule.end())
+    {
+        targetPath = found->second;
+    }
+    else
+    {
+        return specifier;
+    }
+
+    size_t const lastSlash = specifier.find_last_of('/');
+
+    return specifier.substr(0, lastSlash + 1) + GetFileName(targetPath);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::RemoveVersionedModules()
+{
+    for (auto const& [modulePath, versionedPath] : m_versionedPathByModule)
+    {
+        std::error_code errorCode;
+        std::filesystem::remove(versionedPath, errorCode);
+    }
+
+    m_versionedPathByModule.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Adds timestamps for modules not tracked yet (initial graph, or imports added by an edit).
+//
+void ScriptHotReloader::RecordTimestamps()
+{
+    for (sScriptModuleNode const& node : m_moduleGraph.GetModules())
+    {
+        if (m_timestampByModule.contains(node.m_path)) continue;
+
+        std::error_code                       errorCode;
+        std::filesystem::file_time_type const writeTime = std::filesystem::last_write_time(node.m_path, errorCode);
+
+        if (!errorCode) m_timestampByModule[node.m_path] = writeTime;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Drops the oldest report once MAX_REPORTS are kept, so a long editing session stays bounded.
+//
+void ScriptHotReloader::AddReport(sScriptReloadReport const& report)
+{
+    if (static_cast<int>(m_reports.size()) >= MAX_REPORTS) m_reports.erase(m_reports.begin());
+
+    m_reports.push_back(report);
+}
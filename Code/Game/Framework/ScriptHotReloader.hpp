@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptHotReloader.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptModuleGraph.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+
+#include <filesystem>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ScriptModuleCompiler;
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptReloadReport
+{
+    String m_modulePath;
+    bool   m_isSkipped           = false;   // Timestamp changed but the bytes did not
+    bool   m_isRootReload        = false;   // Dirty set reached the entry module (whole world re-created)
+    int    m_reloadedModuleCount = 0;
+    float  m_latencyMs           = 0.f;     // Hash check + graph walk + evaluation + instance swap
+};
+
+//----------------------------------------------------------------------------------------------------
+// Incremental hot reload over the static import graph of the entry module.
+//
+// Polls module timestamps; an edited module whose content hash is unchanged is skipped. Otherwise the
+// dirty set is the module plus its transitive importers, stopping at hot-swappable modules (files in
+// the component directory), which re-instantiate their own systems through JSEngine.acceptHotModule.
+// Modules are evaluated through the ScriptModuleCompiler that loaded the entry module. It caches by path,
+// so each dirty module is written to a versioned sibling ("Name.hot-<n>.mjs") whose imports of other
+// dirty modules point at their versioned copies; clean modules stay shared. Only the top of the dirty set is evaluated: the edited component for a leaf
+// edit, or the entry module (re-creating JSEngine/JSGame) when the edit reaches the root. A root
+// reload first destroys the props the old world's scripts created (Game::DestroyScriptProps), since
+// the new world holds no handles to them.
+// DevConsole: "ScriptHotReload file=<path> [force=1]" reloads now, "ScriptHotReloadStats" prints latency
+// over the last MAX_REPORTS reloads.
+//
+class ScriptHotReloader
+{
+public:
+    static int constexpr POLL_INTERVAL_FRAMES = 30;
+    static int constexpr MAX_REPORTS          = 256;
+
+    ScriptHotReloader(ScriptModuleGraph const& moduleGraph, ScriptModuleCompiler& moduleCompiler, String const& hotSwapDirectory);
+    ~ScriptHotReloader();
+
+    static void SubscribeEventCallbacks();
+    static bool OnReloadCommand(EventArgs& args);
+    static bool OnPrintStats(EventArgs& args);
+
+    void Update();
+    bool ReloadModule(String const& modulePath, bool isForced = false);
+
+    ScriptModuleGraph const&                GetModuleGraph() const;
+    std::vector<sScriptReloadReport> const& GetReports() const;
+
+private:
+    bool                IsHotSwappable(String const& modulePath) const;
+    std::vector<String> CollectDirtyModules(String const& modulePath) const;
+    bool                WriteVersionedModule(String const& modulePath, String const& source, std::vector<String> const& dirtyModules, bool isHotSwappable) const;
+    String              GetVersionedPath(String const& path) const;
+    String              GetCurrentSpecifier(String const& specifier, String const& resolvedPath, std::vector<String> const& dirtyModules) const;
+    void                RemoveVersionedModules();
+    void                RecordTimestamps();
+    void                AddReport(sScriptReloadReport const& report);
+
+    ScriptModuleGraph                                           m_moduleGraph;
+    ScriptModuleCompiler&                                       m_moduleCompiler;
+    String                                                      m_hotSwapDirectory;
+    int                                                         m_generation      = 0;
+    int                                                         m_framesSincePoll = 0;
+    std::unordered_map<String, std::filesystem::file_time_type> m_timestampByModule;
+    std::unordered_map<String, String>                          m_versionedPathByModule;   // Latest evaluated copy
+    std::vector<sScriptReloadReport>                            m_reports;                 // Latest MAX_REPORTS, oldest first
+};
@@ -0,0 +1,288 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptIdleCollector.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptIdleCollector.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/App.hpp"
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Scripting/ScriptSubsystem.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    char const* GetPhaseName(eScriptGcPhase const phase)
+    {
+        switch (phase)
+        {
+        case eScriptGcPhase::UPDATE:    return "update";
+        case eScriptGcPhase::RENDER:    return "render";
+        case eScriptGcPhase::END_FRAME: return "endFrame";
+        default:                        return "unknown";
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void ScriptIdleCollector::SubscribeEventCallbacks()
+{
+    g_eventSystem->SubscribeEventCallbackFunction("ScriptGcIdle", OnConfigure);
+    g_eventSystem->SubscribeEventCallbackFunction("ScriptGcStats", OnPrintStats);
+}
+
+//----------------------------------------------------------------------------------------------------
+// ScriptGcIdle [enabled=0|1] [fps=60] [interval=60]
+//
+STATIC bool ScriptIdleCollector::OnConfigure(EventArgs& args)
+{
+    if (g_app == nullptr) return false;
+
+    ScriptIdleCollector& collector = g_app->GetScriptIdleCollector();
+
+    collector.SetIdleModeEnabled(args.GetValue("enabled", 1) != 0);
+    collector.SetTargetFrameRate(args.GetValue("fps", 60));
+    collector.SetMinFramesBetweenCollections(args.GetValue("interval", 60));
+
+    if (g_devConsole)
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, StringFormat("(ScriptGcIdle)({})", collector.IsIdleModeEnabled() ? "enabled" : "disabled"));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool ScriptIdleCollector::OnPrintStats(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_app == nullptr) return false;
+
+    ScriptIdleCollector const& collector = g_app->GetScriptIdleCollector();
+
+    for (int i = 0; i < static_cast<int>(eScriptGcPhase::COUNT); ++i)
+    {
+        eScriptGcPhase const       phase = static_cast<eScriptGcPhase>(i);
+        sScriptGcPhaseStats const& stats = collector.GetPhaseStats(phase);
+
+        String const line = StringFormat("(ScriptGcStats)({}: {} pauses ({} major), total {:.3f} ms, max {:.3f} ms, per-frame avg {:.4f} ms, p99 {:.3f} ms)",
+                                         GetPhaseName(phase), stats.m_collectionCount, stats.m_majorCollectionCount, stats.m_totalPauseMs, stats.m_maxPauseMs,
+                                         stats.m_pauseHistory.GetAverage(), stats.m_pauseHistory.GetPercentile(0.99f));
+
+        DAEMON_LOG(LogScript, eLogVerbosity::Display, line);
+        if (g_devConsole) g_devConsole->AddLine(DevConsole::INFO_MINOR, line);
+    }
+
+    String const summary = StringFormat("(ScriptGcStats)(idle mode {}, avg slack {:.3f} ms, major pause estimate {:.3f} ms, idle requests {})",
+                                        collector.IsIdleModeEnabled() ? "on" : "off", collector.GetAverageSlackMs(),
+                                        collector.GetPauseEstimateMs(), collector.GetIdleRequestCount());
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Display, summary);
+    if (g_devConsole) g_devConsole->AddLine(DevConsole::INFO_MINOR, summary);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Call once the isolate exists; every GC pause from then on is recorded by OnGcPrologue/OnGcEpilogue.
+//
+void ScriptIdleCollector::Attach(v8::Isolate* isolate)
+{
+    Detach();
+
+    if (isolate == nullptr) return;
+
+    m_isolate = isolate;
+    m_isolate->AddGCPrologueCallback(OnGcPrologue, this);
+    m_isolate->AddGCEpilogueCallback(OnGcEpilogue, this);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Call before the isolate is disposed.
+//
+void ScriptIdleCollector::Detach()
+{
+    if (m_isolate == nullptr) return;
+
+    SetMemoryPressure(v8::MemoryPressureLevel::kNone);
+
+    m_isolate->RemoveGCPrologueCallback(OnGcPrologue, this);
+    m_isolate->RemoveGCEpilogueCallback(OnGcEpilogue, this);
+    m_isolate = nullptr;
+    m_gcDepth = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptIdleCollector::BeginFrame()
+{
+    m_frameStartMs = ScriptSystemProfiler::GetTimeMilliseconds();
+    m_currentPhase = eScriptGcPhase::UPDATE;
+
+    std::fill(std::begin(m_framePauseMs), std::end(m_framePauseMs), 0.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptIdleCollector::BeginPhase(eScriptGcPhase const phase)
+{
+    m_currentPhase = phase;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Blocking full collection for the "gc" global. The pause itself is recorded by the GC callbacks;
+// the return value is only for the caller's log line.
+//
+float ScriptIdleCollector::CollectNow()
+{
+    if (g_scriptSubsystem == nullptr || !g_scriptSubsystem->IsInitialized()) return 0.f;
+
+    double const startMs = ScriptSystemProfiler::GetTimeMilliseconds();
+    g_scriptSubsystem->ForceGarbageCollection();
+
+    return static_cast<float>(ScriptSystemProfiler::GetTimeMilliseconds() - startMs);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Called from App::EndFrame before the renderer presents. When the slack left in this frame covers
+// the expected major pause, moderate memory pressure makes V8 start incremental marking now, so the
+// next major collection is spread over small steps instead of landing in UpdateJS as one pause.
+//
+void ScriptIdleCollector::EndFrame()
+{
+    m_currentPhase = eScriptGcPhase::END_FRAME;
+
+    // A major collection finished since the last frame: the request is served
+    if (m_isPressureRaised && m_framesSinceCollection == 0) SetMemoryPressure(v8::MemoryPressureLevel::kNone);
+
+    ++m_framesSinceCollection;
+
+    float const elapsedMs = static_cast<float>(ScriptSystemProfiler::GetTimeMilliseconds() - m_frameStartMs);
+    float const slackMs   = m_frameBudgetMs - elapsedMs;
+
+    m_slackHistory.AddSample(std::max(slackMs, 0.f));
+
+    if (m_isIdleModeEnabled &&
+        !m_isPressureRaised &&
+        m_framesSinceCollection >= m_minFramesBetweenCollections &&
+        slackMs >= GetPauseEstimateMs() + SAFETY_MARGIN_MS)
+    {
+        SetMemoryPressure(v8::MemoryPressureLevel::kModerate);
+        ++m_idleRequestCount;
+    }
+
+    for (int i = 0; i < static_cast<int>(eScriptGcPhase::COUNT); ++i)
+    {
+        m_phaseStats[i].m_pauseHistory.AddSample(m_framePauseMs[i]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptIdleCollector::SetIdleModeEnabled(bool const isEnabled)
+{
+    m_isIdleModeEnabled = isEnabled;
+
+    if (!m_isIdleModeEnabled) SetMemoryPressure(v8::MemoryPressureLevel::kNone);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptIdleCollector::IsIdleModeEnabled() const
+{
+    return m_isIdleModeEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptIdleCollector::SetTargetFrameRate(int const framesPerSecond)
+{
+    m_frameBudgetMs = 1000.f / static_cast<float>(std::max(framesPerSecond, 1));
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptIdleCollector::SetMinFramesBetweenCollections(int const frameCount)
+{
+    m_minFramesBetweenCollections = std::max(frameCount, 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptGcPhaseStats const& ScriptIdleCollector::GetPhaseStats(eScriptGcPhase const phase) const
+{
+    return m_phaseStats[static_cast<int>(phase)];
+}
+
+//----------------------------------------------------------------------------------------------------
+float ScriptIdleCollector::GetAverageSlackMs() const
+{
+    return m_slackHistory.GetAverage();
+}
+
+//----------------------------------------------------------------------------------------------------
+int ScriptIdleCollector::GetIdleRequestCount() const
+{
+    return m_idleRequestCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Expected cost of the next major pause, in any phase: the larger of the average and the recent worst case.
+//
+float ScriptIdleCollector::GetPauseEstimateMs() const
+{
+    if (m_majorCollectionCount == 0) return INITIAL_PAUSE_ESTIMATE_MS;
+
+    return std::max(m_totalMajorPauseMs / static_cast<float>(m_majorCollectionCount), m_majorPauseHistory.GetMax());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs on the isolate's thread, inside the frame phase that triggered the collection.
+//
+STATIC void ScriptIdleCollector::OnGcPrologue(v8::Isolate* isolate, v8::GCType const type, v8::GCCallbackFlags const flags, void* data)
+{
+    UNUSED(isolate)
+    UNUSED(type)
+    UNUSED(flags)
+
+    ScriptIdleCollector* collector = static_cast<ScriptIdleCollector*>(data);
+
+    if (collector->m_gcDepth++ == 0) collector->m_gcStartMs = ScriptSystemProfiler::GetTimeMilliseconds();
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void ScriptIdleCollector::OnGcEpilogue(v8::Isolate* isolate, v8::GCType const type, v8::GCCallbackFlags const flags, void* data)
+{
+    UNUSED(isolate)
+    UNUSED(flags)
+
+    ScriptIdleCollector* collector = static_cast<ScriptIdleCollector*>(data);
+
+    if (collector->m_gcDepth == 0 || --collector->m_gcDepth != 0) return;
+
+    float const          pauseMs    = static_cast<float>(ScriptSystemProfiler::GetTimeMilliseconds() - collector->m_gcStartMs);
+    int const            phaseIndex = static_cast<int>(collector->m_currentPhase);
+    sScriptGcPhaseStats& stats      = collector->m_phaseStats[phaseIndex];
+
+    collector->m_framePauseMs[phaseIndex] += pauseMs;
+    stats.m_collectionCount++;
+    stats.m_totalPauseMs += pauseMs;
+    stats.m_maxPauseMs = std::max(stats.m_maxPauseMs, pauseMs);
+
+    if ((type & v8::kGCTypeMarkSweepCompact) == 0) return;
+
+    stats.m_majorCollectionCount++;
+    collector->m_majorCollectionCount++;
+    collector->m_totalMajorPauseMs += pauseMs;
+    collector->m_majorPauseHistory.AddSample(pauseMs);
+    collector->m_framesSinceCollection = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptIdleCollector::SetMemoryPressure(v8::MemoryPressureLevel const level)
+{
+    if (m_isolate == nullptr) return;
+
+    m_isolate->MemoryPressureNotification(level);
+    m_isPressureRaised = level != v8::MemoryPressureLevel::kNone;
+}
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptIdleCollector.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptSystemProfiler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+
+#include <cstdint>
+#include <v8.h>
+
+//----------------------------------------------------------------------------------------------------
+enum class eScriptGcPhase : uint8_t
+{
+    UPDATE,
+    RENDER,
+    END_FRAME,
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptGcPhaseStats
+{
+    int           m_collectionCount      = 0;   // Every V8 pause: scavenges, incremental marking steps, full collections
+    int           m_majorCollectionCount = 0;   // Mark-sweep-compact pauses only
+    float         m_totalPauseMs         = 0.f;
+    float         m_maxPauseMs           = 0.f;
+    TimingHistory m_pauseHistory;                // Per-frame pause time in this phase (0 when nothing collected)
+};
+
+//----------------------------------------------------------------------------------------------------
+// Measures script garbage collection per frame phase and steers V8's own collector into the idle
+// time at the end of the frame.
+//
+// Attach() installs GC prologue/epilogue callbacks on the isolate, so every pause V8 takes (its own
+// scavenges and incremental marking steps as well as collections requested by the "gc" global) is
+// timed and attributed to the phase it ran in. In idle mode App::EndFrame raises moderate memory
+// pressure when the remaining frame budget covers the expected major pause, rate-limited to once
+// every N frames: V8 then starts incremental marking and finishes it in small steps, instead of the
+// game blocking on a full collection. The pressure is lowered again once a major collection ends.
+// DevConsole: "ScriptGcIdle enabled=1 fps=60 interval=60" configures, "ScriptGcStats" prints.
+//
+class ScriptIdleCollector
+{
+public:
+    static float constexpr INITIAL_PAUSE_ESTIMATE_MS = 2.f;
+    static float constexpr SAFETY_MARGIN_MS          = 0.5f;
+
+    static void SubscribeEventCallbacks();
+    static bool OnConfigure(EventArgs& args);
+    static bool OnPrintStats(EventArgs& args);
+
+    void Attach(v8::Isolate* isolate);
+    void Detach();
+
+    void  BeginFrame();
+    void  BeginPhase(eScriptGcPhase phase);
+    float CollectNow();
+    void  EndFrame();
+
+    void SetIdleModeEnabled(bool isEnabled);
+    bool IsIdleModeEnabled() const;
+    void SetTargetFrameRate(int framesPerSecond);
+    void SetMinFramesBetweenCollections(int frameCount);
+
+    sScriptGcPhaseStats const& GetPhaseStats(eScriptGcPhase phase) const;
+    float                      GetAverageSlackMs() const;
+    int                        GetIdleRequestCount() const;
+    float                      GetPauseEstimateMs() const;
+
+private:
+    static void OnGcPrologue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+    static void OnGcEpilogue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+
+    void SetMemoryPressure(v8::MemoryPressureLevel level);
+
+    v8::Isolate*   m_isolate                      = nullptr;
+    float          m_frameBudgetMs                = 1000.f / 60.f;
+    int            m_minFramesBetweenCollections  = 60;
+    bool           m_isIdleModeEnabled            = false;
+    bool           m_isPressureRaised             = false;
+    eScriptGcPhase m_currentPhase                 = eScriptGcPhase::UPDATE;
+    double         m_frameStartMs                 = 0.0;
+    double         m_gcStartMs                    = 0.0;
+    int            m_gcDepth                      = 0;
+    int            m_framesSinceCollection        = 0;
+    int            m_idleRequestCount             = 0;
+    int            m_majorCollectionCount         = 0;
+    float          m_totalMajorPauseMs            = 0.f;
+    float          m_framePauseMs[static_cast<int>(eScriptGcPhase::COUNT)] = {};
+
+    sScriptGcPhaseStats m_phaseStats[static_cast<int>(eScriptGcPhase::COUNT)];
+    TimingHistory       m_slackHistory;
+    TimingHistory       m_majorPauseHistory;
+};
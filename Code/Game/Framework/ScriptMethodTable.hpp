@@ -0,0 +1,780 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptMethodTable.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Scripting/IScriptableObject.hpp"
+#include "Engine/Scripting/ScriptTypeExtractor.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <v8.h>
+#include <v8-fast-api-calls.h>
+
+//----------------------------------------------------------------------------------------------------
+// Whether a script number converts to int/float without undefined behaviour: NaN and values outside
+// the target range do not. Infinity and NaN are fine as floats.
+//
+inline bool IsScriptNumberIntConvertible(double const number)
+{
+    return number > static_cast<double>(std::numeric_limits<int>::min()) - 1.0 && number < static_cast<double>(std::numeric_limits<int>::max()) + 1.0;
+}
+
+inline bool IsScriptNumberFloatConvertible(double const number)
+{
+    return !std::isfinite(number) || std::abs(number) <= static_cast<double>(std::numeric_limits<float>::max());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Script argument conversion per C++ parameter type. Each type consumes SLOT_COUNT script arguments
+// (Vec3 takes three consecutive floats, matching the existing "x, y, z" script signatures).
+// FromNumbers may only be called once IsInRange accepted the same numbers. FastTypes are the
+// parameter types of the V8 fast API call, one per slot.
+//
+template <typename T>
+struct sScriptArgTraits;
+
+template <>
+struct sScriptArgTraits<int>
+{
+    static int constexpr  SLOT_COUNT = 1;
+    static bool constexpr IS_NUMERIC = true;
+    using FastTypes = std::tuple<int32_t>;
+    static int  Extract(ScriptArgs const& args, size_t const slot) { return ScriptTypeExtractor::ExtractInt(args[slot]); }
+    static int  FromNumbers(double const* numbers) { return static_cast<int>(numbers[0]); }
+    static bool IsInRange(double const* numbers) { return IsScriptNumberIntConvertible(numbers[0]); }
+    static void AppendTypeNames(std::vector<String>& typeNames) { typeNames.emplace_back("int"); }
+};
+
+template <>
+struct sScriptArgTraits<float>
+{
+    static int constexpr  SLOT_COUNT = 1;
+    static bool constexpr IS_NUMERIC = true;
+    using FastTypes = std::tuple<float>;
+    static float Extract(ScriptArgs const& args, size_t const slot) { return ScriptTypeExtractor::ExtractFloat(args[slot]); }
+    static float FromNumbers(double const* numbers) { return static_cast<float>(numbers[0]); }
+    static bool  IsInRange(double const* numbers) { return IsScriptNumberFloatConvertible(numbers[0]); }
+    static void  AppendTypeNames(std::vector<String>& typeNames) { typeNames.emplace_back("float"); }
+};
+
+template <>
+struct sScriptArgTraits<bool>
+{
+    static int constexpr  SLOT_COUNT = 1;
+    static bool constexpr IS_NUMERIC = true;
+    using FastTypes = std::tuple<bool>;
+    static bool Extract(ScriptArgs const& args, size_t const slot) { return ScriptTypeExtractor::ExtractBool(args[slot]); }
+    static bool FromNumbers(double const* numbers) { return numbers[0] != 0.0; }
+    static bool IsInRange(double const* numbers) { UNUSED(numbers) return true; }
+    static void AppendTypeNames(std::vector<String>& typeNames) { typeNames.emplace_back("bool"); }
+};
+
+template <>
+struct sScriptArgTraits<String>
+{
+    static int constexpr  SLOT_COUNT = 1;
+    static bool constexpr IS_NUMERIC = false;
+    static String Extract(ScriptArgs const& args, size_t const slot) { return ScriptTypeExtractor::ExtractString(args[slot]); }
+    static void   AppendTypeNames(std::vector<String>& typeNames) { typeNames.emplace_back("string"); }
+
+    static bool TryFromValue(v8::FunctionCallbackInfo<v8::Value> const& info, int const slot, String& outValue)
+    {
+        if (!info[slot]->IsString()) return false;
+
+        v8::String::Utf8Value const utf8(info.GetIsolate(), info[slot]);
+        outValue.assign(*utf8, static_cast<size_t>(utf8.length()));
+        return true;
+    }
+};
+
+template <>
+struct sScriptArgTraits<Vec3>
+{
+    static int constexpr  SLOT_COUNT = 3;
+    static bool constexpr IS_NUMERIC = true;
+    using FastTypes = std::tuple<float, float, float>;
+    static Vec3 Extract(ScriptArgs const& args, size_t const slot) { return ScriptTypeExtractor::ExtractVec3(args, slot); }
+    static Vec3 FromNumbers(double const* numbers) { return Vec3(static_cast<float>(numbers[0]), static_cast<float>(numbers[1]), static_cast<float>(numbers[2])); }
+    static bool IsInRange(double const* numbers) { return IsScriptNumberFloatConvertible(numbers[0]) && IsScriptNumberFloatConvertible(numbers[1]) && IsScriptNumberFloatConvertible(numbers[2]); }
+    static void AppendTypeNames(std::vector<String>& typeNames) { typeNames.insert(typeNames.end(), {"float", "float", "float"}); }
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+struct sScriptReturnTraits
+{
+    static char const* GetTypeName()
+    {
+        if constexpr (std::is_void_v<T>) return "void";
+        else if constexpr (std::is_same_v<T, bool>) return "bool";
+        else if constexpr (std::is_same_v<T, int>) return "int";
+        else if constexpr (std::is_same_v<T, float>) return "float";
+        else if constexpr (std::is_same_v<T, double>) return "number";
+        else if constexpr (std::is_same_v<T, String>) return "string";
+        else static_assert(std::is_void_v<T>, "Unsupported script return type");
+    }
+
+    static bool constexpr IS_NUMERIC = std::is_void_v<T> || std::is_same_v<T, bool> || std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    template <typename TValue>
+    static void SetReturnValue(v8::ReturnValue<v8::Value> returnValue, TValue const& value)
+    {
+        if constexpr (std::is_same_v<TValue, String>)
+        {
+            returnValue.Set(v8::String::NewFromUtf8(returnValue.GetIsolate(), value.c_str(), v8::NewStringType::kNormal, static_cast<int>(value.size())).ToLocalChecked());
+        }
+        else if constexpr (std::is_same_v<TValue, bool> || std::is_same_v<TValue, int>)
+        {
+            returnValue.Set(value);
+        }
+        else
+        {
+            returnValue.Set(static_cast<double>(value));
+        }
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Reads a script argument as a plain number without going through ScriptTypeExtractor.
+// Returns false for anything that is not a number or bool, so the caller can take the slow path.
+//
+inline bool TryGetScriptNumber(std::any const& value, double& outNumber)
+{
+    if (double const* number = std::any_cast<double>(&value)) { outNumber = *number; return true; }
+    if (float const* number = std::any_cast<float>(&value)) { outNumber = static_cast<double>(*number); return true; }
+    if (int const* number = std::any_cast<int>(&value)) { outNumber = static_cast<double>(*number); return true; }
+    if (bool const* flag = std::any_cast<bool>(&value)) { outNumber = *flag ? 1.0 : 0.0; return true; }
+    return false;
+}
+
+inline bool TryGetScriptNumber(v8::Local<v8::Value> const value, double& outNumber)
+{
+    if (value->IsNumber()) { outNumber = value.As<v8::Number>()->Value(); return true; }
+    if (value->IsBoolean()) { outNumber = value.As<v8::Boolean>()->Value() ? 1.0 : 0.0; return true; }
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Converts the SLOT_COUNT V8 arguments starting at slot to a C++ parameter. Returns false when a
+// value has the wrong type or does not convert (NaN or out of range for an int).
+//
+template <typename T>
+bool TryGetScriptArg(v8::FunctionCallbackInfo<v8::Value> const& info, int const slot, T& outValue)
+{
+    using ArgTraits = sScriptArgTraits<T>;
+
+    if constexpr (ArgTraits::IS_NUMERIC)
+    {
+        double numbers[ArgTraits::SLOT_COUNT];
+
+        for (int i = 0; i < ArgTraits::SLOT_COUNT; ++i)
+        {
+            if (!TryGetScriptNumber(info[slot + i], numbers[i])) return false;
+        }
+
+        if (!ArgTraits::IsInRange(numbers)) return false;
+
+        outValue = ArgTraits::FromNumbers(numbers);
+        return true;
+    }
+    else
+    {
+        return ArgTraits::TryFromValue(info, slot, outValue);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+inline void ThrowScriptTypeError(v8::Isolate* isolate, String const& message)
+{
+    isolate->ThrowException(v8::Exception::TypeError(v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked()));
+}
+
+inline void ThrowScriptError(v8::Isolate* isolate, String const& message)
+{
+    isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked()));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Signature decomposition for bound functions: member functions (const or not) and free/static functions.
+//
+template <typename TFunction>
+struct sScriptFunctionTraits;
+
+template <typename TReturn, typename... TArgs>
+struct sScriptFunctionTraits<TReturn (*)(TArgs...)>
+{
+    using Class  = void;
+    using Return = TReturn;
+    using Args   = std::tuple<std::remove_cvref_t<TArgs>...>;
+};
+
+template <typename TClass, typename TReturn, typename... TArgs>
+struct sScriptFunctionTraits<TReturn (TClass::*)(TArgs...)>
+{
+    using Class  = TClass;
+    using Return = TReturn;
+    using Args   = std::tuple<std::remove_cvref_t<TArgs>...>;
+};
+
+template <typename TClass, typename TReturn, typename... TArgs>
+struct sScriptFunctionTraits<TReturn (TClass::*)(TArgs...) const>
+{
+    using Class  = TClass const;
+    using Return = TReturn;
+    using Args   = std::tuple<std::remove_cvref_t<TArgs>...>;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Compile-time script argument layout of a bound function: total slot count and per-parameter offsets.
+//
+template <typename TArgsTuple>
+struct sScriptArgLayout;
+
+template <typename... TArgs>
+struct sScriptArgLayout<std::tuple<TArgs...>>
+{
+    static int constexpr  SLOT_COUNT = (0 + ... + sScriptArgTraits<TArgs>::SLOT_COUNT);
+    static bool constexpr IS_NUMERIC = (true && ... && sScriptArgTraits<TArgs>::IS_NUMERIC);
+
+    static constexpr std::array<size_t, sizeof...(TArgs) + 1> GetSlotOffsets()
+    {
+        std::array<size_t, sizeof...(TArgs) + 1> offsets     = {};
+        size_t                                    slotCounts[] = {static_cast<size_t>(sScriptArgTraits<TArgs>::SLOT_COUNT)..., 0};
+
+        for (size_t i = 0; i < sizeof...(TArgs); ++i)
+        {
+            offsets[i + 1] = offsets[i] + slotCounts[i];
+        }
+
+        return offsets;
+    }
+
+    static std::vector<String> GetTypeNames()
+    {
+        std::vector<String> typeNames;
+        (sScriptArgTraits<TArgs>::AppendTypeNames(typeNames), ...);
+        return typeNames;
+    }
+
+    // Numeric signatures only: true if every argument converts to its parameter type.
+    static bool AreNumbersInRange(double const* numbers)
+    {
+        [[maybe_unused]] static constexpr auto offsets = GetSlotOffsets();   // Unused for functions without parameters
+
+        return [numbers]<size_t... Indices>(std::index_sequence<Indices...>)
+        {
+            return (true && ... && sScriptArgTraits<TArgs>::IsInRange(numbers + offsets[Indices]));
+        }(std::index_sequence_for<TArgs...>{});
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Fast API parameter list of a numeric signature: the FastTypes of every parameter, concatenated.
+//
+template <typename TArgsTuple>
+struct sScriptFastArgs;
+
+template <typename... TArgs>
+struct sScriptFastArgs<std::tuple<TArgs...>>
+{
+    using Types = decltype(std::tuple_cat(std::declval<typename sScriptArgTraits<TArgs>::FastTypes>()...));
+};
+
+//----------------------------------------------------------------------------------------------------
+// Calls Function on target (ignored for free functions) with arguments converted straight from the
+// script argument list; the conversions are fixed at compile time from Function's signature.
+//
+template <auto Function, typename TTarget, size_t... Indices>
+ScriptMethodResult InvokeBoundScriptFunction(TTarget* target, ScriptArgs const& args, std::index_sequence<Indices...>)
+{
+    using Traits = sScriptFunctionTraits<decltype(Function)>;
+    using Args   = typename Traits::Args;
+
+    [[maybe_unused]] static constexpr auto offsets = sScriptArgLayout<Args>::GetSlotOffsets();
+
+    auto const call = [&]() -> decltype(auto)
+    {
+        if constexpr (std::is_void_v<typename Traits::Class>)
+        {
+            return Function(sScriptArgTraits<std::tuple_element_t<Indices, Args>>::Extract(args, offsets[Indices])...);
+        }
+        else
+        {
+            return (target->*Function)(sScriptArgTraits<std::tuple_element_t<Indices, Args>>::Extract(args, offsets[Indices])...);
+        }
+    };
+
+    if constexpr (std::is_void_v<typename Traits::Return>)
+    {
+        call();
+        return ScriptMethodResult::Success();
+    }
+    else
+    {
+        return ScriptMethodResult::Success(call());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// V8 callback variant: arguments are converted straight from the V8 values and the result is set as
+// the V8 return value, with no ScriptArgs, std::any or ScriptMethodResult in between. Throws a script
+// TypeError instead of calling when an argument does not convert.
+//
+template <auto Function, typename TTarget, size_t... Indices>
+void InvokeBoundScriptCallback(TTarget* target, v8::FunctionCallbackInfo<v8::Value> const& info, std::index_sequence<Indices...>)
+{
+    using Traits = sScriptFunctionTraits<decltype(Function)>;
+    using Args   = typename Traits::Args;
+
+    [[maybe_unused]] static constexpr auto offsets = sScriptArgLayout<Args>::GetSlotOffsets();
+
+    [[maybe_unused]] Args values;
+
+    if (!(true && ... && TryGetScriptArg(info, static_cast<int>(offsets[Indices]), std::get<Indices>(values))))
+    {
+        ThrowScriptTypeError(info.GetIsolate(), "參數型別錯誤或超出範圍");
+        return;
+    }
+
+    auto const call = [&]() -> decltype(auto)
+    {
+        if constexpr (std::is_void_v<typename Traits::Class>)
+        {
+            return Function(std::move(std::get<Indices>(values))...);
+        }
+        else
+        {
+            return (target->*Function)(std::move(std::get<Indices>(values))...);
+        }
+    };
+
+    if constexpr (std::is_void_v<typename Traits::Return>)
+    {
+        call();
+    }
+    else
+    {
+        sScriptReturnTraits<typename Traits::Return>::SetReturnValue(info.GetReturnValue(), call());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Numeric-only variant: arguments arrive as a flat double array and the result leaves as a double,
+// so no std::any, ScriptMethodResult or string is touched on the way through.
+//
+template <auto Function, typename TTarget, size_t... Indices>
+double InvokeBoundScriptFunctionNumeric(TTarget* target, double const* numbers, std::index_sequence<Indices...>)
+{
+    using Traits = sScriptFunctionTraits<decltype(Function)>;
+    using Args   = typename Traits::Args;
+
+    [[maybe_unused]] static constexpr auto offsets = sScriptArgLayout<Args>::GetSlotOffsets();
+
+    auto const call = [&]() -> decltype(auto)
+    {
+        if constexpr (std::is_void_v<typename Traits::Class>)
+        {
+            return Function(sScriptArgTraits<std::tuple_element_t<Indices, Args>>::FromNumbers(numbers + offsets[Indices])...);
+        }
+        else
+        {
+            return (target->*Function)(sScriptArgTraits<std::tuple_element_t<Indices, Args>>::FromNumbers(numbers + offsets[Indices])...);
+        }
+    };
+
+    if constexpr (std::is_void_v<typename Traits::Return>)
+    {
+        call();
+        return 0.0;
+    }
+    else
+    {
+        return static_cast<double>(call());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// V8 fast API entry point for a numeric bound function. Optimized script call sites call it with
+// unboxed values that V8 already converted (ToInt32 for int, rounded for float), so no handle,
+// std::any or ScriptMethodResult is created. options.data is the External wrapping the owner.
+//
+template <auto Function, typename TOwner, typename TFastArgs = typename sScriptFastArgs<typename sScriptFunctionTraits<decltype(Function)>::Args>::Types>
+struct sScriptFastCall;
+
+template <auto Function, typename TOwner, typename... TFastArgs>
+struct sScriptFastCall<Function, TOwner, std::tuple<TFastArgs...>>
+{
+    using Traits = sScriptFunctionTraits<decltype(Function)>;
+    using Args   = typename Traits::Args;
+    using Return = typename Traits::Return;
+
+    static Return Call(v8::Local<v8::Object> receiver, TFastArgs... values, v8::FastApiCallbackOptions& options)
+    {
+        using Class = std::remove_const_t<typename Traits::Class>;
+
+        UNUSED(receiver)
+
+        double const numbers[] = {static_cast<double>(values)..., 0.0};     // Trailing slot keeps the array legal without parameters
+        TOwner&      owner     = *static_cast<TOwner*>(options.data.As<v8::External>()->Value());
+        double       result    = 0.0;
+
+        if constexpr (std::is_void_v<Class>)
+        {
+            UNUSED(owner)
+            result = InvokeBoundScriptFunctionNumeric<Function, void>(nullptr, numbers, std::make_index_sequence<std::tuple_size_v<Args>>{});
+        }
+        else if constexpr (std::is_same_v<Class, TOwner>)
+        {
+            result = InvokeBoundScriptFunctionNumeric<Function>(&owner, numbers, std::make_index_sequence<std::tuple_size_v<Args>>{});
+        }
+        else
+        {
+            result = InvokeBoundScriptFunctionNumeric<Function>(owner.GetScriptTarget(), numbers, std::make_index_sequence<std::tuple_size_v<Args>>{});
+        }
+
+        if constexpr (std::is_void_v<Return>)
+        {
+            UNUSED(result)
+        }
+        else if constexpr (std::is_same_v<Return, bool>)
+        {
+            return result != 0.0;
+        }
+        else
+        {
+            return static_cast<Return>(result);
+        }
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Name -> invoker table for an IScriptableObject. Replaces a hand-written GetAvailableMethods() list
+// plus an if/else string chain: each Bind generates the typed wrapper and the method info from the
+// function signature, and CallMethod becomes one hash lookup.
+//
+// Each Bind also generates a v8::FunctionCallback trampoline for its function. InstallFunctions puts
+// those on the script object, so calls from script go straight from V8 values to the C++ call
+// without CallMethod's name lookup and ScriptArgs boxing. BindFastCall additionally registers a V8
+// fast API CFunction, which optimized call sites use instead of the trampoline.
+//
+// TOwner is the scriptable object. Member functions of TOwner are called on the owner; member functions
+// of any other class are called on owner.GetScriptTarget(), which TOwner must provide.
+//
+// Methods whose parameters and result are all numbers (int/float/bool/Vec3 -> void/int/float/bool) also
+// get a numeric fast invoker: doubles in, double out. CallNumeric reaches it through a pre-resolved
+// method index, and the fast API calls of BindFastCall go through it; Call uses it whenever every
+// argument is a plain number and falls back to the typed slow path otherwise.
+//
+template <typename TOwner>
+class ScriptMethodTable
+{
+public:
+    static int constexpr MAX_NUMERIC_ARG_COUNT = 8;
+
+    using Invoker        = ScriptMethodResult (*)(TOwner&, ScriptArgs const&);
+    using NumericInvoker = bool (*)(TOwner&, double const*, double&);
+    using ResultWrapper  = ScriptMethodResult (*)(double);
+
+    // Binds a function whose parameters map to script arguments through sScriptArgTraits.
+    template <auto Function>
+    void Bind(String const& name, String const& description)
+    {
+        using Traits = sScriptFunctionTraits<decltype(Function)>;
+        using Args   = typename Traits::Args;
+        using Layout = sScriptArgLayout<Args>;
+
+        Invoker const invoker = [](TOwner& owner, ScriptArgs const& args) -> ScriptMethodResult
+        {
+            using Class = std::remove_const_t<typename Traits::Class>;
+
+            if constexpr (std::is_void_v<Class>)
+            {
+                UNUSED(owner)
+                return InvokeBoundScriptFunction<Function, void>(nullptr, args, std::make_index_sequence<std::tuple_size_v<Args>>{});
+            }
+            else if constexpr (std::is_same_v<Class, TOwner>)
+            {
+                return InvokeBoundScriptFunction<Function>(&owner, args, std::make_index_sequence<std::tuple_size_v<Args>>{});
+            }
+            else
+            {
+                return InvokeBoundScriptFunction<Function>(owner.GetScriptTarget(), args, std::make_index_sequence<std::tuple_size_v<Args>>{});
+            }
+        };
+
+        AddEntry(name, description, Layout::GetTypeNames(), sScriptReturnTraits<typename Traits::Return>::GetTypeName(), Layout::SLOT_COUNT, invoker);
+
+        sEntry& entry = m_entries.back();
+
+        // Data is the External wrapping the owner, see InstallFunctions
+        entry.m_callback = [](v8::FunctionCallbackInfo<v8::Value> const& info)
+        {
+            using Class = std::remove_const_t<typename Traits::Class>;
+
+            v8::Isolate* const isolate = info.GetIsolate();
+
+            if (info.Length() != Layout::SLOT_COUNT)
+            {
+                ThrowScriptTypeError(isolate, StringFormat("需要 {} 個參數，收到 {} 個", Layout::SLOT_COUNT, info.Length()));
+                return;
+            }
+
+            TOwner& owner = *static_cast<TOwner*>(info.Data().template As<v8::External>()->Value());
+
+            try
+            {
+                if constexpr (std::is_void_v<Class>)
+                {
+                    UNUSED(owner)
+                    InvokeBoundScriptCallback<Function, void>(nullptr, info, std::make_index_sequence<std::tuple_size_v<Args>>{});
+                }
+                else if constexpr (std::is_same_v<Class, TOwner>)
+                {
+                    InvokeBoundScriptCallback<Function>(&owner, info, std::make_index_sequence<std::tuple_size_v<Args>>{});
+                }
+                else
+                {
+                    InvokeBoundScriptCallback<Function>(owner.GetScriptTarget(), info, std::make_index_sequence<std::tuple_size_v<Args>>{});
+                }
+            }
+            catch (std::exception const& e)
+            {
+                ThrowScriptError(isolate, "方法執行時發生例外: " + String(e.what()));
+            }
+        };
+
+        if constexpr (Layout::IS_NUMERIC && sScriptReturnTraits<typename Traits::Return>::IS_NUMERIC && Layout::SLOT_COUNT <= MAX_NUMERIC_ARG_COUNT)
+        {
+            // Declines (returns false without calling) when an argument would not convert, e.g. NaN to int
+            entry.m_numericInvoker = [](TOwner& owner, double const* numbers, double& outResult) -> bool
+            {
+                using Class = std::remove_const_t<typename Traits::Class>;
+
+                if (!Layout::AreNumbersInRange(numbers)) return false;
+
+                if constexpr (std::is_void_v<Class>)
+                {
+                    UNUSED(owner)
+                    outResult = InvokeBoundScriptFunctionNumeric<Function, void>(nullptr, numbers, std::make_index_sequence<std::tuple_size_v<Args>>{});
+                }
+                else if constexpr (std::is_same_v<Class, TOwner>)
+                {
+                    outResult = InvokeBoundScriptFunctionNumeric<Function>(&owner, numbers, std::make_index_sequence<std::tuple_size_v<Args>>{});
+                }
+                else
+                {
+                    outResult = InvokeBoundScriptFunctionNumeric<Function>(owner.GetScriptTarget(), numbers, std::make_index_sequence<std::tuple_size_v<Args>>{});
+                }
+
+                return true;
+            };
+
+            entry.m_resultWrapper = [](double const number) -> ScriptMethodResult
+            {
+                using Return = typename Traits::Return;
+
+                if constexpr (std::is_void_v<Return>)
+                {
+                    UNUSED(number)
+                    return ScriptMethodResult::Success();
+                }
+                else if constexpr (std::is_same_v<Return, bool>)
+                {
+                    return ScriptMethodResult::Success(number != 0.0);
+                }
+                else
+                {
+                    return ScriptMethodResult::Success(static_cast<Return>(number));
+                }
+            };
+        }
+    }
+
+    // Bind plus a V8 fast API call for a numeric signature; the trampoline stays as the slow path.
+    // Only for functions that never re-enter V8: no script execution, no ArrayBuffer publish and
+    // nothing allocated on the script heap.
+    template <auto Function>
+    void BindFastCall(String const& name, String const& description)
+    {
+        using Traits = sScriptFunctionTraits<decltype(Function)>;
+        using Layout = sScriptArgLayout<typename Traits::Args>;
+
+        static_assert(Layout::IS_NUMERIC && sScriptReturnTraits<typename Traits::Return>::IS_NUMERIC, "Fast calls need numeric parameters and result");
+
+        static v8::CFunction const s_cFunction = v8::CFunction::Make(&sScriptFastCall<Function, TOwner>::Call);
+
+        Bind<Function>(name, description);
+        m_entries.back().m_cFunction = &s_cFunction;
+    }
+
+    // Binds a hand-written ScriptMethodResult TOwner::Method(ScriptArgs const&) for variadic or
+    // structured methods; the wrapper validates its own arguments.
+    template <ScriptMethodResult (TOwner::*Method)(ScriptArgs const&)>
+    void BindWrapper(String const& name, String const& description, std::vector<String> const& parameterTypes, String const& returnType)
+    {
+        Invoker const invoker = [](TOwner& owner, ScriptArgs const& args) -> ScriptMethodResult
+        {
+            return (owner.*Method)(args);
+        };
+
+        AddEntry(name, description, parameterTypes, returnType, -1, invoker);
+    }
+
+    bool HasMethod(String const& name) const
+    {
+        return m_entryIndexByName.find(name) != m_entryIndexByName.end();
+    }
+
+    ScriptMethodResult Call(TOwner& owner, String const& name, ScriptArgs const& args) const
+    {
+        auto const found = m_entryIndexByName.find(name);
+        if (found == m_entryIndexByName.end())
+        {
+            return ScriptMethodResult::Error("未知的方法: " + name);
+        }
+
+        sEntry const& entry = m_entries[found->second];
+
+        if (entry.m_argCount >= 0 && args.size() != static_cast<size_t>(entry.m_argCount))
+        {
+            return ScriptTypeExtractor::ValidateArgCount(args, static_cast<size_t>(entry.m_argCount), entry.m_name);
+        }
+
+        if (entry.m_numericInvoker != nullptr && m_isNumericFastPathEnabled)
+        {
+            double numbers[MAX_NUMERIC_ARG_COUNT];
+            size_t argIndex = 0;
+
+            while (argIndex < args.size() && TryGetScriptNumber(args[argIndex], numbers[argIndex]))
+            {
+                ++argIndex;
+            }
+
+            // Numbers that do not convert go through the regular extractors instead
+            double result;
+
+            if (argIndex == args.size() && entry.m_numericInvoker(owner, numbers, result))
+            {
+                return entry.m_resultWrapper(result);
+            }
+        }
+
+        return entry.m_invoker(owner, args);
+    }
+
+    // Index of a method with a numeric fast invoker, or -1. Resolve once and keep it.
+    int FindNumericMethod(String const& name) const
+    {
+        auto const found = m_entryIndexByName.find(name);
+        if (found == m_entryIndexByName.end() || m_entries[found->second].m_numericInvoker == nullptr) return -1;
+        return static_cast<int>(found->second);
+    }
+
+    // Fast entry point: no name lookup, no std::any and no ScriptMethodResult. Returns false (and leaves
+    // outResult untouched) if the index is not a numeric method, the argument count does not match or
+    // an argument does not convert to its parameter type (NaN or out of range).
+    bool CallNumeric(TOwner& owner, int const methodIndex, double const* numbers, int const numberCount, double& outResult) const
+    {
+        if (methodIndex < 0 || methodIndex >= static_cast<int>(m_entries.size())) return false;
+
+        sEntry const& entry = m_entries[methodIndex];
+        if (entry.m_numericInvoker == nullptr || numberCount != entry.m_argCount) return false;
+
+        return entry.m_numericInvoker(owner, numbers, outResult);
+    }
+
+    void SetNumericFastPathEnabled(bool const isEnabled)
+    {
+        m_isNumericFastPathEnabled = isEnabled;
+    }
+
+    bool IsNumericFastPathEnabled() const
+    {
+        return m_isNumericFastPathEnabled;
+    }
+
+    // Replaces the methods of globalThis[objectName], the object ScriptSubsystem registered for owner,
+    // with the generated callbacks. Methods bound through BindWrapper keep ScriptSubsystem's callback.
+    // owner must outlive the isolate. Returns false if the global is not an object.
+    bool InstallFunctions(v8::Isolate* isolate, v8::Local<v8::Context> const context, String const& objectName, TOwner& owner, bool const areFastCallsEnabled = true) const
+    {
+        v8::Isolate::Scope isolateScope(isolate);
+        v8::HandleScope    handleScope(isolate);
+        v8::Context::Scope contextScope(context);
+
+        v8::Local<v8::Value> object;
+
+        if (!context->Global()->Get(context, v8::String::NewFromUtf8(isolate, objectName.c_str()).ToLocalChecked()).ToLocal(&object) || !object->IsObject())
+        {
+            return false;
+        }
+
+        v8::Local<v8::External> const data = v8::External::New(isolate, &owner);
+
+        for (sEntry const& entry : m_entries)
+        {
+            if (entry.m_callback == nullptr) continue;
+
+            v8::CFunction const* const            cFunction        = areFastCallsEnabled ? entry.m_cFunction : nullptr;
+            v8::Local<v8::FunctionTemplate> const functionTemplate = v8::FunctionTemplate::New(isolate, entry.m_callback, data, v8::Local<v8::Signature>(), entry.m_argCount,
+                                                                                               v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect, cFunction);
+            v8::Local<v8::Function> const         function         = functionTemplate->GetFunction(context).ToLocalChecked();
+            v8::Local<v8::String> const           name             = v8::String::NewFromUtf8(isolate, entry.m_name.c_str(), v8::NewStringType::kInternalized).ToLocalChecked();
+
+            function->SetName(name);
+            object.As<v8::Object>()->Set(context, name, function).Check();
+        }
+
+        return true;
+    }
+
+    std::vector<ScriptMethodInfo> GetMethodInfos() const
+    {
+        std::vector<ScriptMethodInfo> methodInfos;
+        methodInfos.reserve(m_entries.size());
+
+        for (sEntry const& entry : m_entries)
+        {
+            methodInfos.emplace_back(entry.m_name, entry.m_description, entry.m_parameterTypes, entry.m_returnType);
+        }
+
+        return methodInfos;
+    }
+
+private:
+    struct sEntry
+    {
+        String               m_name;
+        String               m_description;
+        std::vector<String>  m_parameterTypes;
+        String               m_returnType;
+        int                  m_argCount       = -1;          // -1: wrapper validates its own arguments
+        Invoker              m_invoker        = nullptr;
+        NumericInvoker       m_numericInvoker = nullptr;     // Only for all-numeric signatures
+        ResultWrapper        m_resultWrapper  = nullptr;
+        v8::FunctionCallback m_callback       = nullptr;     // Generated per Bind; none for BindWrapper methods
+        v8::CFunction const* m_cFunction      = nullptr;     // BindFastCall only
+    };
+
+    void AddEntry(String const& name, String const& description, std::vector<String> const& parameterTypes, String const& returnType, int const argCount, Invoker const invoker)
+    {
+        m_entryIndexByName[name] = m_entries.size();
+        m_entries.push_back({name, description, parameterTypes, returnType, argCount, invoker, nullptr, nullptr, nullptr, nullptr});
+    }
+
+    std::vector<sEntry>                m_entries;
+    std::unordered_map<String, size_t> m_entryIndexByName;
+    bool                               m_isNumericFastPathEnabled = true;
+};
@@ -0,0 +1,306 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptModuleCompiler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptModuleCompiler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptCodeCache.hpp"
+#include "Game/Framework/ScriptModuleGraph.hpp"
+#include "Game/Framework/ScriptSystemProfiler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <memory>
+
+//----------------------------------------------------------------------------------------------------
+ScriptModuleCompiler* ScriptModuleCompiler::s_linkingCompiler = nullptr;
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    String ToUtf8(v8::Isolate* isolate, v8::Local<v8::Value> const value)
+    {
+        v8::String::Utf8Value const utf8(isolate, value);
+
+        return *utf8 != nullptr ? String(*utf8, utf8.length()) : String();
+    }
+
+    v8::Local<v8::String> ToV8String(v8::Isolate* isolate, String const& text)
+    {
+        return v8::String::NewFromUtf8(isolate, text.data(), v8::NewStringType::kNormal, static_cast<int>(text.size())).ToLocalChecked();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptModuleCompiler::ScriptModuleCompiler(v8::Isolate*                 isolate,
+                                           v8::Local<v8::Context> const context,
+                                           ScriptCodeCache*             codeCache)
+    : m_isolate(isolate),
+      m_context(isolate, context),
+      m_codeCache(codeCache)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptModuleCompiler::~ScriptModuleCompiler()
+{
+    m_pendingCodeCaches.clear();
+    m_moduleByPath.clear();
+    m_context.Reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Loads the module and everything it imports that is not loaded yet, links it and evaluates it.
+// New code cache entries are only written when the evaluation succeeded.
+//
+bool ScriptModuleCompiler::ExecuteModule(String const& modulePath, sScriptModuleLoadStats* out_stats)
+{
+    double const           startMs      = ScriptSystemProfiler::GetTimeMilliseconds();
+    String const           resolvedPath = ScriptModuleGraph::ResolveImportPath("", modulePath);
+    sScriptModuleLoadStats stats;
+
+    v8::Isolate::Scope           isolateScope(m_isolate);
+    v8::HandleScope              handleScope(m_isolate);
+    v8::Local<v8::Context> const context = m_context.Get(m_isolate);
+    v8::Context::Scope           contextScope(context);
+
+    m_lastError.clear();
+
+    bool isSuccess = LoadModuleTree(resolvedPath, stats);
+
+    if (isSuccess)
+    {
+        double const                evaluateStartMs = ScriptSystemProfiler::GetTimeMilliseconds();
+        v8::Local<v8::Module> const module          = m_moduleByPath[resolvedPath].Get(m_isolate);
+        v8::TryCatch                tryCatch(m_isolate);
+
+        if (module->GetStatus() == v8::Module::kUninstantiated)
+        {
+            s_linkingCompiler = this;
+            isSuccess         = module->InstantiateModule(context, ResolveModule).FromMaybe(false);
+            s_linkingCompiler = nullptr;
+
+            if (!isSuccess) SetErrorFromException(resolvedPath, tryCatch);
+        }
+
+        if (isSuccess && module->GetStatus() == v8::Module::kInstantiated)
+        {
+            v8::Local<v8::Value> result;
+
+            if (!module->Evaluate(context).ToLocal(&result))
+            {
+                SetErrorFromException(resolvedPath, tryCatch);
+                isSuccess = false;
+            }
+            else if (result->IsPromise() && result.As<v8::Promise>()->State() == v8::Promise::kRejected)
+            {
+                m_lastError = StringFormat("{}: {}", resolvedPath, ToUtf8(m_isolate, result.As<v8::Promise>()->Result()));
+                isSuccess   = false;
+            }
+        }
+        else if (isSuccess && module->GetStatus() == v8::Module::kErrored)
+        {
+            m_lastError = StringFormat("{}: {}", resolvedPath, ToUtf8(m_isolate, module->GetException()));
+            isSuccess   = false;
+        }
+
+        stats.m_evaluateMs = ScriptSystemProfiler::GetTimeMilliseconds() - evaluateStartMs;
+    }
+
+    if (isSuccess) StorePendingCodeCaches(stats);
+
+    m_pendingCodeCaches.clear();
+    stats.m_totalMs = ScriptSystemProfiler::GetTimeMilliseconds() - startMs;
+
+    if (out_stats != nullptr) *out_stats = stats;
+
+    if (!isSuccess)
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Error, StringFormat("(ScriptModuleCompiler::ExecuteModule)(fail)({})", m_lastError));
+    }
+
+    return isSuccess;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Entries are only read and written while a cache is attached; nullptr compiles without one.
+//
+void ScriptModuleCompiler::SetCodeCache(ScriptCodeCache* codeCache)
+{
+    m_codeCache = codeCache;
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& ScriptModuleCompiler::GetLastError() const
+{
+    return m_lastError;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Depth-first over the import requests, so InstantiateModule finds every module already compiled.
+// A module is registered before its imports are visited, which terminates import cycles.
+//
+bool ScriptModuleCompiler::LoadModuleTree(String const& modulePath, sScriptModuleLoadStats& stats)
+{
+    if (m_moduleByPath.contains(modulePath)) return true;
+
+    v8::Local<v8::Module> module;
+
+    if (!CompileModule(modulePath, stats).ToLocal(&module)) return false;
+
+    v8::Local<v8::Context> const    context  = m_isolate->GetCurrentContext();
+    v8::Local<v8::FixedArray> const requests = module->GetModuleRequests();
+
+    for (int requestIndex = 0; requestIndex < requests->Length(); ++requestIndex)
+    {
+        v8::Local<v8::ModuleRequest> const request   = requests->Get(context, requestIndex).As<v8::ModuleRequest>();
+        String const                       specifier = ToUtf8(m_isolate, request->GetSpecifier());
+
+        if (!LoadModuleTree(ScriptModuleGraph::ResolveImportPath(modulePath, specifier), stats)) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Consumes the cache entry for the exact source bytes when there is one. Without an accepted entry the
+// unbound script is kept, so a cache can be produced from it once the module has run.
+//
+v8::MaybeLocal<v8::Module> ScriptModuleCompiler::CompileModule(String const& modulePath, sScriptModuleLoadStats& stats)
+{
+    double const startMs = ScriptSystemProfiler::GetTimeMilliseconds();
+    String       source;
+
+    if (!ScriptModuleGraph::ReadSourceFile(modulePath, source))
+    {
+        m_lastError = StringFormat("{}: cannot read module file", modulePath);
+        return {};
+    }
+
+    uint64_t const       sourceHash = ScriptModuleGraph::HashSource(source);
+    std::vector<uint8_t> cacheData;
+    bool const           hasCache   = m_codeCache != nullptr && m_codeCache->LoadCodeCache(sourceHash, cacheData);
+
+    v8::ScriptOrigin const origin(ToV8String(m_isolate, modulePath), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+
+    // Source deletes the CachedData wrapper; the bytes stay owned by cacheData (BufferNotOwned)
+    v8::ScriptCompiler::Source compilerSource(ToV8String(m_isolate, source), origin,
+                                              hasCache ? new v8::ScriptCompiler::CachedData(cacheData.data(), static_cast<int>(cacheData.size())) : nullptr);
+
+    v8::TryCatch          tryCatch(m_isolate);
+    v8::Local<v8::Module> module;
+
+    if (!v8::ScriptCompiler::CompileModule(m_isolate, &compilerSource, hasCache ? v8::ScriptCompiler::kConsumeCodeCache : v8::ScriptCompiler::kNoCompileOptions).ToLocal(&module))
+    {
+        SetErrorFromException(modulePath, tryCatch);
+        return {};
+    }
+
+    ++stats.m_compiledModuleCount;
+
+    if (hasCache && !compilerSource.GetCachedData()->rejected)
+    {
+        ++stats.m_consumedCacheCount;
+    }
+    else
+    {
+        if (hasCache) ++stats.m_rejectedCacheCount;
+
+        if (m_codeCache != nullptr) m_pendingCodeCaches.push_back({sourceHash, v8::Global<v8::UnboundModuleScript>(m_isolate, module->GetUnboundModuleScript())});
+    }
+
+    m_moduleByPath.emplace(modulePath, v8::Global<v8::Module>(m_isolate, module));
+    m_pathByIdentityHash.emplace(module->GetIdentityHash(), modulePath);
+
+    stats.m_compileMs += ScriptSystemProfiler::GetTimeMilliseconds() - startMs;
+
+    return module;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Produced after evaluation, so the entry also holds bytecode for the functions the module ran.
+//
+void ScriptModuleCompiler::StorePendingCodeCaches(sScriptModuleLoadStats& stats)
+{
+    if (m_codeCache == nullptr) return;
+
+    for (sPendingCodeCache const& pending : m_pendingCodeCaches)
+    {
+        std::unique_ptr<v8::ScriptCompiler::CachedData> const cachedData(v8::ScriptCompiler::CreateCodeCache(pending.m_script.Get(m_isolate)));
+
+        if (cachedData == nullptr) continue;
+
+        std::vector<uint8_t> const data(cachedData->data, cachedData->data + cachedData->length);
+
+        if (m_codeCache->StoreCodeCache(pending.m_sourceHash, data)) ++stats.m_producedCacheCount;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+String const* ScriptModuleCompiler::FindModulePath(v8::Local<v8::Module> const module) const
+{
+    auto const [first, last] = m_pathByIdentityHash.equal_range(module->GetIdentityHash());
+
+    for (auto entry = first; entry != last; ++entry)
+    {
+        if (m_moduleByPath.at(entry->second).Get(m_isolate) == module) return &entry->second;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// "<resource>:<line>: <exception>", falling back to the module being processed when V8 has no message.
+//
+void ScriptModuleCompiler::SetErrorFromException(String const& modulePath, v8::TryCatch const& tryCatch)
+{
+    if (!tryCatch.HasCaught())
+    {
+        m_lastError = StringFormat("{}: unknown error", modulePath);
+        return;
+    }
+
+    String const                 exception = ToUtf8(m_isolate, tryCatch.Exception());
+    v8::Local<v8::Message> const message   = tryCatch.Message();
+
+    if (message.IsEmpty())
+    {
+        m_lastError = StringFormat("{}: {}", modulePath, exception);
+        return;
+    }
+
+    m_lastError = StringFormat("{}:{}: {}", ToUtf8(m_isolate, message->GetScriptResourceName()),
+                               message->GetLineNumber(m_isolate->GetCurrentContext()).FromMaybe(0), exception);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC v8::MaybeLocal<v8::Module> ScriptModuleCompiler::ResolveModule(v8::Local<v8::Context> const    context,
+                                                                      v8::Local<v8::String> const     specifier,
+                                                                      v8::Local<v8::FixedArray> const importAttributes,
+                                                                      v8::Local<v8::Module> const     referrer)
+{
+    UNUSED(importAttributes)
+
+    v8::Isolate* const          isolate      = context->GetIsolate();
+    ScriptModuleCompiler* const compiler     = s_linkingCompiler;
+    String const*               referrerPath = compiler != nullptr ? compiler->FindModulePath(referrer) : nullptr;
+
+    if (referrerPath == nullptr)
+    {
+        isolate->ThrowException(v8::Exception::Error(ToV8String(isolate, "(ScriptModuleCompiler::ResolveModule)(unknown referrer)")));
+        return {};
+    }
+
+    String const resolvedPath = ScriptModuleGraph::ResolveImportPath(*referrerPath, ToUtf8(isolate, specifier));
+    auto const   found        = compiler->m_moduleByPath.find(resolvedPath);
+
+    if (found == compiler->m_moduleByPath.end())
+    {
+        isolate->ThrowException(v8::Exception::Error(ToV8String(isolate, StringFormat("(ScriptModuleCompiler::ResolveModule)(not loaded)({})", resolvedPath))));
+        return {};
+    }
+
+    return found->second.Get(isolate);
+}
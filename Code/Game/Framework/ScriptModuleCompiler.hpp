@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptModuleCompiler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <v8.h>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ScriptCodeCache;
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptModuleLoadStats
+{
+    int    m_compiledModuleCount = 0;
+    int    m_consumedCacheCount  = 0;     // Compiled from an accepted code cache
+    int    m_rejectedCacheCount  = 0;     // Cache entry found but refused by V8 (other V8 build or flags)
+    int    m_producedCacheCount  = 0;     // Entries written after evaluation
+    double m_compileMs           = 0.0;   // Read + compile of every newly loaded module
+    double m_evaluateMs          = 0.0;   // Instantiate + evaluate of the requested module
+    double m_totalMs             = 0.0;   // Includes producing and storing new cache entries
+};
+
+//----------------------------------------------------------------------------------------------------
+// Compiles, links and evaluates ES module files directly through V8, consuming and producing code
+// caches from a ScriptCodeCache.
+//
+// Every module reached from a requested file is compiled once and kept by path, so later requests (hot
+// reload copies) link against the instances already evaluated, exactly like the engine module loader.
+// A module compiled without an accepted cache gets one produced after the first evaluation, which
+// also covers the functions that ran during it. Only relative static imports are resolved, which is
+// all ScriptModuleGraph follows as well.
+//
+// Owns V8 handles: must be destroyed while the isolate is still alive.
+//
+class ScriptModuleCompiler
+{
+public:
+    ScriptModuleCompiler(v8::Isolate* isolate, v8::Local<v8::Context> context, ScriptCodeCache* codeCache);
+    ~ScriptModuleCompiler();
+
+    bool ExecuteModule(String const& modulePath, sScriptModuleLoadStats* out_stats = nullptr);
+
+    void          SetCodeCache(ScriptCodeCache* codeCache);
+    String const& GetLastError() const;
+
+private:
+    struct sPendingCodeCache
+    {
+        uint64_t                            m_sourceHash = 0;
+        v8::Global<v8::UnboundModuleScript> m_script;
+    };
+
+    bool                       LoadModuleTree(String const& modulePath, sScriptModuleLoadStats& stats);
+    v8::MaybeLocal<v8::Module> CompileModule(String const& modulePath, sScriptModuleLoadStats& stats);
+    void                       StorePendingCodeCaches(sScriptModuleLoadStats& stats);
+    String const*              FindModulePath(v8::Local<v8::Module> module) const;
+    void                       SetErrorFromException(String const& modulePath, v8::TryCatch const& tryCatch);
+
+    static v8::MaybeLocal<v8::Module> ResolveModule(v8::Local<v8::Context>    context,
+                                                    v8::Local<v8::String>     specifier,
+                                                    v8::Local<v8::FixedArray> importAttributes,
+                                                    v8::Local<v8::Module>     referrer);
+
+    v8::Isolate*                                       m_isolate   = nullptr;
+    v8::Global<v8::Context>                            m_context;
+    ScriptCodeCache*                                   m_codeCache = nullptr;
+    std::unordered_map<String, v8::Global<v8::Module>> m_moduleByPath;
+    std::unordered_multimap<int, String>               m_pathByIdentityHash;   // Resolve callbacks only get the referrer module
+    std::vector<sPendingCodeCache>                     m_pendingCodeCaches;
+    String                                             m_lastError;
+
+    static ScriptModuleCompiler* s_linkingCompiler;   // Set while InstantiateModule runs ResolveModule
+};
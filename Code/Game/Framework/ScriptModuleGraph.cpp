@@ -0,0 +1,213 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptModuleGraph.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptModuleGraph.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <regex>
+#include <sstream>
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptModuleGraph::Build(String const& entryModulePath)
+{
+    m_modules.clear();
+    m_moduleIndexByPath.clear();
+
+    AddModule(ResolveImportPath("", entryModulePath));
+
+    return !m_modules.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sScriptModuleNode> const& ScriptModuleGraph::GetModules() const
+{
+    return m_modules;
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptModuleNode const* ScriptModuleGraph::FindModule(String const& modulePath) const
+{
+    auto const found = m_moduleIndexByPath.find(modulePath);
+
+    return found != m_moduleIndexByPath.end() ? &m_modules[found->second] : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<String> ScriptModuleGraph::GetImporters(String const& modulePath) const
+{
+    std::vector<String> importers;
+
+    for (sScriptModuleNode const& node : m_modules)
+    {
+        if (std::find(node.m_imports.begin(), node.m_imports.end(), modulePath) != node.m_imports.end())
+        {
+            importers.push_back(node.m_path);
+        }
+    }
+
+    return importers;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Re-reads an edited module. Returns false when the file is unreadable or its bytes hash the same as
+// before; otherwise updates the hash and imports, adding any newly imported modules to the graph.
+//
+bool ScriptModuleGraph::RefreshModule(String const& modulePath, String& out_source)
+{
+    auto const found = m_moduleIndexByPath.find(modulePath);
+
+    if (found == m_moduleIndexByPath.end()) return false;
+    if (!ReadSourceFile(modulePath, out_source)) return false;
+
+    int const      moduleIndex = found->second;
+    uint64_t const sourceHash  = HashSource(out_source);
+
+    if (m_modules[moduleIndex].m_sourceHash == sourceHash) return false;
+
+    sScriptModuleNode node;
+    node.m_path       = modulePath;
+    node.m_sourceHash = sourceHash;
+    ParseImports(modulePath, out_source, node);
+
+    std::vector<String> const imports = node.m_imports;
+    m_modules[moduleIndex]            = node;
+
+    for (String const& importPath : imports)
+    {
+        AddModule(importPath);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool ScriptModuleGraph::ReadSourceFile(String const& path, String& out_source)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open()) return false;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    out_source = buffer.str();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 64-bit FNV-1a over the raw source bytes.
+//
+STATIC uint64_t ScriptModuleGraph::HashSource(String const& source)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (char const character : source)
+    {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Resolves a relative specifier against the importer's directory and collapses "." / ".." segments.
+//
+STATIC String ScriptModuleGraph::ResolveImportPath(String const& importerPath, String const& specifier)
+{
+    String combined = specifier;
+
+    if (!importerPath.empty() && (specifier.rfind("./", 0) == 0 || specifier.rfind("../", 0) == 0))
+    {
+        size_t const lastSlash = importerPath.find_last_of("/\\");
+        combined               = (lastSlash == String::npos) ? specifier : importerPath.substr(0, lastSlash + 1) + specifier;
+    }
+
+    std::vector<String> segments;
+    std::stringstream   stream(combined);
+    String              segment;
+
+    while (std::getline(stream, segment, '/'))
+    {
+        if (segment.empty() || segment == ".") continue;
+
+        if (segment == ".." && !segments.empty() && segments.back() != "..")
+        {
+            segments.pop_back();
+            continue;
+        }
+
+        segments.push_back(segment);
+    }
+
+    String resolved;
+
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        if (i > 0) resolved += "/";
+        resolved += segments[i];
+    }
+
+    return resolved;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptModuleGraph::AddModule(String const& modulePath)
+{
+    if (m_moduleIndexByPath.contains(modulePath)) return;
+
+    String source;
+
+    if (!ReadSourceFile(modulePath, source))
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, StringFormat("(ScriptModuleGraph::AddModule)(failed to read)({})", modulePath));
+        return;
+    }
+
+    int const moduleIndex           = static_cast<int>(m_modules.size());
+    m_moduleIndexByPath[modulePath] = moduleIndex;
+
+    sScriptModuleNode node;
+    node.m_path       = modulePath;
+    node.m_sourceHash = HashSource(source);
+    ParseImports(modulePath, source, node);
+
+    std::vector<String> const imports = node.m_imports;
+    m_modules.push_back(node);
+
+    for (String const& importPath : imports)
+    {
+        AddModule(importPath);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptModuleGraph::ParseImports(String const& modulePath, String const& source, sScriptModuleNode& out_node) const
+{
+    // Matches `import ... from './x.mjs'`, `export ... from './x.mjs'` and `import './x.mjs'`
+    static std::regex const importPattern(R"((?:^|[\s}])(?:from|import)\s*['"](\.\.?/[^'"]+)['"])");
+
+    std::stringstream lines(source);
+    String            line;
+
+    while (std::getline(lines, line))
+    {
+        size_t const firstCharacter = line.find_first_not_of(" \t");
+
+        if (firstCharacter == String::npos) continue;
+        if (line.compare(firstCharacter, 2, "//") == 0 || line[firstCharacter] == '*') continue;
+
+        for (std::sregex_iterator match(line.begin(), line.end(), importPattern); match != std::sregex_iterator(); ++match)
+        {
+            String const specifier = (*match)[1].str();
+            out_node.m_imports.push_back(ResolveImportPath(modulePath, specifier));
+            out_node.m_importSpecifiers.push_back(specifier);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptModuleGraph.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptModuleNode
+{
+    String              m_path;
+    uint64_t            m_sourceHash = 0;
+    std::vector<String> m_imports;            // Resolved paths
+    std::vector<String> m_importSpecifiers;   // As written in the source, parallel to m_imports
+};
+
+//----------------------------------------------------------------------------------------------------
+// Static import graph of an ES module entry point (e.g. Data/Scripts/main.mjs).
+// Only relative static imports ('./x.mjs', '../x.mjs') are followed; dynamic import() is ignored.
+// RefreshModule re-reads one module after an edit; GetImporters walks the edges in reverse.
+//
+class ScriptModuleGraph
+{
+public:
+    bool Build(String const& entryModulePath);
+
+    std::vector<sScriptModuleNode> const& GetModules() const;
+    sScriptModuleNode const*              FindModule(String const& modulePath) const;
+    std::vector<String>                   GetImporters(String const& modulePath) const;
+    bool                                  RefreshModule(String const& modulePath, String& out_source);
+
+    static bool     ReadSourceFile(String const& path, String& out_source);
+    static uint64_t HashSource(String const& source);
+    static String   ResolveImportPath(String const& importerPath, String const& specifier);
+
+private:
+    void AddModule(String const& modulePath);
+    void ParseImports(String const& modulePath, String const& source, sScriptModuleNode& out_node) const;
+
+    std::vector<sScriptModuleNode>  m_modules;
+    std::unordered_map<String, int> m_moduleIndexByPath;
+};
@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptSharedBuffer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptSharedBuffer.hpp"
+
+#include <memory>
+
+//----------------------------------------------------------------------------------------------------
+ScriptSharedBuffer::ScriptSharedBuffer(v8::Isolate*                 isolate,
+                                       v8::Local<v8::Context> const context,
+                                       String const&                globalName)
+    : m_isolate(isolate),
+      m_context(isolate, context),
+      m_globalName(globalName)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptSharedBuffer::~ScriptSharedBuffer()
+{
+    Revoke();
+    m_context.Reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+// No-op while the block is unchanged, so callers can publish after every operation that may grow it.
+//
+void ScriptSharedBuffer::Publish(void* data, size_t const byteLength)
+{
+    if (!m_arrayBuffer.IsEmpty() && data == m_data && byteLength == m_byteLength) return;
+
+    v8::Isolate::Scope           isolateScope(m_isolate);
+    v8::HandleScope              handleScope(m_isolate);
+    v8::Local<v8::Context> const context = m_context.Get(m_isolate);
+    v8::Context::Scope           contextScope(context);
+
+    DetachArrayBuffer();
+
+    // The empty deleter leaves the bytes alone when V8 collects the ArrayBuffer: C++ frees them
+    std::unique_ptr<v8::BackingStore> backingStore = v8::ArrayBuffer::NewBackingStore(data, byteLength, v8::BackingStore::EmptyDeleter, nullptr);
+    v8::Local<v8::ArrayBuffer> const  arrayBuffer  = v8::ArrayBuffer::New(m_isolate, std::move(backingStore));
+    v8::Local<v8::String> const       name         = v8::String::NewFromUtf8(m_isolate, m_globalName.c_str()).ToLocalChecked();
+
+    context->Global()->Set(context, name, arrayBuffer).Check();
+
+    m_arrayBuffer.Reset(m_isolate, arrayBuffer);
+    m_data       = data;
+    m_byteLength = byteLength;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Detaches the current ArrayBuffer and removes the global; call before freeing the block for good.
+//
+void ScriptSharedBuffer::Revoke()
+{
+    if (m_arrayBuffer.IsEmpty()) return;
+
+    v8::Isolate::Scope           isolateScope(m_isolate);
+    v8::HandleScope              handleScope(m_isolate);
+    v8::Local<v8::Context> const context = m_context.Get(m_isolate);
+    v8::Context::Scope           contextScope(context);
+
+    DetachArrayBuffer();
+
+    context->Global()->Delete(context, v8::String::NewFromUtf8(m_isolate, m_globalName.c_str()).ToLocalChecked()).Check();
+
+    m_data       = nullptr;
+    m_byteLength = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptSharedBuffer::DetachArrayBuffer()
+{
+    if (m_arrayBuffer.IsEmpty()) return;
+
+    v8::Local<v8::ArrayBuffer> const arrayBuffer = m_arrayBuffer.Get(m_isolate);
+
+    if (arrayBuffer->IsDetachable()) arrayBuffer->Detach(v8::Local<v8::Value>()).Check();
+
+    m_arrayBuffer.Reset();
+}
@@ -0,0 +1,41 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptSharedBuffer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <v8.h>
+
+//----------------------------------------------------------------------------------------------------
+// Publishes a block of C++-owned memory to scripts as globalThis[<name>], an ArrayBuffer over the same
+// bytes: scripts read and write it through typed arrays, with nothing copied or converted on either
+// side.
+//
+// The memory stays owned by C++. Publish again whenever the block moves or changes size; the previous
+// ArrayBuffer is detached first, so typed arrays over it become empty instead of pointing at freed
+// memory. Scripts notice by comparing globalThis[<name>] with the buffer their views were built on.
+//
+// Owns V8 handles: must be destroyed while the isolate is still alive.
+//
+class ScriptSharedBuffer
+{
+public:
+    ScriptSharedBuffer(v8::Isolate* isolate, v8::Local<v8::Context> context, String const& globalName);
+    ~ScriptSharedBuffer();
+
+    void Publish(void* data, size_t byteLength);
+    void Revoke();
+
+private:
+    void DetachArrayBuffer();
+
+    v8::Isolate*                m_isolate    = nullptr;
+    v8::Global<v8::Context>     m_context;
+    v8::Global<v8::ArrayBuffer> m_arrayBuffer;
+    String                      m_globalName;
+    void*                       m_data       = nullptr;
+    size_t                      m_byteLength = 0;
+};
@@ -0,0 +1,238 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptSystemProfiler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptSystemProfiler.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Game.hpp"
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+//----------------------------------------------------------------------------------------------------
+void TimingHistory::AddSample(float const milliseconds)
+{
+    m_samples[m_nextIndex] = milliseconds;
+    m_nextIndex            = (m_nextIndex + 1) % WINDOW_SIZE;
+    m_sampleCount          = std::min(m_sampleCount + 1, WINDOW_SIZE);
+}
+
+//----------------------------------------------------------------------------------------------------
+int TimingHistory::GetSampleCount() const
+{
+    return m_sampleCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+float TimingHistory::GetAverage() const
+{
+    if (m_sampleCount == 0) return 0.f;
+
+    float total = 0.f;
+
+    for (int i = 0; i < m_sampleCount; ++i)
+    {
+        total += m_samples[i];
+    }
+
+    return total / static_cast<float>(m_sampleCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+float TimingHistory::GetMax() const
+{
+    if (m_sampleCount == 0) return 0.f;
+
+    return *std::max_element(m_samples, m_samples + m_sampleCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Nearest-rank percentile over the current window.
+//
+float TimingHistory::GetPercentile(float const fraction) const
+{
+    if (m_sampleCount == 0) return 0.f;
+
+    float sorted[WINDOW_SIZE];
+    std::copy(m_samples, m_samples + m_sampleCount, sorted);
+
+    int const rank = std::clamp(static_cast<int>(fraction * static_cast<float>(m_sampleCount) + 0.999f) - 1, 0, m_sampleCount - 1);
+    std::nth_element(sorted, sorted + rank, sorted + m_sampleCount);
+
+    return sorted[rank];
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void ScriptSystemProfiler::SubscribeEventCallbacks()
+{
+    g_eventSystem->SubscribeEventCallbackFunction("ScriptProfilerHud", OnToggleHud);
+    g_eventSystem->SubscribeEventCallbackFunction("ScriptProfilerDump", OnDumpCsv);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool ScriptSystemProfiler::OnToggleHud(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_game == nullptr) return false;
+
+    ScriptSystemProfiler& profiler = g_game->GetScriptSystemProfiler();
+    profiler.SetHudVisible(!profiler.IsHudVisible());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Writes Data/Logs/ScriptSystemTimings_<n>.csv, or the path given as "file=".
+//
+STATIC bool ScriptSystemProfiler::OnDumpCsv(EventArgs& args)
+{
+    if (g_game == nullptr) return false;
+
+    static int s_dumpIndex = 0;
+
+    String const defaultPath = StringFormat("Data/Logs/ScriptSystemTimings_{}.csv", s_dumpIndex++);
+    String const filePath    = args.GetValue("file", defaultPath);
+    bool const   success     = g_game->GetScriptSystemProfiler().WriteCsv(filePath);
+
+    if (g_devConsole)
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, StringFormat("(ScriptProfilerDump)({})({})", success ? "written" : "failed", filePath));
+    }
+
+    return success;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC double ScriptSystemProfiler::GetTimeMilliseconds()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces the script-side timings with a published snapshot. Malformed lines are skipped.
+//
+bool ScriptSystemProfiler::ParseSnapshot(String const& snapshot)
+{
+    std::istringstream lines(snapshot);
+    String             line;
+
+    m_scriptTimings.clear();
+
+    while (std::getline(lines, line))
+    {
+        std::istringstream  fields(line);
+        sScriptSystemTiming timing;
+        String              number;
+
+        if (!std::getline(fields, timing.m_phase, ',') || !std::getline(fields, timing.m_systemId, ',')) continue;
+
+        try
+        {
+            std::getline(fields, number, ',');
+            timing.m_averageMs = std::stof(number);
+            std::getline(fields, number, ',');
+            timing.m_maxMs = std::stof(number);
+            std::getline(fields, number, ',');
+            timing.m_p99Ms = std::stof(number);
+            std::getline(fields, number, ',');
+            timing.m_sampleCount = std::stoi(number);
+
+            // Optional: scheduler deferral count (absent in older snapshots)
+            if (std::getline(fields, number, ',') && !number.empty()) timing.m_deferredCount = std::stoi(number);
+        }
+        catch (std::exception const&)
+        {
+            continue;
+        }
+
+        m_scriptTimings.push_back(timing);
+    }
+
+    return !m_scriptTimings.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptSystemProfiler::RecordFrameCall(String const& frameCallName,
+                                           float const   milliseconds)
+{
+    for (sFrameCallHistory& frameCall : m_frameCallHistories)
+    {
+        if (frameCall.m_name == frameCallName)
+        {
+            frameCall.m_history.AddSample(milliseconds);
+            return;
+        }
+    }
+
+    m_frameCallHistories.push_back({frameCallName, {}});
+    m_frameCallHistories.back().m_history.AddSample(milliseconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+// C++ frame call rows first, then the script systems in the order JSEngine published them.
+//
+std::vector<sScriptSystemTiming> ScriptSystemProfiler::GetTimings() const
+{
+    std::vector<sScriptSystemTiming> timings;
+    timings.reserve(m_frameCallHistories.size() + m_scriptTimings.size());
+
+    for (sFrameCallHistory const& frameCall : m_frameCallHistories)
+    {
+        TimingHistory const& history = frameCall.m_history;
+        timings.push_back({"frame", frameCall.m_name, history.GetAverage(), history.GetMax(), history.GetPercentile(0.99f), history.GetSampleCount()});
+    }
+
+    timings.insert(timings.end(), m_scriptTimings.begin(), m_scriptTimings.end());
+
+    return timings;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptSystemProfiler::WriteCsv(String const& filePath) const
+{
+    std::filesystem::path const path(filePath);
+
+    if (path.has_parent_path())
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(path.parent_path(), errorCode);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Warning, StringFormat("(ScriptSystemProfiler::WriteCsv)(cannot open {})", filePath));
+        return false;
+    }
+
+    file << "phase,systemId,avgMs,maxMs,p99Ms,samples,deferred\n";
+
+    for (sScriptSystemTiming const& timing : GetTimings())
+    {
+        file << StringFormat("{},{},{:.4f},{:.4f},{:.4f},{},{}\n", timing.m_phase, timing.m_systemId, timing.m_averageMs, timing.m_maxMs, timing.m_p99Ms, timing.m_sampleCount, timing.m_deferredCount);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptSystemProfiler::SetHudVisible(bool const isVisible)
+{
+    m_isHudVisible = isVisible;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptSystemProfiler::IsHudVisible() const
+{
+    return m_isHudVisible;
+}
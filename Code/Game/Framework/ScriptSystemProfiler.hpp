@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptSystemProfiler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptSystemTiming
+{
+    String m_phase;             // "update", "render" or "frame" (C++ side of the bridge)
+    String m_systemId;
+    float  m_averageMs     = 0.f;
+    float  m_maxMs         = 0.f;
+    float  m_p99Ms         = 0.f;
+    int    m_sampleCount   = 0;
+    int    m_deferredCount = 0; // Frames JSEngine's scheduler pushed this system past its due frame
+};
+
+//----------------------------------------------------------------------------------------------------
+// Fixed-size window of frame timings with average, max and percentile queries.
+//
+class TimingHistory
+{
+public:
+    static int constexpr WINDOW_SIZE = 120;
+
+    void  AddSample(float milliseconds);
+    int   GetSampleCount() const;
+    float GetAverage() const;
+    float GetMax() const;
+    float GetPercentile(float fraction) const;
+
+private:
+    float m_samples[WINDOW_SIZE] = {};
+    int   m_nextIndex            = 0;
+    int   m_sampleCount          = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Per-system timings of JSEngine's update/render loops plus the C++ cost of each frame call.
+//
+// JSEngine (core/SystemProfiler.mjs) times every system with game.getHighResolutionMs() and publishes
+// a CSV snapshot ("phase,systemId,avgMs,maxMs,p99Ms,samples[,deferred]" per line) through game.publishSystemTimings
+// every few frames. Game records the total jsFrameUpdate/jsFrameRender call times here directly.
+// DevConsole: "ScriptProfilerHud" toggles the on-screen table, "ScriptProfilerDump" writes a CSV.
+//
+class ScriptSystemProfiler
+{
+public:
+    static void   SubscribeEventCallbacks();
+    static bool   OnToggleHud(EventArgs& args);
+    static bool   OnDumpCsv(EventArgs& args);
+    static double GetTimeMilliseconds();
+
+    bool ParseSnapshot(String const& snapshot);
+    void RecordFrameCall(String const& frameCallName, float milliseconds);
+
+    std::vector<sScriptSystemTiming> GetTimings() const;
+    bool                             WriteCsv(String const& filePath) const;
+
+    void SetHudVisible(bool isVisible);
+    bool IsHudVisible() const;
+
+private:
+    struct sFrameCallHistory
+    {
+        String        m_name;
+        TimingHistory m_history;
+    };
+
+    std::vector<sScriptSystemTiming> m_scriptTimings;
+    std::vector<sFrameCallHistory>   m_frameCallHistories;
+    bool                             m_isHudVisible = false;
+};
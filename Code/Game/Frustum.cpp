@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------------------------------
+// Frustum.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Frustum.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    sFrustumPlane MakePlane(Vec3 const& normal, Vec3 const& pointOnPlane)
+    {
+        sFrustumPlane plane;
+        plane.m_normal   = normal.GetNormalized();
+        plane.m_distance = DotProduct3D(plane.m_normal, pointOnPlane);
+
+        return plane;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// fovDegrees is the vertical field of view, as passed to Camera::SetPerspectiveGraphicView.
+//
+STATIC sFrustum sFrustum::CreatePerspective(Vec3 const&        position,
+                                            EulerAngles const& orientation,
+                                            float const        aspect,
+                                            float const        fovDegrees,
+                                            float const        nearDistance,
+                                            float const        farDistance)
+{
+    Vec3 forward;
+    Vec3 left;
+    Vec3 up;
+    orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+
+    float const halfHeight = SinDegrees(fovDegrees * 0.5f) / CosDegrees(fovDegrees * 0.5f);
+    float const halfWidth  = halfHeight * aspect;
+
+    sFrustum frustum;
+    frustum.m_planes[0] = MakePlane(forward, position + forward * nearDistance);
+    frustum.m_planes[1] = MakePlane(-forward, position + forward * farDistance);
+    frustum.m_planes[2] = MakePlane(forward * halfWidth - left, position);
+    frustum.m_planes[3] = MakePlane(forward * halfWidth + left, position);
+    frustum.m_planes[4] = MakePlane(forward * halfHeight - up, position);
+    frustum.m_planes[5] = MakePlane(forward * halfHeight + up, position);
+
+    return frustum;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Per plane, the box corner farthest along the normal decides OUTSIDE and the nearest one decides
+// whether the box is fully inside that plane.
+//
+eFrustumTest sFrustum::TestAABB(AABB3 const& bounds, uint8_t& inout_planeMask) const
+{
+    eFrustumTest result = eFrustumTest::INSIDE;
+
+    for (int planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex)
+    {
+        uint8_t const planeBit = static_cast<uint8_t>(1 << planeIndex);
+        if ((inout_planeMask & planeBit) == 0) continue;
+
+        sFrustumPlane const& plane = m_planes[planeIndex];
+
+        Vec3 const farCorner(plane.m_normal.x >= 0.f ? bounds.m_maxs.x : bounds.m_mins.x,
+                             plane.m_normal.y >= 0.f ? bounds.m_maxs.y : bounds.m_mins.y,
+                             plane.m_normal.z >= 0.f ? bounds.m_maxs.z : bounds.m_mins.z);
+
+        if (DotProduct3D(plane.m_normal, farCorner) < plane.m_distance) return eFrustumTest::OUTSIDE;
+
+        Vec3 const nearCorner(plane.m_normal.x >= 0.f ? bounds.m_mins.x : bounds.m_maxs.x,
+                              plane.m_normal.y >= 0.f ? bounds.m_mins.y : bounds.m_maxs.y,
+                              plane.m_normal.z >= 0.f ? bounds.m_mins.z : bounds.m_maxs.z);
+
+        if (DotProduct3D(plane.m_normal, nearCorner) >= plane.m_distance)
+        {
+            inout_planeMask = static_cast<uint8_t>(inout_planeMask & ~planeBit);
+        }
+        else
+        {
+            result = eFrustumTest::INTERSECTING;
+        }
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Conservative: boxes near a frustum corner may pass although they are outside.
+//
+bool sFrustum::IsOverlappingAABB(AABB3 const& bounds) const
+{
+    uint8_t planeMask = ALL_PLANES;
+
+    return TestAABB(bounds, planeMask) != eFrustumTest::OUTSIDE;
+}
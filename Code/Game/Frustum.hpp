@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------------------------------
+// Frustum.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+// Points p with DotProduct3D(m_normal, p) >= m_distance are on the inner side.
+//
+struct sFrustumPlane
+{
+    Vec3  m_normal;
+    float m_distance = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eFrustumTest : uint8_t
+{
+    OUTSIDE,
+    INTERSECTING,
+    INSIDE
+};
+
+//----------------------------------------------------------------------------------------------------
+// Six inward-facing planes of a perspective view volume in world space, in the engine's X-forward,
+// Y-left, Z-up convention.
+//
+// TestAABB takes a plane mask so hierarchical culling can skip planes a parent box was already fully
+// inside of: it clears the bits of planes the box is inside, and a result of INSIDE means the box
+// (and everything within it) needs no further tests.
+//
+struct sFrustum
+{
+    static int constexpr PLANE_COUNT    = 6;
+    static uint8_t constexpr ALL_PLANES = 0x3F;
+
+    sFrustumPlane m_planes[PLANE_COUNT];
+
+    static sFrustum CreatePerspective(Vec3 const& position, EulerAngles const& orientation, float aspect, float fovDegrees, float nearDistance, float farDistance);
+
+    eFrustumTest TestAABB(AABB3 const& bounds, uint8_t& inout_planeMask) const;
+    bool         IsOverlappingAABB(AABB3 const& bounds) const;
+};
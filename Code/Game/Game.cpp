@@ -1,4 +1,4 @@
-//----------------------------------------------------------------------------------------------------
+﻿//----------------------------------------------------------------------------------------------------
 // Game.cpp
 //----------------------------------------------------------------------------------------------------
 
@@ -14,6 +14,7 @@
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/LogSubsystem.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
@@ -28,12 +29,28 @@
 #include "Game/Prop.hpp"
 #include "Game/Framework/App.hpp"
 #include "Game/Framework/GameCommon.hpp"
-
+#include "Game/Framework/ScriptCodeCache.hpp"
+#include "Game/Framework/ScriptFunctionHandle.hpp"
+#include "Game/Framework/ScriptHotReloader.hpp"
+#include "Game/Framework/ScriptModuleCompiler.hpp"
+#include "Game/Framework/ScriptModuleGraph.hpp"
+#include "Game/Framework/ScriptSharedBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 
 #include "Engine/Audio/AudioSystem.hpp"
 
+//----------------------------------------------------------------------------------------------------
+String const JS_MAIN_MODULE_PATH     = "Data/Scripts/main.mjs";
+String const JS_CODE_CACHE_DIRECTORY = "Data/Cache/Scripts";
+String const JS_HOT_SWAP_DIRECTORY   = "Data/Scripts/components/";   // Modules that re-instantiate their own systems
+
+int constexpr ENTITY_COMMAND_RECORD_MIN_CAPACITY = 1024;    // Commands the record block holds before scripts ask for more
+int constexpr SPATIAL_QUERY_RECORD_MIN_CAPACITY  = 256;     // Queries the record block holds before scripts ask for more
+
 //----------------------------------------------------------------------------------------------------
 Game::Game()
 {
@@ -41,6 +58,14 @@ Game::Game()
 
     SpawnPlayer();
     InitPlayer();
+
+    m_attractModeShader = m_resourceHandles.ResolveShader("Data/Shaders/Default");
+
+    m_propRenderBackend = new RendererPropRenderBackend(m_resourceHandles);
+    m_propStore.SetRenderBackend(m_propRenderBackend);
+    m_propStore.SetParallelForWorkers(g_parallelForWorkers, PARALLEL_FOR_WORKER_COUNT + 1);
+    m_propHierarchy.SetParallelForWorkers(g_parallelForWorkers, PARALLEL_FOR_WORKER_COUNT + 1);
+
     SpawnProps();
     InitProps();
 
@@ -77,8 +102,11 @@ Game::~Game()
 {
     DAEMON_LOG(LogGame, eLogVerbosity::Log, "(Game::~Game)(start)");
 
-    m_props.clear();
+    m_propStore.Clear();
+    m_propStore.SetRenderBackend(nullptr);
 
+    GAME_SAFE_RELEASE(m_propRenderBackend);
+    ShutdownJavaScriptFramework();
     GAME_SAFE_RELEASE(m_gameClock);
 
     GAME_SAFE_RELEASE(m_player);
@@ -100,9 +128,16 @@ void Game::UpdateJS()
     // Update JavaScript framework - this will call the actual C++ Update(float,float)
     if (g_scriptSubsystem && g_scriptSubsystem->IsInitialized())
     {
-        float const gameDeltaSeconds   = static_cast<float>(m_gameClock->GetDeltaSeconds());
-        float const systemDeltaSeconds = static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds());
-        ExecuteJavaScriptCommand(StringFormat("globalThis.JSEngine.update({}, {});", std::to_string(gameDeltaSeconds), std::to_string(systemDeltaSeconds)));
+        // Between frames, so swapped systems and a re-created root see a complete frame
+        if (m_scriptHotReloader != nullptr) m_scriptHotReloader->Update();
+
+        m_frameGameDeltaSeconds   = static_cast<float>(m_gameClock->GetDeltaSeconds());
+        m_frameSystemDeltaSeconds = static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds());
+        double const frameDeltaSeconds[] = {m_frameGameDeltaSeconds, m_frameSystemDeltaSeconds};
+        double const frameCallStartMs    = ScriptSystemProfiler::GetTimeMilliseconds();
+        CallJavaScriptFrameFunction(m_jsEngineUpdateFunction, frameDeltaSeconds, 2);
+        m_scriptSystemProfiler.RecordFrameCall("jsFrameUpdate", static_cast<float>(ScriptSystemProfiler::GetTimeMilliseconds() - frameCallStartMs));
+        ApplyPropTransformBuffer();
     }
     // else
     // {
@@ -123,7 +158,10 @@ void Game::RenderJS()
     // Render JavaScript framework - this will call the actual C++ Render(float,float)
     if (g_scriptSubsystem && g_scriptSubsystem->IsInitialized())
     {
-        ExecuteJavaScriptCommand(StringFormat("globalThis.JSEngine.render();"));
+        double const frameCallStartMs = ScriptSystemProfiler::GetTimeMilliseconds();
+        CallJavaScriptFrameFunction(m_jsEngineRenderFunction, nullptr, 0);
+        m_scriptSystemProfiler.RecordFrameCall("jsFrameRender", static_cast<float>(ScriptSystemProfiler::GetTimeMilliseconds() - frameCallStartMs));
+        ApplyPropTransformBuffer();
     }
     // else
     // {
@@ -576,37 +614,85 @@ void Game::UpdateFromController()
 }
 
 //----------------------------------------------------------------------------------------------------
-void Game::UpdateEntities(float const gameDeltaSeconds, float const systemDeltaSeconds) const
+void Game::UpdateEntities(float const gameDeltaSeconds, float const systemDeltaSeconds)
 {
     if (m_player)
     {
         m_player->Update(systemDeltaSeconds);
     }
 
-    for (Prop* prop : m_props)
+    m_propStore.Update(gameDeltaSeconds);
+
+    // Scripts may destroy the scene props, and destroys move other props into their indices, so resolve
+    // each one by handle every frame and skip it once it is gone.
+    if (int const spinningCube = m_propStore.GetIndex(m_scenePropHandles[0]); spinningCube >= 0)
     {
-        if (prop)
-        {
-            prop->Update(gameDeltaSeconds);
-        }
+        EulerAngles orientation = m_propStore.GetOrientations()[spinningCube];
+        orientation.m_pitchDegrees += 30.f * gameDeltaSeconds;
+        orientation.m_rollDegrees += 30.f * gameDeltaSeconds;
+
+        m_propStore.SetOrientation(spinningCube, orientation);
     }
 
-    m_props[0]->m_orientation.m_pitchDegrees += 30.f * gameDeltaSeconds;
-    m_props[0]->m_orientation.m_rollDegrees += 30.f * gameDeltaSeconds;
+    if (int const pulsingCube = m_propStore.GetIndex(m_scenePropHandles[1]); pulsingCube >= 0)
+    {
+        float const time       = static_cast<float>(m_gameClock->GetTotalSeconds());
+        float const colorValue = (sinf(time) + 1.0f) * 0.5f * 255.0f;
 
-    float const time       = static_cast<float>(m_gameClock->GetTotalSeconds());
-    float const colorValue = (sinf(time) + 1.0f) * 0.5f * 255.0f;
+        Rgba8 color = m_propStore.GetColors()[pulsingCube];
+        color.r     = static_cast<unsigned char>(colorValue);
+        color.g     = static_cast<unsigned char>(colorValue);
+        color.b     = static_cast<unsigned char>(colorValue);
+
+        m_propStore.SetColor(pulsingCube, color);
+    }
 
-    m_props[1]->m_color.r = static_cast<unsigned char>(colorValue);
-    m_props[1]->m_color.g = static_cast<unsigned char>(colorValue);
-    m_props[1]->m_color.b = static_cast<unsigned char>(colorValue);
+    if (int const sphere = m_propStore.GetIndex(m_scenePropHandles[2]); sphere >= 0)
+    {
+        EulerAngles orientation = m_propStore.GetOrientations()[sphere];
+        orientation.m_yawDegrees += 45.f * gameDeltaSeconds;
 
-    m_props[2]->m_orientation.m_yawDegrees += 45.f * gameDeltaSeconds;
+        m_propStore.SetOrientation(sphere, orientation);
+    }
 
     DebugAddScreenText(Stringf("GameTime:   %.2f", m_gameClock->GetTotalSeconds()), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 20.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
     DebugAddScreenText(Stringf("SystemTime: %.2f", Clock::GetSystemClock().GetTotalSeconds()), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 40.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
     DebugAddScreenText(Stringf("FPS:        %.2f", 1.f / m_gameClock->GetDeltaSeconds()), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 60.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
     DebugAddScreenText(Stringf("Scale:      %.2f", m_gameClock->GetTimeScale()), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 80.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    sEntityPoolStats const& poolStats = m_propStore.GetRenderPropPoolStats();
+    DebugAddScreenText(Stringf("Props:      %d (pool %d/%d, peak %d)", m_propStore.GetCount(), poolStats.m_liveCount, poolStats.m_capacity, poolStats.m_highWaterMark), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 100.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    sPropRenderStats const& renderStats = m_propRenderBackend->GetLastFrameStats();
+    DebugAddScreenText(Stringf("Upload:     %.1f KB/frame (%d static, %d dynamic)", static_cast<float>(renderStats.m_uploadedBytes) / 1024.f, renderStats.m_staticDraws, renderStats.m_dynamicDraws), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 120.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+    DebugAddScreenText(Stringf("States:     %d changes/frame", renderStats.m_stateChanges), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 140.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+    DebugAddScreenText(Stringf("Culling:    %d visible, %d culled (%d nodes)", m_lastCullStats.m_visibleCount, m_lastCullStats.m_culledCount, m_lastCullStats.m_nodesVisited), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 160.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    sPropTransformStats const& transformStats = m_propStore.GetLastTransformStats();
+    DebugAddScreenText(Stringf("Matrices:   %d rebuilt, %d cached", transformStats.m_recomputedCount, transformStats.m_reusedCount), m_screenCamera->GetOrthographicTopRight() - Vec2(500.f, 180.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    AddScriptProfilerScreenText();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Per-system script timing table, drawn below the FPS lines while "ScriptProfilerHud" is on.
+//
+void Game::AddScriptProfilerScreenText() const
+{
+    if (!m_scriptSystemProfiler.IsHudVisible()) return;
+
+    Vec2 const topRight = m_screenCamera->GetOrthographicTopRight();
+    float      offsetY  = 210.f;
+
+    DebugAddScreenText("Script (ms)               avg     max     p99   def", topRight - Vec2(500.f, offsetY), 16.f, Vec2::ZERO, 0.f, Rgba8::YELLOW, Rgba8::YELLOW);
+
+    for (sScriptSystemTiming const& timing : m_scriptSystemProfiler.GetTimings())
+    {
+        offsetY += 18.f;
+
+        String const label = StringFormat("{}:{}", timing.m_phase, timing.m_systemId);
+        DebugAddScreenText(Stringf("%-24.24s %7.3f %7.3f %7.3f %5d", label.c_str(), timing.m_averageMs, timing.m_maxMs, timing.m_p99Ms, timing.m_deferredCount), topRight - Vec2(500.f, offsetY), 16.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -622,23 +708,97 @@ void Game::RenderAttractMode() const
     g_renderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
     g_renderer->SetDepthMode(eDepthMode::DISABLED);
     g_renderer->BindTexture(nullptr);
-    // g_renderer->BindShader(g_renderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
-    g_renderer->BindShader(g_renderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
+    g_renderer->BindShader(m_resourceHandles.GetShader(m_attractModeShader));
     g_renderer->DrawVertexArray(verts);
 }
 
 //----------------------------------------------------------------------------------------------------
-void Game::RenderEntities() const
+void Game::RenderEntities()
 {
     g_renderer->SetModelConstants(m_player->GetModelToWorldTransform());
     m_player->Render();
 
-    for (Prop* prop : m_props)
+    UpdatePropAttachments();
+
+    m_propRenderBackend->BeginFrame();
+    m_lastCullStats = m_propStore.CullFrustum(m_player->GetCameraFrustum(), m_visiblePropIndices);
+
+    m_propDrawQueue.Clear();
+    m_propStore.SubmitDraws(m_propDrawQueue, m_player->m_position, m_resourceHandles, m_visiblePropIndices);
+    m_propDrawQueue.RecordCommandLists(m_propCommandLists, g_parallelForWorkers, PARALLEL_FOR_WORKER_COUNT + 1);
+    PropDrawQueue::ReplayCommandLists(m_propCommandLists, *m_propRenderBackend);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Root nodes mirror their prop (or the player), the hierarchy re-propagates only what moved, and
+// attached props whose world matrix changed take it back. Update runs it before syncing the shared
+// buffer, so scripts see attached props where their parent is this frame; RenderEntities runs it again
+// before culling for parents scripts moved after that (usually a no-op).
+//
+void Game::UpdatePropAttachments()
+{
+    if (m_playerNode != INVALID_TRANSFORM_NODE)
     {
-        prop->Render();
+        if (m_propHierarchy.GetChildCount(m_playerNode) == 0)
+        {
+            m_propHierarchy.DestroyNode(m_playerNode);
+            m_playerNode = INVALID_TRANSFORM_NODE;
+        }
+        else
+        {
+            m_propHierarchy.SetLocalTransform(m_playerNode, m_player->m_position, m_player->m_orientation);
+        }
+    }
+
+    // Destroyed props leave the hierarchy (their children stay where they are as roots), and so do
+    // roots nothing is attached to anymore.
+    for (auto iterator = m_propNodes.begin(); iterator != m_propNodes.end();)
+    {
+        TransformNodeHandle const node      = iterator->second;
+        int const                 propIndex = m_propStore.GetIndex(iterator->first);
+        bool const                isRoot    = m_propHierarchy.GetParent(node) == INVALID_TRANSFORM_NODE;
+
+        if (propIndex < 0 || (isRoot && m_propHierarchy.GetChildCount(node) == 0))
+        {
+            m_propHierarchy.DestroyNode(node);
+            iterator = m_propNodes.erase(iterator);
+            continue;
+        }
+
+        if (isRoot) m_propHierarchy.SetLocalTransform(node, m_propStore.GetPositions()[propIndex], m_propStore.GetOrientations()[propIndex]);
+
+        ++iterator;
+    }
+
+    if (m_propHierarchy.GetNodeCount() == 0) return;
+
+    m_propHierarchy.Update();
+
+    for (auto const& [handle, node] : m_propNodes)
+    {
+        if (m_propHierarchy.GetParent(node) == INVALID_TRANSFORM_NODE || !m_propHierarchy.HasWorldTransformChanged(node)) continue;
+
+        Mat44 const& world     = m_propHierarchy.GetWorldTransform(node);
+        int const    propIndex = m_propStore.GetIndex(handle);
+
+        m_propStore.SetPosition(propIndex, Vec3(world.m_values[Mat44::Tx], world.m_values[Mat44::Ty], world.m_values[Mat44::Tz]));
+        m_propStore.SetOrientation(propIndex, TransformHierarchy::GetEulerAngles(world));
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+TransformNodeHandle Game::GetOrCreatePropNode(PropHandle const handle)
+{
+    if (auto const found = m_propNodes.find(handle); found != m_propNodes.end()) return found->second;
+
+    int const                 propIndex = m_propStore.GetIndex(handle);
+    TransformNodeHandle const node      = m_propHierarchy.CreateNode(INVALID_TRANSFORM_NODE, m_propStore.GetPositions()[propIndex], m_propStore.GetOrientations()[propIndex]);
+
+    m_propNodes.emplace(handle, node);
+
+    return node;
+}
+
 //----------------------------------------------------------------------------------------------------
 void Game::SpawnPlayer()
 {
@@ -653,33 +813,107 @@ void Game::InitPlayer() const
 //----------------------------------------------------------------------------------------------------
 void Game::SpawnProps()
 {
-    // Texture const* texture = g_renderer->CreateOrGetTextureFromFile("Data/Images/TestUV.png");
-    Texture const* texture = ResourceSubsystem::CreateOrGetTextureFromFile("Data/Images/TestUV.png");
+    TextureHandle const texture = m_resourceHandles.ResolveTexture("Data/Images/TestUV.png");
+
+    m_propStore.Reserve(4);
 
-    m_props.reserve(4);
+    m_scenePropHandles[0] = m_propStore.AddProp(Vec3::ZERO, Rgba8::WHITE, m_propStore.AllocateRenderProp(sPropMeshDesc::Cube()));
+    m_scenePropHandles[1] = m_propStore.AddProp(Vec3::ZERO, Rgba8::WHITE, m_propStore.AllocateRenderProp(sPropMeshDesc::Cube()));
+    m_scenePropHandles[2] = m_propStore.AddProp(Vec3::ZERO, Rgba8::WHITE, m_propStore.AllocateRenderProp(sPropMeshDesc::Sphere(), texture));
+    m_scenePropHandles[3] = m_propStore.AddProp(Vec3::ZERO, Rgba8::WHITE, m_propStore.AllocateRenderProp(sPropMeshDesc::Grid()));
+}
 
-    Prop* prop1 = new Prop(this);
-    Prop* prop2 = new Prop(this);
-    Prop* prop3 = new Prop(this, texture);
-    Prop* prop4 = new Prop(this);
+void Game::InitProps()
+{
+    m_propStore.SetPosition(m_propStore.GetIndex(m_scenePropHandles[0]), Vec3(2.f, 2.f, 0.f));
+    m_propStore.SetPosition(m_propStore.GetIndex(m_scenePropHandles[1]), Vec3(-2.f, -2.f, 0.f));
+    m_propStore.SetPosition(m_propStore.GetIndex(m_scenePropHandles[2]), Vec3(10, -5, 1));
+    m_propStore.SetPosition(m_propStore.GetIndex(m_scenePropHandles[3]), Vec3::ZERO);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Lands pending script writes, then copies the props C++ changed since the last sync into the shared
+// buffer so scripts running after the C++ update see them; entries nothing changed are already current.
+// Re-publishes the buffer when growing it moved the block.
+//
+void Game::SyncPropTransformBuffer()
+{
+    ApplyPropTransformBuffer();
+
+    m_propTransformBuffer.Resize(m_propStore.GetCount());
+    m_propStore.TakeChangedProps(m_changedPropIndices);
+
+    for (int const propIndex : m_changedPropIndices)
+    {
+        StorePropInTransformBuffer(propIndex);
+    }
+
+    PublishPropTransformBuffer();
+}
+
+//----------------------------------------------------------------------------------------------------
+void Game::StorePropInTransformBuffer(int const propIndex)
+{
+    Vec3 const&        position    = m_propStore.GetPositions()[propIndex];
+    EulerAngles const& orientation = m_propStore.GetOrientations()[propIndex];
+    Rgba8 const&       propColor   = m_propStore.GetColors()[propIndex];
+    float*             transform   = m_propTransformBuffer.GetTransformData() + propIndex * PropTransformBuffer::FLOATS_PER_TRANSFORM;
+    uint8_t*           color       = m_propTransformBuffer.GetColorData() + propIndex * PropTransformBuffer::BYTES_PER_COLOR;
+
+    transform[0] = position.x;
+    transform[1] = position.y;
+    transform[2] = position.z;
+    transform[3] = orientation.m_yawDegrees;
+    transform[4] = orientation.m_pitchDegrees;
+    transform[5] = orientation.m_rollDegrees;
+    color[0]     = propColor.r;
+    color[1]     = propColor.g;
+    color[2]     = propColor.b;
+    color[3]     = propColor.a;
+}
 
-    if (prop1 != nullptr) m_props.push_back(prop1);
-    if (prop2 != nullptr) m_props.push_back(prop2);
-    if (prop3 != nullptr) m_props.push_back(prop3);
-    if (prop4 != nullptr) m_props.push_back(prop4);
+//----------------------------------------------------------------------------------------------------
+// No-op unless the block moved; call after anything that may have grown it.
+//
+void Game::PublishPropTransformBuffer()
+{
+    if (m_propTransformScriptBuffer != nullptr)
+    {
+        m_propTransformScriptBuffer->Publish(m_propTransformBuffer.GetSharedData(), m_propTransformBuffer.GetSharedByteLength());
+    }
 }
 
-void Game::InitProps() const
+//----------------------------------------------------------------------------------------------------
+// Applies only the entries and fields scripts wrote since the last apply, walking the dirty index list,
+// so props moved directly from C++ in the meantime keep their positions.
+//
+void Game::ApplyPropTransformBuffer()
 {
-    m_props[0]->InitializeLocalVertsForCube();
-    m_props[1]->InitializeLocalVertsForCube();
-    m_props[2]->InitializeLocalVertsForSphere();
-    m_props[3]->InitializeLocalVertsForGrid();
+    int const dirtyCount = m_propTransformBuffer.GetDirtyCount();
+
+    if (dirtyCount == 0) return;
+
+    float const*   transforms = m_propTransformBuffer.GetTransformData();
+    uint8_t const* colors     = m_propTransformBuffer.GetColorData();
+    int const      propCount  = std::min(m_propTransformBuffer.GetPropCount(), m_propStore.GetCount());
+
+    for (int dirtyIndex = 0; dirtyIndex < dirtyCount; ++dirtyIndex)
+    {
+        int const propIndex = m_propTransformBuffer.GetDirtyIndex(dirtyIndex);
+
+        // Indices come from scripts
+        if (propIndex < 0 || propIndex >= propCount) continue;
+
+        uint8_t const  dirtyFlags = m_propTransformBuffer.GetDirtyFlags(propIndex);
+        float const*   transform  = transforms + propIndex * PropTransformBuffer::FLOATS_PER_TRANSFORM;
+        uint8_t const* color      = colors + propIndex * PropTransformBuffer::BYTES_PER_COLOR;
+
+        if (dirtyFlags & PropTransformBuffer::DIRTY_POSITION) m_propStore.SetPosition(propIndex, Vec3(transform[0], transform[1], transform[2]));
+        if (dirtyFlags & PropTransformBuffer::DIRTY_ORIENTATION) m_propStore.SetOrientation(propIndex, EulerAngles(transform[3], transform[4], transform[5]));
+        if (dirtyFlags & PropTransformBuffer::DIRTY_COLOR) m_propStore.SetColor(propIndex, Rgba8(color[0], color[1], color[2], color[3]));
+    }
 
-    m_props[0]->m_position = Vec3(2.f, 2.f, 0.f);
-    m_props[1]->m_position = Vec3(-2.f, -2.f, 0.f);
-    m_props[2]->m_position = Vec3(10, -5, 1);
-    m_props[3]->m_position = Vec3::ZERO;
+    m_propTransformBuffer.ClearDirtyEntries();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -723,6 +957,28 @@ void Game::ExecuteJavaScriptCommand(String const& command)
     // DAEMON_LOG(LogGame, eLogVerbosity::Log, Stringf("Game::ExecuteJavaScriptCommand() end | %s", command.c_str()));
 }
 
+//----------------------------------------------------------------------------------------------------
+// Per-frame update/render calls go straight to the resolved JSEngine method: nothing is compiled,
+// the deltas are passed as arguments and the undefined result is never converted to a string.
+void Game::CallJavaScriptFrameFunction(ScriptFunctionHandle* function, double const* numbers, int const numberCount)
+{
+    if (function == nullptr) return;
+
+    if (!function->Call(numbers, numberCount))
+    {
+        DAEMON_LOG(LogGame, eLogVerbosity::Error, StringFormat("(Game::CallJavaScriptFrameFunction)(fail)({})(error: {})", function->GetName(), function->GetLastError()));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// A root hot reload replaces globalThis.JSEngine; the frame functions re-resolve on their next call.
+//
+void Game::ResetJavaScriptFrameFunctions()
+{
+    if (m_jsEngineUpdateFunction != nullptr) m_jsEngineUpdateFunction->Reset();
+    if (m_jsEngineRenderFunction != nullptr) m_jsEngineRenderFunction->Reset();
+}
+
 //----------------------------------------------------------------------------------------------------
 void Game::ExecuteJavaScriptCommandForDebug(String const& command, String const& scriptName)
 {
@@ -836,6 +1092,16 @@ void Game::ExecuteJavaScriptFileForDebug(String const& filename)
     }
 }
 
+float Game::GetFrameGameDeltaSeconds() const
+{
+    return m_frameGameDeltaSeconds;
+}
+
+float Game::GetFrameSystemDeltaSeconds() const
+{
+    return m_frameSystemDeltaSeconds;
+}
+
 eGameState Game::GetGameState() const
 {
     return m_gameState;
@@ -872,28 +1138,29 @@ void Game::ExecuteJavaScriptFile(String const& filename)
 }
 
 //----------------------------------------------------------------------------------------------------
-void Game::ExecuteModuleFile(String const& modulePath)
+// Goes through the game's module compiler (code cache + shared module registry), not the engine loader.
+//
+bool Game::ExecuteModuleFile(String const& modulePath, sScriptModuleLoadStats* out_stats)
 {
     if (g_scriptSubsystem == nullptr)ERROR_AND_DIE(StringFormat("(Game::ExecuteModuleFile)(g_scriptSubsystem is nullptr!)"))
     if (!g_scriptSubsystem->IsInitialized())ERROR_AND_DIE(StringFormat("(Game::ExecuteModuleFile)(g_scriptSubsystem is not initialized!)"))
+    if (m_scriptModuleCompiler == nullptr)ERROR_AND_DIE(StringFormat("(Game::ExecuteModuleFile)(m_scriptModuleCompiler is nullptr!)"))
 
     DAEMON_LOG(LogGame, eLogVerbosity::Log, StringFormat("(Game::ExecuteModuleFile)(start)({})", modulePath));
 
-    bool const success = g_scriptSubsystem->ExecuteModule(modulePath);
+    bool const success = m_scriptModuleCompiler->ExecuteModule(modulePath, out_stats);
 
     if (!success)
     {
         DAEMON_LOG(LogGame, eLogVerbosity::Error, StringFormat("(Game::ExecuteModuleFile)(fail)({})", modulePath));
+        DAEMON_LOG(LogGame, eLogVerbosity::Error, StringFormat("(Game::ExecuteModuleFile)(fail)(error: {})", m_scriptModuleCompiler->GetLastError()));
 
-        if (g_scriptSubsystem->HasError())
-        {
-            DAEMON_LOG(LogGame, eLogVerbosity::Error, StringFormat("(Game::ExecuteModuleFile)(fail)(error: {})", g_scriptSubsystem->GetLastError()));
-        }
-
-        return;
+        return false;
     }
 
     DAEMON_LOG(LogGame, eLogVerbosity::Log, StringFormat("(Game::ExecuteModuleFile)(end)({})", modulePath.c_str()));
+
+    return true;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -936,38 +1203,286 @@ void Game::HandleJavaScriptCommands()
 }
 
 //----------------------------------------------------------------------------------------------------
-void Game::CreateCube(Vec3 const& position)
+PropHandle Game::CreateCube(Vec3 const& position)
 {
     DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(Game::CreateCube)(start)(position ({:.2f}, {:.2f}, {:.2f}))", position.x, position.y, position.z));
 
-    Prop* newCube       = new Prop(this);
-    newCube->m_position = position;
-    newCube->m_color    = Rgba8(
+    Rgba8 const color = Rgba8(
         static_cast<unsigned char>(g_rng->RollRandomIntInRange(100, 255)),
         static_cast<unsigned char>(g_rng->RollRandomIntInRange(100, 255)),
         static_cast<unsigned char>(g_rng->RollRandomIntInRange(100, 255)),
         255
     );
-    newCube->InitializeLocalVertsForCube();
 
-    m_props.push_back(newCube);
+    PropHandle const handle    = m_propStore.AddProp(position, color, m_propStore.AllocateRenderProp(sPropMeshDesc::Cube()));
+    int const        propIndex = m_propStore.GetIndex(handle);
 
-    DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(Game::CreateCube)(end)(m_props size: {})", m_props.size()));
+    // Appended to the mirror right away, so it stays index-aligned with the store for DestroyProp
+    if (m_propTransformBuffer.GetPropCount() == propIndex)
+    {
+        m_propTransformBuffer.Resize(propIndex + 1);
+        StorePropInTransformBuffer(propIndex);
+        PublishPropTransformBuffer();
+    }
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(Game::CreateCube)(end)(handle {})(prop count: {})", handle, m_propStore.GetCount()));
+
+    return handle;
 }
 
 //----------------------------------------------------------------------------------------------------
-void Game::MoveProp(int         propIndex,
-                    Vec3 const& newPosition)
+void Game::MoveProp(PropHandle const handle,
+                    Vec3 const&      newPosition)
 {
-    if (propIndex >= 0 && propIndex < static_cast<int>(m_props.size()))
+    int const propIndex = m_propStore.GetIndex(handle);
+
+    if (propIndex >= 0)
     {
-        m_props[propIndex]->m_position = newPosition;
-        DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(Game::MoveProp)(end)(prop {} move to position ({:.2f}, {:.2f}, {:.2f}))", propIndex, newPosition.x, newPosition.y, newPosition.z));
+        m_propStore.SetPosition(propIndex, newPosition);
+
+        if (propIndex < m_propTransformBuffer.GetPropCount())
+        {
+            m_propTransformBuffer.StorePosition(propIndex, newPosition.x, newPosition.y, newPosition.z);
+        }
+
+        DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(Game::MoveProp)(end)(prop {} move to position ({:.2f}, {:.2f}, {:.2f}))", handle, newPosition.x, newPosition.y, newPosition.z));
     }
     else
     {
-        DebuggerPrintf("警告：JavaScript 請求移動無效的物件索引 %d（總共 %zu 個物件）\n", propIndex, m_props.size());
+        DebuggerPrintf("警告：JavaScript 請求移動無效或已銷毀的物件 handle %d（總共 %d 個物件）\n", handle, m_propStore.GetCount());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Immediate destroy: the render prop goes back to the pool and the last prop moves into the freed
+// index. Stale handles are rejected. Scripts destroying many props should batch them through entity
+// commands instead.
+//
+void Game::DestroyProp(PropHandle const handle)
+{
+    if (!m_propStore.IsValid(handle))
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, StringFormat("(Game::DestroyProp)(invalid or stale prop handle {})(prop count: {})", handle, m_propStore.GetCount()));
+        return;
+    }
+
+    int const  propIndex       = m_propStore.GetIndex(handle);
+    bool const isBufferAligned = m_propTransformBuffer.GetPropCount() == m_propStore.GetCount();
+
+    // A mirror that fell behind the store is resynced once; pending script writes land first, while
+    // their indices still match
+    if (!isBufferAligned) ApplyPropTransformBuffer();
+
+    m_propStore.DestroyProp(handle);
+
+    // Same swap-remove on the mirror: O(1), and pending script writes follow the prop that moved
+    if (isBufferAligned) m_propTransformBuffer.RemoveAt(propIndex);
+    else SyncPropTransformBuffer();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Applies a whole batch of script structural commands in one pass. Unlike CreateCube, a batch logs
+// once and rolls one random number per cube color.
+//
+sEntityCommandStats Game::ApplyEntityCommands(EntityCommandBuffer const& commandBuffer)
+{
+    sEntityCommandStats stats;
+
+    m_createdPropHandles.clear();
+
+    if (commandBuffer.IsEmpty()) return stats;
+
+    // Land pending script transform writes while their indices still match; destroys below move props.
+    ApplyPropTransformBuffer();
+
+    int constexpr colorRange = 156;     // Channels in [100, 255], same as CreateCube
+
+    m_propStore.Reserve(m_propStore.GetCount() + commandBuffer.GetCreateCount());
+
+    for (sEntityCommand const& command : commandBuffer.GetCommands())
+    {
+        switch (command.m_type)
+        {
+        case eEntityCommandType::CREATE_CUBE:
+            {
+                int const   packedColor = g_rng->RollRandomIntInRange(0, colorRange * colorRange * colorRange - 1);
+                Rgba8 const color       = Rgba8(
+                    static_cast<unsigned char>(100 + packedColor % colorRange),
+                    static_cast<unsigned char>(100 + packedColor / colorRange % colorRange),
+                    static_cast<unsigned char>(100 + packedColor / (colorRange * colorRange)),
+                    255
+                );
+
+                m_createdPropHandles.push_back(m_propStore.AddProp(command.m_position, color, m_propStore.AllocateRenderProp(sPropMeshDesc::Cube())));
+                ++stats.m_created;
+                break;
+            }
+
+        case eEntityCommandType::DESTROY_PROP:
+            // Later commands address props by handle, so swap-removing here cannot retarget them.
+            if (m_propStore.DestroyProp(command.m_propHandle))
+            {
+                ++stats.m_destroyed;
+            }
+            else
+            {
+                ++stats.m_rejected;
+            }
+            break;
+
+        case eEntityCommandType::MOVE_PROP:
+            if (int const propIndex = m_propStore.GetIndex(command.m_propHandle); propIndex >= 0)
+            {
+                m_propStore.SetPosition(propIndex, command.m_position);
+                ++stats.m_moved;
+            }
+            else
+            {
+                ++stats.m_rejected;
+            }
+            break;
+
+        case eEntityCommandType::COUNT:
+            ++stats.m_rejected;
+            break;
+        }
+    }
+
+    SyncPropTransformBuffer();
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(Game::ApplyEntityCommands)(created {})(destroyed {})(moved {})(rejected {})(prop count: {})", stats.m_created, stats.m_destroyed, stats.m_moved, stats.m_rejected, m_propStore.GetCount()));
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<PropHandle> const& Game::GetCreatedPropHandles() const
+{
+    return m_createdPropHandles;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Destroys every prop except the scene props C++ spawned itself, i.e. everything scripts created.
+// Used when a root hot reload replaces the script world, which holds no handles to the old props.
+// Returns the number of props destroyed.
+//
+int Game::DestroyScriptProps()
+{
+    // Land pending script transform writes while their indices still match.
+    ApplyPropTransformBuffer();
+
+    int destroyedCount = 0;
+
+    // Back to front: a swap-remove only moves an already kept prop into the hole.
+    for (int propIndex = m_propStore.GetCount() - 1; propIndex >= 0; --propIndex)
+    {
+        PropHandle const handle = m_propStore.GetHandle(propIndex);
+
+        if (std::find(std::begin(m_scenePropHandles), std::end(m_scenePropHandles), handle) != std::end(m_scenePropHandles)) continue;
+
+        m_propStore.DestroyProp(handle);
+        ++destroyedCount;
+    }
+
+    SyncPropTransformBuffer();
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log, StringFormat("(Game::DestroyScriptProps)(destroyed {})(prop count: {})", destroyedCount, m_propStore.GetCount()));
+
+    return destroyedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Grows the record block scripts write entity commands into to hold at least commandCount commands
+// and re-publishes it if it moved. Returns the capacity in commands.
+//
+int Game::ReserveEntityCommands(int const commandCount)
+{
+    size_t const numberCount = static_cast<size_t>(std::max(commandCount, 0)) * EntityCommandBuffer::NUMBERS_PER_COMMAND;
+
+    if (numberCount > m_entityCommandRecords.size())
+    {
+        m_entityCommandRecords.resize(std::max(numberCount, m_entityCommandRecords.size() * 2));
+    }
+
+    if (m_entityCommandRecordScriptBuffer != nullptr && !m_entityCommandRecords.empty())
+    {
+        m_entityCommandRecordScriptBuffer->Publish(m_entityCommandRecords.data(), m_entityCommandRecords.size() * sizeof(double));
     }
+
+    return static_cast<int>(m_entityCommandRecords.size() / EntityCommandBuffer::NUMBERS_PER_COMMAND);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Applies the first commandCount records scripts wrote into the record block. The handles of the
+// cubes it created land in the created-handle block (re-published if it moved), in record order.
+// Returns the number of commands applied, or -1 if the records are malformed or commandCount exceeds
+// the reserved capacity.
+//
+int Game::SubmitEntityCommands(int const commandCount)
+{
+    m_entityCommands.Clear();
+
+    if (commandCount < 0 || static_cast<size_t>(commandCount) * EntityCommandBuffer::NUMBERS_PER_COMMAND > m_entityCommandRecords.size()) return -1;
+
+    if (commandCount > 0 && !m_entityCommands.AppendRecords(m_entityCommandRecords.data(), commandCount * EntityCommandBuffer::NUMBERS_PER_COMMAND)) return -1;
+
+    sEntityCommandStats const stats = ApplyEntityCommands(m_entityCommands);
+
+    if (m_entityCommandCreatedScriptBuffer != nullptr && m_createdPropHandles.capacity() > 0)
+    {
+        m_entityCommandCreatedScriptBuffer->Publish(m_createdPropHandles.data(), m_createdPropHandles.capacity() * sizeof(PropHandle));
+    }
+
+    return stats.m_created + stats.m_destroyed + stats.m_moved;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Grows the record block scripts write spatial queries into to hold at least queryCount queries and
+// re-publishes it if it moved. Returns the capacity in queries.
+//
+int Game::ReserveSpatialQueries(int const queryCount)
+{
+    size_t const numberCount = static_cast<size_t>(std::max(queryCount, 0)) * PropSpatialQueryBatch::NUMBERS_PER_QUERY;
+
+    if (numberCount > m_spatialQueryRecords.size())
+    {
+        m_spatialQueryRecords.resize(std::max(numberCount, m_spatialQueryRecords.size() * 2));
+    }
+
+    if (m_spatialQueryRecordScriptBuffer != nullptr && !m_spatialQueryRecords.empty())
+    {
+        m_spatialQueryRecordScriptBuffer->Publish(m_spatialQueryRecords.data(), m_spatialQueryRecords.size() * sizeof(double));
+    }
+
+    return static_cast<int>(m_spatialQueryRecords.size() / PropSpatialQueryBatch::NUMBERS_PER_QUERY);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Answers the first queryCount records scripts wrote into the record block, against the current prop
+// positions including transform writes scripts made this frame. The answers land in the result block
+// (re-published if it moved). Returns the total number of hits, or -1 if the records are malformed or
+// queryCount exceeds the reserved capacity.
+//
+int Game::RunSpatialQueries(int const queryCount)
+{
+    m_spatialQueries.Clear();
+
+    if (queryCount == 0) return 0;
+
+    if (queryCount < 0 || static_cast<size_t>(queryCount) * PropSpatialQueryBatch::NUMBERS_PER_QUERY > m_spatialQueryRecords.size()) return -1;
+
+    if (!m_spatialQueries.AppendRecords(m_spatialQueryRecords.data(), queryCount * PropSpatialQueryBatch::NUMBERS_PER_QUERY)) return -1;
+
+    ApplyPropTransformBuffer();
+
+    int const hitCount = m_spatialQueries.Execute(m_propStore);
+
+    if (m_spatialQueryResultScriptBuffer != nullptr)
+    {
+        m_spatialQueryResultScriptBuffer->Publish(m_spatialQueries.GetResultData(), m_spatialQueries.GetResultCapacity() * sizeof(double));
+    }
+
+    return hitCount;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -976,10 +1491,152 @@ Player* Game::GetPlayer()
     return m_player;
 }
 
+//----------------------------------------------------------------------------------------------------
+int Game::GetPropCount() const
+{
+    return m_propStore.GetCount();
+}
+
+//----------------------------------------------------------------------------------------------------
+int Game::GetPropIndex(PropHandle const handle) const
+{
+    return m_propStore.GetIndex(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+PropHandle Game::GetPropHandle(int const propIndex) const
+{
+    return m_propStore.GetHandle(propIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Interns the path on first use; scripts keep the returned handle instead of the path.
+//
+int Game::ResolveTexture(String const& path)
+{
+    return m_resourceHandles.ResolveTexture(path);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns false for a stale prop handle. An unknown texture handle draws untextured.
+//
+bool Game::SetPropTexture(PropHandle const handle, int const textureHandle)
+{
+    return m_propStore.SetTexture(handle, textureHandle);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Makes the child prop follow the parent prop at an offset in the parent's space (yaw, pitch, roll in
+// degrees), replacing any previous attachment; scripts then move only the parent. Moving an attached
+// prop directly lasts until its parent next moves. Returns false for stale handles or when the parent
+// is the child or hangs (directly or not) from it.
+//
+bool Game::AttachProp(PropHandle const childHandle,
+                      PropHandle const parentHandle,
+                      Vec3 const&      localPosition,
+                      float const      yawDegrees,
+                      float const      pitchDegrees,
+                      float const      rollDegrees)
+{
+    if (childHandle == parentHandle || !m_propStore.IsValid(childHandle) || !m_propStore.IsValid(parentHandle)) return false;
+
+    TransformNodeHandle const childNode = GetOrCreatePropNode(childHandle);
+
+    if (!m_propHierarchy.SetParent(childNode, GetOrCreatePropNode(parentHandle))) return false;
+
+    m_propHierarchy.SetLocalTransform(childNode, localPosition, EulerAngles(yawDegrees, pitchDegrees, rollDegrees));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same as AttachProp with the player as the parent, e.g. for a held item.
+//
+bool Game::AttachPropToPlayer(PropHandle const childHandle,
+                              Vec3 const&      localPosition,
+                              float const      yawDegrees,
+                              float const      pitchDegrees,
+                              float const      rollDegrees)
+{
+    if (!m_propStore.IsValid(childHandle)) return false;
+
+    if (m_playerNode == INVALID_TRANSFORM_NODE)
+    {
+        m_playerNode = m_propHierarchy.CreateNode(INVALID_TRANSFORM_NODE, m_player->m_position, m_player->m_orientation);
+    }
+
+    TransformNodeHandle const childNode = GetOrCreatePropNode(childHandle);
+
+    m_propHierarchy.SetParent(childNode, m_playerNode);     // The player node is a root, so this cannot form a cycle
+    m_propHierarchy.SetLocalTransform(childNode, localPosition, EulerAngles(yawDegrees, pitchDegrees, rollDegrees));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The prop stays where it was last placed and moves on its own again. Props attached to it stay
+// attached. Returns false if the prop is stale or not attached.
+//
+bool Game::DetachProp(PropHandle const childHandle)
+{
+    auto const found = m_propNodes.find(childHandle);
+
+    if (found == m_propNodes.end() || m_propHierarchy.GetParent(found->second) == INVALID_TRANSFORM_NODE) return false;
+
+    return m_propHierarchy.SetParent(found->second, INVALID_TRANSFORM_NODE);
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptSystemProfiler& Game::GetScriptSystemProfiler()
+{
+    return m_scriptSystemProfiler;
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptHotReloader* Game::GetScriptHotReloader() const
+{
+    return m_scriptHotReloader;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Game::PublishScriptSystemTimings(String const& snapshot)
+{
+    m_scriptSystemProfiler.ParseSnapshot(snapshot);
+}
+
+//----------------------------------------------------------------------------------------------------
+PropStore const& Game::GetPropStore() const
+{
+    return m_propStore;
+}
+
+//----------------------------------------------------------------------------------------------------
+ResourceHandleTable& Game::GetResourceHandles()
+{
+    return m_resourceHandles;
+}
+
+//----------------------------------------------------------------------------------------------------
+PropTransformBuffer& Game::GetPropTransformBuffer()
+{
+    return m_propTransformBuffer;
+}
+
+//----------------------------------------------------------------------------------------------------
+PropTransformBuffer const& Game::GetPropTransformBuffer() const
+{
+    return m_propTransformBuffer;
+}
+
 void Game::Update(float const gameDeltaSeconds,
                   float const systemDeltaSeconds)
 {
+    // Script writes made earlier this frame take part in the C++ update
+    ApplyPropTransformBuffer();
     UpdateEntities(gameDeltaSeconds, systemDeltaSeconds);
+    // Attached props follow their parents before the sync, so scripts read this frame's transforms
+    UpdatePropAttachments();
+    SyncPropTransformBuffer();
     UpdateFromKeyBoard();
     UpdateFromController();
 
@@ -1114,9 +1771,48 @@ void Game::InitializeJavaScriptFramework()
         // have been removed. All functionality should be migrated to ES6 modules.
         // If you need these systems, create .mjs equivalents and import them in main.mjs.
 
+        ScriptModuleGraph moduleGraph;
+        moduleGraph.Build(JS_MAIN_MODULE_PATH);
+
+        m_scriptCodeCache = new ScriptCodeCache(JS_CODE_CACHE_DIRECTORY);
+        m_scriptCodeCache->LoadManifest();
+
+        m_scriptModuleCompiler = new ScriptModuleCompiler(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), m_scriptCodeCache);
+
+        // Shared before any module runs, so systems can map the prop buffer from their constructors
+        m_propTransformScriptBuffer        = new ScriptSharedBuffer(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "propTransformMemory");
+        m_entityCommandRecordScriptBuffer  = new ScriptSharedBuffer(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "entityCommandRecordMemory");
+        m_entityCommandCreatedScriptBuffer = new ScriptSharedBuffer(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "entityCommandCreatedMemory");
+        m_spatialQueryRecordScriptBuffer   = new ScriptSharedBuffer(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "spatialQueryRecordMemory");
+        m_spatialQueryResultScriptBuffer   = new ScriptSharedBuffer(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "spatialQueryResultMemory");
+        m_jsEngineUpdateFunction           = new ScriptFunctionHandle(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "JSEngine", "update");
+        m_jsEngineRenderFunction           = new ScriptFunctionHandle(g_scriptSubsystem->GetIsolate(), g_scriptSubsystem->GetContext(), "JSEngine", "render");
+        SyncPropTransformBuffer();
+        ReserveEntityCommands(ENTITY_COMMAND_RECORD_MIN_CAPACITY);
+        ReserveSpatialQueries(SPATIAL_QUERY_RECORD_MIN_CAPACITY);
+
         // Load ES6 module entry point (imports all other modules via import statements)
         DAEMON_LOG(LogGame, eLogVerbosity::Display, "Loading main.mjs (ES6 module entry point)...");
-        ExecuteModuleFile("Data/Scripts/main.mjs");
+
+        sScriptModuleLoadStats loadStats;
+        ExecuteModuleFile(JS_MAIN_MODULE_PATH, &loadStats);
+
+        // Warm: every module compiled from an accepted code cache entry
+        bool const isWarm = loadStats.m_compiledModuleCount > 0 && loadStats.m_consumedCacheCount == loadStats.m_compiledModuleCount;
+
+        DAEMON_LOG(LogGame, eLogVerbosity::Display, StringFormat("(Game::InitializeJavaScriptFramework)({} startup)({}/{} code caches consumed, {} rejected, {} produced)(compile {:.2f} ms, evaluate {:.2f} ms, total {:.2f} ms)",
+                                                                 isWarm ? "warm" : "cold", loadStats.m_consumedCacheCount, loadStats.m_compiledModuleCount, loadStats.m_rejectedCacheCount,
+                                                                 loadStats.m_producedCacheCount, loadStats.m_compileMs, loadStats.m_evaluateMs, loadStats.m_totalMs));
+
+        m_scriptCodeCache->UpdateManifest(moduleGraph);
+        m_scriptCodeCache->SaveManifest();
+        m_scriptCodeCache->PruneStaleEntries();
+
+        // Hot reload copies are rewritten per edit and never loaded twice, so they are compiled without the cache
+        m_scriptModuleCompiler->SetCodeCache(nullptr);
+
+        // Hot reload walks the same graph: only edited modules and their importers are re-evaluated
+        m_scriptHotReloader = new ScriptHotReloader(moduleGraph, *m_scriptModuleCompiler, JS_HOT_SWAP_DIRECTORY);
 
         DAEMON_LOG(LogGame, eLogVerbosity::Display, "Game::InitializeJavaScriptFramework() complete - Pure ES6 Module architecture initialized");
     }
@@ -1125,3 +1821,21 @@ void Game::InitializeJavaScriptFramework()
         DAEMON_LOG(LogGame, eLogVerbosity::Error, "Game::InitializeJavaScriptFramework() exception occurred");
     }
 }
+
+//----------------------------------------------------------------------------------------------------
+// Releases everything holding V8 handles. The App calls this before the script subsystem shuts down,
+// since the Game itself outlives the isolate; safe to call more than once.
+//
+void Game::ShutdownJavaScriptFramework()
+{
+    GAME_SAFE_RELEASE(m_scriptHotReloader);
+    GAME_SAFE_RELEASE(m_scriptModuleCompiler);
+    GAME_SAFE_RELEASE(m_scriptCodeCache);
+    GAME_SAFE_RELEASE(m_propTransformScriptBuffer);
+    GAME_SAFE_RELEASE(m_entityCommandRecordScriptBuffer);
+    GAME_SAFE_RELEASE(m_entityCommandCreatedScriptBuffer);
+    GAME_SAFE_RELEASE(m_spatialQueryRecordScriptBuffer);
+    GAME_SAFE_RELEASE(m_spatialQueryResultScriptBuffer);
+    GAME_SAFE_RELEASE(m_jsEngineUpdateFunction);
+    GAME_SAFE_RELEASE(m_jsEngineRenderFunction);
+}
@@ -1,18 +1,33 @@
-//----------------------------------------------------------------------------------------------------
+﻿//----------------------------------------------------------------------------------------------------
 // Game.hpp
 //----------------------------------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
 //----------------------------------------------------------------------------------------------------
+#include "Game/EntityCommandBuffer.hpp"
+#include "Game/PropSpatialQueryBatch.hpp"
+#include "Game/PropStore.hpp"
+#include "Game/PropTransformBuffer.hpp"
+#include "Game/ResourceHandleTable.hpp"
+#include "Game/TransformHierarchy.hpp"
+#include "Game/Framework/ScriptSystemProfiler.hpp"
+//----------------------------------------------------------------------------------------------------
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Renderer/VertexUtils.hpp"
 
+#include <unordered_map>
+
 //----------------------------------------------------------------------------------------------------
 class Camera;
 class Clock;
 class Player;
-class Prop;
+class ScriptCodeCache;
+class ScriptFunctionHandle;
+class ScriptHotReloader;
+class ScriptModuleCompiler;
+class ScriptSharedBuffer;
+struct sScriptModuleLoadStats;
 
 //----------------------------------------------------------------------------------------------------
 enum class eGameState : uint8_t
@@ -29,6 +44,7 @@ public:
     ~Game();
 
     void PostInit();
+    void ShutdownJavaScriptFramework();
     void UpdateJS();
     void RenderJS();
 
@@ -39,7 +55,9 @@ public:
 
     void ExecuteJavaScriptCommand(String const& command);
     void ExecuteJavaScriptFile(String const& filename);
-    void ExecuteModuleFile(String const& modulePath);
+    bool ExecuteModuleFile(String const& modulePath, sScriptModuleLoadStats* out_stats = nullptr);
+    void CallJavaScriptFrameFunction(ScriptFunctionHandle* function, double const* numbers, int numberCount);
+    void ResetJavaScriptFrameFunctions();
     void HandleJavaScriptCommands();
 
     // SCRIPT REGISTRY: Chrome DevTools selective integration
@@ -47,12 +65,40 @@ public:
     void ExecuteJavaScriptFileForDebug(String const& filename);
 
     // JavaScript callback functions
+    float      GetFrameGameDeltaSeconds() const;
+    float      GetFrameSystemDeltaSeconds() const;
     eGameState GetGameState() const;
     void       SetGameState(eGameState newState);
-    void       CreateCube(Vec3 const& position);
-    void       MoveProp(int propIndex, Vec3 const& newPosition);
+    PropHandle CreateCube(Vec3 const& position);
+    void       MoveProp(PropHandle handle, Vec3 const& newPosition);
+    void       DestroyProp(PropHandle handle);
     void       MovePlayerCamera(Vec3 const& offset);
     Player*    GetPlayer();
+    int        GetPropCount() const;
+    int        GetPropIndex(PropHandle handle) const;
+    PropHandle GetPropHandle(int propIndex) const;
+    int        ResolveTexture(String const& path);
+    bool       SetPropTexture(PropHandle handle, int textureHandle);
+    bool       AttachProp(PropHandle childHandle, PropHandle parentHandle, Vec3 const& localPosition, float yawDegrees, float pitchDegrees, float rollDegrees);
+    bool       AttachPropToPlayer(PropHandle childHandle, Vec3 const& localPosition, float yawDegrees, float pitchDegrees, float rollDegrees);
+    bool       DetachProp(PropHandle childHandle);
+
+    PropStore const&           GetPropStore() const;
+    ResourceHandleTable&       GetResourceHandles();
+    PropTransformBuffer&       GetPropTransformBuffer();
+    PropTransformBuffer const& GetPropTransformBuffer() const;
+    sEntityCommandStats        ApplyEntityCommands(EntityCommandBuffer const& commandBuffer);
+    std::vector<PropHandle> const& GetCreatedPropHandles() const;
+    int                        ReserveEntityCommands(int commandCount);
+    int                        DestroyScriptProps();
+    int                        SubmitEntityCommands(int commandCount);
+    int                        ReserveSpatialQueries(int queryCount);
+    int                        RunSpatialQueries(int queryCount);
+
+    ScriptSystemProfiler& GetScriptSystemProfiler();
+    ScriptHotReloader*    GetScriptHotReloader() const;
+    void                  PublishScriptSystemTimings(String const& snapshot);
+
     void       Update(float gameDeltaSeconds, float systemDeltaSeconds);
     void       Render();
 
@@ -62,25 +108,71 @@ public:
 private:
     void UpdateFromKeyBoard();
     void UpdateFromController();
-    void UpdateEntities(float gameDeltaSeconds, float systemDeltaSeconds) const;
+    void UpdateEntities(float gameDeltaSeconds, float systemDeltaSeconds);
     void RenderAttractMode() const;
-    void RenderEntities() const;
+    void RenderEntities();
+    void AddScriptProfilerScreenText() const;
+
+    void                UpdatePropAttachments();
+    TransformNodeHandle GetOrCreatePropNode(PropHandle handle);
 
     void SpawnPlayer();
     void InitPlayer() const;
     void SpawnProps();
-    void InitProps() const;
+    void InitProps();
+
+    void SyncPropTransformBuffer();
+    void ApplyPropTransformBuffer();
+    void StorePropInTransformBuffer(int propIndex);
+    void PublishPropTransformBuffer();
 
 
     void SetupJavaScriptBindings();
     void InitializeJavaScriptFramework();
 
-    Camera*            m_screenCamera = nullptr;
-    Player*            m_player       = nullptr;
-    Clock*             m_gameClock    = nullptr;
-    std::vector<Prop*> m_props;
-    eGameState         m_gameState = eGameState::ATTRACT;
+    Camera*               m_screenCamera                     = nullptr;
+    Player*               m_player                           = nullptr;
+    Clock*                m_gameClock                        = nullptr;
+    ScriptCodeCache*      m_scriptCodeCache                  = nullptr;
+    ScriptModuleCompiler* m_scriptModuleCompiler             = nullptr;
+    ScriptHotReloader*    m_scriptHotReloader                = nullptr;
+    ScriptSharedBuffer*   m_propTransformScriptBuffer        = nullptr;   // m_propTransformBuffer as globalThis.propTransformMemory
+    ScriptSharedBuffer*   m_entityCommandRecordScriptBuffer  = nullptr;   // m_entityCommandRecords as globalThis.entityCommandRecordMemory
+    ScriptSharedBuffer*   m_entityCommandCreatedScriptBuffer = nullptr;   // m_createdPropHandles as globalThis.entityCommandCreatedMemory
+    ScriptSharedBuffer*   m_spatialQueryRecordScriptBuffer   = nullptr;   // m_spatialQueryRecords as globalThis.spatialQueryRecordMemory
+    ScriptSharedBuffer*   m_spatialQueryResultScriptBuffer   = nullptr;   // m_spatialQueries results as globalThis.spatialQueryResultMemory
+    ScriptFunctionHandle* m_jsEngineUpdateFunction           = nullptr;   // JSEngine.update(gameDeltaSeconds, systemDeltaSeconds)
+    ScriptFunctionHandle* m_jsEngineRenderFunction           = nullptr;   // JSEngine.render()
+    PropRenderBackend*    m_propRenderBackend                = nullptr;
+    eGameState            m_gameState                        = eGameState::ATTRACT;
+
+    ResourceHandleTable     m_resourceHandles;
+    ShaderHandle            m_attractModeShader = INVALID_RESOURCE_HANDLE;
+    PropStore               m_propStore;
+    PropDrawQueue           m_propDrawQueue;
+    std::vector<int>        m_visiblePropIndices;       // CullFrustum result of the last RenderEntities
+    sPropCullStats          m_lastCullStats;
+    PropHandle              m_scenePropHandles[4] = {INVALID_PROP_HANDLE, INVALID_PROP_HANDLE, INVALID_PROP_HANDLE, INVALID_PROP_HANDLE};
+    std::vector<PropHandle> m_createdPropHandles;       // CREATE_CUBE results of the last ApplyEntityCommands, in record order
+    EntityCommandBuffer     m_entityCommands;
+    std::vector<double>     m_entityCommandRecords;     // Script-written command records, EntityCommandBuffer::NUMBERS_PER_COMMAND each
+    PropTransformBuffer     m_propTransformBuffer;
+    std::vector<int>        m_changedPropIndices;       // PropStore::TakeChangedProps scratch for SyncPropTransformBuffer
+    PropSpatialQueryBatch   m_spatialQueries;
+    std::vector<double>     m_spatialQueryRecords;      // Script-written query records, PropSpatialQueryBatch::NUMBERS_PER_QUERY each
+    ScriptSystemProfiler    m_scriptSystemProfiler;
+
+    // One per chunk of sorted prop draws; recorded on the ParallelFor workers, replayed by RenderEntities.
+    std::vector<PropCommandList> m_propCommandLists;
+
+    // Only props that are attached or have attachments get a node, see UpdatePropAttachments.
+    TransformHierarchy                                  m_propHierarchy;
+    TransformNodeHandle                                 m_playerNode = INVALID_TRANSFORM_NODE;
+    std::unordered_map<PropHandle, TransformNodeHandle> m_propNodes;
 
     Vec3 m_originalPlayerPosition = Vec3(-2.f, 0.f, 1.f);
     bool m_cameraShakeActive      = false;
+
+    float m_frameGameDeltaSeconds   = 0.f;
+    float m_frameSystemDeltaSeconds = 0.f;
 };
@@ -0,0 +1,384 @@
+//----------------------------------------------------------------------------------------------------
+// IndexedMesh.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/IndexedMesh.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Forsyth, "Linear-Speed Vertex Cache Optimisation" (2006); the cache size only shapes the scores and
+    // suits any real FIFO/LRU cache of 16-32 entries.
+    int constexpr   FORSYTH_CACHE_SIZE          = 32;
+    float constexpr FORSYTH_CACHE_DECAY_POWER   = 1.5f;
+    float constexpr FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+    float constexpr FORSYTH_VALENCE_BOOST_SCALE = 2.f;
+    float constexpr FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+    float GetForsythVertexScore(int const cachePosition, int const remainingTriangles)
+    {
+        if (remainingTriangles == 0) return -1.f;
+
+        float score = 0.f;
+
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                // The triangle just added; scored flat so its vertexes do not win just for being newest.
+                score = FORSYTH_LAST_TRIANGLE_SCORE;
+            }
+            else
+            {
+                float const scaler = 1.f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+                score              = std::pow(1.f - static_cast<float>(cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+            }
+        }
+
+        // Favour vertexes with few triangles left so lone triangles are not stranded until the end.
+        score += FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+
+        return score;
+    }
+
+    struct sVertexBytesHash
+    {
+        size_t operator()(Vertex_PCU const& vertex) const
+        {
+            unsigned char bytes[sizeof(Vertex_PCU)];
+            std::memcpy(bytes, &vertex, sizeof(Vertex_PCU));
+
+            uint64_t hash = 14695981039346656037ull;     // FNV-1a
+
+            for (unsigned char const byte : bytes)
+            {
+                hash = (hash ^ byte) * 1099511628211ull;
+            }
+
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct sVertexBytesEqual
+    {
+        bool operator()(Vertex_PCU const& a, Vertex_PCU const& b) const
+        {
+            return std::memcmp(&a, &b, sizeof(Vertex_PCU)) == 0;
+        }
+    };
+}
+
+//----------------------------------------------------------------------------------------------------
+void sIndexedMesh::SetIndexes(std::vector<uint32_t> const& indexes)
+{
+    m_indexes16.clear();
+    m_indexes32.clear();
+
+    if (m_vertexes.size() <= UINT16_MAX + 1ull)
+    {
+        m_indexFormat = eIndexFormat::UINT16;
+        m_indexes16.assign(indexes.begin(), indexes.end());
+    }
+    else
+    {
+        m_indexFormat = eIndexFormat::UINT32;
+        m_indexes32   = indexes;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int sIndexedMesh::GetVertexCount() const
+{
+    return static_cast<int>(m_vertexes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int sIndexedMesh::GetIndexCount() const
+{
+    return static_cast<int>(m_indexFormat == eIndexFormat::UINT16 ? m_indexes16.size() : m_indexes32.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t sIndexedMesh::GetIndex(int const indexIndex) const
+{
+    return m_indexFormat == eIndexFormat::UINT16 ? m_indexes16[indexIndex] : m_indexes32[indexIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+void const* sIndexedMesh::GetIndexData() const
+{
+    return m_indexFormat == eIndexFormat::UINT16 ? static_cast<void const*>(m_indexes16.data()) : static_cast<void const*>(m_indexes32.data());
+}
+
+//----------------------------------------------------------------------------------------------------
+int sIndexedMesh::GetIndexStride() const
+{
+    return m_indexFormat == eIndexFormat::UINT16 ? static_cast<int>(sizeof(uint16_t)) : static_cast<int>(sizeof(uint32_t));
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t sIndexedMesh::GetVertexBytes() const
+{
+    return m_vertexes.size() * sizeof(Vertex_PCU);
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t sIndexedMesh::GetIndexBytes() const
+{
+    return static_cast<size_t>(GetIndexCount()) * static_cast<size_t>(GetIndexStride());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Back to a plain triangle list, for draw paths without index buffers.
+//
+void sIndexedMesh::ExpandToTriangleList(VertexList_PCU& out_triangleList) const
+{
+    int const indexCount = GetIndexCount();
+
+    out_triangleList.resize(static_cast<size_t>(indexCount));
+
+    for (int indexIndex = 0; indexIndex < indexCount; ++indexIndex)
+    {
+        out_triangleList[indexIndex] = m_vertexes[GetIndex(indexIndex)];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void BuildIndexedMesh(VertexList_PCU const& triangleList, sIndexedMesh& out_mesh, bool const optimizeOrder)
+{
+    std::vector<uint32_t> indexes;
+
+    DeduplicateVertexes(triangleList, out_mesh.m_vertexes, indexes);
+
+    if (optimizeOrder)
+    {
+        OptimizeVertexCacheOrder(indexes, out_mesh.GetVertexCount());
+        OptimizeVertexFetchOrder(out_mesh.m_vertexes, indexes);
+    }
+
+    out_mesh.m_vertexes.shrink_to_fit();
+    out_mesh.SetIndexes(indexes);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only bit-identical vertexes merge: a cube corner with three face colors stays three vertexes.
+//
+void DeduplicateVertexes(VertexList_PCU const& triangleList, VertexList_PCU& out_vertexes, std::vector<uint32_t>& out_indexes)
+{
+    std::unordered_map<Vertex_PCU, uint32_t, sVertexBytesHash, sVertexBytesEqual> indexByVertex;
+    indexByVertex.reserve(triangleList.size());
+
+    out_vertexes.clear();
+    out_indexes.clear();
+    out_indexes.reserve(triangleList.size());
+
+    for (Vertex_PCU const& vertex : triangleList)
+    {
+        auto const [found, isNew] = indexByVertex.try_emplace(vertex, static_cast<uint32_t>(out_vertexes.size()));
+
+        if (isNew) out_vertexes.push_back(vertex);
+
+        out_indexes.push_back(found->second);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Greedy: always emits the unadded triangle with the highest summed vertex score, where scores favour
+// vertexes still in the simulated LRU cache and vertexes with few triangles left. Only triangles of
+// vertexes touched by the last step are rescored, so the whole pass is close to linear.
+//
+void OptimizeVertexCacheOrder(std::vector<uint32_t>& indexes, int const vertexCount)
+{
+    int const triangleCount = static_cast<int>(indexes.size() / 3);
+    if (triangleCount == 0 || vertexCount == 0) return;
+
+    // Per-vertex triangle adjacency; the first remainingTriangles[v] entries of a vertex are the unadded ones.
+    std::vector<int> remainingTriangles(vertexCount, 0);
+    std::vector<int> adjacencyOffsets(vertexCount + 1, 0);
+    std::vector<int> adjacency(static_cast<size_t>(triangleCount) * 3);
+
+    for (int i = 0; i < triangleCount * 3; ++i) ++remainingTriangles[indexes[i]];
+    for (int v = 0; v < vertexCount; ++v) adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remainingTriangles[v];
+
+    {
+        std::vector<int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+        for (int triangle = 0; triangle < triangleCount; ++triangle)
+        {
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                adjacency[fill[indexes[triangle * 3 + corner]]++] = triangle;
+            }
+        }
+    }
+
+    std::vector<int>   cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    std::vector<bool>  isTriangleAdded(triangleCount, false);
+
+    for (int v = 0; v < vertexCount; ++v) vertexScores[v] = GetForsythVertexScore(-1, remainingTriangles[v]);
+
+    int   bestTriangle      = -1;
+    float bestTriangleScore = -1.f;
+
+    for (int triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        float const score = vertexScores[indexes[triangle * 3]] + vertexScores[indexes[triangle * 3 + 1]] + vertexScores[indexes[triangle * 3 + 2]];
+
+        if (score > bestTriangleScore)
+        {
+            bestTriangleScore = score;
+            bestTriangle      = triangle;
+        }
+    }
+
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indexes.size());
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    int scanCursor = 0;
+
+    for (int added = 0; added < triangleCount; ++added)
+    {
+        if (bestTriangle < 0)
+        {
+            // Nothing in the cache has triangles left: restart from the next unadded triangle.
+            while (isTriangleAdded[scanCursor]) ++scanCursor;
+            bestTriangle = scanCursor;
+        }
+
+        isTriangleAdded[bestTriangle] = true;
+
+        uint32_t const* corners = &indexes[bestTriangle * 3];
+
+        nextCache.assign(corners, corners + 3);
+
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            uint32_t const vertex = corners[corner];
+            reordered.push_back(vertex);
+
+            int* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+            int& remaining       = remainingTriangles[vertex];
+
+            for (int i = 0; i < remaining; ++i)
+            {
+                if (vertexTriangles[i] == bestTriangle)
+                {
+                    vertexTriangles[i] = vertexTriangles[remaining - 1];
+                    --remaining;
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t const vertex : cache)
+        {
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) nextCache.push_back(vertex);
+        }
+
+        // Vertexes pushed past the cache are evicted; rescore them too so their triangles lose the bonus.
+        for (int position = 0; position < static_cast<int>(nextCache.size()); ++position)
+        {
+            uint32_t const vertex = nextCache[position];
+
+            cachePositions[vertex] = position < FORSYTH_CACHE_SIZE ? position : -1;
+            vertexScores[vertex]   = GetForsythVertexScore(cachePositions[vertex], remainingTriangles[vertex]);
+        }
+
+        if (static_cast<int>(nextCache.size()) > FORSYTH_CACHE_SIZE) nextCache.resize(FORSYTH_CACHE_SIZE);
+
+        cache.swap(nextCache);
+
+        bestTriangle      = -1;
+        bestTriangleScore = -1.f;
+
+        for (uint32_t const vertex : cache)
+        {
+            int const* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+
+            for (int i = 0; i < remainingTriangles[vertex]; ++i)
+            {
+                int const       triangle = vertexTriangles[i];
+                uint32_t const* tri      = &indexes[triangle * 3];
+                float const     score    = vertexScores[tri[0]] + vertexScores[tri[1]] + vertexScores[tri[2]];
+
+                if (score > bestTriangleScore)
+                {
+                    bestTriangleScore = score;
+                    bestTriangle      = triangle;
+                }
+            }
+        }
+    }
+
+    indexes.swap(reordered);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Renumbers vertexes in the order the index buffer first references them; drops unreferenced ones.
+//
+void OptimizeVertexFetchOrder(VertexList_PCU& vertexes, std::vector<uint32_t>& indexes)
+{
+    std::vector<uint32_t> remap(vertexes.size(), UINT32_MAX);
+    VertexList_PCU        reordered;
+    reordered.reserve(vertexes.size());
+
+    for (uint32_t& index : indexes)
+    {
+        if (remap[index] == UINT32_MAX)
+        {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(vertexes[index]);
+        }
+
+        index = remap[index];
+    }
+
+    vertexes.swap(reordered);
+}
+
+//----------------------------------------------------------------------------------------------------
+float ComputeACMR(std::vector<uint32_t> const& indexes, int const vertexCount, int const cacheSize)
+{
+    int const triangleCount = static_cast<int>(indexes.size() / 3);
+    if (triangleCount == 0) return 0.f;
+
+    // FIFO of cacheSize entries: a hit does not refresh the entry, as on post-transform caches in hardware.
+    std::vector<int> insertedAt(vertexCount, INT32_MIN / 2);
+    int              misses = 0;
+
+    for (uint32_t const index : indexes)
+    {
+        if (misses - insertedAt[index] >= cacheSize)
+        {
+            insertedAt[index] = misses;
+            ++misses;
+        }
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+float ComputeACMR(sIndexedMesh const& mesh, int const cacheSize)
+{
+    int const             indexCount = mesh.GetIndexCount();
+    std::vector<uint32_t> indexes(static_cast<size_t>(indexCount));
+
+    for (int indexIndex = 0; indexIndex < indexCount; ++indexIndex)
+    {
+        indexes[indexIndex] = mesh.GetIndex(indexIndex);
+    }
+
+    return ComputeACMR(indexes, mesh.GetVertexCount(), cacheSize);
+}
@@ -0,0 +1,58 @@
+//----------------------------------------------------------------------------------------------------
+// IndexedMesh.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/VertexUtils.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+enum class eIndexFormat : uint8_t
+{
+    UINT16,
+    UINT32
+};
+
+//----------------------------------------------------------------------------------------------------
+// Deduplicated vertexes plus a triangle-list index buffer. Indexes are 16-bit whenever every vertex is
+// addressable with 16 bits, which halves the index buffer of every prop mesh in the game.
+//
+struct sIndexedMesh
+{
+    VertexList_PCU        m_vertexes;
+    std::vector<uint16_t> m_indexes16;      // Used when m_indexFormat is UINT16
+    std::vector<uint32_t> m_indexes32;      // Used when m_indexFormat is UINT32
+    eIndexFormat          m_indexFormat = eIndexFormat::UINT16;
+
+    void SetIndexes(std::vector<uint32_t> const& indexes);
+
+    int         GetVertexCount() const;
+    int         GetIndexCount() const;
+    uint32_t    GetIndex(int indexIndex) const;
+    void const* GetIndexData() const;
+    int         GetIndexStride() const;
+    size_t      GetVertexBytes() const;
+    size_t      GetIndexBytes() const;
+    void        ExpandToTriangleList(VertexList_PCU& out_triangleList) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Builds an indexed mesh from the non-indexed triangle lists the AddVertsFor* helpers emit: bit-identical
+// vertexes are merged, triangles are reordered for the post-transform vertex cache (Forsyth) and the
+// vertexes are renumbered in first-use order so fetches walk the vertex buffer forwards.
+//
+void BuildIndexedMesh(VertexList_PCU const& triangleList, sIndexedMesh& out_mesh, bool optimizeOrder = true);
+void DeduplicateVertexes(VertexList_PCU const& triangleList, VertexList_PCU& out_vertexes, std::vector<uint32_t>& out_indexes);
+void OptimizeVertexCacheOrder(std::vector<uint32_t>& indexes, int vertexCount);
+void OptimizeVertexFetchOrder(VertexList_PCU& vertexes, std::vector<uint32_t>& indexes);
+
+//----------------------------------------------------------------------------------------------------
+// Average cache miss ratio: post-transform cache misses per triangle with a FIFO cache of cacheSize
+// vertexes. 3.0 is the worst case (every vertex transformed per triangle); ~0.5-0.7 is good for grids.
+//
+float ComputeACMR(std::vector<uint32_t> const& indexes, int vertexCount, int cacheSize = 16);
+float ComputeACMR(sIndexedMesh const& mesh, int cacheSize = 16);
@@ -0,0 +1,189 @@
+//----------------------------------------------------------------------------------------------------
+// ParallelFor.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/ParallelFor.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+//----------------------------------------------------------------------------------------------------
+struct sParallelForContext
+{
+    ParallelFor::RangeFunction const* m_function   = nullptr;
+    int                               m_itemCount  = 0;
+    int                               m_chunkItems = 0;
+    int                               m_chunkCount = 0;
+    std::atomic<int>                  m_nextChunk  = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Runs chunks until the counter passes the last one; shared by the workers and the calling thread.
+    void RunChunks(sParallelForContext& context)
+    {
+        for (int chunk = context.m_nextChunk.fetch_add(1); chunk < context.m_chunkCount; chunk = context.m_nextChunk.fetch_add(1))
+        {
+            int const beginIndex = chunk * context.m_chunkItems;
+            int const endIndex   = std::min(beginIndex + context.m_chunkItems, context.m_itemCount);
+
+            (*context.m_function)(beginIndex, endIndex);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ParallelForWorkers::ParallelForWorkers(int const workerCount)
+{
+    m_threads.reserve(static_cast<size_t>(std::max(workerCount, 0)));
+
+    for (int workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        m_threads.emplace_back(&ParallelForWorkers::RunWorker, this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Must not run while a Run is using the workers.
+//
+ParallelForWorkers::~ParallelForWorkers()
+{
+    {
+        std::scoped_lock const lock(m_mutex);
+        m_isStopping = true;
+    }
+
+    m_postedCondition.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int ParallelForWorkers::GetWorkerCount() const
+{
+    return static_cast<int>(m_threads.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Workers offered to or working on a Run that has not returned yet; zero whenever no Run is in
+// progress, which benchmarks check after each frame.
+//
+int ParallelForWorkers::GetOutstandingHelperCount() const
+{
+    std::scoped_lock const lock(m_mutex);
+    return m_openHelperSlots + m_activeHelperCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Offers context to helperCount workers. False if another Run holds the workers.
+//
+bool ParallelForWorkers::Post(sParallelForContext& context, int const helperCount)
+{
+    {
+        std::scoped_lock const lock(m_mutex);
+
+        if (m_postedContext != nullptr) return false;
+
+        m_postedContext   = &context;
+        m_openHelperSlots = helperCount;
+    }
+
+    m_postedCondition.notify_all();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Closes the posted Run to workers that have not joined yet and waits for the ones that did to leave.
+//
+void ParallelForWorkers::Withdraw()
+{
+    std::unique_lock lock(m_mutex);
+
+    m_openHelperSlots = 0;
+    m_leftCondition.wait(lock, [this]() { return m_activeHelperCount == 0; });
+    m_postedContext = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ParallelForWorkers::RunWorker()
+{
+    std::unique_lock lock(m_mutex);
+
+    for (;;)
+    {
+        m_postedCondition.wait(lock, [this]() { return m_isStopping || m_openHelperSlots > 0; });
+
+        if (m_isStopping) return;
+
+        sParallelForContext& context = *m_postedContext;
+
+        --m_openHelperSlots;
+        ++m_activeHelperCount;
+        lock.unlock();
+
+        RunChunks(context);
+
+        lock.lock();
+
+        if (--m_activeHelperCount == 0) m_leftCondition.notify_all();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sParallelForStats ParallelFor::Run(ParallelForWorkers*  workers,
+                                          int const            threadCount,
+                                          int const            itemCount,
+                                          int const            itemBytes,
+                                          RangeFunction const& function,
+                                          int const            serialThreshold)
+{
+    sParallelForStats stats;
+    stats.m_itemCount = itemCount;
+
+    if (itemCount <= 0) return stats;
+
+    if (workers == nullptr || workers->GetWorkerCount() == 0 || threadCount <= 1 || itemCount < serialThreshold)
+    {
+        stats.m_chunkItems = itemCount;
+        stats.m_chunkCount = 1;
+
+        function(0, itemCount);
+
+        return stats;
+    }
+
+    // Smallest item count that spans whole cache lines, e.g. 16 items of a 12-byte Vec3 (3 lines).
+    int const lineItems   = CACHE_LINE_BYTES / std::gcd(CACHE_LINE_BYTES, std::max(itemBytes, 1));
+    int const chunkTarget = threadCount * CHUNKS_PER_THREAD;
+    int const chunkItems  = std::max((itemCount + chunkTarget - 1) / chunkTarget + lineItems - 1, lineItems) / lineItems * lineItems;
+
+    sParallelForContext context;
+    context.m_function   = &function;
+    context.m_itemCount  = itemCount;
+    context.m_chunkItems = chunkItems;
+    context.m_chunkCount = (itemCount + chunkItems - 1) / chunkItems;
+
+    int const  helperCount = std::min({threadCount - 1, workers->GetWorkerCount(), context.m_chunkCount - 1});
+    bool const isPosted    = helperCount > 0 && workers->Post(context, helperCount);
+
+    RunChunks(context);
+
+    // Every chunk is claimed; wait for the ones workers are still running before context goes away.
+    if (isPosted) workers->Withdraw();
+
+    stats.m_chunkItems  = chunkItems;
+    stats.m_chunkCount  = context.m_chunkCount;
+    stats.m_helperCount = isPosted ? helperCount : 0;
+    stats.m_wasSerial   = !isPosted;
+
+    return stats;
+}
@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------------------------------
+// ParallelFor.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct sParallelForContext;
+
+//----------------------------------------------------------------------------------------------------
+struct sParallelForStats
+{
+    int  m_itemCount   = 0;
+    int  m_chunkItems  = 0;         // Items per chunk; the last chunk may be shorter
+    int  m_chunkCount  = 0;
+    int  m_helperCount = 0;         // Workers offered a share of the chunks; the calling thread works alongside them
+    bool m_wasSerial   = true;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Persistent helper threads for ParallelFor. They sleep on a condition variable between Runs, so a
+// parallel loop allocates nothing and leaves nothing behind: no job objects, no completed queue for
+// anyone else to drain. One Run holds the workers at a time; a Run that finds them taken (another
+// thread's, or one nested inside a chunk) runs its chunks on the calling thread alone.
+//
+// Kept apart from the engine JobSystem on purpose: its completed jobs must be retrieved and deleted by
+// the client that submitted them, and that queue is shared with GEngine.
+//
+class ParallelForWorkers
+{
+public:
+    explicit ParallelForWorkers(int workerCount);
+    ~ParallelForWorkers();
+
+    ParallelForWorkers(ParallelForWorkers const&)            = delete;
+    ParallelForWorkers& operator=(ParallelForWorkers const&) = delete;
+
+    int GetWorkerCount() const;
+    int GetOutstandingHelperCount() const;
+
+private:
+    friend class ParallelFor;
+
+    bool Post(sParallelForContext& context, int helperCount);
+    void Withdraw();
+    void RunWorker();
+
+    std::vector<std::thread> m_threads;
+    mutable std::mutex       m_mutex;
+    std::condition_variable  m_postedCondition;
+    std::condition_variable  m_leftCondition;
+    sParallelForContext*     m_postedContext     = nullptr;   // The Run holding the workers, if any
+    int                      m_openHelperSlots   = 0;         // Workers that may still join it
+    int                      m_activeHelperCount = 0;         // Workers inside it
+    bool                     m_isStopping        = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+// parallel_for over an index range on ParallelForWorkers.
+//
+// The range is cut into chunks whose item count is a multiple of the items per 64-byte cache line, so
+// for arrays of itemBytes-sized elements no two chunks write into the same line (relative to the array
+// start), and the chunk size targets CHUNKS_PER_THREAD chunks per thread for load balance. Up to
+// threadCount - 1 workers are offered the call; they and the calling thread claim chunks from a shared
+// atomic counter until none are left, so the call never depends on when (or whether) a worker wakes.
+// Ranges below serialThreshold items, a threadCount of 1 or null workers run serially on the calling
+// thread with no overhead.
+//
+// Run returns once every chunk has run and every worker that joined has left, so the call's state
+// lives on its stack and nothing refers to it afterwards.
+//
+class ParallelFor
+{
+public:
+    static int constexpr CACHE_LINE_BYTES         = 64;
+    static int constexpr CHUNKS_PER_THREAD        = 4;
+    static int constexpr DEFAULT_SERIAL_THRESHOLD = 8192;
+
+    using RangeFunction = std::function<void(int beginIndex, int endIndex)>;
+
+    static sParallelForStats Run(ParallelForWorkers* workers, int threadCount, int itemCount, int itemBytes, RangeFunction const& function, int serialThreshold = DEFAULT_SERIAL_THRESHOLD);
+};
@@ -19,7 +19,7 @@ Player::Player(Game* owner)
 {
     m_worldCamera = new Camera();
 
-    m_worldCamera->SetPerspectiveGraphicView(2.f, 60.f, 0.1f, 100.f);
+    m_worldCamera->SetPerspectiveGraphicView(CAMERA_ASPECT, CAMERA_FOV_DEGREES, CAMERA_NEAR, CAMERA_FAR);
 
     m_worldCamera->SetNormalizedViewport(AABB2::ZERO_TO_ONE);
 
@@ -129,3 +129,11 @@ Camera* Player::GetCamera() const
 {
     return m_worldCamera;
 }
+
+//----------------------------------------------------------------------------------------------------
+// World-space view volume of the camera as last placed by Update.
+//
+sFrustum Player::GetCameraFrustum() const
+{
+    return sFrustum::CreatePerspective(m_worldCamera->GetPosition(), m_worldCamera->GetOrientation(), CAMERA_ASPECT, CAMERA_FOV_DEGREES, CAMERA_NEAR, CAMERA_FAR);
+}
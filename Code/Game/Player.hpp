@@ -6,6 +6,7 @@
 #pragma once
 //----------------------------------------------------------------------------------------------------
 #include "Game/Entity.hpp"
+#include "Game/Frustum.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class Camera;
@@ -14,6 +15,11 @@ class Camera;
 class Player : public Entity
 {
 public:
+    static float constexpr CAMERA_ASPECT      = 2.f;
+    static float constexpr CAMERA_FOV_DEGREES = 60.f;
+    static float constexpr CAMERA_NEAR        = 0.1f;
+    static float constexpr CAMERA_FAR         = 100.f;
+
     explicit Player(Game* owner);
     ~Player() override;
 
@@ -22,7 +28,8 @@ public:
     void UpdateFromKeyBoard();
     void UpdateFromController();
 
-    Camera* GetCamera() const;
+    Camera*  GetCamera() const;
+    sFrustum GetCameraFrustum() const;
 
 private:
     Camera* m_worldCamera = nullptr;
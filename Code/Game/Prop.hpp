@@ -5,28 +5,35 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 //----------------------------------------------------------------------------------------------------
-#include "Game/Entity.hpp"
+#include "Game/PropMeshCache.hpp"
+#include "Game/PropRenderBackend.hpp"
+#include "Game/ResourceHandleTable.hpp"
 //----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
 #include "Engine/Renderer/VertexUtils.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
-class Texture;
 struct Vertex_PCU;
 
 //----------------------------------------------------------------------------------------------------
-class Prop : public Entity
+// Render component of a prop: a shared mesh handle, a texture handle and the pipeline state it is drawn with.
+// Transform, motion and color live in the PropStore arrays and the vertexes in PropMeshCache;
+// PropStore::SubmitDraws combines them into PropDrawQueue items.
+//
+class Prop
 {
 public:
-    explicit Prop(Game* owner, Texture const* texture = nullptr);
+    explicit Prop(PropMeshHandle mesh = INVALID_PROP_MESH, TextureHandle texture = INVALID_RESOURCE_HANDLE, sPropRenderState const& renderState = sPropRenderState());
 
-    void Update(float deltaSeconds) override;
-    void Render() const override;
+    void SetTexture(TextureHandle texture);
 
-    void InitializeLocalVertsForCube();
-    void InitializeLocalVertsForSphere();
-    void InitializeLocalVertsForGrid();
+    PropMeshHandle          GetMesh() const;
+    TextureHandle           GetTexture() const;
+    sPropRenderState const& GetRenderState() const;
 
 private:
-    std::vector<Vertex_PCU> m_vertexes;
-    Texture const*          m_texture = nullptr;
+    PropMeshHandle   m_mesh    = INVALID_PROP_MESH;
+    TextureHandle    m_texture = INVALID_RESOURCE_HANDLE;
+    sPropRenderState m_renderState;
 };
@@ -0,0 +1,627 @@
+//----------------------------------------------------------------------------------------------------
+// PropBVH.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropBVH.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    void ExpandToInclude(AABB3& bounds, AABB3 const& other)
+    {
+        bounds.m_mins.x = std::min(bounds.m_mins.x, other.m_mins.x);
+        bounds.m_mins.y = std::min(bounds.m_mins.y, other.m_mins.y);
+        bounds.m_mins.z = std::min(bounds.m_mins.z, other.m_mins.z);
+        bounds.m_maxs.x = std::max(bounds.m_maxs.x, other.m_maxs.x);
+        bounds.m_maxs.y = std::max(bounds.m_maxs.y, other.m_maxs.y);
+        bounds.m_maxs.z = std::max(bounds.m_maxs.z, other.m_maxs.z);
+    }
+
+    float GetSurfaceArea(AABB3 const& bounds)
+    {
+        Vec3 const extents = bounds.m_maxs - bounds.m_mins;
+
+        return 2.f * (extents.x * extents.y + extents.y * extents.z + extents.z * extents.x);
+    }
+
+    // Surface area the box would gain by growing to include other.
+    float GetSurfaceAreaGrowth(AABB3 const& bounds, AABB3 const& other)
+    {
+        AABB3 grown = bounds;
+        ExpandToInclude(grown, other);
+
+        return GetSurfaceArea(grown) - GetSurfaceArea(bounds);
+    }
+
+    bool AreBoundsEqual(AABB3 const& a, AABB3 const& b)
+    {
+        return a.m_mins == b.m_mins && a.m_maxs == b.m_maxs;
+    }
+
+    // Twice the box center; only compared, so the halving is skipped.
+    Vec3 GetCentroid(AABB3 const& bounds)
+    {
+        return bounds.m_mins + bounds.m_maxs;
+    }
+
+    float GetAxisValue(Vec3 const& vector, int const axis)
+    {
+        if (axis == 0) return vector.x;
+        if (axis == 1) return vector.y;
+        return vector.z;
+    }
+
+    // The axis along which the items' centroids spread the most.
+    int GetSplitAxis(int const* itemIds, int const itemCount, std::vector<AABB3> const& boundsById)
+    {
+        Vec3 const firstCentroid = GetCentroid(boundsById[itemIds[0]]);
+        AABB3      centroidBounds(firstCentroid, firstCentroid);
+
+        for (int itemIndex = 1; itemIndex < itemCount; ++itemIndex)
+        {
+            Vec3 const centroid = GetCentroid(boundsById[itemIds[itemIndex]]);
+            ExpandToInclude(centroidBounds, AABB3(centroid, centroid));
+        }
+
+        Vec3 const extents = centroidBounds.m_maxs - centroidBounds.m_mins;
+
+        return extents.x >= extents.y && extents.x >= extents.z ? 0 : extents.y >= extents.z ? 1 : 2;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropBVH::Clear()
+{
+    m_nodes.clear();
+    m_freeNodePairs.clear();
+    m_itemBounds.clear();
+    m_leafByItem.clear();
+    m_pendingItems.clear();
+    m_dirtyNodes.clear();
+    m_itemCount     = 0;
+    m_maxDepth      = 0;
+    m_builtRootArea = 0.f;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Queues the item for the next Refit; an item already in the tree just takes the new bounds.
+//
+void PropBVH::InsertItem(int const itemId, AABB3 const& bounds)
+{
+    ReserveItemId(itemId);
+
+    if (m_leafByItem[itemId] >= 0)
+    {
+        UpdateItem(itemId, bounds);
+        return;
+    }
+
+    m_itemBounds[itemId] = bounds;
+
+    if (m_leafByItem[itemId] == PENDING) return;
+
+    m_leafByItem[itemId] = PENDING;
+    m_pendingItems.push_back(itemId);
+
+    // Ids removed while pending stay queued; without a Refit (stores that never cull) churn would grow
+    // the queue forever, so it is rebuilt from the states once it outgrows the ids
+    if (m_pendingItems.size() <= 2 * m_leafByItem.size() + 64) return;
+
+    m_pendingItems.clear();
+
+    for (int id = 0; id < static_cast<int>(m_leafByItem.size()); ++id)
+    {
+        if (m_leafByItem[id] == PENDING) m_pendingItems.push_back(id);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// O(1) apart from a collapse: the item leaves its leaf right away and the leaf's bounds shrink on the
+// next Refit. Ids that are not in the tree are ignored.
+//
+void PropBVH::RemoveItem(int const itemId)
+{
+    if (itemId < 0 || itemId >= static_cast<int>(m_leafByItem.size())) return;
+
+    int const leafIndex  = m_leafByItem[itemId];
+    m_leafByItem[itemId] = NOT_IN_TREE;
+
+    // A pending id stays in the queue; draining skips it since it is no longer PENDING
+    if (leafIndex < 0) return;
+
+    sNode&     leaf     = m_nodes[leafIndex];
+    int* const itemsEnd = leaf.m_items + leaf.m_itemCount;
+
+    *std::find(leaf.m_items, itemsEnd, itemId) = *(itemsEnd - 1);
+    --leaf.m_itemCount;
+    --m_itemCount;
+
+    if (leaf.m_itemCount > 0)
+    {
+        MarkDirty(leafIndex);
+    }
+    else if (leaf.m_parent >= 0)
+    {
+        CollapseIntoParent(leafIndex);
+    }
+    else
+    {
+        m_nodes.clear();
+        m_freeNodePairs.clear();
+        m_dirtyNodes.clear();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Ids that are not in the tree are ignored; unchanged bounds leave the leaf clean.
+//
+void PropBVH::UpdateItem(int const itemId, AABB3 const& bounds)
+{
+    if (itemId < 0 || itemId >= static_cast<int>(m_leafByItem.size()) || m_leafByItem[itemId] == NOT_IN_TREE) return;
+    if (AreBoundsEqual(m_itemBounds[itemId], bounds)) return;
+
+    m_itemBounds[itemId] = bounds;
+
+    if (m_leafByItem[itemId] >= 0) MarkDirty(m_leafByItem[itemId]);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Adds the pending items, then recomputes the dirty nodes and walks up from each one until a parent's
+// bounds stop changing. Rebuilds the tree instead when NeedsRebuild, before or after the inserts.
+// Returns the number of nodes recomputed.
+//
+int PropBVH::Refit(bool* out_wasRebuilt)
+{
+    int refitCount = 0;
+
+    if (!NeedsRebuild())
+    {
+        // Not a bulk load, so the tree already has a root to insert under
+        for (int const itemId : m_pendingItems)
+        {
+            if (m_leafByItem[itemId] == PENDING) InsertPendingItem(itemId);
+        }
+
+        m_pendingItems.clear();
+
+        for (int const dirtyIndex : m_dirtyNodes)
+        {
+            // Listed twice, or released by a collapse since
+            if (!m_nodes[dirtyIndex].m_isDirty) continue;
+
+            m_nodes[dirtyIndex].m_isDirty = false;
+
+            for (int nodeIndex = dirtyIndex; nodeIndex >= 0; nodeIndex = m_nodes[nodeIndex].m_parent)
+            {
+                ++refitCount;
+
+                if (!RefitNode(nodeIndex)) break;
+            }
+        }
+
+        m_dirtyNodes.clear();
+    }
+
+    // Inserts along a line can deepen the tree past what the culling stack allows
+    bool const isRebuilding = NeedsRebuild();
+
+    if (isRebuilding) Rebuild();
+    if (out_wasRebuilt != nullptr) *out_wasRebuilt = isRebuilding;
+
+    return refitCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rebuilds the tree top-down from every item in it or pending, splitting at the centroid median of the
+// axis along which the centroids spread the most.
+//
+void PropBVH::Rebuild()
+{
+    m_buildItems.clear();
+
+    for (int itemId = 0; itemId < static_cast<int>(m_leafByItem.size()); ++itemId)
+    {
+        if (m_leafByItem[itemId] != NOT_IN_TREE) m_buildItems.push_back(itemId);
+    }
+
+    m_nodes.clear();
+    m_freeNodePairs.clear();
+    m_pendingItems.clear();
+    m_dirtyNodes.clear();
+    m_itemCount     = static_cast<int>(m_buildItems.size());
+    m_maxDepth      = 0;
+    m_builtRootArea = 0.f;
+
+    if (m_buildItems.empty()) return;
+
+    m_nodes.reserve(m_buildItems.size() * 2 / MAX_LEAF_ITEMS + 1);
+
+    struct sPendingRange
+    {
+        int m_nodeIndex;
+        int m_firstItem;
+        int m_itemCount;
+        int m_depth;
+    };
+
+    sNode root;
+    root.m_bounds = ComputeItemBounds(m_buildItems.data(), m_itemCount);
+    m_nodes.push_back(root);
+
+    std::vector<sPendingRange> pendingRanges = {{0, 0, m_itemCount, 1}};
+
+    while (!pendingRanges.empty())
+    {
+        sPendingRange const range = pendingRanges.back();
+        pendingRanges.pop_back();
+
+        int* const rangeItems = m_buildItems.data() + range.m_firstItem;
+
+        if (range.m_itemCount <= MAX_LEAF_ITEMS)
+        {
+            sNode& leaf      = m_nodes[range.m_nodeIndex];
+            leaf.m_itemCount = range.m_itemCount;
+
+            for (int itemIndex = 0; itemIndex < range.m_itemCount; ++itemIndex)
+            {
+                leaf.m_items[itemIndex]            = rangeItems[itemIndex];
+                m_leafByItem[rangeItems[itemIndex]] = range.m_nodeIndex;
+            }
+
+            m_maxDepth = std::max(m_maxDepth, range.m_depth);
+            continue;
+        }
+
+        int const axis      = GetSplitAxis(rangeItems, range.m_itemCount, m_itemBounds);
+        int const leftCount = range.m_itemCount / 2;
+
+        std::nth_element(rangeItems, rangeItems + leftCount, rangeItems + range.m_itemCount, [this, axis](int const a, int const b)
+        {
+            return GetAxisValue(GetCentroid(m_itemBounds[a]), axis) < GetAxisValue(GetCentroid(m_itemBounds[b]), axis);
+        });
+
+        int const firstChild = AllocateNodePair();
+
+        m_nodes[firstChild].m_parent     = range.m_nodeIndex;
+        m_nodes[firstChild].m_bounds     = ComputeItemBounds(rangeItems, leftCount);
+        m_nodes[firstChild + 1].m_parent = range.m_nodeIndex;
+        m_nodes[firstChild + 1].m_bounds = ComputeItemBounds(rangeItems + leftCount, range.m_itemCount - leftCount);
+        m_nodes[range.m_nodeIndex].m_firstChild = firstChild;
+
+        pendingRanges.push_back({firstChild, range.m_firstItem, leftCount, range.m_depth + 1});
+        pendingRanges.push_back({firstChild + 1, range.m_firstItem + leftCount, range.m_itemCount - leftCount, range.m_depth + 1});
+    }
+
+    m_builtRootArea = GetSurfaceArea(m_nodes[0].m_bounds);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends the ids of every item whose bounds overlap the frustum (conservatively). Call after Refit:
+// pending items are not in the tree yet.
+//
+void PropBVH::CullFrustum(sFrustum const& frustum, std::vector<int>& out_visibleItemIds, sPropCullStats& inout_stats) const
+{
+    if (m_nodes.empty()) return;
+
+    struct sPendingNode
+    {
+        int     m_nodeIndex;
+        uint8_t m_planeMask;
+    };
+
+    sPendingNode pendingNodes[2 * MAX_DEPTH];
+    int          pendingCount = 0;
+
+    pendingNodes[pendingCount++] = {0, sFrustum::ALL_PLANES};
+
+    while (pendingCount > 0)
+    {
+        sPendingNode const pending   = pendingNodes[--pendingCount];
+        sNode const&       node      = m_nodes[pending.m_nodeIndex];
+        uint8_t            planeMask = pending.m_planeMask;
+
+        ++inout_stats.m_nodesVisited;
+
+        eFrustumTest const test = frustum.TestAABB(node.m_bounds, planeMask);
+
+        if (test == eFrustumTest::OUTSIDE) continue;
+
+        if (test == eFrustumTest::INSIDE)
+        {
+            size_t const visibleBefore = out_visibleItemIds.size();
+
+            AppendSubtreeItems(pending.m_nodeIndex, out_visibleItemIds);
+            inout_stats.m_visibleCount += static_cast<int>(out_visibleItemIds.size() - visibleBefore);
+            continue;
+        }
+
+        if (node.m_firstChild < 0)
+        {
+            for (int itemIndex = 0; itemIndex < node.m_itemCount; ++itemIndex)
+            {
+                uint8_t itemPlaneMask = planeMask;
+
+                if (frustum.TestAABB(m_itemBounds[node.m_items[itemIndex]], itemPlaneMask) != eFrustumTest::OUTSIDE)
+                {
+                    out_visibleItemIds.push_back(node.m_items[itemIndex]);
+                    ++inout_stats.m_visibleCount;
+                }
+            }
+
+            continue;
+        }
+
+        // Refit keeps leaves within MAX_DEPTH, and the stack never holds more than one entry per level plus one.
+        pendingNodes[pendingCount++] = {node.m_firstChild + 1, planeMask};
+        pendingNodes[pendingCount++] = {node.m_firstChild, planeMask};
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PropBVH::IsEmpty() const
+{
+    return m_nodes.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+// True for a bulk load (pending items at least a quarter of the tree, which includes the first load),
+// for a root grown past twice its surface area at build time, and for a leaf deeper than MAX_DEPTH.
+//
+bool PropBVH::NeedsRebuild() const
+{
+    if (!m_pendingItems.empty() && static_cast<int>(m_pendingItems.size()) * 4 >= m_itemCount) return true;
+    if (m_nodes.empty()) return false;
+
+    return m_maxDepth > MAX_DEPTH || GetSurfaceArea(m_nodes[0].m_bounds) > m_builtRootArea * 2.f;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropBVH::GetItemCount() const
+{
+    return m_itemCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Includes released child pairs waiting for reuse.
+//
+int PropBVH::GetNodeCount() const
+{
+    return static_cast<int>(m_nodes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB3 const& PropBVH::GetItemBounds(int const itemId) const
+{
+    return m_itemBounds[itemId];
+}
+
+//----------------------------------------------------------------------------------------------------
+// Descends from the root into the child whose surface area grows least, growing every node on the way,
+// and adds the item to the leaf it reaches.
+//
+void PropBVH::InsertPendingItem(int const itemId)
+{
+    AABB3 const& bounds    = m_itemBounds[itemId];
+    int          nodeIndex = 0;
+    int          depth     = 1;
+
+    while (m_nodes[nodeIndex].m_firstChild >= 0)
+    {
+        sNode& node = m_nodes[nodeIndex];
+        ExpandToInclude(node.m_bounds, bounds);
+
+        AABB3 const& leftBounds  = m_nodes[node.m_firstChild].m_bounds;
+        AABB3 const& rightBounds = m_nodes[node.m_firstChild + 1].m_bounds;
+        float const  leftGrowth  = GetSurfaceAreaGrowth(leftBounds, bounds);
+        float const  rightGrowth = GetSurfaceAreaGrowth(rightBounds, bounds);
+        bool const   isLeft      = leftGrowth < rightGrowth || (leftGrowth == rightGrowth && GetSurfaceArea(leftBounds) <= GetSurfaceArea(rightBounds));
+
+        nodeIndex = isLeft ? node.m_firstChild : node.m_firstChild + 1;
+        ++depth;
+    }
+
+    ++m_itemCount;
+
+    sNode& leaf = m_nodes[nodeIndex];
+    ExpandToInclude(leaf.m_bounds, bounds);
+
+    if (leaf.m_itemCount == MAX_LEAF_ITEMS)
+    {
+        SplitLeaf(nodeIndex, itemId, depth);
+        return;
+    }
+
+    leaf.m_items[leaf.m_itemCount++] = itemId;
+    m_leafByItem[itemId]             = nodeIndex;
+    m_maxDepth                       = std::max(m_maxDepth, depth);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Turns a full leaf into the parent of two leaves holding its items plus itemId, split at the centroid
+// median like Rebuild. The leaf's bounds already include itemId.
+//
+void PropBVH::SplitLeaf(int const leafIndex, int const itemId, int const depth)
+{
+    int items[MAX_LEAF_ITEMS + 1];
+    int constexpr itemCount = MAX_LEAF_ITEMS + 1;
+    int constexpr leftCount = itemCount / 2;
+
+    std::copy_n(m_nodes[leafIndex].m_items, MAX_LEAF_ITEMS, items);
+    items[MAX_LEAF_ITEMS] = itemId;
+
+    int const axis = GetSplitAxis(items, itemCount, m_itemBounds);
+
+    std::sort(items, items + itemCount, [this, axis](int const a, int const b)
+    {
+        return GetAxisValue(GetCentroid(m_itemBounds[a]), axis) < GetAxisValue(GetCentroid(m_itemBounds[b]), axis);
+    });
+
+    // Before taking any reference: the allocation may grow m_nodes
+    int const firstChild = AllocateNodePair();
+
+    for (int childIndex = firstChild; childIndex <= firstChild + 1; ++childIndex)
+    {
+        int const* childItems = childIndex == firstChild ? items : items + leftCount;
+        sNode&     child      = m_nodes[childIndex];
+
+        child.m_parent    = leafIndex;
+        child.m_itemCount = childIndex == firstChild ? leftCount : itemCount - leftCount;
+        child.m_bounds    = ComputeItemBounds(childItems, child.m_itemCount);
+
+        for (int itemIndex = 0; itemIndex < child.m_itemCount; ++itemIndex)
+        {
+            child.m_items[itemIndex]            = childItems[itemIndex];
+            m_leafByItem[childItems[itemIndex]] = childIndex;
+        }
+    }
+
+    m_nodes[leafIndex].m_firstChild = firstChild;
+    m_nodes[leafIndex].m_itemCount  = 0;
+    m_maxDepth                      = std::max(m_maxDepth, depth + 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The empty leaf's sibling takes the parent's place and the pair is released. The parent now has the
+// sibling's smaller bounds, so the grandparent is marked to shrink on the next Refit.
+//
+void PropBVH::CollapseIntoParent(int const leafIndex)
+{
+    int const parentIndex  = m_nodes[leafIndex].m_parent;
+    int const firstChild   = m_nodes[parentIndex].m_firstChild;
+    int const siblingIndex = leafIndex == firstChild ? firstChild + 1 : firstChild;
+    int const grandparent  = m_nodes[parentIndex].m_parent;
+
+    m_nodes[parentIndex]           = m_nodes[siblingIndex];
+    m_nodes[parentIndex].m_parent  = grandparent;
+    m_nodes[parentIndex].m_isDirty = false;
+
+    sNode const& moved = m_nodes[parentIndex];
+
+    if (moved.m_firstChild >= 0)
+    {
+        m_nodes[moved.m_firstChild].m_parent     = parentIndex;
+        m_nodes[moved.m_firstChild + 1].m_parent = parentIndex;
+    }
+    else
+    {
+        for (int itemIndex = 0; itemIndex < moved.m_itemCount; ++itemIndex)
+        {
+            m_leafByItem[moved.m_items[itemIndex]] = parentIndex;
+        }
+    }
+
+    // The sibling may have been dirty under its old index
+    if (m_nodes[siblingIndex].m_isDirty) MarkDirty(parentIndex);
+    if (grandparent >= 0) MarkDirty(grandparent);
+
+    // Released nodes are never refit, even while still listed as dirty
+    m_nodes[firstChild].m_isDirty     = false;
+    m_nodes[firstChild + 1].m_isDirty = false;
+
+    m_freeNodePairs.push_back(firstChild);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns the first of two adjacent, reset nodes; may grow m_nodes.
+//
+int PropBVH::AllocateNodePair()
+{
+    if (m_freeNodePairs.empty())
+    {
+        m_nodes.resize(m_nodes.size() + 2);
+
+        return static_cast<int>(m_nodes.size()) - 2;
+    }
+
+    int const firstChild = m_freeNodePairs.back();
+    m_freeNodePairs.pop_back();
+
+    m_nodes[firstChild]     = sNode();
+    m_nodes[firstChild + 1] = sNode();
+
+    return firstChild;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropBVH::MarkDirty(int const nodeIndex)
+{
+    if (m_nodes[nodeIndex].m_isDirty) return;
+
+    m_nodes[nodeIndex].m_isDirty = true;
+    m_dirtyNodes.push_back(nodeIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropBVH::ReserveItemId(int const itemId)
+{
+    if (itemId < static_cast<int>(m_leafByItem.size())) return;
+
+    m_itemBounds.resize(static_cast<size_t>(itemId) + 1);
+    m_leafByItem.resize(static_cast<size_t>(itemId) + 1, NOT_IN_TREE);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every item below the node, without testing it; for nodes fully inside the frustum.
+//
+void PropBVH::AppendSubtreeItems(int const nodeIndex, std::vector<int>& out_itemIds) const
+{
+    int pendingNodes[2 * MAX_DEPTH];
+    int pendingCount = 0;
+
+    pendingNodes[pendingCount++] = nodeIndex;
+
+    while (pendingCount > 0)
+    {
+        sNode const& node = m_nodes[pendingNodes[--pendingCount]];
+
+        if (node.m_firstChild < 0)
+        {
+            out_itemIds.insert(out_itemIds.end(), node.m_items, node.m_items + node.m_itemCount);
+            continue;
+        }
+
+        pendingNodes[pendingCount++] = node.m_firstChild + 1;
+        pendingNodes[pendingCount++] = node.m_firstChild;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB3 PropBVH::ComputeItemBounds(int const* itemIds, int const itemCount) const
+{
+    AABB3 bounds = m_itemBounds[itemIds[0]];
+
+    for (int itemIndex = 1; itemIndex < itemCount; ++itemIndex)
+    {
+        ExpandToInclude(bounds, m_itemBounds[itemIds[itemIndex]]);
+    }
+
+    return bounds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns whether the node's bounds changed.
+//
+bool PropBVH::RefitNode(int const nodeIndex)
+{
+    sNode& node = m_nodes[nodeIndex];
+    AABB3  bounds;
+
+    if (node.m_firstChild < 0)
+    {
+        bounds = ComputeItemBounds(node.m_items, node.m_itemCount);
+    }
+    else
+    {
+        bounds = m_nodes[node.m_firstChild].m_bounds;
+        ExpandToInclude(bounds, m_nodes[node.m_firstChild + 1].m_bounds);
+    }
+
+    if (AreBoundsEqual(bounds, node.m_bounds)) return false;
+
+    node.m_bounds = bounds;
+
+    return true;
+}
@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------------------------------
+// PropBVH.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/Frustum.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/AABB3.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sPropCullStats
+{
+    int  m_visibleCount = 0;
+    int  m_culledCount  = 0;
+    int  m_nodesVisited = 0;
+    int  m_refitNodes   = 0;        // Nodes whose bounds were recomputed before culling
+    bool m_wasRebuilt   = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Bounding-volume hierarchy over axis-aligned item bounds, for frustum culling props.
+//
+// Items are small non-negative ids with bounds indexed by id; PropStore uses handle slots, which do not
+// change when other props are destroyed. Rebuild splits top-down at the centroid median of the longest
+// axis, up to MAX_LEAF_ITEMS items per leaf. A node fully inside the frustum emits its subtree's items
+// without testing them.
+//
+// Nothing requires a rebuild:
+//   InsertItem  queues the item; Refit adds the queue one item at a time, descending to the child whose
+//               surface area grows least and splitting a full leaf in two, or rebuilds the whole tree
+//               when the queue is at least a quarter of the tree (a bulk load).
+//   RemoveItem  takes the item out of its leaf at once; a leaf left empty is replaced by its sibling.
+//   UpdateItem  marks the item's leaf.
+// Refit then recomputes only the marked leaves and walks up from each one until a parent's bounds stop
+// changing. Refitting and incremental inserts never reorder the tree, so it loosens as items travel
+// and can deepen under inserts along a line; NeedsRebuild also reports when the root has grown past
+// twice its surface area at build time or a leaf is deeper than MAX_DEPTH (the culling stack's bound),
+// and Refit rebuilds then.
+//
+class PropBVH
+{
+public:
+    static int constexpr MAX_LEAF_ITEMS = 4;
+    static int constexpr MAX_DEPTH      = 32;
+
+    void Clear();
+    void InsertItem(int itemId, AABB3 const& bounds);
+    void RemoveItem(int itemId);
+    void UpdateItem(int itemId, AABB3 const& bounds);
+    int  Refit(bool* out_wasRebuilt = nullptr);
+    void Rebuild();
+    void CullFrustum(sFrustum const& frustum, std::vector<int>& out_visibleItemIds, sPropCullStats& inout_stats) const;
+
+    bool         IsEmpty() const;
+    bool         NeedsRebuild() const;
+    int          GetItemCount() const;
+    int          GetNodeCount() const;
+    AABB3 const& GetItemBounds(int itemId) const;
+
+private:
+    static int constexpr NOT_IN_TREE = -1;
+    static int constexpr PENDING     = -2;
+
+    struct sNode
+    {
+        AABB3 m_bounds;
+        int   m_parent                = -1;
+        int   m_firstChild            = -1;     // Left child; the right one follows it. -1 for leaves
+        int   m_itemCount             = 0;      // Leaves only
+        int   m_items[MAX_LEAF_ITEMS] = {};     // Leaves only: item ids
+        bool  m_isDirty               = false;
+    };
+
+    void  InsertPendingItem(int itemId);
+    void  SplitLeaf(int leafIndex, int itemId, int depth);
+    void  CollapseIntoParent(int leafIndex);
+    int   AllocateNodePair();
+    void  MarkDirty(int nodeIndex);
+    void  ReserveItemId(int itemId);
+    void  AppendSubtreeItems(int nodeIndex, std::vector<int>& out_itemIds) const;
+    AABB3 ComputeItemBounds(int const* itemIds, int itemCount) const;
+    bool  RefitNode(int nodeIndex);
+
+    std::vector<sNode> m_nodes;                 // Root at 0 while the tree is not empty
+    std::vector<int>   m_freeNodePairs;         // First node of each released child pair
+    std::vector<AABB3> m_itemBounds;            // By item id
+    std::vector<int>   m_leafByItem;            // Item id -> leaf node, NOT_IN_TREE or PENDING
+    std::vector<int>   m_pendingItems;          // Inserted since the last Refit; may hold removed or repeated ids
+    std::vector<int>   m_dirtyNodes;
+    std::vector<int>   m_buildItems;            // Build scratch
+    int                m_itemCount     = 0;     // In the tree, not counting pending items
+    int                m_maxDepth      = 0;     // Deepest leaf since the last Build (removals never lower it)
+    float              m_builtRootArea = 0.f;
+};
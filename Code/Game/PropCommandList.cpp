@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------------------------------
+// PropCommandList.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropCommandList.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/IndexedMesh.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Keeps the capacity, so a list recorded every frame stops allocating once it has seen its peak.
+//
+void PropCommandList::Clear()
+{
+    m_commands.clear();
+    m_renderStates.clear();
+    m_textures.clear();
+    m_modelConstants.clear();
+    m_staticMeshes.clear();
+    m_dynamicMeshes.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Room for drawCount draws with a state and texture change each.
+//
+void PropCommandList::Reserve(int const drawCount)
+{
+    size_t const capacity = static_cast<size_t>(drawCount);
+
+    m_commands.reserve(capacity * 4);
+    m_renderStates.reserve(capacity);
+    m_textures.reserve(capacity);
+    m_modelConstants.reserve(capacity);
+    m_staticMeshes.reserve(capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropCommandList::SetRenderState(sPropRenderState const& state)
+{
+    m_commands.push_back(ePropCommandType::SET_RENDER_STATE);
+    m_renderStates.push_back(state);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropCommandList::SetTexture(Texture const* texture)
+{
+    m_commands.push_back(ePropCommandType::SET_TEXTURE);
+    m_textures.push_back(texture);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropCommandList::SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color)
+{
+    m_commands.push_back(ePropCommandType::SET_MODEL_CONSTANTS);
+    m_modelConstants.push_back({modelToWorldTransform, color});
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropCommandList::DrawStaticMesh(PropGpuMeshHandle const mesh)
+{
+    m_commands.push_back(ePropCommandType::DRAW_STATIC_MESH);
+    m_staticMeshes.push_back(mesh);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The mesh is expanded on replay, by the backend, not while recording.
+//
+void PropCommandList::DrawDynamicMesh(sIndexedMesh const& mesh)
+{
+    m_commands.push_back(ePropCommandType::DRAW_DYNAMIC_MESH);
+    m_dynamicMeshes.push_back(&mesh);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Issues the recorded calls in record order. The list is left as it was, so it can be replayed again.
+//
+void PropCommandList::Replay(PropRenderBackend& renderBackend) const
+{
+    size_t renderStateIndex    = 0;
+    size_t textureIndex        = 0;
+    size_t modelConstantsIndex = 0;
+    size_t staticMeshIndex     = 0;
+    size_t dynamicMeshIndex    = 0;
+
+    for (ePropCommandType const command : m_commands)
+    {
+        switch (command)
+        {
+        case ePropCommandType::SET_RENDER_STATE:
+            renderBackend.SetRenderState(m_renderStates[renderStateIndex++]);
+            break;
+
+        case ePropCommandType::SET_TEXTURE:
+            renderBackend.SetTexture(m_textures[textureIndex++]);
+            break;
+
+        case ePropCommandType::SET_MODEL_CONSTANTS:
+            {
+                sModelConstants const& modelConstants = m_modelConstants[modelConstantsIndex++];
+                renderBackend.SetModelConstants(modelConstants.m_modelToWorldTransform, modelConstants.m_color);
+                break;
+            }
+
+        case ePropCommandType::DRAW_STATIC_MESH:
+            renderBackend.DrawStaticMesh(m_staticMeshes[staticMeshIndex++]);
+            break;
+
+        case ePropCommandType::DRAW_DYNAMIC_MESH:
+            renderBackend.DrawDynamicMesh(*m_dynamicMeshes[dynamicMeshIndex++]);
+            break;
+
+        case ePropCommandType::COUNT:
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PropCommandList::IsEmpty() const
+{
+    return m_commands.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropCommandList::GetCommandCount() const
+{
+    return static_cast<int>(m_commands.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropCommandList::GetDrawCount() const
+{
+    return static_cast<int>(m_staticMeshes.size() + m_dynamicMeshes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Bytes of commands and arguments currently recorded (not the reserved capacity).
+//
+size_t PropCommandList::GetRecordedBytes() const
+{
+    return m_commands.size() * sizeof(ePropCommandType) +
+           m_renderStates.size() * sizeof(sPropRenderState) +
+           m_textures.size() * sizeof(Texture const*) +
+           m_modelConstants.size() * sizeof(sModelConstants) +
+           m_staticMeshes.size() * sizeof(PropGpuMeshHandle) +
+           m_dynamicMeshes.size() * sizeof(sIndexedMesh const*);
+}
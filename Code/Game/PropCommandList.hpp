@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------------------------------
+// PropCommandList.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropRenderBackend.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Texture;
+struct sIndexedMesh;
+
+//----------------------------------------------------------------------------------------------------
+enum class ePropCommandType : uint8_t
+{
+    SET_RENDER_STATE,
+    SET_TEXTURE,
+    SET_MODEL_CONSTANTS,
+    DRAW_STATIC_MESH,
+    DRAW_DYNAMIC_MESH,
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+// Recorded PropRenderBackend calls, replayed later against any backend.
+//
+// Each command is one byte; its arguments live in one array per command type and are consumed in order
+// on replay, so recording is a couple of appends and replay walks every array front to back. A list
+// holds no renderer objects of its own: textures and meshes are recorded by pointer, GPU meshes by
+// handle, and all of them must stay alive until the list is replayed.
+//
+// One thread writes a list at a time, and nothing is shared between lists, so any number of lists can be
+// recorded concurrently. Replay runs on the thread that owns the backend.
+//
+class PropCommandList
+{
+public:
+    void Clear();
+    void Reserve(int drawCount);
+
+    void SetRenderState(sPropRenderState const& state);
+    void SetTexture(Texture const* texture);
+    void SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color);
+    void DrawStaticMesh(PropGpuMeshHandle mesh);
+    void DrawDynamicMesh(sIndexedMesh const& mesh);
+
+    void Replay(PropRenderBackend& renderBackend) const;
+
+    bool   IsEmpty() const;
+    int    GetCommandCount() const;
+    int    GetDrawCount() const;
+    size_t GetRecordedBytes() const;
+
+private:
+    struct sModelConstants
+    {
+        Mat44 m_modelToWorldTransform;
+        Rgba8 m_color;
+    };
+
+    std::vector<ePropCommandType>    m_commands;
+    std::vector<sPropRenderState>    m_renderStates;
+    std::vector<Texture const*>      m_textures;
+    std::vector<sModelConstants>     m_modelConstants;
+    std::vector<PropGpuMeshHandle>   m_staticMeshes;
+    std::vector<sIndexedMesh const*> m_dynamicMeshes;
+};
@@ -0,0 +1,243 @@
+//----------------------------------------------------------------------------------------------------
+// PropDrawQueue.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropDrawQueue.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/IndexedMesh.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+void PropDrawQueue::Clear()
+{
+    m_items.clear();
+    m_sortEntries.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropDrawQueue::Reserve(int const itemCount)
+{
+    m_items.reserve(static_cast<size_t>(itemCount));
+    m_sortEntries.reserve(static_cast<size_t>(itemCount));
+    m_sortScratch.reserve(static_cast<size_t>(itemCount));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Depth is quantized to 16 bits over [0, maxDepth].
+//
+void PropDrawQueue::SetDepthRange(float const maxDepth)
+{
+    m_maxDepth = maxDepth > 0.f ? maxDepth : 1.f;
+}
+
+//----------------------------------------------------------------------------------------------------
+// depth is the view distance of the draw; it only orders draws, so any monotonic measure works.
+//
+void PropDrawQueue::Submit(sPropDrawItem const& item, float const depth)
+{
+    sSortEntry entry;
+    entry.m_key       = MakeSortKey(item, depth);
+    entry.m_itemIndex = static_cast<uint32_t>(m_items.size());
+
+    m_items.push_back(item);
+    m_sortEntries.push_back(entry);
+}
+
+//----------------------------------------------------------------------------------------------------
+// LSD radix sort on the keys. Stable, so draws with equal keys keep their submission order.
+//
+void PropDrawQueue::Sort()
+{
+    size_t const count = m_sortEntries.size();
+    if (count < 2) return;
+
+    m_sortScratch.resize(count);
+
+    sSortEntry* source      = m_sortEntries.data();
+    sSortEntry* destination = m_sortScratch.data();
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t digitCounts[256] = {};
+
+        for (size_t entryIndex = 0; entryIndex < count; ++entryIndex)
+        {
+            ++digitCounts[source[entryIndex].m_key >> shift & 0xFF];
+        }
+
+        if (digitCounts[source[0].m_key >> shift & 0xFF] == count) continue;
+
+        size_t offset = 0;
+
+        for (size_t& digitCount : digitCounts)
+        {
+            size_t const digitTotal = digitCount;
+            digitCount              = offset;
+            offset += digitTotal;
+        }
+
+        for (size_t entryIndex = 0; entryIndex < count; ++entryIndex)
+        {
+            destination[digitCounts[source[entryIndex].m_key >> shift & 0xFF]++] = source[entryIndex];
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != m_sortEntries.data())
+    {
+        std::copy(source, source + count, m_sortEntries.data());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Issues every queued draw in key order. The backend elides state that did not change between
+// consecutive draws, so a sorted queue binds each shader/state/texture run once.
+//
+void PropDrawQueue::Flush(PropRenderBackend& renderBackend, bool const sortItems)
+{
+    if (sortItems) Sort();
+
+    renderBackend.InvalidateState();
+
+    for (sSortEntry const& entry : m_sortEntries)
+    {
+        sPropDrawItem const& item = m_items[entry.m_itemIndex];
+
+        renderBackend.SetRenderState(item.m_state);
+        renderBackend.SetTexture(item.m_texture);
+        renderBackend.SetModelConstants(item.m_modelToWorldTransform, item.m_color);
+
+        if (item.m_gpuMesh != INVALID_PROP_GPU_MESH)
+        {
+            renderBackend.DrawStaticMesh(item.m_gpuMesh);
+        }
+        else if (item.m_mesh != nullptr)
+        {
+            renderBackend.DrawDynamicMesh(*item.m_mesh);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Records the queued draws in key order into one command list per chunk of at least
+// MIN_DRAWS_PER_COMMAND_LIST draws, up to ParallelFor::CHUNKS_PER_THREAD lists per thread. Each list
+// covers a fixed slice of the sorted draws, so the lists and their order do not depend on which thread
+// recorded what. Sorting stays on the calling thread; it is O(n) and touches only the keys.
+//
+sParallelForStats PropDrawQueue::RecordCommandLists(std::vector<PropCommandList>& out_commandLists,
+                                                    ParallelForWorkers*           workers,
+                                                    int const                     threadCount,
+                                                    bool const                    sortItems)
+{
+    if (sortItems) Sort();
+
+    int const drawCount   = GetCount();
+    int const maxLists    = std::max(threadCount, 1) * ParallelFor::CHUNKS_PER_THREAD;
+    int const neededLists = (drawCount + MIN_DRAWS_PER_COMMAND_LIST - 1) / MIN_DRAWS_PER_COMMAND_LIST;
+    int const listCount   = std::clamp(neededLists, 1, maxLists);
+
+    out_commandLists.resize(static_cast<size_t>(listCount));
+
+    return ParallelFor::Run(workers, threadCount, listCount, static_cast<int>(sizeof(PropCommandList)), [&](int const beginList, int const endList)
+    {
+        for (int list = beginList; list < endList; ++list)
+        {
+            int const beginIndex = static_cast<int>(static_cast<int64_t>(drawCount) * list / listCount);
+            int const endIndex   = static_cast<int>(static_cast<int64_t>(drawCount) * (list + 1) / listCount);
+
+            RecordRange(beginIndex, endIndex, out_commandLists[list]);
+        }
+    }, 2);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replays the lists in order as one frame of draws, the way Flush issues them.
+//
+STATIC void PropDrawQueue::ReplayCommandLists(std::vector<PropCommandList> const& commandLists, PropRenderBackend& renderBackend)
+{
+    renderBackend.InvalidateState();
+
+    for (PropCommandList const& commandList : commandLists)
+    {
+        commandList.Replay(renderBackend);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropDrawQueue::GetCount() const
+{
+    return static_cast<int>(m_items.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Key of the drawIndex-th draw in current order (submission order until sorted).
+//
+uint64_t PropDrawQueue::GetSortKey(int const drawIndex) const
+{
+    return m_sortEntries[drawIndex].m_key;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t PropDrawQueue::MakeSortKey(sPropDrawItem const& item, float const depth) const
+{
+    sPropRenderState const& state = item.m_state;
+
+    uint64_t const isTranslucent = state.m_blendMode != eBlendMode::OPAQUE ? 1 : 0;
+    uint64_t const shader        = static_cast<uint64_t>(state.m_shader) & 0x3F;
+    uint64_t const pipeline      = (static_cast<uint64_t>(state.m_blendMode) & 0x3) << 6 |
+                                   (static_cast<uint64_t>(state.m_rasterizerMode) & 0x3) << 4 |
+                                   (static_cast<uint64_t>(state.m_samplerMode) & 0x3) << 2 |
+                                   (static_cast<uint64_t>(state.m_depthMode) & 0x3);
+    uint64_t const texture       = static_cast<uint64_t>(std::clamp(item.m_textureHandle + 1, 0, 0xFFFF));
+    uint64_t const mesh          = item.m_gpuMesh & 0xFFFF;
+
+    float const    normalizedDepth = std::clamp(depth / m_maxDepth, 0.f, 1.f);
+    uint64_t const quantizedDepth  = static_cast<uint64_t>(normalizedDepth * 65535.f);
+
+    if (isTranslucent)
+    {
+        return isTranslucent << 62 | (0xFFFF - quantizedDepth) << 46 | shader << 40 | pipeline << 32 | texture << 16 | (mesh & 0xFF) << 8;
+    }
+
+    return shader << 56 | pipeline << 48 | texture << 32 | mesh << 16 | quantizedDepth;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Records sorted draws [beginIndex, endIndex). A state or texture equal to the previous draw's in the
+// same list is not recorded, since the backend would elide it anyway; the first draw of a list records
+// both, so every list stands on its own.
+//
+void PropDrawQueue::RecordRange(int const        beginIndex,
+                                int const        endIndex,
+                                PropCommandList& out_commandList) const
+{
+    out_commandList.Clear();
+
+    sPropDrawItem const* previousItem = nullptr;
+
+    for (int drawIndex = beginIndex; drawIndex < endIndex; ++drawIndex)
+    {
+        sPropDrawItem const& item = m_items[m_sortEntries[drawIndex].m_itemIndex];
+
+        if (previousItem == nullptr || item.m_state != previousItem->m_state) out_commandList.SetRenderState(item.m_state);
+        if (previousItem == nullptr || item.m_texture != previousItem->m_texture) out_commandList.SetTexture(item.m_texture);
+
+        out_commandList.SetModelConstants(item.m_modelToWorldTransform, item.m_color);
+
+        if (item.m_gpuMesh != INVALID_PROP_GPU_MESH)
+        {
+            out_commandList.DrawStaticMesh(item.m_gpuMesh);
+        }
+        else if (item.m_mesh != nullptr)
+        {
+            out_commandList.DrawDynamicMesh(*item.m_mesh);
+        }
+
+        previousItem = &item;
+    }
+}
@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------------------------------
+// PropDrawQueue.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/ParallelFor.hpp"
+#include "Game/PropCommandList.hpp"
+#include "Game/PropRenderBackend.hpp"
+#include "Game/ResourceHandleTable.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ParallelForWorkers;
+class Texture;
+struct sIndexedMesh;
+
+//----------------------------------------------------------------------------------------------------
+// Everything needed to issue one prop draw. m_mesh is only read when there is no persistent GPU mesh.
+//
+struct sPropDrawItem
+{
+    Mat44               m_modelToWorldTransform;
+    Rgba8               m_color         = Rgba8::WHITE;
+    sPropRenderState    m_state;
+    Texture const*      m_texture       = nullptr;
+    TextureHandle       m_textureHandle = INVALID_RESOURCE_HANDLE;     // Sort key texture id; names m_texture
+    PropGpuMeshHandle   m_gpuMesh       = INVALID_PROP_GPU_MESH;
+    sIndexedMesh const* m_mesh          = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Per-frame list of prop draws, sorted by a packed 64-bit key and flushed through a PropRenderBackend.
+//
+// Key layout, most significant bits first:
+//   opaque:      [2 pass][6 shader][8 blend/raster/sampler/depth][16 texture][16 mesh][16 depth]
+//   translucent: [2 pass][16 inverted depth][6 shader][8 blend/raster/sampler/depth][16 texture][8 mesh]
+// Opaque draws therefore group by shader, then pipeline state, then texture and mesh, and run front to
+// back inside a group; translucent (non-opaque blend) draws come after all opaque ones, back to front.
+// The texture id is the texture handle plus one (0 for none), so building a key needs no lookup.
+//
+// Keys are sorted with an LSD radix sort (8 passes of 8 bits, passes where every key shares the digit
+// are skipped), so the sort is O(n) and does not move the draw items themselves.
+//
+// Flush issues the sorted draws straight to the backend. RecordCommandLists instead cuts the sorted
+// draws into contiguous chunks and records each chunk into its own PropCommandList on the ParallelFor
+// workers; ReplayCommandLists then replays them in chunk order on the calling thread. The backend sees the same
+// draws in the same order as from Flush, whatever the thread count.
+//
+class PropDrawQueue
+{
+public:
+    void Clear();
+    void Reserve(int itemCount);
+    void SetDepthRange(float maxDepth);
+    void Submit(sPropDrawItem const& item, float depth);
+    void Sort();
+    void Flush(PropRenderBackend& renderBackend, bool sortItems = true);
+
+    sParallelForStats RecordCommandLists(std::vector<PropCommandList>& out_commandLists, ParallelForWorkers* workers, int threadCount, bool sortItems = true);
+    static void       ReplayCommandLists(std::vector<PropCommandList> const& commandLists, PropRenderBackend& renderBackend);
+
+    int      GetCount() const;
+    uint64_t GetSortKey(int drawIndex) const;
+
+private:
+    struct sSortEntry
+    {
+        uint64_t m_key       = 0;
+        uint32_t m_itemIndex = 0;
+    };
+
+    static int constexpr MIN_DRAWS_PER_COMMAND_LIST = 512;
+
+    uint64_t MakeSortKey(sPropDrawItem const& item, float depth) const;
+    void     RecordRange(int beginIndex, int endIndex, PropCommandList& out_commandList) const;
+
+    std::vector<sPropDrawItem> m_items;
+    std::vector<sSortEntry>    m_sortEntries;
+    std::vector<sSortEntry>    m_sortScratch;
+    float                      m_maxDepth = 1000.f;      // Depths at or past this share the last bucket
+};
@@ -0,0 +1,22 @@
+//----------------------------------------------------------------------------------------------------
+// PropHandle.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+// Script-facing prop reference: slot in the low PROP_HANDLE_SLOT_BITS bits, slot generation above.
+// Always a non-negative int, so it round-trips through script numbers and int arguments unchanged.
+// Generations start at 1, so a raw prop index (< MAX_PROP_SLOTS) is never a valid handle.
+// A freed slot is only reused once PROP_HANDLE_MIN_FREE_SLOTS others are waiting, oldest first, and a
+// slot whose generation reaches PROP_HANDLE_GENERATION_MAX is retired instead of wrapping, so a stale
+// handle never comes back to life.
+//
+using PropHandle = int;
+
+PropHandle constexpr INVALID_PROP_HANDLE        = -1;
+int constexpr        PROP_HANDLE_SLOT_BITS      = 20;
+int constexpr        MAX_PROP_SLOTS             = 1 << PROP_HANDLE_SLOT_BITS;
+int constexpr        PROP_HANDLE_GENERATION_MAX = (1 << (31 - PROP_HANDLE_SLOT_BITS)) - 1;
+int constexpr        PROP_HANDLE_MIN_FREE_SLOTS = 1024;
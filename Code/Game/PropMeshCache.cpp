@@ -0,0 +1,282 @@
+//----------------------------------------------------------------------------------------------------
+// PropMeshCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropMeshCache.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    void AddVertsForPropCube(VertexList_PCU& verts, float const edgeLength)
+    {
+        float const halfEdge = edgeLength * 0.5f;
+
+        Vec3 const frontBottomLeft(halfEdge, -halfEdge, -halfEdge);
+        Vec3 const frontBottomRight(halfEdge, halfEdge, -halfEdge);
+        Vec3 const frontTopLeft(halfEdge, -halfEdge, halfEdge);
+        Vec3 const frontTopRight(halfEdge, halfEdge, halfEdge);
+        Vec3 const backBottomLeft(-halfEdge, halfEdge, -halfEdge);
+        Vec3 const backBottomRight(-halfEdge, -halfEdge, -halfEdge);
+        Vec3 const backTopLeft(-halfEdge, halfEdge, halfEdge);
+        Vec3 const backTopRight(-halfEdge, -halfEdge, halfEdge);
+
+        AddVertsForQuad3D(verts, frontBottomLeft, frontBottomRight, frontTopLeft, frontTopRight, Rgba8::RED);          // +X Red
+        AddVertsForQuad3D(verts, backBottomLeft, backBottomRight, backTopLeft, backTopRight, Rgba8::CYAN);             // -X -Red (Cyan)
+        AddVertsForQuad3D(verts, frontBottomRight, backBottomLeft, frontTopRight, backTopLeft, Rgba8::GREEN);          // -Y -Green (Magenta)
+        AddVertsForQuad3D(verts, backBottomRight, frontBottomLeft, backTopRight, frontTopLeft, Rgba8::MAGENTA);        // +Y Green
+        AddVertsForQuad3D(verts, frontTopLeft, frontTopRight, backTopRight, backTopLeft, Rgba8::BLUE);                 // +Z Blue
+        AddVertsForQuad3D(verts, backBottomRight, backBottomLeft, frontBottomLeft, frontBottomRight, Rgba8::YELLOW);   // -Z -Blue (Yellow)
+    }
+
+    void AddVertsForPropGrid(VertexList_PCU& verts, float const gridLineLength)
+    {
+        for (int i = -(int)gridLineLength / 2; i < (int)gridLineLength / 2; i++)
+        {
+            float lineWidth = 0.05f;
+            if (i == 0) lineWidth = 0.3f;
+
+            AABB3 boundsX = AABB3(Vec3(-gridLineLength / 2.f, -lineWidth / 2.f + (float)i, -lineWidth / 2.f), Vec3(gridLineLength / 2.f, lineWidth / 2.f + (float)i, lineWidth / 2.f));
+            AABB3 boundsY = AABB3(Vec3(-lineWidth / 2.f + (float)i, -gridLineLength / 2.f, -lineWidth / 2.f), Vec3(lineWidth / 2.f + (float)i, gridLineLength / 2.f, lineWidth / 2.f));
+
+            Rgba8 colorX = Rgba8::DARK_GREY;
+            Rgba8 colorY = Rgba8::DARK_GREY;
+
+            if (i % 5 == 0)
+            {
+                colorX = Rgba8::RED;
+                colorY = Rgba8::GREEN;
+            }
+
+            AddVertsForAABB3D(verts, boundsX, colorX);
+            AddVertsForAABB3D(verts, boundsY, colorY);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sPropMeshDesc sPropMeshDesc::Cube(float const edgeLength)
+{
+    sPropMeshDesc desc;
+    desc.m_shape = ePropMeshShape::CUBE;
+    desc.m_size  = edgeLength;
+    return desc;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sPropMeshDesc sPropMeshDesc::Sphere(float const radius, int const sliceCount, int const stackCount)
+{
+    sPropMeshDesc desc;
+    desc.m_shape      = ePropMeshShape::SPHERE;
+    desc.m_size       = radius * 2.f;
+    desc.m_sliceCount = sliceCount;
+    desc.m_stackCount = stackCount;
+    return desc;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sPropMeshDesc sPropMeshDesc::Grid(float const lineLength)
+{
+    sPropMeshDesc desc;
+    desc.m_shape = ePropMeshShape::GRID;
+    desc.m_size  = lineLength;
+    return desc;
+}
+
+//----------------------------------------------------------------------------------------------------
+// shape (8 bits) | size float bits (32) | slices (12) | stacks (12)
+//
+uint64_t sPropMeshDesc::GetKey() const
+{
+    uint32_t sizeBits = 0;
+    std::memcpy(&sizeBits, &m_size, sizeof(sizeBits));
+
+    return static_cast<uint64_t>(m_shape) << 56 |
+           static_cast<uint64_t>(sizeBits) << 24 |
+           static_cast<uint64_t>(m_sliceCount & 0xFFF) << 12 |
+           static_cast<uint64_t>(m_stackCount & 0xFFF);
+}
+
+//----------------------------------------------------------------------------------------------------
+PropMeshCache::~PropMeshCache()
+{
+    SetRenderBackend(nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Moves every live mesh's GPU copy to renderBackend (nullptr drops them). The previous backend must
+// still be alive.
+//
+void PropMeshCache::SetRenderBackend(PropRenderBackend* renderBackend)
+{
+    if (renderBackend == m_renderBackend) return;
+
+    for (sPropMesh& mesh : m_meshes)
+    {
+        if (mesh.m_referenceCount <= 0) continue;
+
+        if (m_renderBackend != nullptr) m_renderBackend->ReleaseStaticMesh(mesh.m_gpuMesh);
+
+        mesh.m_gpuMesh = renderBackend != nullptr ? renderBackend->CreateStaticMesh(mesh.m_mesh) : INVALID_PROP_GPU_MESH;
+    }
+
+    m_renderBackend = renderBackend;
+}
+
+//----------------------------------------------------------------------------------------------------
+PropMeshHandle PropMeshCache::Acquire(sPropMeshDesc const& desc)
+{
+    uint64_t const key   = desc.GetKey();
+    auto const     found = m_handleByKey.find(key);
+
+    if (found != m_handleByKey.end())
+    {
+        ++m_meshes[found->second].m_referenceCount;
+        return found->second;
+    }
+
+    PropMeshHandle handle;
+
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        handle = static_cast<PropMeshHandle>(m_meshes.size());
+        m_meshes.emplace_back();
+    }
+
+    sPropMesh& mesh       = m_meshes[handle];
+    mesh.m_key            = key;
+    mesh.m_referenceCount = 1;
+
+    VertexList_PCU triangleList;
+    BuildTriangleList(desc, triangleList);
+    BuildIndexedMesh(triangleList, mesh.m_mesh);
+
+    float boundingRadiusSquared = 0.f;
+
+    for (Vertex_PCU const& vertex : mesh.m_mesh.m_vertexes)
+    {
+        boundingRadiusSquared = std::max(boundingRadiusSquared, vertex.m_position.GetLengthSquared());
+    }
+
+    mesh.m_boundingRadius = sqrtf(boundingRadiusSquared);
+    mesh.m_gpuMesh        = m_renderBackend != nullptr ? m_renderBackend->CreateStaticMesh(mesh.m_mesh) : INVALID_PROP_GPU_MESH;
+
+    m_handleByKey[key] = handle;
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropMeshCache::AddReference(PropMeshHandle const handle)
+{
+    if (!IsValid(handle)) return;
+
+    ++m_meshes[handle].m_referenceCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropMeshCache::Release(PropMeshHandle const handle)
+{
+    if (!IsValid(handle)) return;
+
+    sPropMesh& mesh = m_meshes[handle];
+
+    if (--mesh.m_referenceCount > 0) return;
+
+    if (m_renderBackend != nullptr) m_renderBackend->ReleaseStaticMesh(mesh.m_gpuMesh);
+
+    m_handleByKey.erase(mesh.m_key);
+    mesh.m_gpuMesh = INVALID_PROP_GPU_MESH;
+    mesh.m_mesh    = sIndexedMesh();
+    m_freeHandles.push_back(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Radius of a sphere around the mesh origin that contains the mesh in any orientation.
+//
+float PropMeshCache::GetBoundingRadius(PropMeshHandle const handle) const
+{
+    return IsValid(handle) ? m_meshes[handle].m_boundingRadius : 0.f;
+}
+
+//----------------------------------------------------------------------------------------------------
+sIndexedMesh const& PropMeshCache::GetMesh(PropMeshHandle const handle) const
+{
+    if (!IsValid(handle)) ERROR_AND_DIE(StringFormat("(PropMeshCache::GetMesh)(invalid mesh handle {})", handle))
+
+    return m_meshes[handle].m_mesh;
+}
+
+//----------------------------------------------------------------------------------------------------
+// INVALID_PROP_GPU_MESH when no render backend is set; callers then draw the mesh dynamically.
+//
+PropGpuMeshHandle PropMeshCache::GetGpuMesh(PropMeshHandle const handle) const
+{
+    return IsValid(handle) ? m_meshes[handle].m_gpuMesh : INVALID_PROP_GPU_MESH;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropMeshCache::GetReferenceCount(PropMeshHandle const handle) const
+{
+    return IsValid(handle) ? m_meshes[handle].m_referenceCount : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sPropMeshCacheStats PropMeshCache::GetStats() const
+{
+    sPropMeshCacheStats stats;
+
+    for (sPropMesh const& mesh : m_meshes)
+    {
+        if (mesh.m_referenceCount <= 0) continue;
+
+        stats.m_meshCount++;
+        stats.m_referenceCount += mesh.m_referenceCount;
+        stats.m_vertexBytes += mesh.m_mesh.GetVertexBytes();
+        stats.m_indexBytes += mesh.m_mesh.GetIndexBytes();
+    }
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The non-indexed triangle list the AddVertsFor* helpers emit for desc.
+//
+STATIC void PropMeshCache::BuildTriangleList(sPropMeshDesc const& desc, VertexList_PCU& out_triangleList)
+{
+    switch (desc.m_shape)
+    {
+    case ePropMeshShape::CUBE:
+        AddVertsForPropCube(out_triangleList, desc.m_size);
+        break;
+
+    case ePropMeshShape::SPHERE:
+        AddVertsForSphere3D(out_triangleList, Vec3::ZERO, desc.m_size * 0.5f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, desc.m_sliceCount, desc.m_stackCount);
+        break;
+
+    case ePropMeshShape::GRID:
+        AddVertsForPropGrid(out_triangleList, desc.m_size);
+        break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PropMeshCache::IsValid(PropMeshHandle const handle) const
+{
+    return handle < m_meshes.size() && m_meshes[handle].m_referenceCount > 0;
+}
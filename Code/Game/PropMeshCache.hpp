@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------------------------------
+// PropMeshCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/IndexedMesh.hpp"
+#include "Game/PropRenderBackend.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/VertexUtils.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+using PropMeshHandle = uint32_t;
+
+PropMeshHandle constexpr INVALID_PROP_MESH = UINT32_MAX;
+
+//----------------------------------------------------------------------------------------------------
+enum class ePropMeshShape : uint8_t
+{
+    CUBE,
+    SPHERE,
+    GRID
+};
+
+//----------------------------------------------------------------------------------------------------
+// Shape + generation parameters; two equal descs always share one mesh.
+//
+struct sPropMeshDesc
+{
+    ePropMeshShape m_shape      = ePropMeshShape::CUBE;
+    float          m_size       = 1.f;      // Cube edge, sphere diameter or grid line length
+    int            m_sliceCount = 0;        // Sphere only
+    int            m_stackCount = 0;        // Sphere only
+
+    static sPropMeshDesc Cube(float edgeLength = 1.f);
+    static sPropMeshDesc Sphere(float radius = 0.5f, int sliceCount = 32, int stackCount = 16);
+    static sPropMeshDesc Grid(float lineLength = 100.f);
+
+    uint64_t GetKey() const;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sPropMeshCacheStats
+{
+    int    m_meshCount      = 0;
+    int    m_referenceCount = 0;    // Render props currently pointing at a cached mesh
+    size_t m_vertexBytes    = 0;    // Vertex storage of all cached meshes
+    size_t m_indexBytes     = 0;    // Index storage of all cached meshes
+};
+
+//----------------------------------------------------------------------------------------------------
+// Immutable prop meshes shared by handle and reference-counted.
+//
+// Acquire builds a mesh the first time its desc is requested and afterwards only bumps the reference
+// count, so 50k cubes share one mesh instead of owning 50k copies. Release frees the mesh when the last
+// reference goes; its handle slot is reused by the next new mesh.
+//
+// Meshes are stored indexed: the AddVertsFor* triangle list is deduplicated and reordered for the
+// post-transform vertex cache (BuildIndexedMesh), e.g. a cube shrinks from 36 to 24 vertexes.
+//
+// Cached meshes never change, so with a render backend set each one is uploaded once into a persistent
+// vertex buffer when it is built and released with it; draws then reuse the buffer (GetGpuMesh).
+//
+class PropMeshCache
+{
+public:
+    PropMeshCache() = default;
+    ~PropMeshCache();
+
+    PropMeshCache(PropMeshCache const&)            = delete;
+    PropMeshCache& operator=(PropMeshCache const&) = delete;
+
+    void           SetRenderBackend(PropRenderBackend* renderBackend);
+    PropMeshHandle Acquire(sPropMeshDesc const& desc);
+    void           AddReference(PropMeshHandle handle);
+    void           Release(PropMeshHandle handle);
+
+    sIndexedMesh const&   GetMesh(PropMeshHandle handle) const;
+    PropGpuMeshHandle     GetGpuMesh(PropMeshHandle handle) const;
+    float                 GetBoundingRadius(PropMeshHandle handle) const;
+    int                   GetReferenceCount(PropMeshHandle handle) const;
+    sPropMeshCacheStats   GetStats() const;
+
+    static void BuildTriangleList(sPropMeshDesc const& desc, VertexList_PCU& out_triangleList);
+
+private:
+    struct sPropMesh
+    {
+        sIndexedMesh      m_mesh;
+        uint64_t          m_key            = 0;
+        int               m_referenceCount = 0;
+        float             m_boundingRadius = 0.f;                       // Farthest vertex from the mesh origin
+        PropGpuMeshHandle m_gpuMesh        = INVALID_PROP_GPU_MESH;     // Persistent buffer on m_renderBackend
+    };
+
+    bool IsValid(PropMeshHandle handle) const;
+
+    std::vector<sPropMesh>                       m_meshes;
+    std::vector<PropMeshHandle>                  m_freeHandles;
+    std::unordered_map<uint64_t, PropMeshHandle> m_handleByKey;
+    PropRenderBackend*                           m_renderBackend = nullptr;
+};
@@ -0,0 +1,296 @@
+//----------------------------------------------------------------------------------------------------
+// PropRenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropRenderBackend.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void PropRenderBackend::DrawDynamicMesh(sIndexedMesh const& mesh)
+{
+    mesh.ExpandToTriangleList(m_scratchTriangleList);
+    DrawDynamicMesh(m_scratchTriangleList);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Binds only the fields that differ from the bound state; each bound field counts as one state change.
+//
+void PropRenderBackend::SetRenderState(sPropRenderState const& state)
+{
+    uint8_t changedFields = FIELD_ALL;
+
+    if (m_isStateBound && m_isElisionEnabled)
+    {
+        changedFields = 0;
+
+        if (state.m_shader != m_boundState.m_shader) changedFields |= FIELD_SHADER;
+        if (state.m_blendMode != m_boundState.m_blendMode) changedFields |= FIELD_BLEND;
+        if (state.m_rasterizerMode != m_boundState.m_rasterizerMode) changedFields |= FIELD_RASTERIZER;
+        if (state.m_samplerMode != m_boundState.m_samplerMode) changedFields |= FIELD_SAMPLER;
+        if (state.m_depthMode != m_boundState.m_depthMode) changedFields |= FIELD_DEPTH;
+
+        if (changedFields == 0) return;
+    }
+
+    BindRenderState(state, changedFields);
+
+    for (uint8_t fields = changedFields; fields != 0; fields &= static_cast<uint8_t>(fields - 1))
+    {
+        ++m_currentFrameStats.m_stateChanges;
+    }
+
+    m_boundState   = state;
+    m_isStateBound = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropRenderBackend::SetTexture(Texture const* texture)
+{
+    if (m_isTextureBound && m_isElisionEnabled && texture == m_boundTexture) return;
+
+    BindTexture(texture);
+    ++m_currentFrameStats.m_stateChanges;
+
+    m_boundTexture   = texture;
+    m_isTextureBound = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The next SetRenderState/SetTexture binds everything again.
+//
+void PropRenderBackend::InvalidateState()
+{
+    m_isStateBound   = false;
+    m_isTextureBound = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropRenderBackend::SetStateElision(bool const isEnabled)
+{
+    m_isElisionEnabled = isEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Static mesh counts carry over; traffic counters restart.
+//
+void PropRenderBackend::BeginFrame()
+{
+    m_lastFrameStats = m_currentFrameStats;
+
+    int const staticMeshes = m_currentFrameStats.m_staticMeshes;
+
+    m_currentFrameStats                = sPropRenderStats();
+    m_currentFrameStats.m_staticMeshes = staticMeshes;
+}
+
+//----------------------------------------------------------------------------------------------------
+sPropRenderStats const& PropRenderBackend::GetLastFrameStats() const
+{
+    return m_lastFrameStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+sPropRenderStats const& PropRenderBackend::GetCurrentFrameStats() const
+{
+    return m_currentFrameStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+RendererPropRenderBackend::RendererPropRenderBackend(ResourceHandleTable& resourceHandles)
+    : m_resourceHandles(resourceHandles)
+{
+    m_shaders[static_cast<int>(ePropShader::BLOOM)]   = resourceHandles.ResolveShader("Data/Shaders/Bloom");
+    m_shaders[static_cast<int>(ePropShader::DEFAULT)] = resourceHandles.ResolveShader("Data/Shaders/Default");
+}
+
+//----------------------------------------------------------------------------------------------------
+RendererPropRenderBackend::~RendererPropRenderBackend()
+{
+    for (sGpuMesh& mesh : m_meshes)
+    {
+        GAME_SAFE_RELEASE(mesh.m_vertexBuffer);
+        GAME_SAFE_RELEASE(mesh.m_indexBuffer);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The only upload a static mesh ever makes.
+//
+PropGpuMeshHandle RendererPropRenderBackend::CreateStaticMesh(sIndexedMesh const& mesh)
+{
+    if (mesh.GetIndexCount() == 0) return INVALID_PROP_GPU_MESH;
+
+    unsigned int const vertexBytes = static_cast<unsigned int>(mesh.GetVertexBytes());
+    unsigned int const indexBytes  = static_cast<unsigned int>(mesh.GetIndexBytes());
+
+    PropGpuMeshHandle handle;
+
+    if (!m_freeMeshes.empty())
+    {
+        handle = m_freeMeshes.back();
+        m_freeMeshes.pop_back();
+    }
+    else
+    {
+        handle = static_cast<PropGpuMeshHandle>(m_meshes.size());
+        m_meshes.emplace_back();
+    }
+
+    sGpuMesh& gpuMesh      = m_meshes[handle];
+    gpuMesh.m_vertexBuffer = g_renderer->CreateVertexBuffer(vertexBytes, sizeof(Vertex_PCU));
+    gpuMesh.m_indexBuffer  = g_renderer->CreateIndexBuffer(indexBytes, static_cast<unsigned int>(mesh.GetIndexStride()));
+    gpuMesh.m_indexCount   = static_cast<unsigned int>(mesh.GetIndexCount());
+
+    g_renderer->CopyCPUToGPU(mesh.m_vertexes.data(), vertexBytes, gpuMesh.m_vertexBuffer);
+    g_renderer->CopyCPUToGPU(mesh.GetIndexData(), indexBytes, gpuMesh.m_indexBuffer);
+
+    m_currentFrameStats.m_uploadedBytes += vertexBytes + indexBytes;
+    ++m_currentFrameStats.m_staticMeshes;
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererPropRenderBackend::ReleaseStaticMesh(PropGpuMeshHandle const mesh)
+{
+    if (mesh >= m_meshes.size() || m_meshes[mesh].m_vertexBuffer == nullptr) return;
+
+    GAME_SAFE_RELEASE(m_meshes[mesh].m_vertexBuffer);
+    GAME_SAFE_RELEASE(m_meshes[mesh].m_indexBuffer);
+    m_meshes[mesh].m_indexCount = 0;
+    m_freeMeshes.push_back(mesh);
+
+    --m_currentFrameStats.m_staticMeshes;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererPropRenderBackend::DrawStaticMesh(PropGpuMeshHandle const mesh)
+{
+    if (mesh >= m_meshes.size() || m_meshes[mesh].m_vertexBuffer == nullptr) return;
+
+    g_renderer->DrawIndexedVertexBuffer(m_meshes[mesh].m_vertexBuffer, m_meshes[mesh].m_indexBuffer, m_meshes[mesh].m_indexCount);
+
+    ++m_currentFrameStats.m_staticDraws;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererPropRenderBackend::DrawDynamicMesh(VertexList_PCU const& triangleList)
+{
+    g_renderer->DrawVertexArray(static_cast<int>(triangleList.size()), triangleList.data());
+
+    m_currentFrameStats.m_uploadedBytes += triangleList.size() * sizeof(Vertex_PCU);
+    ++m_currentFrameStats.m_dynamicDraws;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererPropRenderBackend::SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color)
+{
+    g_renderer->SetModelConstants(modelToWorldTransform, color);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererPropRenderBackend::BindRenderState(sPropRenderState const& state, uint8_t const changedFields)
+{
+    if (changedFields & FIELD_SHADER) g_renderer->BindShader(m_resourceHandles.GetShader(m_shaders[static_cast<int>(state.m_shader)]));
+    if (changedFields & FIELD_BLEND) g_renderer->SetBlendMode(state.m_blendMode);
+    if (changedFields & FIELD_RASTERIZER) g_renderer->SetRasterizerMode(state.m_rasterizerMode);
+    if (changedFields & FIELD_SAMPLER) g_renderer->SetSamplerMode(state.m_samplerMode);
+    if (changedFields & FIELD_DEPTH) g_renderer->SetDepthMode(state.m_depthMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererPropRenderBackend::BindTexture(Texture const* texture)
+{
+    g_renderer->BindTexture(texture);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Counts the bytes a real backend would copy once, without keeping the mesh.
+//
+PropGpuMeshHandle RecordingPropRenderBackend::CreateStaticMesh(sIndexedMesh const& mesh)
+{
+    if (mesh.GetIndexCount() == 0) return INVALID_PROP_GPU_MESH;
+
+    PropGpuMeshHandle handle;
+
+    if (!m_freeMeshes.empty())
+    {
+        handle = m_freeMeshes.back();
+        m_freeMeshes.pop_back();
+    }
+    else
+    {
+        handle = static_cast<PropGpuMeshHandle>(m_vertexCounts.size());
+        m_vertexCounts.emplace_back();
+    }
+
+    m_vertexCounts[handle] = static_cast<size_t>(mesh.GetIndexCount());
+
+    m_currentFrameStats.m_uploadedBytes += mesh.GetVertexBytes() + mesh.GetIndexBytes();
+    ++m_currentFrameStats.m_staticMeshes;
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingPropRenderBackend::ReleaseStaticMesh(PropGpuMeshHandle const mesh)
+{
+    if (mesh >= m_vertexCounts.size() || m_vertexCounts[mesh] == SIZE_MAX) return;
+
+    m_vertexCounts[mesh] = SIZE_MAX;
+    m_freeMeshes.push_back(mesh);
+
+    --m_currentFrameStats.m_staticMeshes;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingPropRenderBackend::DrawStaticMesh(PropGpuMeshHandle const mesh)
+{
+    if (mesh >= m_vertexCounts.size() || m_vertexCounts[mesh] == SIZE_MAX) return;
+
+    m_drawnVertexCount += m_vertexCounts[mesh];
+    ++m_currentFrameStats.m_staticDraws;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingPropRenderBackend::DrawDynamicMesh(VertexList_PCU const& triangleList)
+{
+    m_drawnVertexCount += triangleList.size();
+    m_currentFrameStats.m_uploadedBytes += triangleList.size() * sizeof(Vertex_PCU);
+    ++m_currentFrameStats.m_dynamicDraws;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingPropRenderBackend::SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color)
+{
+    UNUSED(modelToWorldTransform)
+    UNUSED(color)
+}
+
+//----------------------------------------------------------------------------------------------------
+// State changes are counted by PropRenderBackend; there is no device to bind them to.
+//
+void RecordingPropRenderBackend::BindRenderState(sPropRenderState const& state, uint8_t const changedFields)
+{
+    UNUSED(state)
+    UNUSED(changedFields)
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingPropRenderBackend::BindTexture(Texture const* texture)
+{
+    UNUSED(texture)
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t RecordingPropRenderBackend::GetDrawnVertexCount() const
+{
+    return m_drawnVertexCount;
+}
@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------------------------------------
+// PropRenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/IndexedMesh.hpp"
+#include "Game/ResourceHandleTable.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class IndexBuffer;
+class Shader;
+class Texture;
+class VertexBuffer;
+
+//----------------------------------------------------------------------------------------------------
+using PropGpuMeshHandle = uint32_t;
+
+PropGpuMeshHandle constexpr INVALID_PROP_GPU_MESH = UINT32_MAX;
+
+//----------------------------------------------------------------------------------------------------
+// Shaders props can use; backends resolve them once instead of looking the file name up per draw.
+//
+enum class ePropShader : uint8_t
+{
+    BLOOM,
+    DEFAULT,
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+// Pipeline state of a prop draw, excluding the texture.
+//
+struct sPropRenderState
+{
+    ePropShader     m_shader         = ePropShader::BLOOM;
+    eBlendMode      m_blendMode      = eBlendMode::OPAQUE;
+    eRasterizerMode m_rasterizerMode = eRasterizerMode::SOLID_CULL_BACK;
+    eSamplerMode    m_samplerMode    = eSamplerMode::POINT_CLAMP;
+    eDepthMode      m_depthMode      = eDepthMode::READ_WRITE_LESS_EQUAL;
+
+    bool operator==(sPropRenderState const& other) const = default;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sPropRenderStats
+{
+    size_t m_uploadedBytes = 0;     // Vertex and index bytes copied from CPU to GPU
+    int    m_staticDraws   = 0;     // Draws from a persistent vertex buffer
+    int    m_dynamicDraws  = 0;     // Draws that uploaded their vertexes first
+    int    m_staticMeshes  = 0;     // Persistent vertex buffers alive at the end of the frame
+    int    m_stateChanges  = 0;     // Shader, blend, rasterizer, sampler, depth and texture binds issued
+};
+
+//----------------------------------------------------------------------------------------------------
+// Where props are drawn. Static meshes are uploaded once into persistent vertex + index buffers and drawn
+// by handle; dynamic meshes are uploaded on every draw and are meant for geometry that changes per frame.
+// A dynamic indexed mesh is expanded back to a triangle list, since immediate draws take no indexes.
+//
+// SetRenderState/SetTexture only forward the fields that differ from what is bound, so draws sorted by
+// state (PropDrawQueue) pay for each change once. InvalidateState forgets the bound state; call it
+// whenever something else may have used the renderer in between. With elision off every field is
+// rebound on every call, as each prop did before draws were sorted.
+//
+// The backend counts uploaded bytes, draws and state changes per frame (BeginFrame starts a new one),
+// so a headless RecordingPropRenderBackend can verify the traffic without a device.
+//
+class PropRenderBackend
+{
+public:
+    virtual ~PropRenderBackend() = default;
+
+    virtual PropGpuMeshHandle CreateStaticMesh(sIndexedMesh const& mesh) = 0;
+    virtual void              ReleaseStaticMesh(PropGpuMeshHandle mesh) = 0;
+    virtual void              DrawStaticMesh(PropGpuMeshHandle mesh) = 0;
+    virtual void              DrawDynamicMesh(VertexList_PCU const& triangleList) = 0;
+    virtual void              SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color) = 0;
+
+    void DrawDynamicMesh(sIndexedMesh const& mesh);
+    void SetRenderState(sPropRenderState const& state);
+    void SetTexture(Texture const* texture);
+    void InvalidateState();
+    void SetStateElision(bool isEnabled);
+
+    void                    BeginFrame();
+    sPropRenderStats const& GetLastFrameStats() const;
+    sPropRenderStats const& GetCurrentFrameStats() const;
+
+protected:
+    enum eRenderStateField : uint8_t
+    {
+        FIELD_SHADER     = 1 << 0,
+        FIELD_BLEND      = 1 << 1,
+        FIELD_RASTERIZER = 1 << 2,
+        FIELD_SAMPLER    = 1 << 3,
+        FIELD_DEPTH      = 1 << 4,
+        FIELD_ALL        = 0x1F
+    };
+
+    virtual void BindRenderState(sPropRenderState const& state, uint8_t changedFields) = 0;
+    virtual void BindTexture(Texture const* texture) = 0;
+
+    sPropRenderStats m_currentFrameStats;
+    sPropRenderStats m_lastFrameStats;
+
+private:
+    VertexList_PCU   m_scratchTriangleList;
+    sPropRenderState m_boundState;
+    Texture const*   m_boundTexture     = nullptr;
+    bool             m_isStateBound     = false;    // m_boundState matches the device
+    bool             m_isTextureBound   = false;    // m_boundTexture matches the device
+    bool             m_isElisionEnabled = true;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Draws through g_renderer: static meshes live in engine vertex/index buffers, dynamic ones go through
+// DrawVertexArray. Owns every buffer it created until released or destroyed. Shaders are interned in the
+// game's ResourceHandleTable at construction, so there is no second shader cache here.
+//
+class RendererPropRenderBackend : public PropRenderBackend
+{
+public:
+    explicit RendererPropRenderBackend(ResourceHandleTable& resourceHandles);
+    ~RendererPropRenderBackend() override;
+
+    RendererPropRenderBackend(RendererPropRenderBackend const&)            = delete;
+    RendererPropRenderBackend& operator=(RendererPropRenderBackend const&) = delete;
+
+    PropGpuMeshHandle CreateStaticMesh(sIndexedMesh const& mesh) override;
+    void              ReleaseStaticMesh(PropGpuMeshHandle mesh) override;
+    void              DrawStaticMesh(PropGpuMeshHandle mesh) override;
+    void              DrawDynamicMesh(VertexList_PCU const& triangleList) override;
+    void              SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color) override;
+    using PropRenderBackend::DrawDynamicMesh;
+
+protected:
+    void BindRenderState(sPropRenderState const& state, uint8_t changedFields) override;
+    void BindTexture(Texture const* texture) override;
+
+private:
+    struct sGpuMesh
+    {
+        VertexBuffer* m_vertexBuffer = nullptr;
+        IndexBuffer*  m_indexBuffer  = nullptr;
+        unsigned int  m_indexCount   = 0;
+    };
+
+    ResourceHandleTable const&     m_resourceHandles;
+    std::vector<sGpuMesh>          m_meshes;
+    std::vector<PropGpuMeshHandle> m_freeMeshes;
+    ShaderHandle                   m_shaders[static_cast<int>(ePropShader::COUNT)] = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+// Headless backend: keeps only vertex counts and records the traffic a real backend would generate.
+// Used by benchmarks and anywhere props are "drawn" without a renderer.
+//
+class RecordingPropRenderBackend : public PropRenderBackend
+{
+public:
+    PropGpuMeshHandle CreateStaticMesh(sIndexedMesh const& mesh) override;
+    void              ReleaseStaticMesh(PropGpuMeshHandle mesh) override;
+    void              DrawStaticMesh(PropGpuMeshHandle mesh) override;
+    void              DrawDynamicMesh(VertexList_PCU const& triangleList) override;
+    void              SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& color) override;
+    using PropRenderBackend::DrawDynamicMesh;
+
+    size_t GetDrawnVertexCount() const;
+
+protected:
+    void BindRenderState(sPropRenderState const& state, uint8_t changedFields) override;
+    void BindTexture(Texture const* texture) override;
+
+private:
+    std::vector<size_t>            m_vertexCounts;      // Vertexes per draw (index count); SIZE_MAX while the handle is free
+    std::vector<PropGpuMeshHandle> m_freeMeshes;
+    size_t                         m_drawnVertexCount = 0;
+};
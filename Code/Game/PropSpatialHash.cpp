@@ -0,0 +1,444 @@
+//----------------------------------------------------------------------------------------------------
+// PropSpatialHash.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropSpatialHash.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // 21 bits per axis, biased so negative coordinates pack without sign bits.
+    int constexpr CELL_COORDINATE_BITS = 21;
+    int constexpr CELL_COORDINATE_BIAS = 1 << (CELL_COORDINATE_BITS - 1);
+    int constexpr CELL_COORDINATE_MIN  = -CELL_COORDINATE_BIAS;
+    int constexpr CELL_COORDINATE_MAX  = CELL_COORDINATE_BIAS - 1;
+
+    uint64_t MakeCellKey(int const cellX, int const cellY, int const cellZ)
+    {
+        uint64_t constexpr mask = (uint64_t{1} << CELL_COORDINATE_BITS) - 1;
+
+        return (static_cast<uint64_t>(cellX + CELL_COORDINATE_BIAS) & mask) << (CELL_COORDINATE_BITS * 2) |
+               (static_cast<uint64_t>(cellY + CELL_COORDINATE_BIAS) & mask) << CELL_COORDINATE_BITS |
+               (static_cast<uint64_t>(cellZ + CELL_COORDINATE_BIAS) & mask);
+    }
+
+    int GetKeyCoordinate(uint64_t const cellKey, int const axis)
+    {
+        uint64_t constexpr mask = (uint64_t{1} << CELL_COORDINATE_BITS) - 1;
+
+        return static_cast<int>(cellKey >> (CELL_COORDINATE_BITS * (2 - axis)) & mask) - CELL_COORDINATE_BIAS;
+    }
+
+    bool IsCloser(sSpatialHashHit const& a, sSpatialHashHit const& b)
+    {
+        return a.m_distance < b.m_distance;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+PropSpatialHash::PropSpatialHash(float const cellSize)
+    : m_cellSize(std::max(cellSize, 0.01f)),
+      m_inverseCellSize(1.f / m_cellSize)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+// Reserves the per-item arrays for ids below itemCount.
+//
+void PropSpatialHash::Reserve(int const itemCount)
+{
+    size_t const capacity = static_cast<size_t>(std::max(itemCount, 0));
+
+    m_positions.reserve(capacity);
+    m_cellKeyByItem.reserve(capacity);
+    m_placeInCell.reserve(capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Inserting an id that is already present moves it instead.
+//
+void PropSpatialHash::Insert(int const itemId, Vec3 const& position)
+{
+    if (itemId < 0) return;
+
+    if (Contains(itemId))
+    {
+        Move(itemId, position);
+        return;
+    }
+
+    if (itemId >= static_cast<int>(m_positions.size()))
+    {
+        size_t const size = static_cast<size_t>(itemId) + 1;
+
+        m_positions.resize(size);
+        m_cellKeyByItem.resize(size, INVALID_CELL_KEY);
+        m_placeInCell.resize(size, -1);
+    }
+
+    m_positions[itemId] = position;
+    AddToCell(itemId, GetCellKey(position));
+    ++m_itemCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropSpatialHash::Remove(int const itemId)
+{
+    if (!Contains(itemId)) return;
+
+    RemoveFromCell(itemId);
+    --m_itemCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only touches the cell lists when the item crosses into another cell.
+//
+void PropSpatialHash::Move(int const itemId, Vec3 const& position)
+{
+    if (!Contains(itemId)) return;
+
+    m_positions[itemId] = position;
+
+    uint64_t const cellKey = GetCellKey(position);
+    if (cellKey == m_cellKeyByItem[itemId]) return;
+
+    RemoveFromCell(itemId);
+    AddToCell(itemId, cellKey);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropSpatialHash::Clear()
+{
+    m_cells.clear();
+    m_positions.clear();
+    m_cellKeyByItem.clear();
+    m_placeInCell.clear();
+    m_itemCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends the items within radius of center, nearest first, up to maxResults (no limit if it is 0 or
+// less). Returns the number of hits appended.
+//
+int PropSpatialHash::QueryRadius(Vec3 const& center, float const radius, int const maxResults, std::vector<sSpatialHashHit>& out_hits) const
+{
+    size_t const firstHit = out_hits.size();
+
+    if (radius < 0.f || m_itemCount == 0) return 0;
+
+    CollectInRadius(center, radius, out_hits);
+
+    size_t const hitCount  = out_hits.size() - firstHit;
+    size_t const keepCount = maxResults > 0 ? std::min(hitCount, static_cast<size_t>(maxResults)) : hitCount;
+
+    std::partial_sort(out_hits.begin() + firstHit, out_hits.begin() + firstHit + keepCount, out_hits.end(), IsCloser);
+    out_hits.resize(firstHit + keepCount);
+
+    return static_cast<int>(keepCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends the maxResults items nearest to center, nearest first, ignoring items past maxRadius (no
+// limit if it is 0 or less). The search radius starts at one cell and doubles until it holds enough
+// items, so dense neighbourhoods never look past their own few cells.
+//
+int PropSpatialHash::QueryNearest(Vec3 const& center, int const maxResults, float const maxRadius, std::vector<sSpatialHashHit>& out_hits) const
+{
+    size_t const firstHit = out_hits.size();
+
+    if (maxResults <= 0 || m_itemCount == 0) return 0;
+
+    float const radiusLimit = maxRadius > 0.f ? maxRadius : FLT_MAX;
+    float       radius      = std::min(m_cellSize, radiusLimit);
+
+    for (;;)
+    {
+        out_hits.resize(firstHit);
+        CollectInRadius(center, radius, out_hits);
+
+        size_t const hitCount = out_hits.size() - firstHit;
+
+        if (hitCount >= static_cast<size_t>(maxResults) || hitCount == static_cast<size_t>(m_itemCount) || radius >= radiusLimit) break;
+
+        radius = radius >= radiusLimit * 0.5f ? radiusLimit : radius * 2.f;
+    }
+
+    size_t const keepCount = std::min(out_hits.size() - firstHit, static_cast<size_t>(maxResults));
+
+    std::partial_sort(out_hits.begin() + firstHit, out_hits.begin() + firstHit + keepCount, out_hits.end(), IsCloser);
+    out_hits.resize(firstHit + keepCount);
+
+    return static_cast<int>(keepCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Finds the first item whose hitRadius sphere the ray enters within maxDistance; out_hit.m_distance
+// is measured along the ray (0 when start is already inside the sphere).
+//
+// Every cell within one of a visited cell gets tested, so once the ray enters a cell past the best hit
+// so far, no untested item can be hit earlier: its sphere would have to reach a visited cell, which
+// puts its center in a tested neighbour.
+//
+bool PropSpatialHash::Raycast(Vec3 const& start, Vec3 const& direction, float const maxDistance, float const hitRadius, sSpatialHashHit& out_hit) const
+{
+    out_hit = sSpatialHashHit();
+
+    float const directionLength = direction.GetLength();
+
+    if (directionLength <= 0.f || maxDistance < 0.f || m_itemCount == 0) return false;
+
+    Vec3 const  rayDirection = direction.GetNormalized();
+    float const radius       = GetClamped(hitRadius, 0.f, m_cellSize);
+
+    // DDA state per axis: the ray's distance to its next cell boundary and between two boundaries.
+    float const origin[3]   = {start.x, start.y, start.z};
+    float const axisStep[3] = {rayDirection.x, rayDirection.y, rayDirection.z};
+    int         cell[3]     = {GetCellCoordinate(start.x), GetCellCoordinate(start.y), GetCellCoordinate(start.z)};
+    int         cellStep[3] = {0, 0, 0};
+    float       nextCrossing[3];
+    float       crossingStep[3];
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (axisStep[axis] == 0.f)
+        {
+            nextCrossing[axis] = FLT_MAX;
+            crossingStep[axis] = FLT_MAX;
+            continue;
+        }
+
+        float const boundary = static_cast<float>(cell[axis] + (axisStep[axis] > 0.f ? 1 : 0)) * m_cellSize;
+
+        cellStep[axis]     = axisStep[axis] > 0.f ? 1 : -1;
+        nextCrossing[axis] = (boundary - origin[axis]) / axisStep[axis];
+        crossingStep[axis] = m_cellSize / std::fabs(axisStep[axis]);
+    }
+
+    sSpatialHashHit bestHit;
+    bestHit.m_distance = maxDistance;
+
+    float enterDistance = 0.f;
+    int   movedAxis     = -1;
+
+    for (int step = 0; step < MAX_RAY_STEPS && enterDistance <= maxDistance; ++step)
+    {
+        if (bestHit.m_itemId >= 0 && bestHit.m_distance <= enterDistance) break;
+
+        // The first cell tests its whole 3x3x3 neighbourhood; after a step only the 9-cell face the
+        // neighbourhood gained along the moved axis is new.
+        int minOffset[3] = {-1, -1, -1};
+        int maxOffset[3] = {1, 1, 1};
+
+        if (movedAxis >= 0)
+        {
+            minOffset[movedAxis] = cellStep[movedAxis];
+            maxOffset[movedAxis] = cellStep[movedAxis];
+        }
+
+        for (int offsetX = minOffset[0]; offsetX <= maxOffset[0]; ++offsetX)
+        {
+            for (int offsetY = minOffset[1]; offsetY <= maxOffset[1]; ++offsetY)
+            {
+                for (int offsetZ = minOffset[2]; offsetZ <= maxOffset[2]; ++offsetZ)
+                {
+                    TestRayAgainstCell(MakeCellKey(cell[0] + offsetX, cell[1] + offsetY, cell[2] + offsetZ), start, rayDirection, maxDistance, radius, bestHit);
+                }
+            }
+        }
+
+        movedAxis = nextCrossing[0] <= nextCrossing[1] && nextCrossing[0] <= nextCrossing[2] ? 0 : nextCrossing[1] <= nextCrossing[2] ? 1 : 2;
+
+        enterDistance = nextCrossing[movedAxis];
+        cell[movedAxis] += cellStep[movedAxis];
+        nextCrossing[movedAxis] += crossingStep[movedAxis];
+    }
+
+    if (bestHit.m_itemId < 0) return false;
+
+    out_hit = bestHit;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PropSpatialHash::Contains(int const itemId) const
+{
+    return itemId >= 0 && itemId < static_cast<int>(m_cellKeyByItem.size()) && m_cellKeyByItem[itemId] != INVALID_CELL_KEY;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 const& PropSpatialHash::GetPosition(int const itemId) const
+{
+    return m_positions[itemId];
+}
+
+//----------------------------------------------------------------------------------------------------
+float PropSpatialHash::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropSpatialHash::GetItemCount() const
+{
+    return m_itemCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropSpatialHash::GetCellCount() const
+{
+    return static_cast<int>(m_cells.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Coordinates past the packable range (and NaN) clamp to its edges.
+//
+int PropSpatialHash::GetCellCoordinate(float const value) const
+{
+    float const cell = std::floor(value * m_inverseCellSize);
+
+    if (!(cell >= static_cast<float>(CELL_COORDINATE_MIN))) return CELL_COORDINATE_MIN;
+    if (cell >= static_cast<float>(CELL_COORDINATE_MAX)) return CELL_COORDINATE_MAX;
+
+    return static_cast<int>(cell);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t PropSpatialHash::GetCellKey(Vec3 const& position) const
+{
+    return MakeCellKey(GetCellCoordinate(position.x), GetCellCoordinate(position.y), GetCellCoordinate(position.z));
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropSpatialHash::AddToCell(int const itemId, uint64_t const cellKey)
+{
+    std::vector<int>& cellItems = m_cells[cellKey];
+
+    m_cellKeyByItem[itemId] = cellKey;
+    m_placeInCell[itemId]   = static_cast<int>(cellItems.size());
+    cellItems.push_back(itemId);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Swap-removes the item from its cell's list and erases the cell once it is empty.
+//
+void PropSpatialHash::RemoveFromCell(int const itemId)
+{
+    auto const cellIt = m_cells.find(m_cellKeyByItem[itemId]);
+
+    std::vector<int>& cellItems = cellIt->second;
+    int const         place     = m_placeInCell[itemId];
+    int const         lastItem  = cellItems.back();
+
+    cellItems[place]        = lastItem;
+    m_placeInCell[lastItem] = place;
+    cellItems.pop_back();
+
+    if (cellItems.empty()) m_cells.erase(cellIt);
+
+    m_cellKeyByItem[itemId] = INVALID_CELL_KEY;
+    m_placeInCell[itemId]   = -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends every item within radius of center, unsorted.
+//
+void PropSpatialHash::CollectInRadius(Vec3 const& center, float const radius, std::vector<sSpatialHashHit>& out_hits) const
+{
+    float const radiusSquared = radius * radius;
+    int const   minCell[3]    = {GetCellCoordinate(center.x - radius), GetCellCoordinate(center.y - radius), GetCellCoordinate(center.z - radius)};
+    int const   maxCell[3]    = {GetCellCoordinate(center.x + radius), GetCellCoordinate(center.y + radius), GetCellCoordinate(center.z + radius)};
+
+    auto const CollectCell = [&](std::vector<int> const& cellItems)
+    {
+        for (int const itemId : cellItems)
+        {
+            float const distanceSquared = (m_positions[itemId] - center).GetLengthSquared();
+
+            if (distanceSquared <= radiusSquared)
+            {
+                out_hits.push_back({itemId, std::sqrt(distanceSquared)});
+            }
+        }
+    };
+
+    double const boxCellCount = static_cast<double>(maxCell[0] - minCell[0] + 1) *
+                                static_cast<double>(maxCell[1] - minCell[1] + 1) *
+                                static_cast<double>(maxCell[2] - minCell[2] + 1);
+
+    if (boxCellCount > static_cast<double>(m_cells.size()))
+    {
+        for (auto const& [cellKey, cellItems] : m_cells)
+        {
+            bool isInBox = true;
+
+            for (int axis = 0; axis < 3 && isInBox; ++axis)
+            {
+                int const coordinate = GetKeyCoordinate(cellKey, axis);
+                isInBox              = coordinate >= minCell[axis] && coordinate <= maxCell[axis];
+            }
+
+            if (isInBox) CollectCell(cellItems);
+        }
+
+        return;
+    }
+
+    for (int cellX = minCell[0]; cellX <= maxCell[0]; ++cellX)
+    {
+        for (int cellY = minCell[1]; cellY <= maxCell[1]; ++cellY)
+        {
+            for (int cellZ = minCell[2]; cellZ <= maxCell[2]; ++cellZ)
+            {
+                auto const cellIt = m_cells.find(MakeCellKey(cellX, cellY, cellZ));
+
+                if (cellIt != m_cells.end()) CollectCell(cellIt->second);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Keeps inout_hit as the earliest hit along the ray; direction must be normalized.
+//
+void PropSpatialHash::TestRayAgainstCell(uint64_t const cellKey, Vec3 const& start, Vec3 const& direction, float const maxDistance, float const hitRadius, sSpatialHashHit& inout_hit) const
+{
+    auto const cellIt = m_cells.find(cellKey);
+    if (cellIt == m_cells.end()) return;
+
+    float const radiusSquared = hitRadius * hitRadius;
+
+    for (int const itemId : cellIt->second)
+    {
+        Vec3 const  toItem        = m_positions[itemId] - start;
+        float const alongRay      = DotProduct3D(toItem, direction);
+        float const offRaySquared = toItem.GetLengthSquared() - alongRay * alongRay;
+
+        if (offRaySquared > radiusSquared) continue;
+
+        float const halfChord = std::sqrt(radiusSquared - offRaySquared);
+        float       distance  = alongRay - halfChord;
+
+        if (distance < 0.f)
+        {
+            if (alongRay + halfChord < 0.f) continue;       // Sphere is behind the start
+
+            distance = 0.f;
+        }
+
+        if (distance > maxDistance) continue;
+
+        if (inout_hit.m_itemId < 0 || distance < inout_hit.m_distance)
+        {
+            inout_hit.m_itemId   = itemId;
+            inout_hit.m_distance = distance;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+//----------------------------------------------------------------------------------------------------
+// PropSpatialHash.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sSpatialHashHit
+{
+    int   m_itemId   = -1;
+    float m_distance = 0.f;     // From the query center, or along the ray for Raycast
+};
+
+//----------------------------------------------------------------------------------------------------
+// Uniform hash grid over point items, for radius, k-nearest and ray queries.
+//
+// Items are small non-negative ids (PropStore uses handle slots, which survive swap-removes) at a
+// position each. Cells are cubes of m_cellSize keyed by their packed integer coordinates, so only
+// occupied cells cost memory. Insert, Remove and Move are O(1): every item remembers its cell and its
+// place in that cell's list, and Move only touches the lists when the item crosses a cell boundary.
+//
+// A query box spanning more cells than are occupied walks the occupied cells instead of the box, so
+// large radii over sparse worlds cost no more than a linear scan. Raycast marches the cells along the
+// ray (3D DDA) and tests each one's neighbours too, so it finds every item within hitRadius of the ray
+// as long as hitRadius does not exceed the cell size; larger radii are clamped.
+//
+class PropSpatialHash
+{
+public:
+    static float constexpr DEFAULT_CELL_SIZE = 4.f;
+    static int constexpr   MAX_RAY_STEPS     = 4096;
+
+    explicit PropSpatialHash(float cellSize = DEFAULT_CELL_SIZE);
+
+    void Reserve(int itemCount);
+    void Insert(int itemId, Vec3 const& position);
+    void Remove(int itemId);
+    void Move(int itemId, Vec3 const& position);
+    void Clear();
+
+    int  QueryRadius(Vec3 const& center, float radius, int maxResults, std::vector<sSpatialHashHit>& out_hits) const;
+    int  QueryNearest(Vec3 const& center, int maxResults, float maxRadius, std::vector<sSpatialHashHit>& out_hits) const;
+    bool Raycast(Vec3 const& start, Vec3 const& direction, float maxDistance, float hitRadius, sSpatialHashHit& out_hit) const;
+
+    bool        Contains(int itemId) const;
+    Vec3 const& GetPosition(int itemId) const;
+    float       GetCellSize() const;
+    int         GetItemCount() const;
+    int         GetCellCount() const;
+
+private:
+    static uint64_t constexpr INVALID_CELL_KEY = UINT64_MAX;
+
+    int      GetCellCoordinate(float value) const;
+    uint64_t GetCellKey(Vec3 const& position) const;
+    void     AddToCell(int itemId, uint64_t cellKey);
+    void     RemoveFromCell(int itemId);
+    void     CollectInRadius(Vec3 const& center, float radius, std::vector<sSpatialHashHit>& out_hits) const;
+    void     TestRayAgainstCell(uint64_t cellKey, Vec3 const& start, Vec3 const& direction, float maxDistance, float hitRadius, sSpatialHashHit& inout_hit) const;
+
+    float                                          m_cellSize;
+    float                                          m_inverseCellSize;
+    std::unordered_map<uint64_t, std::vector<int>> m_cells;           // Cell key -> item ids; empty cells are erased
+    std::vector<Vec3>                              m_positions;       // By item id
+    std::vector<uint64_t>                          m_cellKeyByItem;   // INVALID_CELL_KEY while the id is unused
+    std::vector<int>                               m_placeInCell;     // Index of the item in its cell's list
+    int                                            m_itemCount = 0;
+};
@@ -0,0 +1,157 @@
+//----------------------------------------------------------------------------------------------------
+// PropSpatialQueryBatch.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropSpatialQueryBatch.hpp"
+
+#include <climits>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Negative, huge or NaN counts become 0, which RADIUS reads as "no limit" and NEAREST as "none".
+    int ToResultCount(double const number)
+    {
+        return number >= 0.0 && number <= static_cast<double>(INT_MAX) ? static_cast<int>(number) : 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropSpatialQueryBatch::PushRadius(Vec3 const& center,
+                                       float const radius,
+                                       int const   maxResults)
+{
+    m_queries.push_back({eSpatialQueryType::RADIUS, center, Vec3::ZERO, radius, maxResults, 0.f});
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropSpatialQueryBatch::PushNearest(Vec3 const& center,
+                                        int const   resultCount,
+                                        float const maxRadius)
+{
+    m_queries.push_back({eSpatialQueryType::NEAREST, center, Vec3::ZERO, maxRadius, resultCount, 0.f});
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropSpatialQueryBatch::PushRay(Vec3 const& start,
+                                    Vec3 const& direction,
+                                    float const maxDistance,
+                                    float const hitRadius)
+{
+    m_queries.push_back({eSpatialQueryType::RAY, start, direction, maxDistance, 1, hitRadius});
+}
+
+//----------------------------------------------------------------------------------------------------
+// Decodes script records. The whole chunk is rejected if it is partial or holds an unknown type.
+//
+bool PropSpatialQueryBatch::AppendRecords(double const* records,
+                                          int const     numberCount)
+{
+    if (records == nullptr || numberCount <= 0 || numberCount % NUMBERS_PER_QUERY != 0) return false;
+
+    for (int offset = 0; offset < numberCount; offset += NUMBERS_PER_QUERY)
+    {
+        int const type = static_cast<int>(records[offset]);
+        if (type < 0 || type >= static_cast<int>(eSpatialQueryType::COUNT)) return false;
+    }
+
+    m_queries.reserve(m_queries.size() + numberCount / NUMBERS_PER_QUERY);
+
+    for (int offset = 0; offset < numberCount; offset += NUMBERS_PER_QUERY)
+    {
+        double const* record = records + offset;
+        Vec3 const    origin(static_cast<float>(record[1]), static_cast<float>(record[2]), static_cast<float>(record[3]));
+        Vec3 const    direction(static_cast<float>(record[4]), static_cast<float>(record[5]), static_cast<float>(record[6]));
+        float const   range = static_cast<float>(record[7]);
+
+        switch (static_cast<eSpatialQueryType>(static_cast<int>(record[0])))
+        {
+        case eSpatialQueryType::RADIUS: PushRadius(origin, range, ToResultCount(record[8])); break;
+        case eSpatialQueryType::NEAREST: PushNearest(origin, ToResultCount(record[8]), range); break;
+        case eSpatialQueryType::RAY: PushRay(origin, direction, range, static_cast<float>(record[8])); break;
+        case eSpatialQueryType::COUNT: break;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropSpatialQueryBatch::Clear()
+{
+    m_queries.clear();
+    m_results.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Answers every query in record order and returns the total number of hits.
+//
+int PropSpatialQueryBatch::Execute(PropStore& propStore)
+{
+    int hitTotal = 0;
+
+    m_results.clear();
+
+    for (sSpatialQuery const& query : m_queries)
+    {
+        m_scratchHits.clear();
+
+        switch (query.m_type)
+        {
+        case eSpatialQueryType::RADIUS:
+            propStore.QueryRadius(query.m_origin, query.m_range, query.m_resultLimit, m_scratchHits);
+            break;
+
+        case eSpatialQueryType::NEAREST:
+            propStore.QueryNearest(query.m_origin, query.m_resultLimit, query.m_range, m_scratchHits);
+            break;
+
+        case eSpatialQueryType::RAY:
+            {
+                sPropQueryHit hit;
+                if (propStore.Raycast(query.m_origin, query.m_direction, query.m_range, query.m_hitRadius, hit)) m_scratchHits.push_back(hit);
+                break;
+            }
+
+        case eSpatialQueryType::COUNT:
+            break;
+        }
+
+        m_results.push_back(static_cast<double>(m_scratchHits.size()));
+
+        for (sPropQueryHit const& hit : m_scratchHits)
+        {
+            m_results.push_back(static_cast<double>(hit.m_propHandle));
+            m_results.push_back(static_cast<double>(hit.m_distance));
+        }
+
+        hitTotal += static_cast<int>(m_scratchHits.size());
+    }
+
+    return hitTotal;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropSpatialQueryBatch::GetQueryCount() const
+{
+    return static_cast<int>(m_queries.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<double> const& PropSpatialQueryBatch::GetResults() const
+{
+    return m_results;
+}
+
+//----------------------------------------------------------------------------------------------------
+double* PropSpatialQueryBatch::GetResultData()
+{
+    return m_results.data();
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t PropSpatialQueryBatch::GetResultCapacity() const
+{
+    return m_results.capacity();
+}
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------------------------------
+// PropSpatialQueryBatch.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropStore.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+enum class eSpatialQueryType : uint8_t
+{
+    RADIUS,
+    NEAREST,
+    RAY,
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+// m_range is the radius for RADIUS, the max radius for NEAREST (0 for no limit) and the max distance
+// for RAY. m_resultLimit caps RADIUS hits (0 for no limit) and is k for NEAREST.
+//
+struct sSpatialQuery
+{
+    eSpatialQueryType m_type = eSpatialQueryType::RADIUS;
+    Vec3              m_origin;
+    Vec3              m_direction;              // RAY only
+    float             m_range       = 0.f;
+    int               m_resultLimit = 0;
+    float             m_hitRadius   = 0.f;      // RAY only
+};
+
+//----------------------------------------------------------------------------------------------------
+// Spatial queries recorded by scripts and answered by PropStore in one pass.
+//
+// Script records are flat numbers, NUMBERS_PER_QUERY per query: [type, x, y, z, dx, dy, dz, range,
+// limit], where limit is m_resultLimit, or m_hitRadius for RAY. Execute writes every answer into one flat result array, query by query:
+// [hitCount, propHandle0, distance0, propHandle1, distance1, ...], hits nearest first. A ray query
+// has at most one hit. The results are doubles, so prop handles survive the trip to scripts exactly;
+// scripts read them in place (GetResultData), and the data only moves when a batch outgrows
+// GetResultCapacity.
+//
+class PropSpatialQueryBatch
+{
+public:
+    static int constexpr NUMBERS_PER_QUERY = 9;
+
+    void PushRadius(Vec3 const& center, float radius, int maxResults);
+    void PushNearest(Vec3 const& center, int resultCount, float maxRadius);
+    void PushRay(Vec3 const& start, Vec3 const& direction, float maxDistance, float hitRadius);
+    bool AppendRecords(double const* records, int numberCount);
+    void Clear();
+    int  Execute(PropStore& propStore);
+
+    int                        GetQueryCount() const;
+    std::vector<double> const& GetResults() const;
+    double*                    GetResultData();
+    size_t                     GetResultCapacity() const;
+
+private:
+    std::vector<sSpatialQuery> m_queries;
+    std::vector<double>        m_results;
+    std::vector<sPropQueryHit> m_scratchHits;
+};
@@ -0,0 +1,798 @@
+//----------------------------------------------------------------------------------------------------
+// PropStore.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropStore.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Game.hpp"
+#include "Game/TransformKernels.hpp"
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+PropStore::~PropStore()
+{
+    Clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void PropStore::SubscribeEventCallbacks()
+{
+    g_eventSystem->SubscribeEventCallbackFunction("PropPoolStats", OnPrintPoolStats);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool PropStore::OnPrintPoolStats(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_game == nullptr) return false;
+
+    PropStore const&        propStore = g_game->GetPropStore();
+    sEntityPoolStats const& stats     = propStore.GetRenderPropPoolStats();
+
+    sPropMeshCacheStats const meshStats = propStore.GetMeshCacheStats();
+
+    String const line = StringFormat("(PropPoolStats)({} props)(render props {} live / {} slots, {:.1f}% occupied)(high-water mark {})(blocks {}, {} KB)(recycled {})",
+                                     propStore.GetCount(), stats.m_liveCount, stats.m_capacity, propStore.GetRenderPropPoolOccupancy() * 100.f,
+                                     stats.m_highWaterMark, stats.m_blockCount, stats.m_reservedBytes / 1024, stats.m_recycledCount);
+    String const meshLine = StringFormat("(PropPoolStats)(mesh cache)({} meshes, {} references, {} KB vertexes, {} KB indexes)",
+                                         meshStats.m_meshCount, meshStats.m_referenceCount, meshStats.m_vertexBytes / 1024, meshStats.m_indexBytes / 1024);
+
+    DAEMON_LOG(LogGame, eLogVerbosity::Display, line);
+    DAEMON_LOG(LogGame, eLogVerbosity::Display, meshLine);
+
+    if (g_devConsole)
+    {
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, line);
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, meshLine);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Uploads the cached meshes to renderBackend once; queued draws must then be flushed to the same backend. Set it
+// back to nullptr before destroying the backend while props are still alive.
+//
+void PropStore::SetRenderBackend(PropRenderBackend* renderBackend)
+{
+    m_meshCache.SetRenderBackend(renderBackend);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Update splits its arrays across threadCount threads of workers (the calling thread included).
+// nullptr or a threadCount of 1 keeps it serial.
+//
+void PropStore::SetParallelForWorkers(ParallelForWorkers* workers, int const threadCount)
+{
+    m_workers           = workers;
+    m_updateThreadCount = std::max(threadCount, 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+// O(1) pool allocation plus one reference on the shared mesh; the mesh is only built the first time
+// its desc is requested. Pass the result to AddProp, which takes ownership.
+//
+Prop* PropStore::AllocateRenderProp(sPropMeshDesc const& meshDesc, TextureHandle const texture, sPropRenderState const& renderState)
+{
+    return m_renderPropPool.Allocate(m_meshCache.Acquire(meshDesc), texture, renderState);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends a prop at rest and returns its handle. renderProp must come from AllocateRenderProp (or be
+// nullptr); the store returns it to the pool when the prop is destroyed.
+//
+PropHandle PropStore::AddProp(Vec3 const& position, Rgba8 const& color, Prop* renderProp)
+{
+    int slot;
+
+    // Oldest free slot first, and only past the minimum queue length (or once the slots run out), so a
+    // slot cycles through its generations as slowly as possible
+    bool const isOutOfNewSlots = static_cast<int>(m_indexBySlot.size()) >= MAX_PROP_SLOTS;
+
+    if (static_cast<int>(m_freeSlots.size()) > PROP_HANDLE_MIN_FREE_SLOTS || (isOutOfNewSlots && !m_freeSlots.empty()))
+    {
+        slot = m_freeSlots.front();
+        m_freeSlots.pop_front();
+    }
+    else
+    {
+        if (isOutOfNewSlots) ERROR_AND_DIE(StringFormat("(PropStore::AddProp)(out of prop handle slots)({})", MAX_PROP_SLOTS))
+
+        slot = static_cast<int>(m_indexBySlot.size());
+        m_indexBySlot.push_back(-1);
+        m_generationBySlot.push_back(1);
+    }
+
+    int const propIndex = GetCount();
+
+    m_positions.push_back(position);
+    m_velocities.push_back(Vec3::ZERO);
+    m_orientations.push_back(EulerAngles::ZERO);
+    m_angularVelocities.push_back(EulerAngles::ZERO);
+    m_colors.push_back(color);
+    m_renderProps.push_back(renderProp);
+    m_worldTransforms.push_back(Mat44());
+    m_isWorldTransformDirty.push_back(1);
+    m_changeFlags.push_back(0);
+    m_slotByIndex.push_back(slot);
+    m_indexBySlot[slot] = propIndex;
+
+    MarkChanged(propIndex, POSITION_CHANGED | COLOR_CHANGED);
+
+    if (renderProp != nullptr) m_bvh.InsertItem(slot, GetBounds(propIndex));
+
+    m_spatialHash.Insert(slot, position);
+
+    return GetHandleForSlot(slot);
+}
+
+//----------------------------------------------------------------------------------------------------
+// O(1): releases the render prop, swap-removes the arrays and retires the handle. Returns false for a
+// stale or invalid handle.
+//
+bool PropStore::DestroyProp(PropHandle const handle)
+{
+    int const propIndex = GetIndex(handle);
+    if (propIndex < 0) return false;
+
+    int const slot = m_slotByIndex[propIndex];
+
+    ReleaseRenderProp(m_renderProps[propIndex]);
+    RemoveAt(propIndex);
+
+    m_indexBySlot[slot] = -1;
+
+    m_bvh.RemoveItem(slot);
+
+    // A slot that used up its generations is retired: wrapping to 1 would revive its oldest handles
+    if (m_generationBySlot[slot] < PROP_HANDLE_GENERATION_MAX)
+    {
+        ++m_generationBySlot[slot];
+        m_freeSlots.push_back(slot);
+    }
+
+    m_spatialHash.Remove(slot);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropStore::Reserve(int const propCount)
+{
+    size_t const capacity = static_cast<size_t>(propCount);
+
+    m_positions.reserve(capacity);
+    m_velocities.reserve(capacity);
+    m_orientations.reserve(capacity);
+    m_angularVelocities.reserve(capacity);
+    m_colors.reserve(capacity);
+    m_renderProps.reserve(capacity);
+    m_worldTransforms.reserve(capacity);
+    m_isWorldTransformDirty.reserve(capacity);
+    m_changeFlags.reserve(capacity);
+    m_slotByIndex.reserve(capacity);
+    m_spatialHash.Reserve(propCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Destroys every prop; outstanding handles become stale.
+//
+void PropStore::Clear()
+{
+    while (!m_positions.empty())
+    {
+        DestroyProp(GetHandle(GetCount() - 1));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns false for a stale handle or a data-only prop.
+//
+bool PropStore::SetTexture(PropHandle const handle, TextureHandle const texture)
+{
+    int const propIndex = GetIndex(handle);
+    if (propIndex < 0 || m_renderProps[propIndex] == nullptr) return false;
+
+    m_renderProps[propIndex]->SetTexture(texture);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Moves one prop and its spatial hash entry; the hash only re-buckets it when it changes cells.
+//
+void PropStore::SetPosition(int const propIndex, Vec3 const& position)
+{
+    m_positions[propIndex]             = position;
+    m_isWorldTransformDirty[propIndex] = 1;
+    m_spatialHash.Move(m_slotByIndex[propIndex], position);
+    MarkChanged(propIndex, POSITION_CHANGED);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropStore::SetOrientation(int const propIndex, EulerAngles const& orientation)
+{
+    m_orientations[propIndex]          = orientation;
+    m_isWorldTransformDirty[propIndex] = 1;
+    MarkChanged(propIndex, ORIENTATION_CHANGED);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Takes effect on the next Update, which marks the matrix dirty and the spatial hash stale.
+//
+void PropStore::SetVelocity(int const propIndex, Vec3 const& velocity)
+{
+    m_velocities[propIndex] = velocity;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropStore::SetAngularVelocity(int const propIndex, EulerAngles const& angularVelocity)
+{
+    m_angularVelocities[propIndex] = angularVelocity;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Colors are read when draws are submitted, so no cached state depends on them.
+//
+void PropStore::SetColor(int const propIndex, Rgba8 const& color)
+{
+    m_colors[propIndex] = color;
+    MarkChanged(propIndex, COLOR_CHANGED);
+}
+
+//----------------------------------------------------------------------------------------------------
+// One linear pass per field pair and chunk; no pointer chasing or virtual dispatch per prop. Chunks
+// only write their own index range, so they need no synchronization. Props at rest keep their cached
+// world matrix. Each chunk packs the props it moved or rotated into the scratch range starting at its
+// own begin index, and only those are marked changed afterwards.
+//
+void PropStore::Update(float const deltaSeconds)
+{
+    int const count = GetCount();
+
+    Vec3*              positions         = m_positions.data();
+    Vec3 const*        velocities        = m_velocities.data();
+    EulerAngles*       orientations      = m_orientations.data();
+    EulerAngles const* angularVelocities = m_angularVelocities.data();
+    uint8_t*           isDirty           = m_isWorldTransformDirty.data();
+
+    m_updateChangedIndices.resize(static_cast<size_t>(count));
+    m_updateChangedCounts.resize(static_cast<size_t>(count));
+
+    int* changedIndices = m_updateChangedIndices.data();
+    int* changedCounts  = m_updateChangedCounts.data();
+
+    auto const UpdateRange = [=](int const beginIndex, int const endIndex)
+    {
+        int changedCount = 0;
+
+        for (int propIndex = beginIndex; propIndex < endIndex; ++propIndex)
+        {
+            positions[propIndex].x += velocities[propIndex].x * deltaSeconds;
+            positions[propIndex].y += velocities[propIndex].y * deltaSeconds;
+            positions[propIndex].z += velocities[propIndex].z * deltaSeconds;
+        }
+
+        for (int propIndex = beginIndex; propIndex < endIndex; ++propIndex)
+        {
+            orientations[propIndex].m_yawDegrees += angularVelocities[propIndex].m_yawDegrees * deltaSeconds;
+            orientations[propIndex].m_pitchDegrees += angularVelocities[propIndex].m_pitchDegrees * deltaSeconds;
+            orientations[propIndex].m_rollDegrees += angularVelocities[propIndex].m_rollDegrees * deltaSeconds;
+        }
+
+        for (int propIndex = beginIndex; propIndex < endIndex; ++propIndex)
+        {
+            Vec3 const&        velocity        = velocities[propIndex];
+            EulerAngles const& angularVelocity = angularVelocities[propIndex];
+
+            bool const         isMoving        = (velocity.x != 0.f) | (velocity.y != 0.f) | (velocity.z != 0.f);
+            bool const         isChanged       = isMoving | (angularVelocity.m_yawDegrees != 0.f) | (angularVelocity.m_pitchDegrees != 0.f) | (angularVelocity.m_rollDegrees != 0.f);
+
+            isDirty[propIndex] |= static_cast<uint8_t>(isChanged);
+
+            // Branchless pack: the slot is overwritten by the next prop unless this one changed
+            changedIndices[beginIndex + changedCount] = propIndex;
+            changedCount += static_cast<int>(isChanged);
+        }
+
+        changedCounts[beginIndex] = changedCount;
+    };
+
+    // Vec3 and EulerAngles are both three floats, so one chunk size keeps both arrays line-aligned.
+    m_lastUpdateStats = ParallelFor::Run(m_workers, m_updateThreadCount, count, static_cast<int>(sizeof(Vec3)), UpdateRange);
+
+    for (int beginIndex = 0; beginIndex < count; beginIndex += m_lastUpdateStats.m_chunkItems)
+    {
+        for (int changedIndex = 0; changedIndex < changedCounts[beginIndex]; ++changedIndex)
+        {
+            int const   propIndex = changedIndices[beginIndex + changedIndex];
+            Vec3 const& velocity  = m_velocities[propIndex];
+            bool const  isMoving  = velocity.x != 0.f || velocity.y != 0.f || velocity.z != 0.f;
+
+            // Unlike SetPosition, the hash entry is left for the next spatial query to move, so frames
+            // without queries never pay for it
+            MarkChanged(propIndex, isMoving ? POSITION_INTEGRATED : ORIENTATION_CHANGED);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Queues one draw per rendered prop; viewPosition only feeds the depth part of the sort key.
+//
+void PropStore::SubmitDraws(PropDrawQueue& drawQueue, Vec3 const& viewPosition, ResourceHandleTable const& resourceHandles)
+{
+    int submittedCount = 0;
+
+    m_dirtyPropIndices.clear();
+
+    for (int propIndex = 0; propIndex < GetCount(); ++propIndex)
+    {
+        if (m_renderProps[propIndex] == nullptr) continue;
+
+        ++submittedCount;
+        if (m_isWorldTransformDirty[propIndex] != 0) m_dirtyPropIndices.push_back(propIndex);
+    }
+
+    RebuildDirtyWorldTransforms(submittedCount);
+
+    for (int propIndex = 0; propIndex < GetCount(); ++propIndex)
+    {
+        SubmitDraw(drawQueue, propIndex, viewPosition, resourceHandles);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Queues draws for the given props only, e.g. the result of CullFrustum.
+//
+void PropStore::SubmitDraws(PropDrawQueue& drawQueue, Vec3 const& viewPosition, ResourceHandleTable const& resourceHandles, std::vector<int> const& propIndices)
+{
+    int submittedCount = 0;
+
+    m_dirtyPropIndices.clear();
+
+    for (int const propIndex : propIndices)
+    {
+        if (m_renderProps[propIndex] == nullptr) continue;
+
+        ++submittedCount;
+        if (m_isWorldTransformDirty[propIndex] != 0) m_dirtyPropIndices.push_back(propIndex);
+    }
+
+    RebuildDirtyWorldTransforms(submittedCount);
+
+    for (int const propIndex : propIndices)
+    {
+        SubmitDraw(drawQueue, propIndex, viewPosition, resourceHandles);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces out_visiblePropIndices with the render props whose bounds overlap the frustum.
+//
+sPropCullStats PropStore::CullFrustum(sFrustum const& frustum, std::vector<int>& out_visiblePropIndices)
+{
+    sPropCullStats stats;
+    stats.m_refitNodes = UpdateBounds(&stats.m_wasRebuilt);
+
+    out_visiblePropIndices.clear();
+    m_bvh.CullFrustum(frustum, out_visiblePropIndices, stats);
+
+    // The tree holds handle slots
+    for (int& visible : out_visiblePropIndices)
+    {
+        visible = m_indexBySlot[visible];
+    }
+
+    stats.m_culledCount = m_bvh.GetItemCount() - stats.m_visibleCount;
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Brings the BVH up to date with the current positions: only the props moved since the last call get
+// new bounds, then the BVH adds the props created since and refits the moved leaves' ancestors (or
+// rebuilds, see PropBVH::NeedsRebuild). Returns the number of nodes refit.
+//
+int PropStore::UpdateBounds(bool* out_wasRebuilt)
+{
+    TakeChangeList(BOUNDS_CHANGE_LIST, m_changedBoundsScratch);
+
+    for (int const propIndex : m_changedBoundsScratch)
+    {
+        if (m_renderProps[propIndex] != nullptr) m_bvh.UpdateItem(m_slotByIndex[propIndex], GetBounds(propIndex));
+    }
+
+    return m_bvh.Refit(out_wasRebuilt);
+}
+
+//----------------------------------------------------------------------------------------------------
+// World box around the prop's mesh bounding sphere; empty (a point) for data-only props.
+//
+AABB3 PropStore::GetBounds(int const propIndex) const
+{
+    Prop const* prop   = m_renderProps[propIndex];
+    float const radius = prop != nullptr ? m_meshCache.GetBoundingRadius(prop->GetMesh()) : 0.f;
+    Vec3 const  extent = Vec3(radius, radius, radius);
+
+    return AABB3(m_positions[propIndex] - extent, m_positions[propIndex] + extent);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces out_hits with the props within radius of center, nearest first, up to maxResults (no limit
+// if it is 0 or less).
+//
+int PropStore::QueryRadius(Vec3 const& center, float const radius, int const maxResults, std::vector<sPropQueryHit>& out_hits)
+{
+    UpdateSpatialHash();
+
+    m_scratchHashHits.clear();
+    m_spatialHash.QueryRadius(center, radius, maxResults, m_scratchHashHits);
+    CopyQueryHits(out_hits);
+
+    return static_cast<int>(out_hits.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces out_hits with the maxResults props nearest to center, nearest first, skipping props past
+// maxRadius (no limit if it is 0 or less).
+//
+int PropStore::QueryNearest(Vec3 const& center, int const maxResults, float const maxRadius, std::vector<sPropQueryHit>& out_hits)
+{
+    UpdateSpatialHash();
+
+    m_scratchHashHits.clear();
+    m_spatialHash.QueryNearest(center, maxResults, maxRadius, m_scratchHashHits);
+    CopyQueryHits(out_hits);
+
+    return static_cast<int>(out_hits.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// First prop center within hitRadius of the ray, up to maxDistance along it. Props are points here,
+// not meshes; hitRadius is clamped to the hash cell size.
+//
+bool PropStore::Raycast(Vec3 const& start, Vec3 const& direction, float const maxDistance, float const hitRadius, sPropQueryHit& out_hit)
+{
+    UpdateSpatialHash();
+
+    sSpatialHashHit hashHit;
+    bool const      isHit = m_spatialHash.Raycast(start, direction, maxDistance, hitRadius, hashHit);
+
+    out_hit.m_propHandle = isHit ? GetHandleForSlot(hashHit.m_itemId) : INVALID_PROP_HANDLE;
+    out_hit.m_distance   = hashHit.m_distance;
+
+    return isHit;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Moves the hash entries of the props Update moved since the last call; each is only re-bucketed if it
+// crossed into another cell. Returns the number of entries moved (0 when the hash was already current).
+//
+int PropStore::UpdateSpatialHash()
+{
+    TakeChangeList(HASH_CHANGE_LIST, m_changedHashScratch);
+
+    for (int const propIndex : m_changedHashScratch)
+    {
+        m_spatialHash.Move(m_slotByIndex[propIndex], m_positions[propIndex]);
+    }
+
+    return static_cast<int>(m_changedHashScratch.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces out_propIndices with every prop changed since the last call, once each, and clears them.
+//
+void PropStore::TakeChangedProps(std::vector<int>& out_propIndices)
+{
+    TakeChangeList(MIRROR_CHANGE_LIST, out_propIndices);
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropStore::GetCount() const
+{
+    return static_cast<int>(m_positions.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PropStore::IsValid(PropHandle const handle) const
+{
+    return GetIndex(handle) >= 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Current dense index of a handle's prop, or -1 if the handle is invalid or its prop was destroyed.
+//
+int PropStore::GetIndex(PropHandle const handle) const
+{
+    if (handle < 0) return -1;
+
+    int const slot       = handle & (MAX_PROP_SLOTS - 1);
+    int const generation = handle >> PROP_HANDLE_SLOT_BITS;
+
+    if (slot >= static_cast<int>(m_indexBySlot.size()) || m_generationBySlot[slot] != generation) return -1;
+
+    return m_indexBySlot[slot];
+}
+
+//----------------------------------------------------------------------------------------------------
+PropHandle PropStore::GetHandle(int const propIndex) const
+{
+    if (propIndex < 0 || propIndex >= GetCount()) return INVALID_PROP_HANDLE;
+
+    return GetHandleForSlot(m_slotByIndex[propIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The cached matrix while it is clean, otherwise built on the spot (without caching it) by the scalar
+// TransformKernels reference, which gives the same bits as the batched rebuild in SubmitDraws.
+//
+Mat44 PropStore::GetModelToWorldTransform(int const propIndex) const
+{
+    if (m_isWorldTransformDirty[propIndex] == 0) return m_worldTransforms[propIndex];
+
+    return TransformKernels::BuildModelToWorldTransform(m_positions[propIndex], m_orientations[propIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PropStore::IsWorldTransformDirty(int const propIndex) const
+{
+    return m_isWorldTransformDirty[propIndex] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::span<Vec3 const> PropStore::GetPositions() const
+{
+    return m_positions;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::span<EulerAngles const> PropStore::GetOrientations() const
+{
+    return m_orientations;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::span<Vec3 const> PropStore::GetVelocities() const
+{
+    return m_velocities;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::span<EulerAngles const> PropStore::GetAngularVelocities() const
+{
+    return m_angularVelocities;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::span<Rgba8 const> PropStore::GetColors() const
+{
+    return m_colors;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::span<Prop* const> PropStore::GetRenderProps() const
+{
+    return m_renderProps;
+}
+
+//----------------------------------------------------------------------------------------------------
+sIndexedMesh const& PropStore::GetMesh(Prop const& renderProp) const
+{
+    return m_meshCache.GetMesh(renderProp.GetMesh());
+}
+
+//----------------------------------------------------------------------------------------------------
+sEntityPoolStats const& PropStore::GetRenderPropPoolStats() const
+{
+    return m_renderPropPool.GetStats();
+}
+
+//----------------------------------------------------------------------------------------------------
+float PropStore::GetRenderPropPoolOccupancy() const
+{
+    return m_renderPropPool.GetOccupancy();
+}
+
+//----------------------------------------------------------------------------------------------------
+sPropMeshCacheStats PropStore::GetMeshCacheStats() const
+{
+    return m_meshCache.GetStats();
+}
+
+//----------------------------------------------------------------------------------------------------
+sParallelForStats const& PropStore::GetLastUpdateStats() const
+{
+    return m_lastUpdateStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+sPropTransformStats const& PropStore::GetLastTransformStats() const
+{
+    return m_lastTransformStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Moves the last prop into propIndex and shrinks every array by one.
+//
+void PropStore::RemoveAt(int const propIndex)
+{
+    int const lastIndex = GetCount() - 1;
+
+    if (propIndex != lastIndex)
+    {
+        m_positions[propIndex]             = m_positions[lastIndex];
+        m_velocities[propIndex]            = m_velocities[lastIndex];
+        m_orientations[propIndex]          = m_orientations[lastIndex];
+        m_angularVelocities[propIndex]     = m_angularVelocities[lastIndex];
+        m_colors[propIndex]                = m_colors[lastIndex];
+        m_renderProps[propIndex]           = m_renderProps[lastIndex];
+        m_worldTransforms[propIndex]       = m_worldTransforms[lastIndex];
+        m_isWorldTransformDirty[propIndex] = m_isWorldTransformDirty[lastIndex];
+        m_slotByIndex[propIndex]           = m_slotByIndex[lastIndex];
+
+        m_indexBySlot[m_slotByIndex[propIndex]] = propIndex;
+
+        // A different prop now lives at propIndex; its pending changes follow it
+        MarkChanged(propIndex, INDEX_CHANGED | m_changeFlags[lastIndex]);
+    }
+
+    m_positions.pop_back();
+    m_velocities.pop_back();
+    m_orientations.pop_back();
+    m_angularVelocities.pop_back();
+    m_colors.pop_back();
+    m_renderProps.pop_back();
+    m_worldTransforms.pop_back();
+    m_isWorldTransformDirty.pop_back();
+    m_changeFlags.pop_back();
+    m_slotByIndex.pop_back();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Lists the prop once in every change list of listMask it is not in yet. Stores nobody takes from
+// (benchmarks) would grow a list with every swap-remove, so it is rebuilt from the flags once it holds
+// twice as many entries as props.
+//
+void PropStore::MarkChanged(int const propIndex, uint8_t const listMask)
+{
+    uint8_t const newLists = static_cast<uint8_t>(listMask & ~m_changeFlags[propIndex]);
+
+    if (newLists == 0) return;
+
+    m_changeFlags[propIndex] |= newLists;
+
+    for (int list = 0; list < CHANGE_LIST_COUNT; ++list)
+    {
+        uint8_t const     listBit = static_cast<uint8_t>(1 << list);
+        std::vector<int>& indices = m_changedPropIndices[list];
+
+        if ((newLists & listBit) == 0) continue;
+
+        indices.push_back(propIndex);
+
+        if (indices.size() <= 2 * m_changeFlags.size() + 64) continue;
+
+        indices.clear();
+
+        for (int index = 0; index < GetCount(); ++index)
+        {
+            if (m_changeFlags[index] & listBit) indices.push_back(index);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces out_propIndices with every prop in the change list, once each, and empties it.
+//
+void PropStore::TakeChangeList(int const list, std::vector<int>& out_propIndices)
+{
+    uint8_t const listBit = static_cast<uint8_t>(1 << list);
+
+    out_propIndices.clear();
+
+    for (int const propIndex : m_changedPropIndices[list])
+    {
+        // Entries past the end or already taken were left behind by swap-removes
+        if (propIndex >= GetCount() || (m_changeFlags[propIndex] & listBit) == 0) continue;
+
+        m_changeFlags[propIndex] &= static_cast<uint8_t>(~listBit);
+        out_propIndices.push_back(propIndex);
+    }
+
+    m_changedPropIndices[list].clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rebuilds the matrices of m_dirtyPropIndices in one kernel batch, stores them in the cache and clears
+// their dirty flags. submittedCount is every prop of the SubmitDraws call, for the reuse count.
+//
+void PropStore::RebuildDirtyWorldTransforms(int const submittedCount)
+{
+    int const dirtyCount = static_cast<int>(m_dirtyPropIndices.size());
+
+    m_lastTransformStats.m_recomputedCount = dirtyCount;
+    m_lastTransformStats.m_reusedCount     = submittedCount - dirtyCount;
+
+    if (dirtyCount == 0) return;
+
+    m_dirtyPositions.resize(m_dirtyPropIndices.size());
+    m_dirtyOrientations.resize(m_dirtyPropIndices.size());
+    m_dirtyTransforms.resize(m_dirtyPropIndices.size());
+
+    for (int dirtyIndex = 0; dirtyIndex < dirtyCount; ++dirtyIndex)
+    {
+        m_dirtyPositions[dirtyIndex]    = m_positions[m_dirtyPropIndices[dirtyIndex]];
+        m_dirtyOrientations[dirtyIndex] = m_orientations[m_dirtyPropIndices[dirtyIndex]];
+    }
+
+    TransformKernels::BuildModelToWorldTransforms(m_dirtyPositions.data(), m_dirtyOrientations.data(), dirtyCount, m_dirtyTransforms.data());
+
+    for (int dirtyIndex = 0; dirtyIndex < dirtyCount; ++dirtyIndex)
+    {
+        int const propIndex = m_dirtyPropIndices[dirtyIndex];
+
+        m_worldTransforms[propIndex]       = m_dirtyTransforms[dirtyIndex];
+        m_isWorldTransformDirty[propIndex] = 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Texture handles are resolved by array index, never by path.
+//
+void PropStore::SubmitDraw(PropDrawQueue& drawQueue, int const propIndex, Vec3 const& viewPosition, ResourceHandleTable const& resourceHandles) const
+{
+    Prop const* prop = m_renderProps[propIndex];
+    if (prop == nullptr) return;
+
+    PropMeshHandle const mesh = prop->GetMesh();
+
+    sPropDrawItem item;
+    item.m_modelToWorldTransform = m_worldTransforms[propIndex];
+    item.m_color                 = m_colors[propIndex];
+    item.m_state                 = prop->GetRenderState();
+    item.m_texture               = resourceHandles.GetTexture(prop->GetTexture());
+    item.m_textureHandle         = prop->GetTexture();
+    item.m_gpuMesh               = m_meshCache.GetGpuMesh(mesh);
+    item.m_mesh                  = &m_meshCache.GetMesh(mesh);
+
+    drawQueue.Submit(item, (m_positions[propIndex] - viewPosition).GetLength());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces out_hits with m_scratchHashHits, turning hash item ids (slots) into handles.
+//
+void PropStore::CopyQueryHits(std::vector<sPropQueryHit>& out_hits) const
+{
+    out_hits.clear();
+    out_hits.reserve(m_scratchHashHits.size());
+
+    for (sSpatialHashHit const& hashHit : m_scratchHashHits)
+    {
+        out_hits.push_back({GetHandleForSlot(hashHit.m_itemId), hashHit.m_distance});
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+PropHandle PropStore::GetHandleForSlot(int const slot) const
+{
+    return m_generationBySlot[slot] << PROP_HANDLE_SLOT_BITS | slot;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PropStore::ReleaseRenderProp(Prop* renderProp)
+{
+    if (renderProp == nullptr) return;
+
+    m_meshCache.Release(renderProp->GetMesh());
+    m_renderPropPool.Free(renderProp);
+}
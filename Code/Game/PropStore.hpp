@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------------------------------
+// PropStore.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Game/EntityPool.hpp"
+#include "Game/Frustum.hpp"
+#include "Game/ParallelFor.hpp"
+#include "Game/Prop.hpp"
+#include "Game/PropBVH.hpp"
+#include "Game/PropDrawQueue.hpp"
+#include "Game/PropHandle.hpp"
+#include "Game/PropSpatialHash.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sPropQueryHit
+{
+    PropHandle m_propHandle = INVALID_PROP_HANDLE;
+    float      m_distance   = 0.f;      // From the query center, or along the ray for Raycast
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sPropTransformStats
+{
+    int m_recomputedCount = 0;      // Dirty matrices rebuilt by the last SubmitDraws
+    int m_reusedCount     = 0;      // Cached matrices it drew unchanged
+};
+
+//----------------------------------------------------------------------------------------------------
+// Structure-of-arrays storage for every prop: one contiguous array per field, all indexed by prop index.
+//
+// Prop indices are dense but not stable: DestroyProp swap-removes, moving the last prop into the hole.
+// Anything that must survive structural changes holds a PropHandle instead; a slot table maps handles
+// to the current index in O(1), and a slot's generation is bumped when its prop is destroyed so stale
+// handles fail validation instead of retargeting another prop (PropHandle.hpp has the reuse rules).
+// Update integrates velocities by walking the arrays directly, split into ParallelFor chunks once
+// workers are set (SetParallelForWorkers).
+// The Prop render component (mesh + texture handles) comes from the store's
+// fixed-block pool (AllocateRenderProp) and holds one reference on a shared PropMeshCache mesh; both
+// are released on destroy. It may be nullptr for data-only props (benchmarks). With a render backend
+// set, every cached mesh owns one persistent vertex buffer; SubmitDraws queues draws that use it, so
+// nothing is re-uploaded.
+//
+// The arrays are private: outside the store they are read through const spans (GetPositions, ...)
+// and written through the Set* mutators, so no write can skip the dirty flags and the spatial hash.
+// Writes are recorded in change lists, one per consumer, each holding a changed prop once: the mirror
+// list (position, orientation or color written, or moved to a new index by a swap-remove) lets a copy
+// of the arrays, like the game's PropTransformBuffer, take only those props (TakeChangedProps), and
+// the bounds list (position written) lets UpdateBounds touch only the props that moved, and the hash
+// list (position changed by Update) does the same for UpdateSpatialHash.
+// Every prop caches its model-to-world matrix. SetPosition and SetOrientation mark it dirty, as does
+// Update for props with a non-zero velocity or angular velocity. SubmitDraws rebuilds only the dirty
+// matrices of the props it submits, in one TransformKernels batch (SIMD), and reuses the rest;
+// GetLastTransformStats has the counts.
+//
+// CullFrustum keeps a PropBVH over the render props' bounding spheres (as boxes, so rotation never
+// changes them), keyed by handle slot: AddProp and DestroyProp insert and remove one leaf each, moved
+// props refit only their leaves' ancestors, and the tree is only rebuilt for bulk loads or once it got
+// too loose or deep (PropBVH has the rules).
+// Spatial queries (QueryRadius, QueryNearest, Raycast) run on a PropSpatialHash of prop positions keyed
+// by handle slot. AddProp, DestroyProp and SetPosition keep it current in O(1), so position writes from
+// outside the store go through SetPosition; props an Update moved (non-zero velocity) are instead
+// listed and moved in the hash before the next query, so a frame where every prop is at rest costs
+// nothing and one where few move touches only those.
+// DevConsole: "PropPoolStats" prints the pool occupancy and mesh cache footprint.
+//
+class PropStore
+{
+public:
+    PropStore() = default;
+    ~PropStore();
+
+    PropStore(PropStore const&)            = delete;
+    PropStore& operator=(PropStore const&) = delete;
+
+    static void SubscribeEventCallbacks();
+    static bool OnPrintPoolStats(EventArgs& args);
+
+    void       SetRenderBackend(PropRenderBackend* renderBackend);
+    void       SetParallelForWorkers(ParallelForWorkers* workers, int threadCount);
+    Prop*      AllocateRenderProp(sPropMeshDesc const& meshDesc, TextureHandle texture = INVALID_RESOURCE_HANDLE, sPropRenderState const& renderState = sPropRenderState());
+    PropHandle AddProp(Vec3 const& position, Rgba8 const& color, Prop* renderProp);
+    bool       DestroyProp(PropHandle handle);
+    void       Reserve(int propCount);
+    void       Clear();
+    bool       SetTexture(PropHandle handle, TextureHandle texture);
+    void       SetPosition(int propIndex, Vec3 const& position);
+    void       SetOrientation(int propIndex, EulerAngles const& orientation);
+    void       SetVelocity(int propIndex, Vec3 const& velocity);
+    void       SetAngularVelocity(int propIndex, EulerAngles const& angularVelocity);
+    void       SetColor(int propIndex, Rgba8 const& color);
+
+    void Update(float deltaSeconds);
+    void SubmitDraws(PropDrawQueue& drawQueue, Vec3 const& viewPosition, ResourceHandleTable const& resourceHandles);
+    void SubmitDraws(PropDrawQueue& drawQueue, Vec3 const& viewPosition, ResourceHandleTable const& resourceHandles, std::vector<int> const& propIndices);
+
+    sPropCullStats CullFrustum(sFrustum const& frustum, std::vector<int>& out_visiblePropIndices);
+    int            UpdateBounds(bool* out_wasRebuilt = nullptr);
+    AABB3          GetBounds(int propIndex) const;
+
+    int  QueryRadius(Vec3 const& center, float radius, int maxResults, std::vector<sPropQueryHit>& out_hits);
+    int  QueryNearest(Vec3 const& center, int maxResults, float maxRadius, std::vector<sPropQueryHit>& out_hits);
+    bool Raycast(Vec3 const& start, Vec3 const& direction, float maxDistance, float hitRadius, sPropQueryHit& out_hit);
+    int  UpdateSpatialHash();
+
+    void       TakeChangedProps(std::vector<int>& out_propIndices);
+    int        GetCount() const;
+    bool       IsValid(PropHandle handle) const;
+    int        GetIndex(PropHandle handle) const;
+    PropHandle GetHandle(int propIndex) const;
+    Mat44      GetModelToWorldTransform(int propIndex) const;
+    bool       IsWorldTransformDirty(int propIndex) const;
+
+    std::span<Vec3 const>        GetPositions() const;
+    std::span<EulerAngles const> GetOrientations() const;
+    std::span<Vec3 const>        GetVelocities() const;
+    std::span<EulerAngles const> GetAngularVelocities() const;
+    std::span<Rgba8 const>       GetColors() const;
+    std::span<Prop* const>       GetRenderProps() const;      // nullptr entries for data-only props
+
+    sIndexedMesh const&        GetMesh(Prop const& renderProp) const;
+    sEntityPoolStats const&    GetRenderPropPoolStats() const;
+    float                      GetRenderPropPoolOccupancy() const;
+    sPropMeshCacheStats        GetMeshCacheStats() const;
+    sParallelForStats const&   GetLastUpdateStats() const;
+    sPropTransformStats const& GetLastTransformStats() const;
+
+private:
+    void       RemoveAt(int propIndex);
+    void       MarkChanged(int propIndex, uint8_t listMask);
+    void       TakeChangeList(int list, std::vector<int>& out_propIndices);
+    void       ReleaseRenderProp(Prop* renderProp);
+    void       RebuildDirtyWorldTransforms(int submittedCount);
+    void       SubmitDraw(PropDrawQueue& drawQueue, int propIndex, Vec3 const& viewPosition, ResourceHandleTable const& resourceHandles) const;
+    void       CopyQueryHits(std::vector<sPropQueryHit>& out_hits) const;
+    PropHandle GetHandleForSlot(int slot) const;
+
+    std::vector<Vec3>        m_positions;
+    std::vector<Vec3>        m_velocities;
+    std::vector<EulerAngles> m_orientations;
+    std::vector<EulerAngles> m_angularVelocities;
+    std::vector<Rgba8>       m_colors;
+    std::vector<Prop*>       m_renderProps;       // From m_renderPropPool; nullptr for data-only props
+
+    std::vector<int>      m_slotByIndex;          // Dense prop index -> handle slot
+    std::vector<int>      m_indexBySlot;          // Handle slot -> dense prop index, -1 while free
+    std::vector<uint16_t> m_generationBySlot;
+    std::deque<int>       m_freeSlots;            // FIFO, so a freed slot waits as long as possible
+
+    PropMeshCache    m_meshCache;
+    EntityPool<Prop> m_renderPropPool;
+    PropBVH          m_bvh;                     // Item ids are handle slots
+
+    ParallelForWorkers* m_workers           = nullptr;
+    int                 m_updateThreadCount = 1;
+    sParallelForStats   m_lastUpdateStats;
+
+    PropSpatialHash              m_spatialHash;
+    std::vector<sSpatialHashHit> m_scratchHashHits;
+
+    // Change lists: bit n of a prop's m_changeFlags means it is listed in m_changedPropIndices[n]
+    static int constexpr     MIRROR_CHANGE_LIST  = 0;     // Drained by TakeChangedProps
+    static int constexpr     BOUNDS_CHANGE_LIST  = 1;     // Drained by UpdateBounds
+    static int constexpr     HASH_CHANGE_LIST    = 2;     // Drained by UpdateSpatialHash
+    static int constexpr     CHANGE_LIST_COUNT   = 3;
+    static uint8_t constexpr POSITION_CHANGED    = (1 << MIRROR_CHANGE_LIST) | (1 << BOUNDS_CHANGE_LIST);     // SetPosition moves the hash entry itself
+    static uint8_t constexpr POSITION_INTEGRATED = POSITION_CHANGED | (1 << HASH_CHANGE_LIST);             // By Update
+    static uint8_t constexpr ORIENTATION_CHANGED = 1 << MIRROR_CHANGE_LIST;
+    static uint8_t constexpr COLOR_CHANGED       = 1 << MIRROR_CHANGE_LIST;
+    static uint8_t constexpr INDEX_CHANGED       = 1 << MIRROR_CHANGE_LIST;     // The BVH and hash key by slot
+
+    std::vector<uint8_t> m_changeFlags;
+    std::vector<int>     m_changedPropIndices[CHANGE_LIST_COUNT];   // Each flagged prop once; stale entries are skipped on take
+    std::vector<int>     m_changedBoundsScratch;                      // UpdateBounds' drained bounds list
+    std::vector<int>     m_changedHashScratch;                        // UpdateSpatialHash's drained hash list
+    std::vector<int>     m_updateChangedIndices;     // Update scratch: each chunk packs its moved props from its begin index
+    std::vector<int>     m_updateChangedCounts;      // Update scratch: the number each chunk packed, at its begin index
+
+    std::vector<Mat44>       m_worldTransforms;           // Cached model-to-world matrices, valid where not dirty
+    std::vector<uint8_t>     m_isWorldTransformDirty;     // Bytes, not vector<bool>: Update chunks write them concurrently
+    std::vector<int>         m_dirtyPropIndices;          // SubmitDraws gathers the dirty submitted props here for the batch kernel
+    std::vector<Vec3>        m_dirtyPositions;
+    std::vector<EulerAngles> m_dirtyOrientations;
+    std::vector<Mat44>       m_dirtyTransforms;
+    sPropTransformStats      m_lastTransformStats;
+};
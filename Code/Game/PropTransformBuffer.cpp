@@ -0,0 +1,247 @@
+//----------------------------------------------------------------------------------------------------
+// PropTransformBuffer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PropTransformBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------
+// New entries start at the origin, white and clean. Shrinking drops removed entries from the dirty
+// list, so a later apply never reaches past the prop count.
+//
+void PropTransformBuffer::Resize(int const propCount)
+{
+    int const oldCount = GetPropCount();
+
+    if (m_block.empty() || propCount > GetCapacity())
+    {
+        Reallocate(std::max({propCount, GetCapacity() * 2, MIN_CAPACITY}));
+    }
+
+    if (propCount > oldCount)
+    {
+        std::fill_n(GetTransformData() + static_cast<size_t>(oldCount) * FLOATS_PER_TRANSFORM, static_cast<size_t>(propCount - oldCount) * FLOATS_PER_TRANSFORM, 0.f);
+        std::fill_n(GetColorData() + static_cast<size_t>(oldCount) * BYTES_PER_COLOR, static_cast<size_t>(propCount - oldCount) * BYTES_PER_COLOR, static_cast<uint8_t>(255));
+        std::fill_n(GetDirtyFlagData() + oldCount, propCount - oldCount, static_cast<uint8_t>(0));
+    }
+    else if (propCount < oldCount)
+    {
+        int32_t* dirtyIndices = GetDirtyIndexData();
+        int32_t* keptEnd      = std::remove_if(dirtyIndices, dirtyIndices + GetDirtyCount(), [propCount](int32_t const propIndex) { return propIndex >= propCount; });
+
+        GetHeader().m_dirtyCount = static_cast<int32_t>(keptEnd - dirtyIndices);
+        std::fill_n(GetDirtyFlagData() + propCount, oldCount - propCount, static_cast<uint8_t>(0));
+    }
+
+    GetHeader().m_propCount = propCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same swap-remove as PropStore: the last entry moves into propIndex. Pending writes to the removed
+// entry are dropped and those to the moved entry follow it, so nothing has to be applied first.
+//
+void PropTransformBuffer::RemoveAt(int const propIndex)
+{
+    int const lastIndex = GetPropCount() - 1;
+
+    if (propIndex < 0 || propIndex > lastIndex) return;
+
+    int32_t* dirtyIndices = GetDirtyIndexData();
+    int32_t* keptEnd      = std::remove(dirtyIndices, dirtyIndices + GetDirtyCount(), propIndex);
+
+    GetHeader().m_dirtyCount = static_cast<int32_t>(keptEnd - dirtyIndices);
+
+    if (propIndex != lastIndex)
+    {
+        std::replace(dirtyIndices, keptEnd, lastIndex, propIndex);
+
+        float*   transforms = GetTransformData();
+        uint8_t* colors     = GetColorData();
+
+        std::copy_n(transforms + static_cast<size_t>(lastIndex) * FLOATS_PER_TRANSFORM, FLOATS_PER_TRANSFORM, transforms + static_cast<size_t>(propIndex) * FLOATS_PER_TRANSFORM);
+        std::copy_n(colors + static_cast<size_t>(lastIndex) * BYTES_PER_COLOR, BYTES_PER_COLOR, colors + static_cast<size_t>(propIndex) * BYTES_PER_COLOR);
+        GetDirtyFlagData()[propIndex] = GetDirtyFlagData()[lastIndex];
+    }
+
+    GetDirtyFlagData()[lastIndex] = 0;
+    GetHeader().m_propCount       = lastIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropTransformBuffer::GetPropCount() const
+{
+    return m_block.empty() ? 0 : GetHeader().m_propCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropTransformBuffer::GetCapacity() const
+{
+    return m_block.empty() ? 0 : GetHeader().m_capacity;
+}
+
+//----------------------------------------------------------------------------------------------------
+float* PropTransformBuffer::GetTransformData()
+{
+    return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_block.data()) + GetHeader().m_transformsOffset);
+}
+
+//----------------------------------------------------------------------------------------------------
+float const* PropTransformBuffer::GetTransformData() const
+{
+    return reinterpret_cast<float const*>(reinterpret_cast<uint8_t const*>(m_block.data()) + GetHeader().m_transformsOffset);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t* PropTransformBuffer::GetColorData()
+{
+    return reinterpret_cast<uint8_t*>(m_block.data()) + GetHeader().m_colorsOffset;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t const* PropTransformBuffer::GetColorData() const
+{
+    return reinterpret_cast<uint8_t const*>(m_block.data()) + GetHeader().m_colorsOffset;
+}
+
+//----------------------------------------------------------------------------------------------------
+void* PropTransformBuffer::GetSharedData()
+{
+    return m_block.data();
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t PropTransformBuffer::GetSharedByteLength() const
+{
+    return m_block.size() * sizeof(uint32_t);
+}
+
+//----------------------------------------------------------------------------------------------------
+// For a position C++ set directly: the mirror follows it, and a script write of the position still
+// pending for this prop is superseded rather than applied over it later.
+//
+void PropTransformBuffer::StorePosition(int const propIndex, float const x, float const y, float const z)
+{
+    float* transform = GetTransformData() + static_cast<size_t>(propIndex) * FLOATS_PER_TRANSFORM;
+
+    transform[0] = x;
+    transform[1] = y;
+    transform[2] = z;
+
+    GetDirtyFlagData()[propIndex] &= static_cast<uint8_t>(~DIRTY_POSITION);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Clamped to the capacity: the count is written by scripts.
+//
+int PropTransformBuffer::GetDirtyCount() const
+{
+    return m_block.empty() ? 0 : std::clamp(GetHeader().m_dirtyCount, 0, GetHeader().m_capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+int PropTransformBuffer::GetDirtyIndex(int const dirtyIndex) const
+{
+    return GetDirtyIndexData()[dirtyIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t PropTransformBuffer::GetDirtyFlags(int const propIndex) const
+{
+    return GetDirtyFlagData()[propIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+// Clears the flags of the listed entries only, so the cost follows the number of writes, not props.
+//
+void PropTransformBuffer::ClearDirtyEntries()
+{
+    if (m_block.empty()) return;
+
+    int const      dirtyCount   = GetDirtyCount();
+    int const      propCount    = GetPropCount();
+    int32_t const* dirtyIndices = GetDirtyIndexData();
+    uint8_t*       dirtyFlags   = GetDirtyFlagData();
+
+    for (int dirtyIndex = 0; dirtyIndex < dirtyCount; ++dirtyIndex)
+    {
+        int32_t const propIndex = dirtyIndices[dirtyIndex];
+
+        if (propIndex >= 0 && propIndex < propCount) dirtyFlags[propIndex] = 0;
+    }
+
+    GetHeader().m_dirtyCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Regions keep their contents up to the old capacity; the header is rewritten with the new offsets.
+//
+void PropTransformBuffer::Reallocate(int const capacity)
+{
+    sPropTransformBufferHeader layout;
+    layout.m_capacity           = capacity;
+    layout.m_transformsOffset   = static_cast<int32_t>(sizeof(sPropTransformBufferHeader));
+    layout.m_colorsOffset       = layout.m_transformsOffset + capacity * FLOATS_PER_TRANSFORM * static_cast<int32_t>(sizeof(float));
+    layout.m_dirtyFlagsOffset   = layout.m_colorsOffset + capacity * BYTES_PER_COLOR;
+    layout.m_dirtyIndicesOffset = (layout.m_dirtyFlagsOffset + capacity + 3) & ~3;
+
+    size_t const          byteLength = static_cast<size_t>(layout.m_dirtyIndicesOffset) + static_cast<size_t>(capacity) * sizeof(int32_t);
+    std::vector<uint32_t> block((byteLength + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+    uint8_t*              bytes      = reinterpret_cast<uint8_t*>(block.data());
+
+    if (!m_block.empty())
+    {
+        sPropTransformBufferHeader const& oldLayout   = GetHeader();
+        uint8_t const*                    oldBytes    = reinterpret_cast<uint8_t const*>(m_block.data());
+        size_t const                      oldCapacity = static_cast<size_t>(oldLayout.m_capacity);
+
+        layout.m_propCount  = oldLayout.m_propCount;
+        layout.m_dirtyCount = GetDirtyCount();
+
+        std::memcpy(bytes + layout.m_transformsOffset, oldBytes + oldLayout.m_transformsOffset, oldCapacity * FLOATS_PER_TRANSFORM * sizeof(float));
+        std::memcpy(bytes + layout.m_colorsOffset, oldBytes + oldLayout.m_colorsOffset, oldCapacity * BYTES_PER_COLOR);
+        std::memcpy(bytes + layout.m_dirtyFlagsOffset, oldBytes + oldLayout.m_dirtyFlagsOffset, oldCapacity);
+        std::memcpy(bytes + layout.m_dirtyIndicesOffset, oldBytes + oldLayout.m_dirtyIndicesOffset, oldCapacity * sizeof(int32_t));
+    }
+
+    std::memcpy(bytes, &layout, sizeof(layout));
+    m_block.swap(block);
+}
+
+//----------------------------------------------------------------------------------------------------
+sPropTransformBufferHeader& PropTransformBuffer::GetHeader()
+{
+    return *reinterpret_cast<sPropTransformBufferHeader*>(m_block.data());
+}
+
+//----------------------------------------------------------------------------------------------------
+sPropTransformBufferHeader const& PropTransformBuffer::GetHeader() const
+{
+    return *reinterpret_cast<sPropTransformBufferHeader const*>(m_block.data());
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t* PropTransformBuffer::GetDirtyFlagData()
+{
+    return reinterpret_cast<uint8_t*>(m_block.data()) + GetHeader().m_dirtyFlagsOffset;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t const* PropTransformBuffer::GetDirtyFlagData() const
+{
+    return reinterpret_cast<uint8_t const*>(m_block.data()) + GetHeader().m_dirtyFlagsOffset;
+}
+
+//----------------------------------------------------------------------------------------------------
+int32_t* PropTransformBuffer::GetDirtyIndexData()
+{
+    return reinterpret_cast<int32_t*>(reinterpret_cast<uint8_t*>(m_block.data()) + GetHeader().m_dirtyIndicesOffset);
+}
+
+//----------------------------------------------------------------------------------------------------
+int32_t const* PropTransformBuffer::GetDirtyIndexData() const
+{
+    return reinterpret_cast<int32_t const*>(reinterpret_cast<uint8_t const*>(m_block.data()) + GetHeader().m_dirtyIndicesOffset);
+}
@@ -0,0 +1,87 @@
+//----------------------------------------------------------------------------------------------------
+// PropTransformBuffer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// First bytes of the shared block. Offsets are in bytes from the start of the block, so scripts build
+// their views from the header instead of repeating the layout math.
+//
+struct sPropTransformBufferHeader
+{
+    int32_t m_propCount          = 0;
+    int32_t m_dirtyCount         = 0;   // Entries in the dirty index list; scripts append as they write
+    int32_t m_capacity           = 0;   // Props the block has room for
+    int32_t m_transformsOffset   = 0;
+    int32_t m_colorsOffset       = 0;
+    int32_t m_dirtyFlagsOffset   = 0;
+    int32_t m_dirtyIndicesOffset = 0;
+    int32_t m_reserved           = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Flat, C++-owned mirror of every prop's transform and color, shared with scripts without copying.
+//
+// Everything lives in one block that scripts map as an ArrayBuffer (see ScriptSharedBuffer):
+//   header        sPropTransformBufferHeader
+//   transforms    float[capacity * 6]   position (x, y, z), orientation (yaw, pitch, roll) in degrees
+//   colors        uint8[capacity * 4]   r, g, b, a
+//   dirty flags   uint8[capacity]       DIRTY_* bits per prop
+//   dirty indices int32[capacity]       every prop with flags set, once, in first-write order
+//
+// Scripts set the fields, then the flag bits, and append an entry whose flags were zero to the index
+// list. The game applies exactly the listed entries and fields back to the props and clears them, so
+// entries nobody wrote never overwrite what C++ changed directly.
+//
+// RemoveAt mirrors the prop store's swap-remove, so destroying a prop keeps the mirror index-aligned in
+// O(1) instead of a full resync.
+//
+// The block only moves when the prop count outgrows the capacity; GetSharedData changes then and the
+// game re-publishes it to scripts.
+//
+class PropTransformBuffer
+{
+public:
+    static int constexpr     FLOATS_PER_TRANSFORM = 6;
+    static int constexpr     BYTES_PER_COLOR      = 4;
+    static int constexpr     MIN_CAPACITY         = 256;
+    static uint8_t constexpr DIRTY_POSITION       = 1 << 0;
+    static uint8_t constexpr DIRTY_ORIENTATION    = 1 << 1;
+    static uint8_t constexpr DIRTY_COLOR          = 1 << 2;
+
+    void Resize(int propCount);
+    void RemoveAt(int propIndex);
+    int  GetPropCount() const;
+    int  GetCapacity() const;
+
+    float*         GetTransformData();
+    float const*   GetTransformData() const;
+    uint8_t*       GetColorData();
+    uint8_t const* GetColorData() const;
+    void*          GetSharedData();
+    size_t         GetSharedByteLength() const;
+
+    void    StorePosition(int propIndex, float x, float y, float z);
+    int     GetDirtyCount() const;
+    int     GetDirtyIndex(int dirtyIndex) const;
+    uint8_t GetDirtyFlags(int propIndex) const;
+    void    ClearDirtyEntries();
+
+private:
+    void Reallocate(int capacity);
+
+    sPropTransformBufferHeader&       GetHeader();
+    sPropTransformBufferHeader const& GetHeader() const;
+    uint8_t*                          GetDirtyFlagData();
+    uint8_t const*                    GetDirtyFlagData() const;
+    int32_t*                          GetDirtyIndexData();
+    int32_t const*                    GetDirtyIndexData() const;
+
+    std::vector<uint32_t> m_block;   // 32-bit words keep every region 4-byte aligned
+};
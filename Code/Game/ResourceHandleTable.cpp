@@ -0,0 +1,145 @@
+//----------------------------------------------------------------------------------------------------
+// ResourceHandleTable.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/ResourceHandleTable.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/GameCommon.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Resource/ResourceSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+TextureHandle ResourceHandleTable::ResolveTexture(String const& path)
+{
+    TextureHandle const handle = m_textures.Find(path);
+    if (handle != INVALID_RESOURCE_HANDLE) return handle;
+
+    ++m_pathLookups;
+
+    Texture const* texture = ResourceSubsystem::CreateOrGetTextureFromFile(path.c_str());
+    if (texture == nullptr) return INVALID_RESOURCE_HANDLE;
+
+    return m_textures.Add(path, texture);
+}
+
+//----------------------------------------------------------------------------------------------------
+// For textures that do not come from a file (render targets, procedural textures). Registering a name
+// again returns its existing handle and keeps the first texture.
+//
+TextureHandle ResourceHandleTable::RegisterTexture(String const& name, Texture const* texture)
+{
+    TextureHandle const handle = m_textures.Find(name);
+    if (handle != INVALID_RESOURCE_HANDLE) return handle;
+    if (texture == nullptr) return INVALID_RESOURCE_HANDLE;
+
+    return m_textures.Add(name, texture);
+}
+
+//----------------------------------------------------------------------------------------------------
+ShaderHandle ResourceHandleTable::ResolveShader(String const& path, eVertexType const vertexType)
+{
+    ShaderHandle const handle = m_shaders.Find(path);
+    if (handle != INVALID_RESOURCE_HANDLE) return handle;
+
+    ++m_pathLookups;
+
+    Shader* shader = g_renderer->CreateOrGetShaderFromFile(path.c_str(), vertexType);
+    if (shader == nullptr) return INVALID_RESOURCE_HANDLE;
+
+    return m_shaders.Add(path, shader);
+}
+
+//----------------------------------------------------------------------------------------------------
+BitmapFontHandle ResourceHandleTable::ResolveBitmapFont(String const& path)
+{
+    BitmapFontHandle const handle = m_bitmapFonts.Find(path);
+    if (handle != INVALID_RESOURCE_HANDLE) return handle;
+
+    ++m_pathLookups;
+
+    BitmapFont* bitmapFont = ResourceSubsystem::CreateOrGetBitmapFontFromFile(path.c_str());
+    if (bitmapFont == nullptr) return INVALID_RESOURCE_HANDLE;
+
+    return m_bitmapFonts.Add(path, bitmapFont);
+}
+
+//----------------------------------------------------------------------------------------------------
+Texture const* ResourceHandleTable::GetTexture(TextureHandle const handle) const
+{
+    return m_textures.Get(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+Shader* ResourceHandleTable::GetShader(ShaderHandle const handle) const
+{
+    return m_shaders.Get(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+BitmapFont* ResourceHandleTable::GetBitmapFont(BitmapFontHandle const handle) const
+{
+    return m_bitmapFonts.Get(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Handle of an already interned path, without loading anything.
+//
+TextureHandle ResourceHandleTable::FindTexture(String const& path) const
+{
+    return m_textures.Find(path);
+}
+
+//----------------------------------------------------------------------------------------------------
+String const& ResourceHandleTable::GetTexturePath(TextureHandle const handle) const
+{
+    static String const s_emptyPath;
+
+    if (handle < 0 || handle >= static_cast<int>(m_textures.m_paths.size())) return s_emptyPath;
+
+    return m_textures.m_paths[handle];
+}
+
+//----------------------------------------------------------------------------------------------------
+sResourceHandleStats ResourceHandleTable::GetStats() const
+{
+    sResourceHandleStats stats;
+    stats.m_textureCount    = static_cast<int>(m_textures.m_resources.size());
+    stats.m_shaderCount     = static_cast<int>(m_shaders.m_resources.size());
+    stats.m_bitmapFontCount = static_cast<int>(m_bitmapFonts.m_resources.size());
+    stats.m_pathLookups     = m_pathLookups;
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename TResource>
+int ResourceHandleTable::sResourceTable<TResource>::Find(String const& path) const
+{
+    auto const found = m_handleByPath.find(path);
+
+    return found != m_handleByPath.end() ? found->second : INVALID_RESOURCE_HANDLE;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename TResource>
+int ResourceHandleTable::sResourceTable<TResource>::Add(String const& path, TResource* resource)
+{
+    int const handle = static_cast<int>(m_resources.size());
+
+    m_resources.push_back(resource);
+    m_paths.push_back(path);
+    m_handleByPath.emplace(path, handle);
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename TResource>
+TResource* ResourceHandleTable::sResourceTable<TResource>::Get(int const handle) const
+{
+    if (handle < 0 || handle >= static_cast<int>(m_resources.size())) return nullptr;
+
+    return m_resources[handle];
+}
@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------------------------------
+// ResourceHandleTable.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class BitmapFont;
+class Shader;
+class Texture;
+
+//----------------------------------------------------------------------------------------------------
+// Dense integer ids for engine resources; ints so scripts can hold them like prop handles.
+//
+using TextureHandle    = int;
+using ShaderHandle     = int;
+using BitmapFontHandle = int;
+
+int constexpr INVALID_RESOURCE_HANDLE = -1;
+
+//----------------------------------------------------------------------------------------------------
+struct sResourceHandleStats
+{
+    int m_textureCount    = 0;
+    int m_shaderCount     = 0;
+    int m_bitmapFontCount = 0;
+    int m_pathLookups     = 0;      // Resolve* calls that went through the engine's path-keyed CreateOrGet*
+};
+
+//----------------------------------------------------------------------------------------------------
+// Interns resource paths into stable handles. Resolve* looks the path up once (the engine's CreateOrGet*
+// is only called the first time a path is seen) and returns the same handle for every later call;
+// Get* is then a bounds-checked array index, so per-frame code caches handles instead of paths.
+//
+// The table does not own the resources: the engine's Renderer/ResourceSubsystem keep them alive for
+// the lifetime of the app. A path that fails to load is not interned and yields INVALID_RESOURCE_HANDLE.
+// Shaders are keyed by path only; the vertex type of the first resolve wins.
+//
+class ResourceHandleTable
+{
+public:
+    TextureHandle    ResolveTexture(String const& path);
+    TextureHandle    RegisterTexture(String const& name, Texture const* texture);
+    ShaderHandle     ResolveShader(String const& path, eVertexType vertexType = eVertexType::VERTEX_PCU);
+    BitmapFontHandle ResolveBitmapFont(String const& path);
+
+    Texture const* GetTexture(TextureHandle handle) const;
+    Shader*        GetShader(ShaderHandle handle) const;
+    BitmapFont*    GetBitmapFont(BitmapFontHandle handle) const;
+    TextureHandle  FindTexture(String const& path) const;
+    String const&  GetTexturePath(TextureHandle handle) const;
+
+    sResourceHandleStats GetStats() const;
+
+private:
+    template <typename TResource>
+    struct sResourceTable
+    {
+        std::unordered_map<String, int> m_handleByPath;
+        std::vector<TResource*>         m_resources;
+        std::vector<String>             m_paths;
+
+        int        Find(String const& path) const;
+        int        Add(String const& path, TResource* resource);
+        TResource* Get(int handle) const;
+    };
+
+    sResourceTable<Texture const> m_textures;
+    sResourceTable<Shader>        m_shaders;
+    sResourceTable<BitmapFont>    m_bitmapFonts;
+    int                           m_pathLookups = 0;
+};
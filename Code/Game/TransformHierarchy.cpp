@@ -0,0 +1,567 @@
+//----------------------------------------------------------------------------------------------------
+// TransformHierarchy.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TransformHierarchy.hpp"
+#include "Game/ParallelFor.hpp"
+#include "Game/TransformKernels.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // values[k] = old values[sourceIndices[k]].
+    template <typename T>
+    void Gather(std::vector<T>& values, std::vector<int> const& sourceIndices)
+    {
+        std::vector<T> gathered(values.size());
+
+        for (size_t index = 0; index < sourceIndices.size(); ++index)
+        {
+            gathered[index] = values[sourceIndices[index]];
+        }
+
+        values.swap(gathered);
+    }
+
+    bool IsSameOrientation(EulerAngles const& a, EulerAngles const& b)
+    {
+        return a.m_yawDegrees == b.m_yawDegrees && a.m_pitchDegrees == b.m_pitchDegrees && a.m_rollDegrees == b.m_rollDegrees;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns INVALID_TRANSFORM_NODE for an invalid parent. The node gets its world matrix in the next Update.
+//
+TransformNodeHandle TransformHierarchy::CreateNode(TransformNodeHandle const parent,
+                                                   Vec3 const&               localPosition,
+                                                   EulerAngles const&        localOrientation)
+{
+    if (parent != INVALID_TRANSFORM_NODE && !IsValid(parent)) return INVALID_TRANSFORM_NODE;
+
+    TransformNodeHandle node;
+
+    if (!m_freeNodes.empty())
+    {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+    else
+    {
+        node = static_cast<TransformNodeHandle>(m_indexByNode.size());
+        m_indexByNode.push_back(-1);
+        m_parentByNode.push_back(INVALID_TRANSFORM_NODE);
+        m_childCountByNode.push_back(0);
+    }
+
+    int const index = GetNodeCount();
+
+    m_nodeByIndex.push_back(node);
+    m_parentIndex.push_back(-1);
+    m_levelByIndex.push_back(0);
+    m_localPositions.push_back(localPosition);
+    m_localOrientations.push_back(localOrientation);
+    m_localTransforms.push_back(Mat44());
+    m_worldTransforms.push_back(Mat44());
+    m_isLocalDirty.push_back(1);
+    m_hasWorldChanged.push_back(0);
+
+    m_indexByNode[node]      = index;
+    m_parentByNode[node]     = parent;
+    m_childCountByNode[node] = 0;
+
+    if (parent != INVALID_TRANSFORM_NODE) ++m_childCountByNode[parent];
+
+    m_isLayoutStale = true;
+    MarkDirty(index);
+
+    return node;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The node's children become roots and keep their world transform as of the last Update as their
+// local one. O(handles) to find them, plus an O(1) swap-remove.
+//
+void TransformHierarchy::DestroyNode(TransformNodeHandle const node)
+{
+    if (!IsValid(node)) return;
+
+    for (TransformNodeHandle child = 0; child < static_cast<TransformNodeHandle>(m_parentByNode.size()); ++child)
+    {
+        if (m_parentByNode[child] != node) continue;
+
+        int const    childIndex = m_indexByNode[child];
+        Mat44 const& world      = m_worldTransforms[childIndex];
+
+        m_parentByNode[child]          = INVALID_TRANSFORM_NODE;
+        m_localPositions[childIndex]    = Vec3(world.m_values[Mat44::Tx], world.m_values[Mat44::Ty], world.m_values[Mat44::Tz]);
+        m_localOrientations[childIndex] = GetEulerAngles(world);
+        MarkDirty(childIndex);
+    }
+
+    TransformNodeHandle const parent = m_parentByNode[node];
+    if (parent != INVALID_TRANSFORM_NODE) --m_childCountByNode[parent];
+
+    int const index     = m_indexByNode[node];
+    int const lastIndex = GetNodeCount() - 1;
+
+    if (index != lastIndex)
+    {
+        m_nodeByIndex[index]       = m_nodeByIndex[lastIndex];
+        m_parentIndex[index]       = m_parentIndex[lastIndex];
+        m_levelByIndex[index]      = m_levelByIndex[lastIndex];
+        m_localPositions[index]    = m_localPositions[lastIndex];
+        m_localOrientations[index] = m_localOrientations[lastIndex];
+        m_localTransforms[index]   = m_localTransforms[lastIndex];
+        m_worldTransforms[index]   = m_worldTransforms[lastIndex];
+        m_isLocalDirty[index]      = m_isLocalDirty[lastIndex];
+        m_hasWorldChanged[index]   = m_hasWorldChanged[lastIndex];
+
+        m_indexByNode[m_nodeByIndex[index]] = index;
+    }
+
+    m_nodeByIndex.pop_back();
+    m_parentIndex.pop_back();
+    m_levelByIndex.pop_back();
+    m_localPositions.pop_back();
+    m_localOrientations.pop_back();
+    m_localTransforms.pop_back();
+    m_worldTransforms.pop_back();
+    m_isLocalDirty.pop_back();
+    m_hasWorldChanged.pop_back();
+
+    m_indexByNode[node]      = -1;
+    m_parentByNode[node]     = INVALID_TRANSFORM_NODE;
+    m_childCountByNode[node] = 0;
+    m_freeNodes.push_back(node);
+
+    m_isLayoutStale = true;
+    m_minDirtyLevel = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Keeps the local transform, so the node (and its subtree) moves with the new parent. INVALID_TRANSFORM_NODE
+// makes it a root. Returns false, changing nothing, for invalid handles or if parent is in node's subtree.
+//
+bool TransformHierarchy::SetParent(TransformNodeHandle const node,
+                                   TransformNodeHandle const parent)
+{
+    if (!IsValid(node)) return false;
+    if (parent != INVALID_TRANSFORM_NODE && (!IsValid(parent) || parent == node || IsAncestor(node, parent))) return false;
+
+    TransformNodeHandle const oldParent = m_parentByNode[node];
+    if (oldParent == parent) return true;
+
+    if (oldParent != INVALID_TRANSFORM_NODE) --m_childCountByNode[oldParent];
+    if (parent != INVALID_TRANSFORM_NODE) ++m_childCountByNode[parent];
+
+    m_parentByNode[node] = parent;
+    m_isLayoutStale      = true;
+    MarkDirty(m_indexByNode[node]);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Writing the values the node already has does not dirty it, so callers may mirror transforms every frame.
+//
+void TransformHierarchy::SetLocalTransform(TransformNodeHandle const node,
+                                           Vec3 const&               localPosition,
+                                           EulerAngles const&        localOrientation)
+{
+    int const index = m_indexByNode[node];
+
+    if (m_localPositions[index] == localPosition && IsSameOrientation(m_localOrientations[index], localOrientation)) return;
+
+    m_localPositions[index]    = localPosition;
+    m_localOrientations[index] = localOrientation;
+    MarkDirty(index);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each level of Update is split across threadCount threads of workers (the calling thread included).
+// nullptr or a threadCount of 1 keeps it serial.
+//
+void TransformHierarchy::SetParallelForWorkers(ParallelForWorkers* workers, int const threadCount)
+{
+    m_workers           = workers;
+    m_updateThreadCount = std::max(threadCount, 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TransformHierarchy::Reserve(int const nodeCount)
+{
+    size_t const capacity = static_cast<size_t>(nodeCount);
+
+    m_indexByNode.reserve(capacity);
+    m_parentByNode.reserve(capacity);
+    m_childCountByNode.reserve(capacity);
+    m_nodeByIndex.reserve(capacity);
+    m_parentIndex.reserve(capacity);
+    m_levelByIndex.reserve(capacity);
+    m_localPositions.reserve(capacity);
+    m_localOrientations.reserve(capacity);
+    m_localTransforms.reserve(capacity);
+    m_worldTransforms.reserve(capacity);
+    m_isLocalDirty.reserve(capacity);
+    m_hasWorldChanged.reserve(capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Destroys every node; all handles become invalid.
+//
+void TransformHierarchy::Clear()
+{
+    m_indexByNode.clear();
+    m_parentByNode.clear();
+    m_childCountByNode.clear();
+    m_freeNodes.clear();
+    m_nodeByIndex.clear();
+    m_parentIndex.clear();
+    m_levelByIndex.clear();
+    m_localPositions.clear();
+    m_localOrientations.clear();
+    m_localTransforms.clear();
+    m_worldTransforms.clear();
+    m_isLocalDirty.clear();
+    m_hasWorldChanged.clear();
+    m_levelBegins.clear();
+
+    m_isLayoutStale   = false;
+    m_minDirtyLevel   = INT32_MAX;
+    m_maxDirtyLevel   = -1;
+    m_hasChangedFlags = false;
+    m_lastUpdateStats = sTransformHierarchyStats();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rebuilds the world matrices of dirty nodes and their subtrees.
+//
+sTransformHierarchyStats const& TransformHierarchy::Update()
+{
+    return UpdateLevels(false);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rebuilds every local and world matrix, dirty or not.
+//
+sTransformHierarchyStats const& TransformHierarchy::UpdateAll()
+{
+    return UpdateLevels(true);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TransformHierarchy::IsValid(TransformNodeHandle const node) const
+{
+    return node >= 0 && node < static_cast<TransformNodeHandle>(m_indexByNode.size()) && m_indexByNode[node] >= 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+TransformNodeHandle TransformHierarchy::GetParent(TransformNodeHandle const node) const
+{
+    return m_parentByNode[node];
+}
+
+//----------------------------------------------------------------------------------------------------
+int TransformHierarchy::GetChildCount(TransformNodeHandle const node) const
+{
+    return m_childCountByNode[node];
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 const& TransformHierarchy::GetLocalPosition(TransformNodeHandle const node) const
+{
+    return m_localPositions[m_indexByNode[node]];
+}
+
+//----------------------------------------------------------------------------------------------------
+EulerAngles const& TransformHierarchy::GetLocalOrientation(TransformNodeHandle const node) const
+{
+    return m_localOrientations[m_indexByNode[node]];
+}
+
+//----------------------------------------------------------------------------------------------------
+// As of the last Update.
+//
+Mat44 const& TransformHierarchy::GetWorldTransform(TransformNodeHandle const node) const
+{
+    return m_worldTransforms[m_indexByNode[node]];
+}
+
+//----------------------------------------------------------------------------------------------------
+// True if the last Update rebuilt the node's world matrix.
+//
+bool TransformHierarchy::HasWorldTransformChanged(TransformNodeHandle const node) const
+{
+    return m_hasWorldChanged[m_indexByNode[node]] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TransformHierarchy::GetNodeCount() const
+{
+    return static_cast<int>(m_nodeByIndex.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+sTransformHierarchyStats const& TransformHierarchy::GetLastUpdateStats() const
+{
+    return m_lastUpdateStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Inverse of EulerAngles::GetAsMatrix_IFwd_JLeft_KUp for a rotation (plus translation) matrix. At
+// +-90 degrees of pitch yaw and roll turn about the same axis, so roll is folded into yaw.
+//
+STATIC EulerAngles TransformHierarchy::GetEulerAngles(Mat44 const& rigidTransform)
+{
+    float constexpr RADIANS_TO_DEGREES = 57.29577951308232f;
+
+    float const* values     = rigidTransform.m_values;
+    float const  horizontal = sqrtf(values[Mat44::Ix] * values[Mat44::Ix] + values[Mat44::Iy] * values[Mat44::Iy]);
+    float const  pitch      = atan2f(-values[Mat44::Iz], horizontal);
+
+    if (horizontal < 1e-5f)
+    {
+        return EulerAngles(atan2f(-values[Mat44::Jx], values[Mat44::Jy]) * RADIANS_TO_DEGREES, pitch * RADIANS_TO_DEGREES, 0.f);
+    }
+
+    return EulerAngles(atan2f(values[Mat44::Iy], values[Mat44::Ix]) * RADIANS_TO_DEGREES,
+                       pitch * RADIANS_TO_DEGREES,
+                       atan2f(values[Mat44::Jz], values[Mat44::Kz]) * RADIANS_TO_DEGREES);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks the levels top-down, one ParallelFor per level. An incremental update starts at the shallowest
+// dirty level and stops at the first level below the deepest dirty one where nothing changed.
+//
+sTransformHierarchyStats const& TransformHierarchy::UpdateLevels(bool const isFullUpdate)
+{
+    sTransformHierarchyStats stats;
+    stats.m_wasLayoutRebuilt = m_isLayoutStale;
+
+    if (m_isLayoutStale) RebuildLayout();
+
+    if (m_hasChangedFlags)
+    {
+        std::fill(m_hasWorldChanged.begin(), m_hasWorldChanged.end(), static_cast<uint8_t>(0));
+        m_hasChangedFlags = false;
+    }
+
+    int const levelCount = static_cast<int>(m_levelBegins.size()) - 1;
+
+    stats.m_nodeCount  = GetNodeCount();
+    stats.m_levelCount = std::max(levelCount, 0);
+    stats.m_firstLevel = isFullUpdate ? 0 : std::min(m_minDirtyLevel, stats.m_levelCount);
+
+    int              levelBegin = 0;
+    std::atomic<int> levelRecomputedCount = 0;
+
+    ParallelFor::RangeFunction const UpdateLevelRange = [&](int const beginIndex, int const endIndex)
+    {
+        levelRecomputedCount.fetch_add(UpdateRange(levelBegin + beginIndex, levelBegin + endIndex, isFullUpdate));
+    };
+
+    for (int level = stats.m_firstLevel; level < stats.m_levelCount; ++level)
+    {
+        levelBegin           = m_levelBegins[level];
+        levelRecomputedCount = 0;
+
+        ParallelFor::Run(m_workers, m_updateThreadCount, m_levelBegins[level + 1] - levelBegin, static_cast<int>(sizeof(Mat44)), UpdateLevelRange);
+
+        stats.m_recomputedCount += levelRecomputedCount;
+
+        if (!isFullUpdate && levelRecomputedCount == 0 && level >= m_maxDirtyLevel) break;
+    }
+
+    m_minDirtyLevel   = INT32_MAX;
+    m_maxDirtyLevel   = -1;
+    m_hasChangedFlags = stats.m_recomputedCount > 0;
+    m_lastUpdateStats = stats;
+
+    return m_lastUpdateStats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Updates one range of a level and returns how many world matrices it rebuilt. Reads only the level
+// above and writes only its own indices, so ranges of a level run concurrently.
+//
+int TransformHierarchy::UpdateRange(int const  beginIndex,
+                                    int const  endIndex,
+                                    bool const isFullUpdate)
+{
+    if (isFullUpdate)
+    {
+        TransformKernels::BuildModelToWorldTransforms(&m_localPositions[beginIndex], &m_localOrientations[beginIndex], endIndex - beginIndex, &m_localTransforms[beginIndex]);
+        std::fill(m_isLocalDirty.begin() + beginIndex, m_isLocalDirty.begin() + endIndex, static_cast<uint8_t>(0));
+    }
+
+    int recomputedCount = 0;
+
+    for (int index = beginIndex; index < endIndex; ++index)
+    {
+        int const  parentIndex     = m_parentIndex[index];
+        bool const isParentChanged = parentIndex >= 0 && m_hasWorldChanged[parentIndex] != 0;
+
+        if (m_isLocalDirty[index] != 0)
+        {
+            m_localTransforms[index] = TransformKernels::BuildModelToWorldTransform(m_localPositions[index], m_localOrientations[index]);
+            m_isLocalDirty[index]    = 0;
+        }
+        else if (!isFullUpdate && !isParentChanged)
+        {
+            continue;
+        }
+
+        if (parentIndex < 0)
+        {
+            m_worldTransforms[index] = m_localTransforms[index];
+        }
+        else
+        {
+            Mat44 world = m_worldTransforms[parentIndex];
+            world.Append(m_localTransforms[index]);
+            m_worldTransforms[index] = world;
+        }
+
+        m_hasWorldChanged[index] = 1;
+        ++recomputedCount;
+    }
+
+    return recomputedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Re-sorts every per-index array into level order: roots in their current order, then each level's
+// children grouped by parent. O(nodes), with a counting sort of children by parent handle.
+//
+void TransformHierarchy::RebuildLayout()
+{
+    int const nodeCount   = GetNodeCount();
+    int const handleCount = static_cast<int>(m_indexByNode.size());
+
+    // Children of each handle, in current index order: m_scratchChildren[m_scratchChildBegins[p]...].
+    m_scratchChildBegins.assign(static_cast<size_t>(handleCount) + 1, 0);
+
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        TransformNodeHandle const parent = m_parentByNode[m_nodeByIndex[index]];
+        if (parent != INVALID_TRANSFORM_NODE) ++m_scratchChildBegins[parent + 1];
+    }
+
+    for (int handle = 0; handle < handleCount; ++handle)
+    {
+        m_scratchChildBegins[handle + 1] += m_scratchChildBegins[handle];
+    }
+
+    m_scratchChildren.resize(static_cast<size_t>(m_scratchChildBegins[handleCount]));
+    m_scratchOrder.assign(m_scratchChildBegins.begin(), m_scratchChildBegins.end() - 1);     // Fill cursor per parent
+
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        TransformNodeHandle const node   = m_nodeByIndex[index];
+        TransformNodeHandle const parent = m_parentByNode[node];
+        if (parent != INVALID_TRANSFORM_NODE) m_scratchChildren[m_scratchOrder[parent]++] = node;
+    }
+
+    // Breadth-first handle order, one level at a time.
+    m_scratchOrder.clear();
+    m_levelBegins.assign(1, 0);
+
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        if (m_parentByNode[m_nodeByIndex[index]] == INVALID_TRANSFORM_NODE) m_scratchOrder.push_back(m_nodeByIndex[index]);
+    }
+
+    for (int levelBegin = 0; levelBegin < static_cast<int>(m_scratchOrder.size());)
+    {
+        int const levelEnd = static_cast<int>(m_scratchOrder.size());
+
+        for (int order = levelBegin; order < levelEnd; ++order)
+        {
+            TransformNodeHandle const node = m_scratchOrder[order];
+            m_scratchOrder.insert(m_scratchOrder.end(), m_scratchChildren.begin() + m_scratchChildBegins[node], m_scratchChildren.begin() + m_scratchChildBegins[node + 1]);
+        }
+
+        m_levelBegins.push_back(levelEnd);
+        levelBegin = levelEnd;
+    }
+
+    if (static_cast<int>(m_scratchOrder.size()) != nodeCount) ERROR_AND_DIE(StringFormat("(TransformHierarchy::RebuildLayout)(reached {} of {} nodes)", m_scratchOrder.size(), nodeCount))
+
+    // Old index of every new index, then gather each array.
+    std::vector<int> sourceIndices(static_cast<size_t>(nodeCount));
+
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        sourceIndices[index] = m_indexByNode[m_scratchOrder[index]];
+    }
+
+    Gather(m_localPositions, sourceIndices);
+    Gather(m_localOrientations, sourceIndices);
+    Gather(m_localTransforms, sourceIndices);
+    Gather(m_worldTransforms, sourceIndices);
+    Gather(m_isLocalDirty, sourceIndices);
+
+    m_nodeByIndex.assign(m_scratchOrder.begin(), m_scratchOrder.end());
+    std::fill(m_hasWorldChanged.begin(), m_hasWorldChanged.end(), static_cast<uint8_t>(0));
+    m_hasChangedFlags = false;
+
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        m_indexByNode[m_nodeByIndex[index]] = index;
+    }
+
+    m_minDirtyLevel = INT32_MAX;
+    m_maxDirtyLevel = -1;
+
+    for (int level = 0; level + 1 < static_cast<int>(m_levelBegins.size()); ++level)
+    {
+        for (int index = m_levelBegins[level]; index < m_levelBegins[level + 1]; ++index)
+        {
+            TransformNodeHandle const parent = m_parentByNode[m_nodeByIndex[index]];
+
+            m_parentIndex[index]  = parent == INVALID_TRANSFORM_NODE ? -1 : m_indexByNode[parent];
+            m_levelByIndex[index] = level;
+
+            if (m_isLocalDirty[index] != 0)
+            {
+                m_minDirtyLevel = std::min(m_minDirtyLevel, level);
+                m_maxDirtyLevel = level;
+            }
+        }
+    }
+
+    m_isLayoutStale = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TransformHierarchy::IsAncestor(TransformNodeHandle const ancestor,
+                                    TransformNodeHandle const node) const
+{
+    for (TransformNodeHandle parent = m_parentByNode[node]; parent != INVALID_TRANSFORM_NODE; parent = m_parentByNode[parent])
+    {
+        if (parent == ancestor) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// While the layout is stale levels are unknown; RebuildLayout recomputes the dirty range from the flags.
+//
+void TransformHierarchy::MarkDirty(int const index)
+{
+    m_isLocalDirty[index] = 1;
+
+    if (m_isLayoutStale) return;
+
+    m_minDirtyLevel = std::min(m_minDirtyLevel, m_levelByIndex[index]);
+    m_maxDirtyLevel = std::max(m_maxDirtyLevel, m_levelByIndex[index]);
+}
@@ -0,0 +1,115 @@
+//----------------------------------------------------------------------------------------------------
+// TransformHierarchy.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ParallelForWorkers;
+
+//----------------------------------------------------------------------------------------------------
+using TransformNodeHandle = int;
+
+TransformNodeHandle constexpr INVALID_TRANSFORM_NODE = -1;
+
+//----------------------------------------------------------------------------------------------------
+struct sTransformHierarchyStats
+{
+    int  m_nodeCount        = 0;
+    int  m_levelCount       = 0;
+    int  m_firstLevel       = 0;            // Shallowest level the last Update had to visit
+    int  m_recomputedCount  = 0;            // World matrices rebuilt by the last Update
+    bool m_wasLayoutRebuilt = false;        // Nodes were created, destroyed or reparented since the previous Update
+};
+
+//----------------------------------------------------------------------------------------------------
+// Parent/child transforms: every node has a local position and orientation relative to its parent (or
+// to the world for roots), and Update turns them into world matrices, world = parent world * local.
+//
+// Nodes are stored breadth-first: every array is indexed in level order, all nodes of one depth are
+// contiguous and siblings sit next to each other, so a parent always comes before its children. Update
+// walks the levels top-down; the nodes of a level only read the level above, so each level runs as one
+// ParallelFor once workers are set (SetParallelForWorkers). Structural edits (CreateNode, DestroyNode,
+// SetParent) append or swap-remove and leave the order stale; the next Update re-sorts everything once.
+//
+// Updates are incremental: SetLocalTransform marks one node dirty, and a node's world matrix is rebuilt
+// only if it is dirty or its parent's was rebuilt in the same Update, so clean subtrees cost one flag
+// test per node and levels above the shallowest dirty node are skipped. UpdateAll rebuilds everything.
+// Local matrices come from the TransformKernels scalar reference (SIMD batches in UpdateAll), so both
+// paths give the same bits.
+//
+// Handles are stable across re-sorts but are reused after DestroyNode.
+//
+class TransformHierarchy
+{
+public:
+    TransformNodeHandle CreateNode(TransformNodeHandle parent = INVALID_TRANSFORM_NODE, Vec3 const& localPosition = Vec3::ZERO, EulerAngles const& localOrientation = EulerAngles::ZERO);
+    void                DestroyNode(TransformNodeHandle node);
+    bool                SetParent(TransformNodeHandle node, TransformNodeHandle parent);
+    void                SetLocalTransform(TransformNodeHandle node, Vec3 const& localPosition, EulerAngles const& localOrientation);
+    void                SetParallelForWorkers(ParallelForWorkers* workers, int threadCount);
+    void                Reserve(int nodeCount);
+    void                Clear();
+
+    sTransformHierarchyStats const& Update();
+    sTransformHierarchyStats const& UpdateAll();
+
+    bool                IsValid(TransformNodeHandle node) const;
+    TransformNodeHandle GetParent(TransformNodeHandle node) const;
+    int                 GetChildCount(TransformNodeHandle node) const;
+    Vec3 const&         GetLocalPosition(TransformNodeHandle node) const;
+    EulerAngles const&  GetLocalOrientation(TransformNodeHandle node) const;
+    Mat44 const&        GetWorldTransform(TransformNodeHandle node) const;
+    bool                HasWorldTransformChanged(TransformNodeHandle node) const;
+    int                 GetNodeCount() const;
+
+    sTransformHierarchyStats const& GetLastUpdateStats() const;
+
+    static EulerAngles GetEulerAngles(Mat44 const& rigidTransform);
+
+private:
+    sTransformHierarchyStats const& UpdateLevels(bool isFullUpdate);
+    int                             UpdateRange(int beginIndex, int endIndex, bool isFullUpdate);
+    void                            RebuildLayout();
+    bool                            IsAncestor(TransformNodeHandle ancestor, TransformNodeHandle node) const;
+    void                            MarkDirty(int index);
+
+    // Per handle; structure only, so re-sorting never touches them except m_indexByNode.
+    std::vector<int>                 m_indexByNode;          // -1 while the handle is free
+    std::vector<TransformNodeHandle> m_parentByNode;
+    std::vector<int>                 m_childCountByNode;
+    std::vector<TransformNodeHandle> m_freeNodes;
+
+    // Per index, in level order after RebuildLayout.
+    std::vector<TransformNodeHandle> m_nodeByIndex;
+    std::vector<int>                 m_parentIndex;          // -1 for roots
+    std::vector<int>                 m_levelByIndex;
+    std::vector<Vec3>                m_localPositions;
+    std::vector<EulerAngles>         m_localOrientations;
+    std::vector<Mat44>               m_localTransforms;
+    std::vector<Mat44>               m_worldTransforms;
+    std::vector<uint8_t>             m_isLocalDirty;         // Bytes, not vector<bool>: level chunks write them concurrently
+    std::vector<uint8_t>             m_hasWorldChanged;
+
+    std::vector<int> m_levelBegins;                          // Level l spans [m_levelBegins[l], m_levelBegins[l + 1])
+    std::vector<int> m_scratchOrder;
+    std::vector<int> m_scratchChildBegins;
+    std::vector<int> m_scratchChildren;
+
+    bool m_isLayoutStale   = false;
+    int  m_minDirtyLevel   = INT32_MAX;                      // Shallowest level with a dirty node; INT32_MAX when clean
+    int  m_maxDirtyLevel   = -1;                             // Deepest level with a dirty node; -1 when clean
+    bool m_hasChangedFlags = false;                          // m_hasWorldChanged has set entries from the last Update
+
+    ParallelForWorkers*      m_workers           = nullptr;
+    int                      m_updateThreadCount = 1;
+    sTransformHierarchyStats m_lastUpdateStats;
+};
@@ -0,0 +1,300 @@
+//----------------------------------------------------------------------------------------------------
+// TransformKernelBlocks.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The TransformKernels math written once over a lane type, so every SIMD level runs the same operations
+// in the same order. Only TransformKernels*.cpp include this, each instantiating it with its own lane
+// type from an anonymous namespace (the AVX2 one must never be shared with a baseline build).
+//
+// A Lane provides WIDTH, the Float/Int/Mask register types and static functions:
+//   Set(float), Load(float const*), Store(float*, Float), Add, Sub, Mul, Negate,
+//   Select(Mask, whenTrue, whenFalse), ToInt(Float), AddInt(Int, int), HasBits(Int, int) -> Mask,
+//   LoadMatrices(Mat44 const*, Float (&)[16]) and StoreMatrices(Float const (&)[16], Mat44*),
+// where lane i of element k is m_values[k] of matrix i.
+//
+template <typename Lane>
+class TransformKernelBlocks
+{
+public:
+    using Float = typename Lane::Float;
+    using Int   = typename Lane::Int;
+    using Mask  = typename Lane::Mask;
+
+    static int constexpr WIDTH = Lane::WIDTH;
+
+    static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 is read as 3 packed floats");
+    static_assert(sizeof(EulerAngles) == 3 * sizeof(float), "EulerAngles is read as 3 packed floats");
+
+    static void BuildModelToWorldTransforms(Vec3 const*        positions,
+                                            EulerAngles const* orientations,
+                                            int const          count,
+                                            Mat44*             out_transforms)
+    {
+        int index = 0;
+
+        for (; index + WIDTH <= count; index += WIDTH)
+        {
+            BuildModelToWorldBlock(positions + index, orientations + index, out_transforms + index);
+        }
+
+        if (index == count) return;
+
+        Vec3        tailPositions[WIDTH];
+        EulerAngles tailOrientations[WIDTH];
+        Mat44       tailTransforms[WIDTH];
+
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            tailPositions[lane]    = index + lane < count ? positions[index + lane] : Vec3::ZERO;
+            tailOrientations[lane] = index + lane < count ? orientations[index + lane] : EulerAngles::ZERO;
+        }
+
+        BuildModelToWorldBlock(tailPositions, tailOrientations, tailTransforms);
+
+        for (int lane = 0; index + lane < count; ++lane)
+        {
+            out_transforms[index + lane] = tailTransforms[lane];
+        }
+    }
+
+    static void AppendTransforms(Mat44 const* transforms,
+                                 Mat44 const* appendTransforms,
+                                 int const    count,
+                                 Mat44*       out_transforms)
+    {
+        int index = 0;
+
+        for (; index + WIDTH <= count; index += WIDTH)
+        {
+            AppendBlock(transforms + index, appendTransforms + index, out_transforms + index);
+        }
+
+        if (index == count) return;
+
+        Mat44 tailTransforms[WIDTH];
+        Mat44 tailAppendTransforms[WIDTH];
+        Mat44 tailResults[WIDTH];
+
+        for (int lane = 0; index + lane < count; ++lane)
+        {
+            tailTransforms[lane]       = transforms[index + lane];
+            tailAppendTransforms[lane] = appendTransforms[index + lane];
+        }
+
+        AppendBlock(tailTransforms, tailAppendTransforms, tailResults);
+
+        for (int lane = 0; index + lane < count; ++lane)
+        {
+            out_transforms[index + lane] = tailResults[lane];
+        }
+    }
+
+    static void TransformPositions(Mat44 const& transform,
+                                   Vec3 const*  positions,
+                                   int const    count,
+                                   Vec3*        out_positions)
+    {
+        Float elements[16];
+
+        for (int element = 0; element < 16; ++element)
+        {
+            elements[element] = Lane::Set(transform.m_values[element]);
+        }
+
+        int index = 0;
+
+        for (; index + WIDTH <= count; index += WIDTH)
+        {
+            TransformPositionBlock(elements, positions + index, out_positions + index);
+        }
+
+        if (index == count) return;
+
+        Vec3 tailPositions[WIDTH];
+        Vec3 tailResults[WIDTH];
+
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            tailPositions[lane] = index + lane < count ? positions[index + lane] : Vec3::ZERO;
+        }
+
+        TransformPositionBlock(elements, tailPositions, tailResults);
+
+        for (int lane = 0; index + lane < count; ++lane)
+        {
+            out_positions[index + lane] = tailResults[lane];
+        }
+    }
+
+private:
+    // Cephes sinf/cosf minimax coefficients for |x| <= pi/4.
+    static float constexpr SIN_C0 = -1.9515295891e-4f;
+    static float constexpr SIN_C1 = 8.3321608736e-3f;
+    static float constexpr SIN_C2 = -1.6666654611e-1f;
+    static float constexpr COS_C0 = 2.443315711809948e-5f;
+    static float constexpr COS_C1 = -1.388731625493765e-3f;
+    static float constexpr COS_C2 = 4.166664568298827e-2f;
+
+    static float constexpr DEGREES_TO_RADIANS = 0.01745329251994329577f;
+    static float constexpr ROUNDING_MAGIC     = 12582912.f;      // 1.5 * 2^23: adding and subtracting it rounds to nearest
+
+    // The angle is split into quarter turns and a remainder in degrees, which is exact for moderate
+    // angles, so only the remainder (within about +-45 degrees) goes through the polynomials.
+    static void SinCosDegrees(Float const degrees, Float& out_sin, Float& out_cos)
+    {
+        Float const quadrant = Lane::Sub(Lane::Add(Lane::Mul(degrees, Lane::Set(1.f / 90.f)), Lane::Set(ROUNDING_MAGIC)), Lane::Set(ROUNDING_MAGIC));
+        Float const x        = Lane::Mul(Lane::Sub(degrees, Lane::Mul(quadrant, Lane::Set(90.f))), Lane::Set(DEGREES_TO_RADIANS));
+        Float const z        = Lane::Mul(x, x);
+
+        Float sinPolynomial = Lane::Add(Lane::Mul(Lane::Set(SIN_C0), z), Lane::Set(SIN_C1));
+        sinPolynomial       = Lane::Add(Lane::Mul(sinPolynomial, z), Lane::Set(SIN_C2));
+        sinPolynomial       = Lane::Add(Lane::Mul(Lane::Mul(sinPolynomial, z), x), x);
+
+        Float cosPolynomial = Lane::Add(Lane::Mul(Lane::Set(COS_C0), z), Lane::Set(COS_C1));
+        cosPolynomial       = Lane::Add(Lane::Mul(cosPolynomial, z), Lane::Set(COS_C2));
+        cosPolynomial       = Lane::Add(Lane::Sub(Lane::Mul(Lane::Mul(cosPolynomial, z), z), Lane::Mul(Lane::Set(0.5f), z)), Lane::Set(1.f));
+
+        // sin(q * 90 + r) and cos(q * 90 + r) by quadrant q mod 4: odd quadrants swap sin and cos,
+        // quadrants 2 and 3 negate sin and quadrants 1 and 2 negate cos.
+        Int const  quarterTurns = Lane::ToInt(quadrant);
+        Mask const isSwapped    = Lane::HasBits(quarterTurns, 1);
+        Mask const isSinNegated = Lane::HasBits(quarterTurns, 2);
+        Mask const isCosNegated = Lane::HasBits(Lane::AddInt(quarterTurns, 1), 2);
+
+        Float const sinValue = Lane::Select(isSwapped, cosPolynomial, sinPolynomial);
+        Float const cosValue = Lane::Select(isSwapped, sinPolynomial, cosPolynomial);
+
+        out_sin = Lane::Select(isSinNegated, Lane::Negate(sinValue), sinValue);
+        out_cos = Lane::Select(isCosNegated, Lane::Negate(cosValue), cosValue);
+    }
+
+    // Splits WIDTH packed triples into one register per component.
+    static void LoadTriples(float const* source, Float& out_first, Float& out_second, Float& out_third)
+    {
+        alignas(32) float components[3][WIDTH];
+
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            components[0][lane] = source[lane * 3];
+            components[1][lane] = source[lane * 3 + 1];
+            components[2][lane] = source[lane * 3 + 2];
+        }
+
+        out_first  = Lane::Load(components[0]);
+        out_second = Lane::Load(components[1]);
+        out_third  = Lane::Load(components[2]);
+    }
+
+    static void StoreTriples(Float const first, Float const second, Float const third, float* destination)
+    {
+        alignas(32) float components[3][WIDTH];
+
+        Lane::Store(components[0], first);
+        Lane::Store(components[1], second);
+        Lane::Store(components[2], third);
+
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            destination[lane * 3]     = components[0][lane];
+            destination[lane * 3 + 1] = components[1][lane];
+            destination[lane * 3 + 2] = components[2][lane];
+        }
+    }
+
+    // Same layout as EulerAngles::GetAsMatrix_IFwd_JLeft_KUp (yaw about K, pitch about J, roll about I)
+    // with the position as the translation.
+    static void BuildModelToWorldBlock(Vec3 const* positions, EulerAngles const* orientations, Mat44* out_transforms)
+    {
+        Float x, y, z;
+        Float yaw, pitch, roll;
+
+        LoadTriples(reinterpret_cast<float const*>(positions), x, y, z);
+        LoadTriples(reinterpret_cast<float const*>(orientations), yaw, pitch, roll);
+
+        Float sy, cy, sp, cp, sr, cr;
+
+        SinCosDegrees(yaw, sy, cy);
+        SinCosDegrees(pitch, sp, cp);
+        SinCosDegrees(roll, sr, cr);
+
+        Float const cysp = Lane::Mul(cy, sp);
+        Float const sysp = Lane::Mul(sy, sp);
+        Float const zero = Lane::Set(0.f);
+
+        Float elements[16];
+
+        elements[Mat44::Ix] = Lane::Mul(cy, cp);
+        elements[Mat44::Iy] = Lane::Mul(sy, cp);
+        elements[Mat44::Iz] = Lane::Negate(sp);
+        elements[Mat44::Iw] = zero;
+        elements[Mat44::Jx] = Lane::Sub(Lane::Mul(cysp, sr), Lane::Mul(sy, cr));
+        elements[Mat44::Jy] = Lane::Add(Lane::Mul(cy, cr), Lane::Mul(sysp, sr));
+        elements[Mat44::Jz] = Lane::Mul(cp, sr);
+        elements[Mat44::Jw] = zero;
+        elements[Mat44::Kx] = Lane::Add(Lane::Mul(sy, sr), Lane::Mul(cysp, cr));
+        elements[Mat44::Ky] = Lane::Sub(Lane::Mul(sysp, cr), Lane::Mul(cy, sr));
+        elements[Mat44::Kz] = Lane::Mul(cp, cr);
+        elements[Mat44::Kw] = zero;
+        elements[Mat44::Tx] = x;
+        elements[Mat44::Ty] = y;
+        elements[Mat44::Tz] = z;
+        elements[Mat44::Tw] = Lane::Set(1.f);
+
+        Lane::StoreMatrices(elements, out_transforms);
+    }
+
+    // Column c of the result is transform * column c of appendTransform, summed I, J, K, T as in Mat44::Append.
+    static void AppendBlock(Mat44 const* transforms, Mat44 const* appendTransforms, Mat44* out_transforms)
+    {
+        Float left[16];
+        Float right[16];
+        Float result[16];
+
+        Lane::LoadMatrices(transforms, left);
+        Lane::LoadMatrices(appendTransforms, right);
+
+        for (int column = 0; column < 4; ++column)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                Float sum = Lane::Mul(left[row], right[column * 4]);
+                sum       = Lane::Add(sum, Lane::Mul(left[4 + row], right[column * 4 + 1]));
+                sum       = Lane::Add(sum, Lane::Mul(left[8 + row], right[column * 4 + 2]));
+                sum       = Lane::Add(sum, Lane::Mul(left[12 + row], right[column * 4 + 3]));
+
+                result[column * 4 + row] = sum;
+            }
+        }
+
+        Lane::StoreMatrices(result, out_transforms);
+    }
+
+    static void TransformPositionBlock(Float const (&elements)[16], Vec3 const* positions, Vec3* out_positions)
+    {
+        Float x, y, z;
+
+        LoadTriples(reinterpret_cast<float const*>(positions), x, y, z);
+
+        Float results[3];
+
+        for (int row = 0; row < 3; ++row)
+        {
+            Float sum = Lane::Mul(elements[row], x);
+            sum       = Lane::Add(sum, Lane::Mul(elements[4 + row], y));
+            sum       = Lane::Add(sum, Lane::Mul(elements[8 + row], z));
+            sum       = Lane::Add(sum, elements[12 + row]);
+
+            results[row] = sum;
+        }
+
+        StoreTriples(results[0], results[1], results[2], reinterpret_cast<float*>(out_positions));
+    }
+};
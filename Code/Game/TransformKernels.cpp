@@ -0,0 +1,334 @@
+//----------------------------------------------------------------------------------------------------
+// TransformKernels.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TransformKernels.hpp"
+#include "Game/TransformKernelBlocks.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+
+#if defined(GAME_SIMD_X86)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(GAME_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // The reference level: one element per step, plain float math.
+    struct sScalarLane
+    {
+        using Float = float;
+        using Int   = int;
+        using Mask  = bool;
+
+        static int constexpr WIDTH = 1;
+
+        static Float Set(float const value) { return value; }
+        static Float Load(float const* source) { return *source; }
+        static void  Store(float* destination, Float const value) { *destination = value; }
+        static Float Add(Float const a, Float const b) { return a + b; }
+        static Float Sub(Float const a, Float const b) { return a - b; }
+        static Float Mul(Float const a, Float const b) { return a * b; }
+        static Float Negate(Float const a) { return -a; }
+        static Float Select(Mask const mask, Float const whenTrue, Float const whenFalse) { return mask ? whenTrue : whenFalse; }
+        static Int   ToInt(Float const a) { return static_cast<int>(a); }
+        static Int   AddInt(Int const a, int const b) { return a + b; }
+        static Mask  HasBits(Int const a, int const bits) { return (a & bits) == bits; }
+
+        static void LoadMatrices(Mat44 const* matrices, Float (&out_elements)[16])
+        {
+            for (int element = 0; element < 16; ++element) out_elements[element] = matrices->m_values[element];
+        }
+
+        static void StoreMatrices(Float const (&elements)[16], Mat44* out_matrices)
+        {
+            for (int element = 0; element < 16; ++element) out_matrices->m_values[element] = elements[element];
+        }
+    };
+
+#if defined(GAME_SIMD_X86)
+    // SSE2 only, so it runs on every x86 target the game builds for.
+    struct sSseLane
+    {
+        using Float = __m128;
+        using Int   = __m128i;
+        using Mask  = __m128;
+
+        static int constexpr WIDTH = 4;
+
+        static Float Set(float const value) { return _mm_set1_ps(value); }
+        static Float Load(float const* source) { return _mm_load_ps(source); }
+        static void  Store(float* destination, Float const value) { _mm_store_ps(destination, value); }
+        static Float Add(Float const a, Float const b) { return _mm_add_ps(a, b); }
+        static Float Sub(Float const a, Float const b) { return _mm_sub_ps(a, b); }
+        static Float Mul(Float const a, Float const b) { return _mm_mul_ps(a, b); }
+        static Float Negate(Float const a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+        static Float Select(Mask const mask, Float const whenTrue, Float const whenFalse) { return _mm_or_ps(_mm_and_ps(mask, whenTrue), _mm_andnot_ps(mask, whenFalse)); }
+        static Int   ToInt(Float const a) { return _mm_cvttps_epi32(a); }
+        static Int   AddInt(Int const a, int const b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+        static Mask  HasBits(Int const a, int const bits) { return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, _mm_set1_epi32(bits)), _mm_set1_epi32(bits))); }
+
+        // Each group of four elements (one basis column) is a 4x4 transpose between lanes and matrices.
+        static void LoadMatrices(Mat44 const* matrices, Float (&out_elements)[16])
+        {
+            for (int group = 0; group < 16; group += 4)
+            {
+                __m128 row0 = _mm_loadu_ps(matrices[0].m_values + group);
+                __m128 row1 = _mm_loadu_ps(matrices[1].m_values + group);
+                __m128 row2 = _mm_loadu_ps(matrices[2].m_values + group);
+                __m128 row3 = _mm_loadu_ps(matrices[3].m_values + group);
+
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+                out_elements[group]     = row0;
+                out_elements[group + 1] = row1;
+                out_elements[group + 2] = row2;
+                out_elements[group + 3] = row3;
+            }
+        }
+
+        static void StoreMatrices(Float const (&elements)[16], Mat44* out_matrices)
+        {
+            for (int group = 0; group < 16; group += 4)
+            {
+                __m128 row0 = elements[group];
+                __m128 row1 = elements[group + 1];
+                __m128 row2 = elements[group + 2];
+                __m128 row3 = elements[group + 3];
+
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+                _mm_storeu_ps(out_matrices[0].m_values + group, row0);
+                _mm_storeu_ps(out_matrices[1].m_values + group, row1);
+                _mm_storeu_ps(out_matrices[2].m_values + group, row2);
+                _mm_storeu_ps(out_matrices[3].m_values + group, row3);
+            }
+        }
+    };
+#endif
+
+#if defined(GAME_SIMD_NEON)
+    struct sNeonLane
+    {
+        using Float = float32x4_t;
+        using Int   = int32x4_t;
+        using Mask  = uint32x4_t;
+
+        static int constexpr WIDTH = 4;
+
+        static Float Set(float const value) { return vdupq_n_f32(value); }
+        static Float Load(float const* source) { return vld1q_f32(source); }
+        static void  Store(float* destination, Float const value) { vst1q_f32(destination, value); }
+        static Float Add(Float const a, Float const b) { return vaddq_f32(a, b); }
+        static Float Sub(Float const a, Float const b) { return vsubq_f32(a, b); }
+        static Float Mul(Float const a, Float const b) { return vmulq_f32(a, b); }
+        static Float Negate(Float const a) { return vnegq_f32(a); }
+        static Float Select(Mask const mask, Float const whenTrue, Float const whenFalse) { return vbslq_f32(mask, whenTrue, whenFalse); }
+        static Int   ToInt(Float const a) { return vcvtq_s32_f32(a); }
+        static Int   AddInt(Int const a, int const b) { return vaddq_s32(a, vdupq_n_s32(b)); }
+        static Mask  HasBits(Int const a, int const bits) { return vceqq_s32(vandq_s32(a, vdupq_n_s32(bits)), vdupq_n_s32(bits)); }
+
+        // vld4q/vst4q de-interleave and interleave four floats at a time, which is the 4x4 transpose.
+        static void LoadMatrices(Mat44 const* matrices, Float (&out_elements)[16])
+        {
+            for (int group = 0; group < 16; group += 4)
+            {
+                float interleaved[16];
+
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    for (int element = 0; element < 4; ++element) interleaved[lane * 4 + element] = matrices[lane].m_values[group + element];
+                }
+
+                float32x4x4_t const rows = vld4q_f32(interleaved);
+
+                out_elements[group]     = rows.val[0];
+                out_elements[group + 1] = rows.val[1];
+                out_elements[group + 2] = rows.val[2];
+                out_elements[group + 3] = rows.val[3];
+            }
+        }
+
+        static void StoreMatrices(Float const (&elements)[16], Mat44* out_matrices)
+        {
+            for (int group = 0; group < 16; group += 4)
+            {
+                float interleaved[16];
+
+                vst4q_f32(interleaved, (float32x4x4_t{{elements[group], elements[group + 1], elements[group + 2], elements[group + 3]}}));
+
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    for (int element = 0; element < 4; ++element) out_matrices[lane].m_values[group + element] = interleaved[lane * 4 + element];
+                }
+            }
+        }
+    };
+#endif
+
+    bool DetectAVX2()
+    {
+#if defined(GAME_SIMD_X86) && defined(_MSC_VER)
+        int registers[4] = {};
+
+        __cpuid(registers, 0);
+        if (registers[0] < 7) return false;
+
+        // AVX2 needs the CPU feature and the OS saving YMM state (OSXSAVE, then XCR0 bits 1 and 2).
+        __cpuid(registers, 1);
+        if ((registers[2] & (1 << 27)) == 0 || (registers[2] & (1 << 28)) == 0) return false;
+        if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#elif defined(GAME_SIMD_X86)
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        return false;
+#endif
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC eSimdLevel TransformKernels::GetBestSimdLevel()
+{
+    static eSimdLevel const s_bestSimdLevel = IsSimdLevelSupported(eSimdLevel::AVX2) ? eSimdLevel::AVX2 :
+                                              IsSimdLevelSupported(eSimdLevel::SSE)  ? eSimdLevel::SSE :
+                                              IsSimdLevelSupported(eSimdLevel::NEON) ? eSimdLevel::NEON : eSimdLevel::SCALAR;
+
+    return s_bestSimdLevel;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool TransformKernels::IsSimdLevelSupported(eSimdLevel const simdLevel)
+{
+    switch (simdLevel)
+    {
+    case eSimdLevel::SCALAR: return true;
+#if defined(GAME_SIMD_X86)
+    case eSimdLevel::SSE: return true;
+    case eSimdLevel::AVX2:
+        {
+            static bool const s_hasAVX2 = DetectAVX2();
+            return s_hasAVX2;
+        }
+#endif
+#if defined(GAME_SIMD_NEON)
+    case eSimdLevel::NEON: return true;
+#endif
+    default: return false;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC char const* TransformKernels::GetSimdLevelName(eSimdLevel const simdLevel)
+{
+    switch (simdLevel)
+    {
+    case eSimdLevel::SCALAR: return "Scalar";
+    case eSimdLevel::SSE: return "SSE";
+    case eSimdLevel::AVX2: return "AVX2";
+    case eSimdLevel::NEON: return "NEON";
+    case eSimdLevel::COUNT: break;
+    }
+
+    return "Unknown";
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int TransformKernels::GetSimdLevelWidth(eSimdLevel const simdLevel)
+{
+    switch (simdLevel)
+    {
+    case eSimdLevel::SSE:
+    case eSimdLevel::NEON: return 4;
+    case eSimdLevel::AVX2: return 8;
+    default: return 1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC Mat44 TransformKernels::BuildModelToWorldTransform(Vec3 const&        position,
+                                                          EulerAngles const& orientation)
+{
+    Mat44 m2w;
+
+    TransformKernelBlocks<sScalarLane>::BuildModelToWorldTransforms(&position, &orientation, 1, &m2w);
+
+    return m2w;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TransformKernels::BuildModelToWorldTransforms(Vec3 const*        positions,
+                                                          EulerAngles const* orientations,
+                                                          int const          count,
+                                                          Mat44*             out_transforms)
+{
+    BuildModelToWorldTransforms(positions, orientations, count, out_transforms, GetBestSimdLevel());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Unsupported levels fall back to the scalar reference, which gives the same bits.
+//
+STATIC void TransformKernels::BuildModelToWorldTransforms(Vec3 const*        positions,
+                                                          EulerAngles const* orientations,
+                                                          int const          count,
+                                                          Mat44*             out_transforms,
+                                                          eSimdLevel const   simdLevel)
+{
+    if (count <= 0) return;
+
+#if defined(GAME_SIMD_X86)
+    if (simdLevel == eSimdLevel::AVX2 && IsSimdLevelSupported(eSimdLevel::AVX2)) return BuildModelToWorldTransformsAVX2(positions, orientations, count, out_transforms);
+    if (simdLevel == eSimdLevel::SSE) return TransformKernelBlocks<sSseLane>::BuildModelToWorldTransforms(positions, orientations, count, out_transforms);
+#elif defined(GAME_SIMD_NEON)
+    if (simdLevel == eSimdLevel::NEON) return TransformKernelBlocks<sNeonLane>::BuildModelToWorldTransforms(positions, orientations, count, out_transforms);
+#endif
+
+    TransformKernelBlocks<sScalarLane>::BuildModelToWorldTransforms(positions, orientations, count, out_transforms);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TransformKernels::AppendTransforms(Mat44 const*     transforms,
+                                               Mat44 const*     appendTransforms,
+                                               int const        count,
+                                               Mat44*           out_transforms,
+                                               eSimdLevel const simdLevel)
+{
+    if (count <= 0) return;
+
+#if defined(GAME_SIMD_X86)
+    if (simdLevel == eSimdLevel::AVX2 && IsSimdLevelSupported(eSimdLevel::AVX2)) return AppendTransformsAVX2(transforms, appendTransforms, count, out_transforms);
+    if (simdLevel == eSimdLevel::SSE) return TransformKernelBlocks<sSseLane>::AppendTransforms(transforms, appendTransforms, count, out_transforms);
+#elif defined(GAME_SIMD_NEON)
+    if (simdLevel == eSimdLevel::NEON) return TransformKernelBlocks<sNeonLane>::AppendTransforms(transforms, appendTransforms, count, out_transforms);
+#endif
+
+    TransformKernelBlocks<sScalarLane>::AppendTransforms(transforms, appendTransforms, count, out_transforms);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TransformKernels::TransformPositions(Mat44 const&     transform,
+                                                 Vec3 const*      positions,
+                                                 int const        count,
+                                                 Vec3*            out_positions,
+                                                 eSimdLevel const simdLevel)
+{
+    if (count <= 0) return;
+
+#if defined(GAME_SIMD_X86)
+    if (simdLevel == eSimdLevel::AVX2 && IsSimdLevelSupported(eSimdLevel::AVX2)) return TransformPositionsAVX2(transform, positions, count, out_positions);
+    if (simdLevel == eSimdLevel::SSE) return TransformKernelBlocks<sSseLane>::TransformPositions(transform, positions, count, out_positions);
+#elif defined(GAME_SIMD_NEON)
+    if (simdLevel == eSimdLevel::NEON) return TransformKernelBlocks<sNeonLane>::TransformPositions(transform, positions, count, out_positions);
+#endif
+
+    TransformKernelBlocks<sScalarLane>::TransformPositions(transform, positions, count, out_positions);
+}
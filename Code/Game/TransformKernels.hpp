@@ -0,0 +1,66 @@
+//----------------------------------------------------------------------------------------------------
+// TransformKernels.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define GAME_SIMD_X86
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+#define GAME_SIMD_NEON
+#endif
+
+//----------------------------------------------------------------------------------------------------
+enum class eSimdLevel : uint8_t
+{
+    SCALAR,
+    SSE,        // 4 lanes, SSE2
+    AVX2,       // 8 lanes, picked at runtime only when the CPU and OS support it
+    NEON,       // 4 lanes
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+// Batch transform math over arrays, 4 (SSE, NEON) or 8 (AVX2) elements per step.
+//
+// Every level runs the same lane-generic kernel (TransformKernelBlocks.hpp) with the same operation
+// order, including its own sin/cos polynomial, so all levels produce bit-identical results and the
+// SCALAR level is the reference they are tested against (BenchmarkTransformKernels). This holds as
+// long as the compiler does not contract multiply-adds into FMAs, which is the MSVC /fp:precise
+// default; the AVX2 level is deliberately built without FMA.
+//
+// BuildModelToWorldTransforms makes the same matrices as Mat44::SetTranslation3D followed by
+// Append(EulerAngles::GetAsMatrix_IFwd_JLeft_KUp()), up to sin/cos rounding (a few ulps). Angles are
+// reduced without error for |degrees| < 2^17 * 90. AppendTransforms is Mat44::Append over matrix pairs and
+// TransformPositions is Mat44::TransformPosition3D over an array. Inputs and outputs must not overlap.
+//
+class TransformKernels
+{
+public:
+    static eSimdLevel  GetBestSimdLevel();
+    static bool        IsSimdLevelSupported(eSimdLevel simdLevel);
+    static char const* GetSimdLevelName(eSimdLevel simdLevel);
+    static int         GetSimdLevelWidth(eSimdLevel simdLevel);
+
+    static Mat44 BuildModelToWorldTransform(Vec3 const& position, EulerAngles const& orientation);
+    static void  BuildModelToWorldTransforms(Vec3 const* positions, EulerAngles const* orientations, int count, Mat44* out_transforms);
+    static void  BuildModelToWorldTransforms(Vec3 const* positions, EulerAngles const* orientations, int count, Mat44* out_transforms, eSimdLevel simdLevel);
+    static void  AppendTransforms(Mat44 const* transforms, Mat44 const* appendTransforms, int count, Mat44* out_transforms, eSimdLevel simdLevel);
+    static void  TransformPositions(Mat44 const& transform, Vec3 const* positions, int count, Vec3* out_positions, eSimdLevel simdLevel);
+
+private:
+#if defined(GAME_SIMD_X86)
+    // Defined in TransformKernelsAVX2.cpp, the only translation unit built for AVX2.
+    static void BuildModelToWorldTransformsAVX2(Vec3 const* positions, EulerAngles const* orientations, int count, Mat44* out_transforms);
+    static void AppendTransformsAVX2(Mat44 const* transforms, Mat44 const* appendTransforms, int count, Mat44* out_transforms);
+    static void TransformPositionsAVX2(Mat44 const& transform, Vec3 const* positions, int count, Vec3* out_positions);
+#endif
+};
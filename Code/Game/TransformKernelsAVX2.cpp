@@ -0,0 +1,128 @@
+//----------------------------------------------------------------------------------------------------
+// TransformKernelsAVX2.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TransformKernels.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+
+#if defined(GAME_SIMD_X86)
+#include <immintrin.h>
+
+//----------------------------------------------------------------------------------------------------
+// Everything below is compiled for AVX2 (and only reached after TransformKernels checked the CPU).
+// Headers with inline functions are all included above, so no inline function shared with other
+// translation units is ever emitted with AVX2 instructions. MSVC needs no flag for AVX2 intrinsics.
+// FMA is left out on purpose: contracted multiply-adds would break bit-exactness with the scalar level.
+//
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "Game/TransformKernelBlocks.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    struct sAvx2Lane
+    {
+        using Float = __m256;
+        using Int   = __m256i;
+        using Mask  = __m256;
+
+        static int constexpr WIDTH = 8;
+
+        static Float Set(float const value) { return _mm256_set1_ps(value); }
+        static Float Load(float const* source) { return _mm256_load_ps(source); }
+        static void  Store(float* destination, Float const value) { _mm256_store_ps(destination, value); }
+        static Float Add(Float const a, Float const b) { return _mm256_add_ps(a, b); }
+        static Float Sub(Float const a, Float const b) { return _mm256_sub_ps(a, b); }
+        static Float Mul(Float const a, Float const b) { return _mm256_mul_ps(a, b); }
+        static Float Negate(Float const a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+        static Float Select(Mask const mask, Float const whenTrue, Float const whenFalse) { return _mm256_blendv_ps(whenFalse, whenTrue, mask); }
+        static Int   ToInt(Float const a) { return _mm256_cvttps_epi32(a); }
+        static Int   AddInt(Int const a, int const b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+        static Mask  HasBits(Int const a, int const bits) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, _mm256_set1_epi32(bits)), _mm256_set1_epi32(bits))); }
+
+        // Lanes 0-3 and 4-7 are two independent 4x4 transposes per group of four elements.
+        static void LoadMatrices(Mat44 const* matrices, Float (&out_elements)[16])
+        {
+            for (int group = 0; group < 16; group += 4)
+            {
+                __m128 rows[2][4];
+
+                for (int half = 0; half < 2; ++half)
+                {
+                    for (int row = 0; row < 4; ++row) rows[half][row] = _mm_loadu_ps(matrices[half * 4 + row].m_values + group);
+
+                    _MM_TRANSPOSE4_PS(rows[half][0], rows[half][1], rows[half][2], rows[half][3]);
+                }
+
+                for (int row = 0; row < 4; ++row)
+                {
+                    out_elements[group + row] = _mm256_insertf128_ps(_mm256_castps128_ps256(rows[0][row]), rows[1][row], 1);
+                }
+            }
+        }
+
+        static void StoreMatrices(Float const (&elements)[16], Mat44* out_matrices)
+        {
+            for (int group = 0; group < 16; group += 4)
+            {
+                __m128 rows[2][4];
+
+                for (int row = 0; row < 4; ++row)
+                {
+                    rows[0][row] = _mm256_castps256_ps128(elements[group + row]);
+                    rows[1][row] = _mm256_extractf128_ps(elements[group + row], 1);
+                }
+
+                for (int half = 0; half < 2; ++half)
+                {
+                    _MM_TRANSPOSE4_PS(rows[half][0], rows[half][1], rows[half][2], rows[half][3]);
+
+                    for (int row = 0; row < 4; ++row) _mm_storeu_ps(out_matrices[half * 4 + row].m_values + group, rows[half][row]);
+                }
+            }
+        }
+    };
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TransformKernels::BuildModelToWorldTransformsAVX2(Vec3 const*        positions,
+                                                              EulerAngles const* orientations,
+                                                              int const          count,
+                                                              Mat44*             out_transforms)
+{
+    TransformKernelBlocks<sAvx2Lane>::BuildModelToWorldTransforms(positions, orientations, count, out_transforms);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TransformKernels::AppendTransformsAVX2(Mat44 const* transforms,
+                                                   Mat44 const* appendTransforms,
+                                                   int const    count,
+                                                   Mat44*       out_transforms)
+{
+    TransformKernelBlocks<sAvx2Lane>::AppendTransforms(transforms, appendTransforms, count, out_transforms);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TransformKernels::TransformPositionsAVX2(Mat44 const& transform,
+                                                     Vec3 const*  positions,
+                                                     int const    count,
+                                                     Vec3*        out_positions)
+{
+    TransformKernelBlocks<sAvx2Lane>::TransformPositions(transform, positions, count, out_positions);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
@@ -9,15 +9,28 @@
  * - Register and manage game systems
  * - Execute systems in priority order
  * - Bridge C++ engine methods to JavaScript
- * - Handle hot-reload system integration
+ * - Handle hot-reload system integration (acceptHotModule swaps component instances in place)
  *
  * Design Philosophy:
  * - This file is CORE INFRASTRUCTURE - rarely edited
  * - Systems register with JSEngine and execute every frame
  * - Priority-based execution (0-100, lower = earlier)
  * - Dual pattern support: legacy config objects + SystemComponent instances
+ * - Prop transforms are written through propTransforms straight into C++ memory (applied after each frame call)
+ * - Entity create/destroy/move are batched through entityCommands and submitted once per frame
+ * - Radius/nearest/ray queries over props are batched through spatialQueries (run() answers them at once)
+ * - While profiler.enabled, every system call is timed (avg/max/p99, published to the C++ HUD)
+ * - Update systems may declare tickInterval/critical/budgetMs; scheduler staggers low-rate systems
+ *   and defers non-critical ones once the frame budget is spent (see core/SystemScheduler.mjs).
+ *   Critical systems, like the C++ update in cppBridge, run outside the budget.
  */
 
+import { EntityCommandBuffer } from './core/EntityCommandBuffer.mjs';
+import { PropTransformBuffer } from './core/PropTransformBuffer.mjs';
+import { SpatialQueryBatch } from './core/SpatialQueryBatch.mjs';
+import { SystemProfiler } from './core/SystemProfiler.mjs';
+import { SystemScheduler } from './core/SystemScheduler.mjs';
+
 export class JSEngine {
     constructor() {
         this.game = null;
@@ -30,7 +43,23 @@ export class JSEngine {
         this.renderSystems = [];
         this.pendingOperations = [];
 
-        // C++ Hot-Reload System (handled by C++ FileWatcher + ScriptReloader)
+        // Zero-copy prop transform access (typed arrays over the C++ buffer, no crossing per prop)
+        this.propTransforms = new PropTransformBuffer();
+
+        // Batched structural commands (one C++ crossing per frame instead of per entity)
+        this.entityCommands = new EntityCommandBuffer();
+
+        // Batched spatial queries over props (one C++ crossing per run() instead of per query)
+        this.spatialQueries = new SpatialQueryBatch();
+
+        // Per-system timing (set profiler.enabled = false to skip the timer calls)
+        this.profiler = new SystemProfiler();
+
+        // Tick rates and frame budget for update systems (deferral counts show up in the profiler HUD)
+        this.scheduler = new SystemScheduler();
+        this.profiler.deferralSource = (systemId) => this.scheduler.getDeferralCount(systemId);
+
+        // C++ Hot-Reload System (Game's ScriptHotReloader re-evaluates edited modules, then calls acceptHotModule)
         this.hotReloadEnabled = true; // C++ hot-reload system availability flag
 
         console.log('JSEngine: Created with system registration support');
@@ -78,10 +107,11 @@ export class JSEngine {
                 priority: component.priority,
                 enabled: component.enabled !== false,
                 data: component.data || {},
-                componentInstance: component // Keep reference for hot-reload detection
+                componentInstance: component, // Keep reference for hot-reload detection
+                schedule: this.scheduler.createSchedule(component.id, component)
             };
 
-            console.log(`JSEngine: Registered SystemComponent '${component.id}' (priority: ${component.priority}, ECS pattern)`);
+            console.log(`JSEngine: Registered SystemComponent '${component.id}' (priority: ${component.priority}, tickInterval: ${system.schedule.tickInterval}, ECS pattern)`);
         } else {
             // LEGACY PATTERN: Config object (backward compatibility)
             if (!id || typeof id !== 'string') {
@@ -95,10 +125,11 @@ export class JSEngine {
                 render: configOrComponent.render || null,
                 priority: configOrComponent.priority || 0,
                 enabled: configOrComponent.enabled !== false,
-                data: configOrComponent.data || {}
+                data: configOrComponent.data || {},
+                schedule: this.scheduler.createSchedule(id, configOrComponent)
             };
 
-            console.log(`JSEngine: Registered system '${id}' (priority: ${system.priority}, legacy pattern)`);
+            console.log(`JSEngine: Registered system '${id}' (priority: ${system.priority}, tickInterval: ${system.schedule.tickInterval}, legacy pattern)`);
         }
 
         this.registeredSystems.set(system.id, system);
@@ -107,6 +138,84 @@ export class JSEngine {
         return true;
     }
 
+    // ============================================================================
+    // HOT RELOAD
+    // ============================================================================
+
+    /**
+     * Called by the re-evaluated copy of an edited component module (see ScriptHotReloader.cpp).
+     * Every registered component whose class name matches an exported class is re-instantiated
+     * from the new class and swapped in place; other modules keep their instances.
+     *
+     * @param {string} modulePath - Original module path (for logging)
+     * @param {Object} moduleNamespace - Namespace of the freshly evaluated module
+     * @returns {number} Number of systems swapped
+     */
+    acceptHotModule(modulePath, moduleNamespace) {
+        let swapCount = 0;
+
+        for (const exported of Object.values(moduleNamespace)) {
+            if (typeof exported !== 'function' || !exported.prototype) {
+                continue;
+            }
+
+            for (const system of Array.from(this.registeredSystems.values())) {
+                const oldInstance = system.componentInstance;
+                if (oldInstance && oldInstance.constructor !== exported && oldInstance.constructor.name === exported.name) {
+                    this.replaceComponent(system, oldInstance, new exported(this));
+                    swapCount++;
+                }
+            }
+        }
+
+        console.log(`JSEngine: Hot module '${modulePath}' accepted (${swapCount} system(s) swapped)`);
+        return swapCount;
+    }
+
+    /**
+     * Swap a registered component for a new instance, keeping references other objects hold
+     */
+    replaceComponent(system, oldInstance, newInstance) {
+        // Carry over runtime wiring the constructor leaves unset (engine, audioSystem, ...)
+        for (const key of Object.keys(oldInstance)) {
+            if (newInstance[key] === undefined || newInstance[key] === null) {
+                newInstance[key] = oldInstance[key];
+            }
+        }
+        newInstance.enabled = oldInstance.enabled;
+
+        // Re-point references held by the game coordinator and other components
+        const holders = [this.game, ...Array.from(this.registeredSystems.values(), sys => sys.componentInstance)];
+        for (const holder of holders) {
+            if (!holder || holder === oldInstance) {
+                continue;
+            }
+            for (const key of Object.keys(holder)) {
+                if (holder[key] === oldInstance) {
+                    holder[key] = newInstance;
+                }
+            }
+        }
+
+        system.update = newInstance.update ? newInstance.update.bind(newInstance) : null;
+        system.render = newInstance.render ? newInstance.render.bind(newInstance) : null;
+        system.priority = newInstance.priority;
+        system.data = newInstance.data || {};
+        system.componentInstance = newInstance;
+
+        // Keep scheduler stats; only re-stagger when the tick rate changed
+        system.schedule.critical = newInstance.critical === true;
+        system.schedule.budgetMs = typeof newInstance.budgetMs === 'number' ? newInstance.budgetMs : null;
+        if (Math.max(1, Math.floor(newInstance.tickInterval || 1)) !== system.schedule.tickInterval) {
+            this.scheduler.setTickInterval(system.id, newInstance.tickInterval || 1);
+        }
+
+        // The system object is shared by both lists; membership or priority may have changed
+        this.updateSystems = this.updateSystems.filter(sys => sys !== system);
+        this.renderSystems = this.renderSystems.filter(sys => sys !== system);
+        this.addSystemToLists(system);
+    }
+
     /**
      * Unregister a system
      */
@@ -136,6 +245,42 @@ export class JSEngine {
         return true;
     }
 
+    /**
+     * Change how often a system's update runs (re-staggers its tick offset)
+     */
+    setSystemTickInterval(id, tickInterval) {
+        if (!this.scheduler.setTickInterval(id, tickInterval)) {
+            console.warn(`JSEngine: System '${id}' not found`);
+            return false;
+        }
+
+        console.log(`JSEngine: System '${id}' tick interval set to ${tickInterval} frames`);
+        return true;
+    }
+
+    /**
+     * Milliseconds the update loop may spend before non-critical systems are deferred
+     */
+    setFrameBudget(milliseconds) {
+        this.scheduler.frameBudgetMs = milliseconds;
+        console.log(`JSEngine: Update frame budget set to ${milliseconds} ms`);
+    }
+
+    /**
+     * Per-system tick/deferral counts
+     */
+    getSchedulerStats() {
+        return this.scheduler.getStats();
+    }
+
+    logSchedulerStats() {
+        for (const stats of this.scheduler.getStats()) {
+            console.log(`JSEngine: '${stats.id}' every ${stats.tickInterval} (+${stats.tickOffset})${stats.critical ? ' critical' : ''}: ` +
+                        `${stats.ticks} ticks, ${stats.deferrals} deferred (${(stats.deferralRate * 100).toFixed(1)}%), ` +
+                        `max ${stats.maxConsecutiveDeferrals} in a row, ${stats.forcedTicks} forced`);
+        }
+    }
+
     /**
      * Get system information
      */
@@ -153,6 +298,7 @@ export class JSEngine {
                 id: sys.id,
                 enabled: sys.enabled,
                 priority: sys.priority,
+                tickInterval: sys.schedule.tickInterval,
                 hasUpdate: sys.update !== null,
                 hasRender: sys.render !== null
             };
@@ -197,6 +343,8 @@ export class JSEngine {
         this.updateSystems = this.updateSystems.filter(sys => sys.id !== id);
         this.renderSystems = this.renderSystems.filter(sys => sys.id !== id);
         this.registeredSystems.delete(id);
+        this.profiler.forget(id);
+        this.scheduler.release(id);
 
         console.log(`JSEngine: System '${id}' removed from all lists`);
     }
@@ -213,17 +361,48 @@ export class JSEngine {
         this.frameCount++;
         this.processOperations();
 
-        // Execute all registered update systems
+        const profiler = this.profiler;
+        const scheduler = this.scheduler;
+        const isProfiling = profiler.enabled;
+        let budgetSpentMs = 0; // Non-critical systems only, so the C++ update never eats the JS budget
+
+        // Execute all registered update systems that are due and fit in the frame budget
         for (const system of this.updateSystems) {
-            if (system.enabled && system.update) {
-                try {
-                    // Pass both gameDeltaSeconds and systemDeltaSeconds to allow systems to choose
-                    system.update(gameDeltaSeconds, systemDeltaSeconds);
-                } catch (error) {
-                    console.log(`JSEngine: Error in system '${system.id}' update:`, error);
-                }
+            if (!system.enabled || !system.update) {
+                continue;
+            }
+
+            const schedule = system.schedule;
+            if (!scheduler.isDue(schedule, this.frameCount, gameDeltaSeconds, systemDeltaSeconds)) {
+                continue;
+            }
+
+            const estimateMs = schedule.budgetMs !== null ? schedule.budgetMs : profiler.getAverage('update', system.id);
+            if (scheduler.shouldDefer(schedule, budgetSpentMs, estimateMs)) {
+                continue;
+            }
+
+            // Low-rate and deferred systems receive the time accumulated since their last tick
+            const [systemGameDelta, systemSystemDelta] = scheduler.consumeTick(schedule, this.frameCount);
+            const startMs = isProfiling ? profiler.now() : 0;
+            try {
+                // Pass both gameDeltaSeconds and systemDeltaSeconds to allow systems to choose
+                system.update(systemGameDelta, systemSystemDelta);
+            } catch (error) {
+                console.log(`JSEngine: Error in system '${system.id}' update:`, error);
+            }
+            // Without profiling nothing reads the clock, so the budget is charged with the estimate
+            const elapsedMs = isProfiling ? profiler.now() - startMs : estimateMs;
+            if (isProfiling) {
+                profiler.record('update', system.id, elapsedMs);
+            }
+            if (!schedule.critical) {
+                budgetSpentMs += elapsedMs;
             }
         }
+
+        // C++ applies pending transform writes before the structural commands, while their indices still match
+        this.entityCommands.flush();
     }
 
     /**
@@ -235,16 +414,27 @@ export class JSEngine {
             return;
         }
 
+        const profiler = this.profiler;
+        const isProfiling = profiler.enabled;
+
         // Execute all registered render systems
         for (const system of this.renderSystems) {
             if (system.enabled && system.render) {
+                const startMs = isProfiling ? profiler.now() : 0;
                 try {
                     system.render();
                 } catch (error) {
                     console.log(`JSEngine: Error in system '${system.id}' render:`, error);
                 }
+                if (isProfiling) {
+                    profiler.record('render', system.id, profiler.now() - startMs);
+                }
             }
         }
+
+        if (isProfiling) {
+            profiler.endFrame();
+        }
     }
 
     /**
@@ -272,26 +462,39 @@ export class JSEngine {
     /**
      * Helper methods for game to use C++ engine functions
      */
+    /**
+     * @returns {number} Prop handle of the new cube, or -1 if unavailable
+     */
     createCube(x, y, z) {
         if (typeof game !== 'undefined' && game.createCube) {
-            game.createCube(x, y, z);
-            console.log(`JSEngine: Created cube at (${x.toFixed(2)}, ${y.toFixed(2)}, ${z.toFixed(2)})`);
-            return true;
+            const handle = game.createCube(x, y, z);
+            console.log(`JSEngine: Created cube ${handle} at (${x.toFixed(2)}, ${y.toFixed(2)}, ${z.toFixed(2)})`);
+            return handle;
         }
         console.warn('JSEngine: createCube not available');
-        return false;
+        return -1;
     }
 
-    moveProp(index, x, y, z) {
+    moveProp(handle, x, y, z) {
         if (typeof game !== 'undefined' && game.moveProp) {
-            game.moveProp(index, x, y, z);
-            console.log(`JSEngine: Moved prop ${index} to (${x.toFixed(2)}, ${y.toFixed(2)}, ${z.toFixed(2)})`);
+            game.moveProp(handle, x, y, z);
+            console.log(`JSEngine: Moved prop ${handle} to (${x.toFixed(2)}, ${y.toFixed(2)}, ${z.toFixed(2)})`);
             return true;
         }
         console.warn('JSEngine: moveProp not available');
         return false;
     }
 
+    destroyProp(handle) {
+        if (typeof game !== 'undefined' && game.destroyProp) {
+            game.destroyProp(handle);
+            console.log(`JSEngine: Destroyed prop ${handle}`);
+            return true;
+        }
+        console.warn('JSEngine: destroyProp not available');
+        return false;
+    }
+
     getPlayerPosition() {
         if (typeof game !== 'undefined' && game.getPlayerPos) {
             return game.getPlayerPos();
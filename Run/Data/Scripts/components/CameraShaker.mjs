@@ -6,9 +6,9 @@
  * CameraShaker - Applies camera shake effects at regular intervals
  *
  * Responsibilities:
- * - Shake camera every 6 seconds (360 frames at 60fps)
+ * - Shake camera every 6 seconds (360 frames at 60fps, via JSEngine tickInterval)
  * - Generate random camera offset for shake effect
- * - Track last shake frame for timing
+ * - Track last shake frame
  *
  * Priority: 40 (Low - camera effects happen last)
  * Note: Uses systemDelta so camera shake continues even when game is paused
@@ -23,10 +23,11 @@ export class CameraShaker {
         this.id = 'cameraShaker';
         this.priority = 40;
         this.enabled = true;
+        this.tickInterval = 360; // 6 seconds at 60fps; JSEngine only calls update() on due frames
         this.data = {
             description: 'Shakes camera every 6 seconds',
             lastShakeFrame: 0,
-            interval: 360 // 6 seconds at 60fps
+            interval: this.tickInterval
         };
 
         // Dependencies
@@ -36,21 +37,14 @@ export class CameraShaker {
     }
 
     /**
-     * Update method - called every frame
-     * Applies camera shake at regular intervals
-     * Note: Uses systemDelta parameter so it works even when game is paused
-     * @param {number} gameDelta - Game time delta (pauses when game paused)
-     * @param {number} systemDelta - System time delta (never pauses)
+     * Update method - called every tickInterval frames by the JSEngine scheduler
+     * Note: Scheduled by frame count, so it keeps shaking even when game is paused
+     * @param {number} gameDelta - Game time delta since last shake (pauses when game paused)
+     * @param {number} systemDelta - System time delta since last shake (never pauses)
      */
     update(gameDelta, systemDelta) {
-        // Get current frame count from engine (via CppBridgeSystem)
-        const frameCount = this.engine.frameCount;
-
-        // Check if enough frames have passed since last shake
-        if (frameCount - this.data.lastShakeFrame >= this.data.interval) {
-            this.applyShake();
-            this.data.lastShakeFrame = frameCount;
-        }
+        this.applyShake();
+        this.data.lastShakeFrame = this.engine.frameCount;
     }
 
     /**
@@ -73,7 +67,9 @@ export class CameraShaker {
      * @param {number} frames - Number of frames between shakes
      */
     setShakeInterval(frames) {
+        this.tickInterval = frames;
         this.data.interval = frames;
+        this.engine.setSystemTickInterval(this.id, frames);
         console.log(`CameraShaker: Shake interval set to ${frames} frames`);
     }
 
@@ -86,12 +82,10 @@ export class CameraShaker {
     }
 
     /**
-     * Static version for hot-reload detection
+     * Component version, bumped by hand when its behaviour changes (hot reload itself watches the file)
      * AI agents can trigger hot-reload by modifying this file
      */
-    static get version() {
-        return Date.now();
-    }
+    static version = 1;
 }
 
 console.log('CameraShaker: Component loaded (ECS pattern)');
@@ -22,6 +22,7 @@ export class CppBridgeSystem {
         this.id = 'cppBridge';
         this.priority = 0;
         this.enabled = true;
+        this.critical = true; // C++ update must run every frame, never deferred by the frame budget
         this.data = {
             description: 'Bridges JavaScript to C++ engine, manages frame count'
         };
@@ -75,12 +76,10 @@ export class CppBridgeSystem {
     }
 
     /**
-     * Static version for hot-reload detection
+     * Component version, bumped by hand when its behaviour changes (hot reload itself watches the file)
      * DO NOT modify - this is infrastructure
      */
-    static get version() {
-        return Date.now();
-    }
+    static version = 1;
 }
 
 console.log('CppBridgeSystem: Component loaded (ECS pattern)');
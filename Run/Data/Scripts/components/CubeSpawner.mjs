@@ -6,9 +6,9 @@
  * CubeSpawner - Spawns cubes at regular intervals
  *
  * Responsibilities:
- * - Spawn cubes every 4 seconds (240 frames at 60fps)
+ * - Spawn cubes every 4 seconds (240 frames at 60fps, via JSEngine tickInterval)
  * - Generate random positions within game space
- * - Track last spawn frame for timing
+ * - Track last spawn frame
  *
  * Priority: 20 (Medium - after input, before prop movement)
  *
@@ -22,10 +22,11 @@ export class CubeSpawner {
         this.id = 'cubeSpawner';
         this.priority = 20;
         this.enabled = true;
+        this.tickInterval = 240; // 4 seconds at 60fps; JSEngine only calls update() on due frames
         this.data = {
             description: 'Spawns cubes every 4 seconds',
             lastSpawnFrame: 0,
-            interval: 240 // 4 seconds at 60fps
+            interval: this.tickInterval
         };
 
         // Dependencies
@@ -35,20 +36,13 @@ export class CubeSpawner {
     }
 
     /**
-     * Update method - called every frame
-     * Spawns cubes at regular intervals
-     * @param {number} gameDelta - Game time delta (pauses when game paused)
-     * @param {number} systemDelta - System time delta (never pauses)
+     * Update method - called every tickInterval frames by the JSEngine scheduler
+     * @param {number} gameDelta - Game time delta since last spawn (pauses when game paused)
+     * @param {number} systemDelta - System time delta since last spawn (never pauses)
      */
     update(gameDelta, systemDelta) {
-        // Get current frame count from engine (via CppBridgeSystem)
-        const frameCount = this.engine.frameCount;
-
-        // Check if enough frames have passed since last spawn
-        if (frameCount - this.data.lastSpawnFrame >= this.data.interval) {
-            this.spawnCube();
-            this.data.lastSpawnFrame = frameCount;
-        }
+        this.spawnCube();
+        this.data.lastSpawnFrame = this.engine.frameCount;
     }
 
     /**
@@ -61,7 +55,8 @@ export class CubeSpawner {
             const y = (Math.random() - 0.5) * 10;  // Random y: -5 to 5
             const z = Math.random() * 3;            // Random z: 0 to 3
 
-            this.engine.createCube(x, y, z);
+            // Recorded into the frame's entity command batch; JSEngine submits it after all systems update
+            this.engine.entityCommands.pushCreateCube(x, y, z);
             console.log(`CubeSpawner: Spawned cube at (${x.toFixed(2)}, ${y.toFixed(2)}, ${z.toFixed(2)})`);
         }
     }
@@ -71,7 +66,9 @@ export class CubeSpawner {
      * @param {number} frames - Number of frames between spawns
      */
     setSpawnInterval(frames) {
+        this.tickInterval = frames;
         this.data.interval = frames;
+        this.engine.setSystemTickInterval(this.id, frames);
         console.log(`CubeSpawner: Spawn interval set to ${frames} frames`);
     }
 
@@ -84,12 +81,10 @@ export class CubeSpawner {
     }
 
     /**
-     * Static version for hot-reload detection
+     * Component version, bumped by hand when its behaviour changes (hot reload itself watches the file)
      * AI agents can trigger hot-reload by modifying this file
      */
-    static get version() {
-        return Date.now();
-    }
+    static version = 1;
 }
 
 console.log('CubeSpawner: Component loaded (ECS pattern)');
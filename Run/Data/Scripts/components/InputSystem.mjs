@@ -15,7 +15,8 @@ import { KEYCODE_F1, KEYCODE_SPACE } from '../InputSystemCommon.mjs';
  */
 export class InputSystem extends SystemComponent {
     constructor() {
-        super('inputSystem', 10, { enabled: true });
+        // Critical: edge detection relies on seeing every frame's key state
+        super('inputSystem', 10, { enabled: true, critical: true });
 
         this.lastF1State = false;
         this.lastSpaceState = false;
@@ -6,9 +6,9 @@
  * PropMover - Moves props at regular intervals
  *
  * Responsibilities:
- * - Move props every 2 seconds (120 frames at 60fps)
+ * - Move props every 2 seconds (120 frames at 60fps, via JSEngine tickInterval)
  * - Generate random positions for props
- * - Track last move frame for timing
+ * - Track last move frame
  *
  * Priority: 30 (Medium-Low - after cube spawning)
  *
@@ -22,12 +22,16 @@ export class PropMover {
         this.id = 'propMover';
         this.priority = 30;
         this.enabled = true;
+        this.tickInterval = 120; // 2 seconds at 60fps; JSEngine only calls update() on due frames
         this.data = {
             description: 'Moves props every 2 seconds',
             lastMoveFrame: 0,
-            interval: 120 // 2 seconds at 60fps
+            interval: this.tickInterval
         };
 
+        // Handle of the prop being moved; prop indices change when other props are destroyed
+        this.propHandle = -1;
+
         // Dependencies
         this.engine = engine;
 
@@ -35,17 +39,15 @@ export class PropMover {
     }
 
     /**
-     * Update method - called every frame
-     * Moves props at regular intervals
-     * @param {number} gameDelta - Game time delta (pauses when game paused)
-     * @param {number} systemDelta - System time delta (never pauses)
+     * Update method - called every tickInterval frames by the JSEngine scheduler
+     * @param {number} gameDelta - Game time delta since last tick (pauses when game paused)
+     * @param {number} systemDelta - System time delta since last tick (never pauses)
      */
     update(gameDelta, systemDelta) {
-        // Get current frame count from engine (via CppBridgeSystem)
         const frameCount = this.engine.frameCount;
 
         // Wait until at least 240 frames have passed (4 seconds) before moving props
-        if (frameCount > 240 && frameCount - this.data.lastMoveFrame >= this.data.interval) {
+        if (frameCount > 240) {
             this.moveProp();
             this.data.lastMoveFrame = frameCount;
         }
@@ -57,13 +59,26 @@ export class PropMover {
      */
     moveProp() {
         if (this.engine) {
-            const propIndex = 0; // Move the first prop
+            // Latch onto the first prop and keep following it by handle; pick a new one once it is destroyed
+            if (typeof game !== 'undefined' && game.getPropIndex && game.getPropIndex(this.propHandle) < 0) {
+                this.propHandle = game.getPropHandle(0);
+            }
+
+            const propIndex = typeof game !== 'undefined' && game.getPropIndex ? game.getPropIndex(this.propHandle) : 0;
+            if (propIndex < 0) {
+                return;
+            }
+
             const x = (Math.random() - 0.5) * 8;   // Random x: -4 to 4
             const y = (Math.random() - 0.5) * 8;   // Random y: -4 to 4
             const z = Math.random() * 2;            // Random z: 0 to 2
 
-            this.engine.moveProp(propIndex, x, y, z);
-            console.log(`PropMover: Moved prop ${propIndex} to (${x.toFixed(2)}, ${y.toFixed(2)}, ${z.toFixed(2)})`);
+            // Write into the shared transform buffer; C++ applies it after the frame call
+            const propTransforms = this.engine.propTransforms;
+            if (propTransforms.pull() > propIndex) {
+                propTransforms.setPosition(propIndex, x, y, z);
+                console.log(`PropMover: Moved prop ${propIndex} to (${x.toFixed(2)}, ${y.toFixed(2)}, ${z.toFixed(2)})`);
+            }
         }
     }
 
@@ -72,7 +87,9 @@ export class PropMover {
      * @param {number} frames - Number of frames between moves
      */
     setMoveInterval(frames) {
+        this.tickInterval = frames;
         this.data.interval = frames;
+        this.engine.setSystemTickInterval(this.id, frames);
         console.log(`PropMover: Move interval set to ${frames} frames`);
     }
 
@@ -85,12 +102,10 @@ export class PropMover {
     }
 
     /**
-     * Static version for hot-reload detection
+     * Component version, bumped by hand when its behaviour changes (hot reload itself watches the file)
      * AI agents can trigger hot-reload by modifying this file
      */
-    static get version() {
-        return Date.now();
-    }
+    static version = 1;
 }
 
 console.log('PropMover: Component loaded (ECS pattern)');
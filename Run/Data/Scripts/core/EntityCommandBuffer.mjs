@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------------------------------
+// EntityCommandBuffer.mjs - Batched structural entity commands (create/destroy/move)
+//----------------------------------------------------------------------------------------------------
+
+/**
+ * EntityCommandBuffer - Records entity structural changes and submits them to C++ in bulk
+ *
+ * Layout (matches Code/Game/EntityCommandBuffer.hpp):
+ * - records: Float64Array, 5 numbers per command [type, propHandle, x, y, z]
+ *   (doubles so generational prop handles stay exact)
+ *
+ * Transport: C++ owns a record block and a created-handle block, published as ArrayBuffers
+ * (globalThis.entityCommandRecordMemory and globalThis.entityCommandCreatedMemory, an Int32Array of
+ * handles). flush() copies the records in with one typed-array set and calls
+ * game.submitEntityCommands(count) once; nothing is spread into arguments or converted to text.
+ *
+ * Semantics:
+ * - Props are addressed by handle (game.createCube / game.getPropHandle), never by buffer index
+ * - Commands apply in record order; a stale handle (prop already destroyed) is rejected, not retargeted
+ * - After flush(), createdHandles holds the handles of the cubes the batch created, in push order
+ * - JSEngine calls flush() once per frame after all systems ran
+ */
+
+export const ENTITY_COMMAND_CREATE_CUBE = 0;
+export const ENTITY_COMMAND_DESTROY_PROP = 1;
+export const ENTITY_COMMAND_MOVE_PROP = 2;
+
+export const NUMBERS_PER_COMMAND = 5;
+
+export class EntityCommandBuffer {
+    constructor(initialCapacity = 256) {
+        this.records = new Float64Array(initialCapacity * NUMBERS_PER_COMMAND);
+        this.count = 0;
+        this.createCount = 0;
+        this.createdHandles = [];
+    }
+
+    pushCreateCube(x, y, z) {
+        this.push(ENTITY_COMMAND_CREATE_CUBE, -1, x, y, z);
+        this.createCount++;
+    }
+
+    pushDestroyProp(handle) {
+        this.push(ENTITY_COMMAND_DESTROY_PROP, handle, 0, 0, 0);
+    }
+
+    pushMoveProp(handle, x, y, z) {
+        this.push(ENTITY_COMMAND_MOVE_PROP, handle, x, y, z);
+    }
+
+    push(type, handle, x, y, z) {
+        if ((this.count + 1) * NUMBERS_PER_COMMAND > this.records.length) {
+            const grown = new Float64Array(this.records.length * 2);
+            grown.set(this.records);
+            this.records = grown;
+        }
+
+        const base = this.count * NUMBERS_PER_COMMAND;
+        this.records[base] = type;
+        this.records[base + 1] = handle;
+        this.records[base + 2] = x;
+        this.records[base + 3] = y;
+        this.records[base + 4] = z;
+        this.count++;
+    }
+
+    /**
+     * Submit every recorded command to C++ in one call and reset the buffer.
+     * @returns {number} Number of commands C++ applied
+     */
+    flush() {
+        const commandCount = this.count;
+        const createCount = this.createCount;
+
+        this.count = 0;
+        this.createCount = 0;
+        this.createdHandles.length = 0;
+
+        if (commandCount === 0 || typeof game === 'undefined' || !game.submitEntityCommands) {
+            return 0;
+        }
+
+        const numberCount = commandCount * NUMBERS_PER_COMMAND;
+        if (!(globalThis.entityCommandRecordMemory instanceof ArrayBuffer) ||
+            globalThis.entityCommandRecordMemory.byteLength < numberCount * Float64Array.BYTES_PER_ELEMENT) {
+            game.reserveEntityCommands(commandCount);
+        }
+
+        new Float64Array(globalThis.entityCommandRecordMemory, 0, numberCount).set(this.records.subarray(0, numberCount));
+
+        const applied = game.submitEntityCommands(commandCount);
+        if (applied < 0) {
+            console.log(`EntityCommandBuffer: C++ rejected ${commandCount} command records`);
+            return 0;
+        }
+
+        // Every create succeeds, so C++ wrote exactly createCount handles, in push order
+        if (createCount > 0) {
+            const created = new Int32Array(globalThis.entityCommandCreatedMemory, 0, createCount);
+            for (let i = 0; i < createCount; ++i) {
+                this.createdHandles.push(created[i]);
+            }
+        }
+
+        return applied;
+    }
+}
+
+console.log('EntityCommandBuffer: Module loaded');
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------------------------------
+// PropTransformBuffer.mjs - Script-side view of the C++ prop transform buffer
+//----------------------------------------------------------------------------------------------------
+
+/**
+ * PropTransformBuffer - Zero-copy prop transform/color access for systems
+ *
+ * C++ owns the memory and publishes it as globalThis.propTransformMemory (an ArrayBuffer).
+ * Layout (matches Code/Game/PropTransformBuffer.hpp; byte offsets come from the header):
+ * - header:       Int32Array [propCount, dirtyCount, capacity, transformsOffset, colorsOffset,
+ *                 dirtyFlagsOffset, dirtyIndicesOffset, reserved]
+ * - transforms:   Float32Array, 6 floats per prop [x, y, z, yaw, pitch, roll]
+ * - colors:       Uint8Array,   4 bytes per prop  [r, g, b, a]
+ * - dirtyFlags:   Uint8Array,   DIRTY_* bits per prop
+ * - dirtyIndices: Int32Array,   each written prop once, appended when its flags go from 0 to non-zero
+ *
+ * Usage:
+ * - pull() returns the current prop count; the views are live, so there is nothing to copy and no
+ *   write (from this or any other system) is ever discarded
+ * - setPosition()/setOrientation()/setColor() write straight into C++ memory and flag the entry
+ * - C++ applies exactly the flagged entries and fields after each frame call (and before structural
+ *   commands, spatial queries and its own update), so props nobody wrote are never touched
+ * - When C++ grows the buffer it publishes a new ArrayBuffer and detaches the old one; every call
+ *   re-maps the views first, so a resize in the middle of a frame is picked up transparently
+ */
+
+export const FLOATS_PER_TRANSFORM = 6;
+export const BYTES_PER_COLOR = 4;
+
+export const DIRTY_POSITION = 1;
+export const DIRTY_ORIENTATION = 2;
+export const DIRTY_COLOR = 4;
+
+const HEADER_PROP_COUNT = 0;
+const HEADER_DIRTY_COUNT = 1;
+const HEADER_CAPACITY = 2;
+const HEADER_TRANSFORMS_OFFSET = 3;
+const HEADER_COLORS_OFFSET = 4;
+const HEADER_DIRTY_FLAGS_OFFSET = 5;
+const HEADER_DIRTY_INDICES_OFFSET = 6;
+const HEADER_INT_COUNT = 8;
+
+export class PropTransformBuffer {
+    constructor() {
+        this.memory = null;
+        this.mapViews(null);
+    }
+
+    /**
+     * Current prop count. Kept for callers that refreshed a copy before each frame; the views are live.
+     * @returns {number}
+     */
+    pull() {
+        return this.count;
+    }
+
+    get count() {
+        this.refresh();
+        return this.header[HEADER_PROP_COUNT];
+    }
+
+    /**
+     * Re-map the typed arrays if C++ published a different ArrayBuffer (first use or growth).
+     */
+    refresh() {
+        const memory = globalThis.propTransformMemory;
+        if (memory !== this.memory) {
+            this.memory = memory;
+            this.mapViews(memory instanceof ArrayBuffer ? memory : null);
+        }
+    }
+
+    mapViews(memory) {
+        if (memory === null) {
+            this.header = new Int32Array(HEADER_INT_COUNT);
+            this.transforms = new Float32Array(0);
+            this.colors = new Uint8Array(0);
+            this.dirtyFlags = new Uint8Array(0);
+            this.dirtyIndices = new Int32Array(0);
+            return;
+        }
+
+        const header = new Int32Array(memory, 0, HEADER_INT_COUNT);
+        const capacity = header[HEADER_CAPACITY];
+
+        this.header = header;
+        this.transforms = new Float32Array(memory, header[HEADER_TRANSFORMS_OFFSET], capacity * FLOATS_PER_TRANSFORM);
+        this.colors = new Uint8Array(memory, header[HEADER_COLORS_OFFSET], capacity * BYTES_PER_COLOR);
+        this.dirtyFlags = new Uint8Array(memory, header[HEADER_DIRTY_FLAGS_OFFSET], capacity);
+        this.dirtyIndices = new Int32Array(memory, header[HEADER_DIRTY_INDICES_OFFSET], capacity);
+    }
+
+    setPosition(index, x, y, z) {
+        if (index < 0 || index >= this.count) {
+            return false;
+        }
+
+        const base = index * FLOATS_PER_TRANSFORM;
+        this.transforms[base] = x;
+        this.transforms[base + 1] = y;
+        this.transforms[base + 2] = z;
+        this.markDirty(index, DIRTY_POSITION);
+        return true;
+    }
+
+    setOrientation(index, yaw, pitch, roll) {
+        if (index < 0 || index >= this.count) {
+            return false;
+        }
+
+        const base = index * FLOATS_PER_TRANSFORM;
+        this.transforms[base + 3] = yaw;
+        this.transforms[base + 4] = pitch;
+        this.transforms[base + 5] = roll;
+        this.markDirty(index, DIRTY_ORIENTATION);
+        return true;
+    }
+
+    setColor(index, r, g, b, a = 255) {
+        if (index < 0 || index >= this.count) {
+            return false;
+        }
+
+        const base = index * BYTES_PER_COLOR;
+        this.colors[base] = r;
+        this.colors[base + 1] = g;
+        this.colors[base + 2] = b;
+        this.colors[base + 3] = a;
+        this.markDirty(index, DIRTY_COLOR);
+        return true;
+    }
+
+    /**
+     * Flag fields of an entry; the first flag lists the entry for C++. Call after writing the fields.
+     */
+    markDirty(index, dirtyFlag) {
+        if (this.dirtyFlags[index] === 0) {
+            this.dirtyIndices[this.header[HEADER_DIRTY_COUNT]++] = index;
+        }
+        this.dirtyFlags[index] |= dirtyFlag;
+    }
+
+    /**
+     * Entries written since C++ last applied the buffer.
+     * @returns {number}
+     */
+    getDirtyCount() {
+        this.refresh();
+        return this.header[HEADER_DIRTY_COUNT];
+    }
+}
+
+console.log('PropTransformBuffer: Module loaded');
@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------------------------------
+// SpatialQueryBatch.mjs - Batched spatial queries over props (radius, k-nearest, ray)
+//----------------------------------------------------------------------------------------------------
+
+/**
+ * SpatialQueryBatch - Records spatial queries and answers them in C++ in bulk
+ *
+ * Layout (matches Code/Game/PropSpatialQueryBatch.hpp):
+ * - records: Float64Array, 9 numbers per query [type, x, y, z, dx, dy, dz, range, limit]
+ * - results: Float64Array, per query [hitCount, propHandle0, distance0, propHandle1, distance1, ...]
+ *   (doubles so generational prop handles stay exact); offsets: Int32Array, start of each query's block
+ *
+ * Transport: C++ owns two blocks, published as ArrayBuffers (globalThis.spatialQueryRecordMemory and
+ * globalThis.spatialQueryResultMemory). run() copies the records into the first with one typed-array
+ * set, calls game.submitSpatialQueries(count) once, and copies the answers out of the second, so
+ * nothing is spread into arguments or converted to text. Each batch keeps its own copies, so several
+ * batches can share the C++ blocks.
+ *
+ * Semantics:
+ * - run() answers every pushed query synchronously, in push order, then clears the records
+ * - Radius and nearest hits come nearest first; a ray reports only its first hit (distance along the ray)
+ * - Props are points at their positions; a ray hits props whose center is within hitRadius of it
+ * - Transform writes made through engine.propTransforms earlier in the frame are applied first, so they are seen
+ */
+
+export const SPATIAL_QUERY_RADIUS = 0;
+export const SPATIAL_QUERY_NEAREST = 1;
+export const SPATIAL_QUERY_RAY = 2;
+
+export const NUMBERS_PER_QUERY = 9;
+
+export class SpatialQueryBatch {
+    constructor(initialCapacity = 64) {
+        this.records = new Float64Array(initialCapacity * NUMBERS_PER_QUERY);
+        this.count = 0;
+        this.results = new Float64Array(0);
+        this.offsets = new Int32Array(0);
+        this.resultQueryCount = 0;
+    }
+
+    /** Props within radius of (x, y, z), up to maxResults (0 = no limit). */
+    pushRadius(x, y, z, radius, maxResults = 0) {
+        return this.push(SPATIAL_QUERY_RADIUS, x, y, z, 0, 0, 0, radius, maxResults);
+    }
+
+    /** The k props nearest to (x, y, z), ignoring props past maxRadius (0 = no limit). */
+    pushNearest(x, y, z, k, maxRadius = 0) {
+        return this.push(SPATIAL_QUERY_NEAREST, x, y, z, 0, 0, 0, maxRadius, k);
+    }
+
+    /** First prop within hitRadius of the ray from (x, y, z) along (dx, dy, dz), up to maxDistance. */
+    pushRay(x, y, z, dx, dy, dz, maxDistance, hitRadius = 0.5) {
+        return this.push(SPATIAL_QUERY_RAY, x, y, z, dx, dy, dz, maxDistance, hitRadius);
+    }
+
+    /** @returns {number} Index of the query, for reading its results after run() */
+    push(type, x, y, z, dx, dy, dz, range, limit) {
+        if ((this.count + 1) * NUMBERS_PER_QUERY > this.records.length) {
+            const grown = new Float64Array(this.records.length * 2);
+            grown.set(this.records);
+            this.records = grown;
+        }
+
+        const base = this.count * NUMBERS_PER_QUERY;
+        this.records[base] = type;
+        this.records[base + 1] = x;
+        this.records[base + 2] = y;
+        this.records[base + 3] = z;
+        this.records[base + 4] = dx;
+        this.records[base + 5] = dy;
+        this.records[base + 6] = dz;
+        this.records[base + 7] = range;
+        this.records[base + 8] = limit;
+        return this.count++;
+    }
+
+    /**
+     * Submit every recorded query to C++, fill results/offsets and reset the records.
+     * @returns {number} Total number of hits
+     */
+    run() {
+        const queryCount = this.count;
+
+        this.count = 0;
+        this.resultQueryCount = 0;
+
+        if (queryCount === 0 || typeof game === 'undefined' || !game.submitSpatialQueries) {
+            return 0;
+        }
+
+        const numberCount = queryCount * NUMBERS_PER_QUERY;
+        if (!(globalThis.spatialQueryRecordMemory instanceof ArrayBuffer) ||
+            globalThis.spatialQueryRecordMemory.byteLength < numberCount * Float64Array.BYTES_PER_ELEMENT) {
+            game.reserveSpatialQueries(queryCount);
+        }
+
+        new Float64Array(globalThis.spatialQueryRecordMemory, 0, numberCount).set(this.records.subarray(0, numberCount));
+
+        const hitTotal = game.submitSpatialQueries(queryCount);
+        if (hitTotal < 0) {
+            console.log(`SpatialQueryBatch: C++ rejected ${queryCount} query records`);
+            return 0;
+        }
+
+        // One count per query plus a handle and a distance per hit
+        const resultCount = queryCount + hitTotal * 2;
+        if (this.results.length < resultCount) {
+            this.results = new Float64Array(resultCount);
+        }
+        if (this.offsets.length < queryCount) {
+            this.offsets = new Int32Array(queryCount);
+        }
+
+        this.results.set(new Float64Array(globalThis.spatialQueryResultMemory, 0, resultCount));
+
+        for (let queryIndex = 0, offset = 0; queryIndex < queryCount; ++queryIndex) {
+            this.offsets[queryIndex] = offset;
+            offset += 1 + this.results[offset] * 2;
+        }
+
+        this.resultQueryCount = queryCount;
+        return hitTotal;
+    }
+
+    getHitCount(queryIndex) {
+        return queryIndex < this.resultQueryCount ? this.results[this.offsets[queryIndex]] : 0;
+    }
+
+    getHandle(queryIndex, hitIndex) {
+        return this.results[this.offsets[queryIndex] + 1 + hitIndex * 2];
+    }
+
+    getDistance(queryIndex, hitIndex) {
+        return this.results[this.offsets[queryIndex] + 2 + hitIndex * 2];
+    }
+}
+
+console.log('SpatialQueryBatch: Module loaded');
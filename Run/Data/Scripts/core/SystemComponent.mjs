@@ -42,12 +42,18 @@ export class SystemComponent {
         this.enabled = config.enabled !== false; // Default: true
         this.data = config.data || {}; // System-specific data storage
 
+        // Scheduling (read by JSEngine's SystemScheduler at registration)
+        this.tickInterval = config.tickInterval || 1;          // Update every N frames
+        this.critical = config.critical === true;               // Never deferred by the frame budget
+        this.budgetMs = typeof config.budgetMs === 'number' ? config.budgetMs : null; // Cost estimate (null = measured)
+
         // Logging
         console.log(`SystemComponent: '${this.id}' created (priority: ${this.priority})`);
     }
 
     /**
-     * Update method - called every frame with delta time
+     * Update method - called every tickInterval frames (later if deferred) with the delta time
+     * accumulated since the previous call
      * @param {number} gameDelta - Game time delta (pauses when game paused)
      * @param {number} systemDelta - System time delta (never pauses)
      */
@@ -89,6 +95,8 @@ export class SystemComponent {
             id: this.id,
             priority: this.priority,
             enabled: this.enabled,
+            tickInterval: this.tickInterval,
+            critical: this.critical,
             hasUpdate: this.update !== SystemComponent.prototype.update,
             hasRender: this.render !== SystemComponent.prototype.render,
             dataKeys: Object.keys(this.data)
@@ -96,14 +104,12 @@ export class SystemComponent {
     }
 
     /**
-     * Static version for hot-reload detection
-     * Each component file should override this with Date.now()
+     * Component version, a constant each component file may override and bump by hand
+     * Hot reload detects edits from the module files, so this never needs to change per load
      * Example in subclass:
-     * static get version() { return Date.now(); }
+     * static version = 2;
      */
-    static get version() {
-        return 0;
-    }
+    static version = 0;
 
     /**
      * Get component instance version
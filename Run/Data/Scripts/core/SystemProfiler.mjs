@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------------------------------
+// SystemProfiler.mjs - Per-system timing for JSEngine update/render loops
+//----------------------------------------------------------------------------------------------------
+
+/**
+ * SystemProfiler - Rolling per-system timings (average, max, p99)
+ *
+ * - JSEngine wraps every system call with now() / record()
+ * - Keeps the last WINDOW_SIZE samples per (phase, systemId)
+ * - Every publishInterval frames, publishes a CSV snapshot to C++ via game.publishSystemTimings
+ *   (drawn by the "ScriptProfilerHud" table and written by "ScriptProfilerDump")
+ *
+ * Time source: performance.now() when the embedding provides it, otherwise the C++
+ * game.getHighResolutionMs() binding (Date.now() only has millisecond resolution).
+ */
+
+const WINDOW_SIZE = 120;
+
+function resolveTimeSource() {
+    if (typeof performance !== 'undefined' && typeof performance.now === 'function') {
+        return () => performance.now();
+    }
+    if (typeof game !== 'undefined' && typeof game.getHighResolutionMs === 'function') {
+        return () => game.getHighResolutionMs();
+    }
+    return () => Date.now();
+}
+
+export class SystemProfiler {
+    constructor(publishInterval = 30) {
+        this.enabled = true;
+        this.publishInterval = publishInterval;
+        this.framesSincePublish = 0;
+        this.entries = new Map(); // 'phase:systemId' -> entry
+        this.now = resolveTimeSource();
+        this.deferralSource = null; // optional (systemId) => deferral count, set by JSEngine
+    }
+
+    /**
+     * Record one sample for a system in a phase ('update' or 'render')
+     */
+    record(phase, systemId, milliseconds) {
+        const key = `${phase}:${systemId}`;
+        let entry = this.entries.get(key);
+
+        if (!entry) {
+            entry = {phase, systemId, samples: new Float64Array(WINDOW_SIZE), nextIndex: 0, count: 0, total: 0};
+            this.entries.set(key, entry);
+        }
+
+        entry.total += milliseconds - entry.samples[entry.nextIndex];
+        entry.samples[entry.nextIndex] = milliseconds;
+        entry.nextIndex = (entry.nextIndex + 1) % WINDOW_SIZE;
+        entry.count = Math.min(entry.count + 1, WINDOW_SIZE);
+    }
+
+    /**
+     * Drop a system's history (e.g. after unregistering it)
+     */
+    forget(systemId) {
+        for (const [key, entry] of this.entries) {
+            if (entry.systemId === systemId) {
+                this.entries.delete(key);
+            }
+        }
+    }
+
+    /**
+     * Called once per frame by JSEngine after the render loop
+     */
+    endFrame() {
+        if (++this.framesSincePublish >= this.publishInterval) {
+            this.framesSincePublish = 0;
+            this.publish();
+        }
+    }
+
+    getStats(phase, systemId) {
+        const entry = this.entries.get(`${phase}:${systemId}`);
+        return entry ? SystemProfiler.computeStats(entry) : null;
+    }
+
+    /**
+     * Rolling average without sorting; cheap enough to call every frame (used by the scheduler)
+     */
+    getAverage(phase, systemId) {
+        const entry = this.entries.get(`${phase}:${systemId}`);
+        return entry && entry.count > 0 ? entry.total / entry.count : 0;
+    }
+
+    static computeStats(entry) {
+        const samples = entry.samples.subarray(0, entry.count);
+        let total = 0;
+        let max = 0;
+
+        for (const sample of samples) {
+            total += sample;
+            max = Math.max(max, sample);
+        }
+
+        // Nearest-rank p99
+        const sorted = Float64Array.from(samples).sort();
+        const rank = Math.min(Math.max(Math.ceil(0.99 * sorted.length) - 1, 0), sorted.length - 1);
+
+        return {
+            average: entry.count > 0 ? total / entry.count : 0,
+            max: max,
+            p99: sorted.length > 0 ? sorted[rank] : 0,
+            samples: entry.count
+        };
+    }
+
+    /**
+     * CSV lines: phase,systemId,avgMs,maxMs,p99Ms,samples,deferred
+     */
+    serialize() {
+        const lines = [];
+
+        for (const entry of this.entries.values()) {
+            const stats = SystemProfiler.computeStats(entry);
+            const deferred = this.deferralSource && entry.phase === 'update' ? this.deferralSource(entry.systemId) : 0;
+            lines.push(`${entry.phase},${entry.systemId},${stats.average.toFixed(4)},${stats.max.toFixed(4)},${stats.p99.toFixed(4)},${stats.samples},${deferred}`);
+        }
+
+        return lines.join('\n');
+    }
+
+    publish() {
+        if (typeof game !== 'undefined' && typeof game.publishSystemTimings === 'function') {
+            game.publishSystemTimings(this.serialize());
+        }
+    }
+}
+
+console.log('SystemProfiler: Module loaded');
@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------------------------------
+// SystemScheduler.mjs - Tick-rate and frame-budget scheduling for JSEngine update systems
+//----------------------------------------------------------------------------------------------------
+
+/**
+ * SystemScheduler - Decides which update systems run this frame
+ *
+ * Systems declare (on the component or legacy config object):
+ * - tickInterval: run once every N frames (default 1 = every frame)
+ * - critical:     never deferred and not charged to the budget (default false)
+ * - budgetMs:     expected cost per tick; defaults to the profiler's rolling average
+ *
+ * Scheduling rules:
+ * - Low-rate systems get a tick offset that avoids frames where other low-rate systems tick,
+ *   so e.g. three 120/240/360-frame systems do not all land on frame 720
+ * - A due, non-critical system is deferred to the next frame when its cost estimate no longer
+ *   fits in what the non-critical systems before it left of the frame budget; after
+ *   maxConsecutiveDeferrals it runs regardless. Critical systems (the C++ update) run outside it
+ * - With profiling disabled, JSEngine charges each system's estimate instead of reading the clock
+ * - Game/system deltas accumulate while a system is not ticking and are passed on its next tick
+ */
+
+function greatestCommonDivisor(a, b) {
+    while (b !== 0) {
+        [a, b] = [b, a % b];
+    }
+    return a;
+}
+
+export class SystemScheduler {
+    constructor(frameBudgetMs = 4.0, maxConsecutiveDeferrals = 8) {
+        this.frameBudgetMs = frameBudgetMs;
+        this.maxConsecutiveDeferrals = maxConsecutiveDeferrals;
+        this.schedules = new Map(); // systemId -> schedule
+    }
+
+    /**
+     * Create (or replace) the schedule for a system from its declaration
+     */
+    createSchedule(systemId, declaration = {}) {
+        this.release(systemId);
+
+        const tickInterval = Math.max(1, Math.floor(declaration.tickInterval || 1));
+        const schedule = {
+            systemId: systemId,
+            tickInterval: tickInterval,
+            tickOffset: 0,
+            critical: declaration.critical === true,
+            budgetMs: typeof declaration.budgetMs === 'number' ? declaration.budgetMs : null,
+            isPending: false,
+            pendingGameDelta: 0,
+            pendingSystemDelta: 0,
+            consecutiveDeferrals: 0,
+            // Stats
+            ticks: 0,
+            deferrals: 0,
+            forcedTicks: 0,
+            maxConsecutiveDeferrals: 0,
+            lastTickFrame: -1
+        };
+
+        schedule.tickOffset = this.chooseTickOffset(tickInterval);
+        this.schedules.set(systemId, schedule);
+        return schedule;
+    }
+
+    release(systemId) {
+        this.schedules.delete(systemId);
+    }
+
+    setTickInterval(systemId, tickInterval) {
+        const schedule = this.schedules.get(systemId);
+        if (!schedule) {
+            return false;
+        }
+
+        this.schedules.delete(systemId);
+        schedule.tickInterval = Math.max(1, Math.floor(tickInterval));
+        schedule.tickOffset = this.chooseTickOffset(schedule.tickInterval);
+        this.schedules.set(systemId, schedule);
+        return true;
+    }
+
+    /**
+     * Offset in [0, tickInterval) that collides with the fewest existing low-rate systems.
+     * Two systems (interval a, offset p) and (interval b, offset q) tick on a common frame
+     * iff p ≡ q (mod gcd(a, b)).
+     */
+    chooseTickOffset(tickInterval) {
+        if (tickInterval <= 1) {
+            return 0;
+        }
+
+        let bestOffset = 0;
+        let bestCollisions = Infinity;
+
+        for (let offset = 0; offset < tickInterval; offset++) {
+            let collisions = 0;
+
+            for (const other of this.schedules.values()) {
+                if (other.tickInterval > 1) {
+                    const divisor = greatestCommonDivisor(tickInterval, other.tickInterval);
+                    if ((offset - other.tickOffset) % divisor === 0) {
+                        collisions++;
+                    }
+                }
+            }
+
+            if (collisions < bestCollisions) {
+                bestCollisions = collisions;
+                bestOffset = offset;
+                if (collisions === 0) {
+                    break;
+                }
+            }
+        }
+
+        return bestOffset;
+    }
+
+    /**
+     * Accumulate this frame's deltas and report whether the system is due (or still pending)
+     */
+    isDue(schedule, frameCount, gameDeltaSeconds, systemDeltaSeconds) {
+        schedule.pendingGameDelta += gameDeltaSeconds;
+        schedule.pendingSystemDelta += systemDeltaSeconds;
+
+        if (!schedule.isPending && frameCount % schedule.tickInterval === schedule.tickOffset) {
+            schedule.isPending = true;
+        }
+
+        return schedule.isPending;
+    }
+
+    /**
+     * True if a due system should wait for a later frame. Records the deferral.
+     * spentMs is what non-critical systems already used of this frame's budget.
+     */
+    shouldDefer(schedule, spentMs, estimateMs) {
+        if (schedule.critical || spentMs + estimateMs <= this.frameBudgetMs) {
+            return false;
+        }
+
+        if (schedule.consecutiveDeferrals >= this.maxConsecutiveDeferrals) {
+            schedule.forcedTicks++;
+            return false;
+        }
+
+        schedule.deferrals++;
+        schedule.consecutiveDeferrals++;
+        schedule.maxConsecutiveDeferrals = Math.max(schedule.maxConsecutiveDeferrals, schedule.consecutiveDeferrals);
+        return true;
+    }
+
+    /**
+     * Mark a tick as run and hand back the accumulated deltas
+     */
+    consumeTick(schedule, frameCount) {
+        const deltas = [schedule.pendingGameDelta, schedule.pendingSystemDelta];
+
+        schedule.isPending = false;
+        schedule.pendingGameDelta = 0;
+        schedule.pendingSystemDelta = 0;
+        schedule.consecutiveDeferrals = 0;
+        schedule.ticks++;
+        schedule.lastTickFrame = frameCount;
+
+        return deltas;
+    }
+
+    getDeferralCount(systemId) {
+        const schedule = this.schedules.get(systemId);
+        return schedule ? schedule.deferrals : 0;
+    }
+
+    getStats() {
+        return Array.from(this.schedules.values()).map(schedule => ({
+            id: schedule.systemId,
+            tickInterval: schedule.tickInterval,
+            tickOffset: schedule.tickOffset,
+            critical: schedule.critical,
+            ticks: schedule.ticks,
+            deferrals: schedule.deferrals,
+            forcedTicks: schedule.forcedTicks,
+            maxConsecutiveDeferrals: schedule.maxConsecutiveDeferrals,
+            deferralRate: schedule.ticks + schedule.deferrals > 0 ? schedule.deferrals / (schedule.ticks + schedule.deferrals) : 0,
+            lastTickFrame: schedule.lastTickFrame
+        }));
+    }
+}
+
+console.log('SystemScheduler: Module loaded');
@@ -39,7 +39,8 @@ jsEngineInstance.setGame(jsGameInstance);
 // GLOBAL REFERENCES (for C++ bridge and hot-reload)
 // ============================================================================
 
-// REQUIRED: C++ calls JSEngine.update() and JSEngine.render() through globalThis
+// REQUIRED: C++ resolves JSEngine.update and JSEngine.render once into persistent function handles
+// and calls them every frame, passing the frame deltas to update() as arguments
 globalThis.JSEngine = jsEngineInstance;
 
 // REQUIRED: Hot-reload system needs global reference to JSGame instance